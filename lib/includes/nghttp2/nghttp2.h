@@ -70,6 +70,25 @@ typedef struct nghttp2_session nghttp2_session;
  * The lowest priority value
  */
 #define NGHTTP2_PRI_LOWEST ((1U << 31) - 1)
+/**
+ * @macro
+ *
+ * The default weight of a stream. See
+ * `nghttp2_session_set_stream_weight()`.
+ */
+#define NGHTTP2_DEFAULT_WEIGHT 16
+/**
+ * @macro
+ *
+ * The minimum weight of a stream.
+ */
+#define NGHTTP2_MIN_WEIGHT 1
+/**
+ * @macro
+ *
+ * The maximum weight of a stream.
+ */
+#define NGHTTP2_MAX_WEIGHT 256
 
 /**
  * @macro
@@ -91,6 +110,38 @@ typedef struct nghttp2_session nghttp2_session;
  */
 #define NGHTTP2_INITIAL_CONNECTION_WINDOW_SIZE ((1 << 16) - 1)
 
+/**
+ * @macro
+ *
+ * The size of the header table used in header compression. Both
+ * endpoints must use the same size, so this cannot be changed. The
+ * header compressor can be limited to a smaller part of it using
+ * :enum:`NGHTTP2_OPT_HD_TABLE_SIZE`.
+ */
+#define NGHTTP2_HD_TABLE_SIZE 4096
+/**
+ * @macro
+ *
+ * The default maximum number of header fields in one header block.
+ */
+#define NGHTTP2_DEFAULT_MAX_HEADER_FIELDS 128
+/**
+ * @macro
+ *
+ * The default maximum number of control frames queued for sending.
+ * See :enum:`NGHTTP2_OPT_MAX_OUTBOUND_CTRL`.
+ */
+#define NGHTTP2_DEFAULT_MAX_OUTBOUND_CTRL 1000
+
+/**
+ * @macro
+ *
+ * The opaque data of the PING frames the library sends to measure
+ * the round trip when
+ * :enum:`NGHTTP2_OPT_WINDOW_AUTO_TUNING_MAX` is set.
+ */
+#define NGHTTP2_WINDOW_AUTO_TUNING_PING_DATA "autowind"
+
 /**
  * @macro
  *
@@ -231,13 +282,47 @@ typedef enum {
   /**
    * The user callback function failed. This is a fatal error.
    */
-  NGHTTP2_ERR_CALLBACK_FAILURE = -902
+  NGHTTP2_ERR_CALLBACK_FAILURE = -902,
+  /**
+   * The remote endpoint sent frames faster than it read the replies,
+   * and too many control frames are queued for sending. See
+   * :enum:`NGHTTP2_OPT_MAX_OUTBOUND_CTRL`. This is a fatal error.
+   */
+  NGHTTP2_ERR_FLOODED = -903
 } nghttp2_error;
 
 typedef enum {
   NGHTTP2_MSG_MORE
 } nghttp2_io_flag;
 
+/**
+ * @enum
+ *
+ * The flags for header field name/value pair.
+ */
+typedef enum {
+  /**
+   * No flag set.
+   */
+  NGHTTP2_NV_FLAG_NONE = 0,
+  /**
+   * Indicates that the name contains no upper-case characters, so the
+   * library does not have to scan or lower-case it.
+   */
+  NGHTTP2_NV_FLAG_LOWERCASE = 0x01,
+  /**
+   * Indicates that the library does not copy the name and value.
+   * The application must keep them valid and unmodified until the
+   * frame carrying them is sent or discarded, that is, until
+   * :member:`nghttp2_session_callbacks.on_frame_send_callback` or
+   * :member:`nghttp2_session_callbacks.on_frame_not_send_callback`
+   * is called for the frame, or the session is deleted.  The name
+   * is still copied if it contains upper-case characters and
+   * :enum:`NGHTTP2_NV_FLAG_LOWERCASE` is not set.
+   */
+  NGHTTP2_NV_FLAG_NO_COPY = 0x02
+} nghttp2_nv_flag;
+
 /**
  * @struct
  *
@@ -262,6 +347,12 @@ typedef struct {
    * The length of the |value|.
    */
   uint16_t valuelen;
+  /**
+   * Bitwise OR of one or more of :type:`nghttp2_nv_flag`.  The
+   * name/value pairs the library passes to the application always
+   * have :enum:`NGHTTP2_NV_FLAG_NONE`.
+   */
+  uint8_t flags;
 } nghttp2_nv;
 
 /**
@@ -457,6 +548,29 @@ typedef union {
   void *ptr;
 } nghttp2_data_source;
 
+/**
+ * @enum
+ *
+ * The flags set by :type:`nghttp2_data_source_read_callback` in its
+ * |*data_flags| argument.
+ */
+typedef enum {
+  /**
+   * No flag set.
+   */
+  NGHTTP2_DATA_FLAG_NONE = 0,
+  /**
+   * Indicates EOF was reached.
+   */
+  NGHTTP2_DATA_FLAG_EOF = 0x01,
+  /**
+   * Indicates that the data was not copied to the buffer. The
+   * application sends it by itself in
+   * :type:`nghttp2_send_data_callback`.
+   */
+  NGHTTP2_DATA_FLAG_NO_COPY = 0x02
+} nghttp2_data_flag;
+
 /**
  * @functypedef
  *
@@ -465,7 +579,19 @@ typedef union {
  * implementation of this function must read at most |length| bytes of
  * data from |source| (or possibly other places) and store them in
  * |buf| and return number of data stored in |buf|. If EOF is reached,
- * set |*eof| to 1.  If the application wants to postpone DATA frames,
+ * set :enum:`NGHTTP2_DATA_FLAG_EOF` in |*data_flags|. Setting
+ * |*data_flags| to 1 does the same for compatibility.
+ *
+ * If the application wants to send the data without copying it to
+ * |buf|, set :enum:`NGHTTP2_DATA_FLAG_NO_COPY` in |*data_flags| and
+ * return the number of bytes to send without touching |buf|. The
+ * library then invokes
+ * :member:`nghttp2_session_callbacks.send_data_callback` with the
+ * frame header when the frame is about to be sent, and the
+ * application writes the header and the data itself, for example
+ * using ``writev()`` or ``sendfile()``.
+ *
+ * If the application wants to postpone DATA frames,
  * (e.g., asynchronous I/O, or reading data blocks for long time), it
  * is achieved by returning :enum:`NGHTTP2_ERR_DEFERRED` without
  * reading any data in this invocation.  The library removes DATA
@@ -479,7 +605,7 @@ typedef union {
  */
 typedef ssize_t (*nghttp2_data_source_read_callback)
 (nghttp2_session *session, int32_t stream_id,
- uint8_t *buf, size_t length, int *eof,
+ uint8_t *buf, size_t length, int *data_flags,
  nghttp2_data_source *source, void *user_data);
 
 /**
@@ -761,6 +887,69 @@ typedef ssize_t (*nghttp2_send_callback)
 (nghttp2_session *session,
  const uint8_t *data, size_t length, int flags, void *user_data);
 
+/**
+ * @struct
+ *
+ * The segment of contiguous memory to be sent. This is used by
+ * :type:`nghttp2_sendv_callback`.
+ */
+typedef struct {
+  /**
+   * Pointer to the beginning of the data.
+   */
+  uint8_t *base;
+  /**
+   * The length of the data.
+   */
+  size_t len;
+} nghttp2_vec;
+
+/**
+ * @functypedef
+ *
+ * Callback function invoked when |session| wants to send data to the
+ * remote peer. This is the vectored version of
+ * :type:`nghttp2_send_callback`. The data to be sent is the
+ * concatenation of |iovcnt| segments pointed by |iov|, each of which
+ * holds one or more complete frames. The implementation of this
+ * function must send at most the total length of the segments, in
+ * order, for example using ``writev()``. The |flags| is currently not
+ * used and always 0. It must return the number of bytes sent if it
+ * succeeds, which may be less than the total length. If it cannot
+ * send any single byte without blocking, it must return
+ * :enum:`NGHTTP2_ERR_WOULDBLOCK`. For other errors, it must return
+ * :enum:`NGHTTP2_ERR_CALLBACK_FAILURE`.
+ */
+typedef ssize_t (*nghttp2_sendv_callback)
+(nghttp2_session *session,
+ const nghttp2_vec *iov, size_t iovcnt, int flags, void *user_data);
+
+/**
+ * @functypedef
+ *
+ * Callback function invoked when the DATA frame whose payload was not
+ * copied by :type:`nghttp2_data_source_read_callback` (see
+ * :enum:`NGHTTP2_DATA_FLAG_NO_COPY`) is sent. The |framehd| is the
+ * 8 bytes frame header and the |length| is the number of bytes of
+ * payload, which is the value returned by the read callback. The
+ * |source| is the data source of the stream |stream_id|.
+ *
+ * The implementation of this function must send the frame header and
+ * then |length| bytes of payload to the remote peer. If all data
+ * were sent, it must return 0. It must not send anything partially;
+ * if it cannot send the whole frame without blocking, it must send
+ * nothing (or buffer the rest by itself) and return
+ * :enum:`NGHTTP2_ERR_WOULDBLOCK`, and the library calls it again with
+ * the same frame later. Returning
+ * :enum:`NGHTTP2_ERR_TEMPORAL_CALLBACK_FAILURE` closes the stream by
+ * issuing RST_STREAM with :enum:`NGHTTP2_INTERNAL_ERROR`. For other
+ * errors, it must return :enum:`NGHTTP2_ERR_CALLBACK_FAILURE`.
+ */
+typedef int (*nghttp2_send_data_callback)
+(nghttp2_session *session, int32_t stream_id,
+ const uint8_t *framehd, size_t length,
+ nghttp2_data_source *source, void *user_data);
+
 /**
  * @functypedef
  *
@@ -858,6 +1047,22 @@ typedef void (*nghttp2_on_frame_not_send_callback)
 (nghttp2_session *session, nghttp2_frame *frame, int lib_error_code,
  void *user_data);
 
+/**
+ * @functypedef
+ *
+ * Callback function invoked when the request queued by
+ * `nghttp2_submit_request_async()` cannot be submitted by the owner
+ * thread. The request is dropped after this call. The
+ * |stream_user_data| is the one passed to
+ * `nghttp2_submit_request_async()`, so that the application can
+ * release it. The |lib_error_code| is one of the non-fatal values
+ * defined in :type:`nghttp2_error`. Fatal errors are returned by
+ * `nghttp2_session_send()` and `nghttp2_session_mem_send()` instead.
+ */
+typedef void (*nghttp2_on_request_async_fail_callback)
+(nghttp2_session *session, void *stream_user_data, int lib_error_code,
+ void *user_data);
+
 /**
  * @functypedef
  *
@@ -928,6 +1133,89 @@ typedef void (*nghttp2_on_unknown_frame_recv_callback)
  const uint8_t *payload, size_t payloadlen,
  void *user_data);
 
+/**
+ * @enum
+ *
+ * The choices of how the header compressor sends a header field
+ * which is not in the header table.
+ */
+typedef enum {
+  /**
+   * The library decides. The header field is added to the header
+   * table unless the header table has values of the same name and
+   * none of them has been reused. Such values, like dates and
+   * content-length, are unlikely to repeat, and adding them just
+   * evicts useful entries.
+   */
+  NGHTTP2_HD_INDEXING_DEFAULT = 0,
+  /**
+   * The header field is added to the header table if it fits.
+   */
+  NGHTTP2_HD_INDEXING_INCREMENTAL = 1,
+  /**
+   * The header field is sent as a literal without indexing, and the
+   * header table is left untouched.
+   */
+  NGHTTP2_HD_INDEXING_NONE = 2
+} nghttp2_hd_indexing;
+
+/**
+ * @functypedef
+ *
+ * Callback function invoked when the header compressor is about to
+ * add the header field |nv| to the header table. This is not invoked
+ * for the header fields which are already in the header table or
+ * which cannot be added anyway. The implementation of this function
+ * must return one of :type:`nghttp2_hd_indexing`. Returning
+ * :enum:`NGHTTP2_HD_INDEXING_NONE` for the values which never repeat,
+ * such as request IDs, keeps useful entries in the header table.
+ */
+typedef int (*nghttp2_select_header_indexing_callback)
+(nghttp2_session *session, const nghttp2_nv *nv, void *user_data);
+
+/**
+ * @enum
+ *
+ * The flags passed to :type:`nghttp2_capture_callback`.
+ */
+typedef enum {
+  /**
+   * The bytes were sent to the remote peer.
+   */
+  NGHTTP2_CAPTURE_SEND = 0x01,
+  /**
+   * The bytes were received from the remote peer.
+   */
+  NGHTTP2_CAPTURE_RECV = 0x02
+} nghttp2_capture_flag;
+
+/**
+ * @functypedef
+ *
+ * Callback function invoked with the raw bytes which |session| sent
+ * or received, in the order they appear on the wire. The |flags| is
+ * either :enum:`NGHTTP2_CAPTURE_SEND` or :enum:`NGHTTP2_CAPTURE_RECV`.
+ * The sent bytes are reported when
+ * :member:`nghttp2_session_callbacks.send_callback` or
+ * :member:`nghttp2_session_callbacks.sendv_callback` accepted them,
+ * or when `nghttp2_session_mem_send()` returns them. The received
+ * bytes are reported when they are passed to
+ * `nghttp2_session_mem_recv()`, which includes the bytes read by
+ * `nghttp2_session_recv()`.
+ *
+ * The payload of the DATA frame sent by
+ * :member:`nghttp2_session_callbacks.send_data_callback` is not
+ * available to the library. It is reported with |data| ``NULL`` and
+ * its length in |length|, after the frame header.
+ *
+ * The |data| is only valid during the call. This callback is meant
+ * to record sessions for later analysis and replay; it must not call
+ * the functions of |session|.
+ */
+typedef void (*nghttp2_capture_callback)
+(nghttp2_session *session, uint8_t flags, const uint8_t *data,
+ size_t length, void *user_data);
+
 /**
  * @struct
  *
@@ -1000,8 +1288,139 @@ typedef struct {
    * unknown.
    */
   nghttp2_on_unknown_frame_recv_callback on_unknown_frame_recv_callback;
+  /**
+   * Callback function invoked when the |session| wants to send data
+   * to the remote peer. If this member is not ``NULL``, it is used
+   * instead of :member:`nghttp2_session_callbacks.send_callback` and
+   * several frames are handed over in one call. The total number of
+   * bytes in one call is limited by
+   * :enum:`NGHTTP2_OPT_SENDV_MAX_BYTES`.
+   */
+  nghttp2_sendv_callback sendv_callback;
+  /**
+   * Callback function invoked when the DATA frame whose payload was
+   * not copied by the data source read callback is sent. This is
+   * required if :enum:`NGHTTP2_DATA_FLAG_NO_COPY` is used.
+   */
+  nghttp2_send_data_callback send_data_callback;
+  /**
+   * Callback function invoked when the header compressor decides
+   * whether to add a header field to the header table. If this member
+   * is ``NULL``, :enum:`NGHTTP2_HD_INDEXING_DEFAULT` is used for all
+   * header fields.
+   */
+  nghttp2_select_header_indexing_callback select_header_indexing_callback;
+  /**
+   * Callback function invoked with the raw bytes sent and received by
+   * the |session|. This may be ``NULL``.
+   */
+  nghttp2_capture_callback capture_callback;
+  /**
+   * Callback function invoked when the request queued by
+   * `nghttp2_submit_request_async()` cannot be submitted. This may be
+   * ``NULL``.
+   */
+  nghttp2_on_request_async_fail_callback on_request_async_fail_callback;
 } nghttp2_session_callbacks;
 
+/**
+ * @functypedef
+ *
+ * Custom memory allocator to replace malloc(). The |mem_user_data|
+ * is the :member:`nghttp2_mem.mem_user_data` member.
+ */
+typedef void* (*nghttp2_malloc)(size_t size, void *mem_user_data);
+
+/**
+ * @functypedef
+ *
+ * Custom memory allocator to replace free(). The |mem_user_data| is
+ * the :member:`nghttp2_mem.mem_user_data` member.
+ */
+typedef void (*nghttp2_free)(void *ptr, void *mem_user_data);
+
+/**
+ * @functypedef
+ *
+ * Custom memory allocator to replace calloc(). The |mem_user_data|
+ * is the :member:`nghttp2_mem.mem_user_data` member.
+ */
+typedef void* (*nghttp2_calloc)(size_t nmemb, size_t size,
+                                void *mem_user_data);
+
+/**
+ * @functypedef
+ *
+ * Custom memory allocator to replace realloc(). The |mem_user_data|
+ * is the :member:`nghttp2_mem.mem_user_data` member.
+ */
+typedef void* (*nghttp2_realloc)(void *ptr, size_t size,
+                                 void *mem_user_data);
+
+/**
+ * @struct
+ *
+ * Custom memory allocator functions and user defined pointer. The
+ * |mem_user_data| member is passed to each allocator function. This
+ * can be used, for example, to achieve per-session memory pool or
+ * per-thread arena.
+ *
+ * In the following example code, ``my_malloc``, ``my_free``,
+ * ``my_calloc`` and ``my_realloc`` are the replacement of the
+ * standard allocators ``malloc``, ``free``, ``calloc`` and
+ * ``realloc`` respectively::
+ *
+ *     void *my_malloc_cb(size_t size, void *mem_user_data) {
+ *       return my_malloc(size);
+ *     }
+ *
+ *     void my_free_cb(void *ptr, void *mem_user_data) { my_free(ptr); }
+ *
+ *     void *my_calloc_cb(size_t nmemb, size_t size, void *mem_user_data) {
+ *       return my_calloc(nmemb, size);
+ *     }
+ *
+ *     void *my_realloc_cb(void *ptr, size_t size, void *mem_user_data) {
+ *       return my_realloc(ptr, size);
+ *     }
+ *
+ *     void session_new() {
+ *       nghttp2_session *session;
+ *       nghttp2_session_callbacks callbacks;
+ *       nghttp2_mem mem = {NULL, my_malloc_cb, my_free_cb, my_calloc_cb,
+ *                          my_realloc_cb};
+ *
+ *       ...
+ *
+ *       nghttp2_session_client_new2(&session, &callbacks, NULL, &mem);
+ *
+ *       ...
+ *     }
+ */
+typedef struct {
+  /**
+   * An arbitrary user supplied data. This is passed to each
+   * allocator function.
+   */
+  void *mem_user_data;
+  /**
+   * Custom allocator function to replace malloc().
+   */
+  nghttp2_malloc malloc;
+  /**
+   * Custom allocator function to replace free().
+   */
+  nghttp2_free free;
+  /**
+   * Custom allocator function to replace calloc().
+   */
+  nghttp2_calloc calloc;
+  /**
+   * Custom allocator function to replace realloc().
+   */
+  nghttp2_realloc realloc;
+} nghttp2_mem;
+
 /**
  * @function
  *
@@ -1048,6 +1467,58 @@ int nghttp2_session_server_new(nghttp2_session **session_ptr,
                                const nghttp2_session_callbacks *callbacks,
                                void *user_data);
 
+/**
+ * @function
+ *
+ * Like `nghttp2_session_client_new()`, but with additional custom
+ * memory allocator specified in the |mem|.
+ *
+ * The |mem| can be ``NULL`` and the call is equivalent to
+ * `nghttp2_session_client_new()`.
+ *
+ * This function does not take ownership |mem|. The application is
+ * responsible for freeing |mem|.
+ *
+ * The library code does not refer to |mem| pointer after this
+ * function returns, so the application can safely free it.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * :enum:`NGHTTP2_ERR_NOMEM`
+ *     Out of memory.
+ */
+int nghttp2_session_client_new2(nghttp2_session **session_ptr,
+                                const nghttp2_session_callbacks *callbacks,
+                                void *user_data,
+                                const nghttp2_mem *mem);
+
+/**
+ * @function
+ *
+ * Like `nghttp2_session_server_new()`, but with additional custom
+ * memory allocator specified in the |mem|.
+ *
+ * The |mem| can be ``NULL`` and the call is equivalent to
+ * `nghttp2_session_server_new()`.
+ *
+ * This function does not take ownership |mem|. The application is
+ * responsible for freeing |mem|.
+ *
+ * The library code does not refer to |mem| pointer after this
+ * function returns, so the application can safely free it.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * :enum:`NGHTTP2_ERR_NOMEM`
+ *     Out of memory.
+ */
+int nghttp2_session_server_new2(nghttp2_session **session_ptr,
+                                const nghttp2_session_callbacks *callbacks,
+                                void *user_data,
+                                const nghttp2_mem *mem);
+
 /**
  * @function
  *
@@ -1075,7 +1546,44 @@ typedef enum {
    * is responsible for sending WINDOW_UPDATE with stream ID 0 using
    * `nghttp2_submit_window_update`.
    */
-  NGHTTP2_OPT_NO_AUTO_CONNECTION_WINDOW_UPDATE = 2
+  NGHTTP2_OPT_NO_AUTO_CONNECTION_WINDOW_UPDATE = 2,
+  /**
+   * This option sets the number of bytes the library packs into one
+   * :member:`nghttp2_session_callbacks.sendv_callback` call.
+   */
+  NGHTTP2_OPT_SENDV_MAX_BYTES = 3,
+  /**
+   * This option sets the maximum payload length of DATA frames the
+   * library sends.
+   */
+  NGHTTP2_OPT_MAX_DATA_PAYLOAD_LENGTH = 4,
+  /**
+   * This option enables automatic tuning of the local flow control
+   * windows and sets the upper limit of them.
+   */
+  NGHTTP2_OPT_WINDOW_AUTO_TUNING_MAX = 5,
+  /**
+   * This option limits the part of the header table the header
+   * compressor uses.
+   */
+  NGHTTP2_OPT_HD_TABLE_SIZE = 6,
+  /**
+   * This option sets the maximum number of header fields in one
+   * header block.
+   */
+  NGHTTP2_OPT_MAX_HEADER_FIELDS = 7,
+  /**
+   * This option enables Huffman coding of header names and values.
+   */
+  NGHTTP2_OPT_HD_HUFFMAN = 8,
+  /**
+   * This option sets the maximum number of control frames queued for
+   * sending before incoming frames are refused.  Only the frames the
+   * library queues in reply to the received frames count: PING
+   * replies, RST_STREAM for invalid frames and WINDOW_UPDATE for
+   * received DATA.  The frames the application submits do not.
+   */
+  NGHTTP2_OPT_MAX_OUTBOUND_CTRL = 9
 } nghttp2_opt;
 
 /**
@@ -1103,12 +1611,132 @@ typedef enum {
  *     sending WINDOW_UPDATE using
  *     `nghttp2_submit_window_update`. This option defaults to 0.
  *
+ * :enum:`NGHTTP2_OPT_SENDV_MAX_BYTES`
+ *     The |optval| must be a pointer to ``size_t``. The library stops
+ *     packing frames for one
+ *     :member:`nghttp2_session_callbacks.sendv_callback` call once the
+ *     number of bytes reaches |*optval|. At least one frame is always
+ *     packed, so the call may exceed |*optval| by at most one
+ *     frame. The |*optval| must be greater than 0. This option
+ *     defaults to 65536.
+ *
+ * :enum:`NGHTTP2_OPT_MAX_DATA_PAYLOAD_LENGTH`
+ *     The |optval| must be a pointer to ``size_t``. The library sends
+ *     DATA frames with at most |*optval| bytes of payload. The
+ *     |*optval| must be in the range [1, 65535], inclusive. This
+ *     option defaults to 4096.
+ *
+ *     The payload length is adapted per stream. Each stream starts
+ *     with at most 4096 bytes per DATA frame, and the limit doubles,
+ *     up to |*optval|, each time a full-size DATA frame is sent and
+ *     the stream continues to send. The limit goes back to 4096 when
+ *     the stream is preempted by higher priority frames or when
+ *     :member:`nghttp2_data_provider.read_callback` returns
+ *     :enum:`NGHTTP2_ERR_DEFERRED`. Therefore, bulk transfers use
+ *     large frames, while interactive streams and streams competing
+ *     with higher priority ones use small frames. The flow control
+ *     window further limits the payload.
+ *
+ * :enum:`NGHTTP2_OPT_WINDOW_AUTO_TUNING_MAX`
+ *     The |optval| must be a pointer to ``int32_t``. If the |*optval|
+ *     is nonzero, the library tunes the connection-level and
+ *     stream-level local flow control windows from the measured
+ *     bandwidth-delay product, and never grows them beyond
+ *     |*optval| bytes. The |*optval| must be in the range [0,
+ *     :macro:`NGHTTP2_MAX_WINDOW_SIZE`], inclusive. This option
+ *     defaults to 0, which disables the tuning.
+ *
+ *     While DATA is received, the library keeps one PING in flight
+ *     and counts the DATA bytes received until the PING is
+ *     acknowledged. This is the amount of data the remote endpoint
+ *     delivers in one round trip. If it exceeds 2/3 of the current
+ *     window, the transfer is limited by the window, and the window
+ *     is grown to twice the measured amount. If it falls below 1/4
+ *     of the window, because the transfer has finished or the
+ *     application has stopped consuming data, the window is halved,
+ *     but not below its initial size. The connection and stream
+ *     windows follow the new size when DATA is received on them. A
+ *     grown window is advertised with WINDOW_UPDATE, and a shrunk
+ *     window is taken back by withholding subsequent WINDOW_UPDATE.
+ *
+ *     These PING frames carry the opaque data
+ *     :macro:`NGHTTP2_WINDOW_AUTO_TUNING_PING_DATA`, and they are
+ *     reported to the callbacks like any other PING.
+ *
+ *     The window of a stream is only tuned if
+ *     :enum:`NGHTTP2_OPT_NO_AUTO_STREAM_WINDOW_UPDATE` is not set,
+ *     and the connection window is only tuned if
+ *     :enum:`NGHTTP2_OPT_NO_AUTO_CONNECTION_WINDOW_UPDATE` is not
+ *     set.
+ *
+ * :enum:`NGHTTP2_OPT_HD_TABLE_SIZE`
+ *     The |optval| must be a pointer to ``size_t``. The header
+ *     compressor only adds header fields to the header table while
+ *     the table fits in |*optval| bytes, and sends the other fields
+ *     as literals. This saves memory at the cost of compression
+ *     ratio. The |*optval| must be in the range [0,
+ *     :macro:`NGHTTP2_HD_TABLE_SIZE`], inclusive. This option
+ *     defaults to :macro:`NGHTTP2_HD_TABLE_SIZE`.
+ *
+ *     The header table of the header decompressor always has
+ *     :macro:`NGHTTP2_HD_TABLE_SIZE` bytes, since the remote endpoint
+ *     decides what it contains and the current draft has no way to
+ *     negotiate the size.
+ *
+ * :enum:`NGHTTP2_OPT_MAX_HEADER_FIELDS`
+ *     The |optval| must be a pointer to ``size_t``. The header
+ *     compressor and decompressor handle at most |*optval| header
+ *     fields in one header block. Submitting more header fields than
+ *     this makes the frame fail with
+ *     :enum:`NGHTTP2_ERR_HEADER_COMP`, and receiving more is a
+ *     compression error. Each header field of the capacity costs
+ *     about 100 bytes per session. The |*optval| must be in the range [1,
+ *     :macro:`NGHTTP2_DEFAULT_MAX_HEADER_FIELDS`], inclusive, and it
+ *     must not be less than the number of header fields remembered
+ *     from the last header block. This option defaults to
+ *     :macro:`NGHTTP2_DEFAULT_MAX_HEADER_FIELDS`.
+ *
+ * :enum:`NGHTTP2_OPT_HD_HUFFMAN`
+ *     The |optval| must be a pointer to ``int``. If the |*optval| is
+ *     nonzero, the header compressor encodes each header name and
+ *     value with the static Huffman code when it makes the literal
+ *     shorter, and the header decompressor accepts Huffman encoded
+ *     literals. Typical header values shrink by 20-30%. This option
+ *     defaults to 0.
+ *
+ *     The current draft has no way to negotiate this, and it changes
+ *     the encoding of every literal in the header block: the length
+ *     is prefixed with 7 bits instead of 8, and the most significant
+ *     bit tells whether the literal is Huffman encoded. Therefore,
+ *     both endpoints must enable it by prior agreement, and it must be
+ *     set before any header block is sent or received. Setting it
+ *     later fails with :enum:`NGHTTP2_ERR_INVALID_ARGUMENT`.
+ *
+ * :enum:`NGHTTP2_OPT_MAX_OUTBOUND_CTRL`
+ *     The |optval| must be a pointer to ``size_t``. PING, SETTINGS,
+ *     RST_STREAM, PRIORITY and WINDOW_UPDATE frames are queued in a
+ *     separate FIFO queue, which is sent before HEADERS and DATA.
+ *     The library queues some of them by itself in reply to the
+ *     remote endpoint: a PING reply for each PING received,
+ *     RST_STREAM for invalid frames and WINDOW_UPDATE for received
+ *     DATA. If |*optval| or more of these replies are in this queue
+ *     when a new frame starts to arrive, `nghttp2_session_recv()` and
+ *     `nghttp2_session_mem_recv()` fail with
+ *     :enum:`NGHTTP2_ERR_FLOODED` instead of processing it, because
+ *     the remote endpoint is sending frames without reading the
+ *     replies. The application should drop the connection then. The
+ *     frames submitted by the application are not counted. The
+ *     |*optval| must be greater than 0. This option defaults to
+ *     :macro:`NGHTTP2_DEFAULT_MAX_OUTBOUND_CTRL`.
+ *
  * This function returns 0 if it succeeds, or one of the following
  * negative error codes:
  *
  * :enum:`NGHTTP2_ERR_INVALID_ARGUMENT`
  *     The |optname| is not supported; or the |optval| and/or the
  *     |optlen| are invalid.
+ * :enum:`NGHTTP2_ERR_NOMEM`
+ *     Out of memory.
  */
 int nghttp2_session_set_option(nghttp2_session *session,
                                int optname, void *optval, size_t optlen);
@@ -1139,7 +1767,11 @@ int nghttp2_session_set_option(nghttp2_session *session,
  * 5. :member:`nghttp2_session_callbacks.before_ctrl_send_callback` is
  *    invoked.
  * 6. :member:`nghttp2_session_callbacks.send_callback` is invoked one
- *    or more times to send the frame.
+ *    or more times to send the frame. If the frame is a DATA frame
+ *    whose payload was not copied (see
+ *    :enum:`NGHTTP2_DATA_FLAG_NO_COPY`),
+ *    :member:`nghttp2_session_callbacks.send_data_callback` is invoked
+ *    instead.
  * 7. If the frame is a control frame,
  *    :member:`nghttp2_session_callbacks.on_ctrl_send_callback` is
  *    invoked.
@@ -1151,6 +1783,21 @@ int nghttp2_session_set_option(nghttp2_session *session,
  *    :member:`nghttp2_session_callbacks.on_stream_close_callback` is
  *    invoked.
  *
+ * If :member:`nghttp2_session_callbacks.sendv_callback` is set, steps
+ * 1-5 and 7-9 are repeated for each frame until
+ * :enum:`NGHTTP2_OPT_SENDV_MAX_BYTES` bytes are packed, and then
+ * :member:`nghttp2_session_callbacks.sendv_callback` is invoked with
+ * all packed frames. In this case, the callbacks in steps 7-9 are
+ * invoked when the frame is packed, which is before the frame is
+ * actually handed over to the application. If the sendv callback
+ * does not send all bytes, the rest are sent first in the next call
+ * of this function.
+ *
+ * Before any of the above, the requests and DATA resumptions queued
+ * by `nghttp2_submit_request_async()` and
+ * `nghttp2_session_resume_data_async()` are submitted in the order
+ * they were queued.
+ *
  * This function returns 0 if it succeeds, or one of the following
  * negative error codes:
  *
@@ -1161,6 +1808,55 @@ int nghttp2_session_set_option(nghttp2_session *session,
  */
 int nghttp2_session_send(nghttp2_session *session);
 
+/**
+ * @function
+ *
+ * Returns the serialized data to send.
+ *
+ * This function behaves like `nghttp2_session_send()` except that it
+ * does not use :member:`nghttp2_session_callbacks.send_callback` (nor
+ * :member:`nghttp2_session_callbacks.sendv_callback`) to transmit
+ * data. Instead, it assigns the pointer to the serialized data to the
+ * |*data_ptr| and returns its length. The other callbacks are called
+ * in the same way as they are in `nghttp2_session_send()`.
+ *
+ * The returned bytes are treated as sent, so the application must
+ * send all of them to the remote peer. The memory pointed by
+ * |*data_ptr| is owned by the |session| and is only valid until the
+ * next call of this function or `nghttp2_session_send()`.
+ *
+ * The frame is finished, and
+ * :member:`nghttp2_session_callbacks.on_frame_send_callback` or
+ * :member:`nghttp2_session_callbacks.on_data_send_callback` is
+ * invoked for it, in the next call of this function. Therefore, the
+ * application should call this function repeatedly until it returns
+ * 0. Until then, `nghttp2_session_want_write()` may return nonzero.
+ *
+ * A DATA frame whose payload was not copied (see
+ * :enum:`NGHTTP2_DATA_FLAG_NO_COPY`) is sent by
+ * :member:`nghttp2_session_callbacks.send_data_callback` inside this
+ * function. The bytes returned by the previous call must be sent
+ * before calling this function again in this case. If
+ * :member:`nghttp2_session_callbacks.send_data_callback` returns
+ * :enum:`NGHTTP2_ERR_WOULDBLOCK`, this function returns 0.
+ *
+ * Like `nghttp2_session_send()`, this function first submits the
+ * requests and DATA resumptions queued by
+ * `nghttp2_submit_request_async()` and
+ * `nghttp2_session_resume_data_async()`.
+ *
+ * This function returns the length of the data pointed by
+ * |*data_ptr|, which is 0 if there is no data to send, or one of the
+ * following negative error codes:
+ *
+ * :enum:`NGHTTP2_ERR_NOMEM`
+ *     Out of memory.
+ * :enum:`NGHTTP2_ERR_CALLBACK_FAILURE`
+ *     The callback function failed.
+ */
+ssize_t nghttp2_session_mem_send(nghttp2_session *session,
+                                 const uint8_t **data_ptr);
+
 /**
  * @function
  *
@@ -1222,6 +1918,9 @@ int nghttp2_session_send(nghttp2_session *session);
  *     Out of memory.
  * :enum:`NGHTTP2_ERR_CALLBACK_FAILURE`
  *     The callback function failed.
+ * :enum:`NGHTTP2_ERR_FLOODED`
+ *     Too many control frames are queued for sending. See
+ *     :enum:`NGHTTP2_OPT_MAX_OUTBOUND_CTRL`.
  */
 int nghttp2_session_recv(nghttp2_session *session);
 
@@ -1246,6 +1945,9 @@ int nghttp2_session_recv(nghttp2_session *session);
  *
  * :enum:`NGHTTP2_ERR_NOMEM`
  *     Out of memory.
+ * :enum:`NGHTTP2_ERR_FLOODED`
+ *     Too many control frames are queued for sending. See
+ *     :enum:`NGHTTP2_OPT_MAX_OUTBOUND_CTRL`.
  */
 ssize_t nghttp2_session_mem_recv(nghttp2_session *session,
                                  const uint8_t *in, size_t inlen);
@@ -1266,6 +1968,34 @@ ssize_t nghttp2_session_mem_recv(nghttp2_session *session,
  */
 int nghttp2_session_resume_data(nghttp2_session *session, int32_t stream_id);
 
+/**
+ * @function
+ *
+ * Same as `nghttp2_session_resume_data()`, but this function may be
+ * called from any thread, while the other functions of |session| are
+ * only called from the thread which owns it. The resumption is queued
+ * without locking and carried out at the next call of
+ * `nghttp2_session_send()` or `nghttp2_session_mem_send()` by the
+ * owner thread. It is silently dropped if the stream is closed or has
+ * no deferred data by then.
+ *
+ * This function does not wake the owner thread up. The application
+ * has to notify it, so that it calls `nghttp2_session_send()` or
+ * `nghttp2_session_mem_send()`.
+ * `nghttp2_session_want_write()` returns nonzero while anything is
+ * queued. The |session| must not be deleted while other threads may
+ * call this function. The memory allocator of |session| must be
+ * thread-safe.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * :enum:`NGHTTP2_ERR_NOMEM`
+ *     Out of memory.
+ */
+int nghttp2_session_resume_data_async(nghttp2_session *session,
+                                      int32_t stream_id);
+
 /**
  * @function
  *
@@ -1305,6 +2035,35 @@ int nghttp2_session_want_write(nghttp2_session *session);
 void* nghttp2_session_get_stream_user_data(nghttp2_session *session,
                                            int32_t stream_id);
 
+/**
+ * @function
+ *
+ * Sets the weight of the stream |stream_id| to |weight|. The weight
+ * is local to the |session| and is not sent to the remote endpoint.
+ *
+ * Streams of different priority never share the connection: DATA of
+ * the stream with the highest priority is always sent first. Streams
+ * of the same priority take turns in round-robin fashion, and in each
+ * turn a stream sends DATA frames until it has sent ``1024 *
+ * weight`` bytes or has no more data to send right now. The frame
+ * that crosses the limit is sent in full, so a turn sends at least
+ * one frame. Therefore, the bandwidth is shared in proportion to
+ * the weights as long as the frames are smaller than the share of a
+ * turn. The weight of a new stream is
+ * :macro:`NGHTTP2_DEFAULT_WEIGHT`, which is 16KiB per turn.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * :enum:`NGHTTP2_ERR_INVALID_ARGUMENT`
+ *     The |weight| is not in the range [:macro:`NGHTTP2_MIN_WEIGHT`,
+ *     :macro:`NGHTTP2_MAX_WEIGHT`], inclusive.
+ * :enum:`NGHTTP2_ERR_STREAM_CLOSED`
+ *     The stream is already closed or does not exist.
+ */
+int nghttp2_session_set_stream_weight(nghttp2_session *session,
+                                      int32_t stream_id, int32_t weight);
+
 /**
  * @function
  *
@@ -1313,6 +2072,153 @@ void* nghttp2_session_get_stream_user_data(nghttp2_session *session,
  */
 size_t nghttp2_session_get_outbound_queue_size(nghttp2_session *session);
 
+/**
+ * @macro
+ *
+ * The number of elements of the per frame type arrays in
+ * :type:`nghttp2_session_stats`. The frames whose type is not less
+ * than this value are not counted.
+ */
+#define NGHTTP2_STATS_FRAME_TYPE_MAX (NGHTTP2_WINDOW_UPDATE + 1)
+
+/**
+ * @struct
+ *
+ * The statistics of a session. The per frame type arrays are indexed
+ * by :type:`nghttp2_frame_type`. The byte counts of frames include
+ * the frame header. See `nghttp2_session_get_stats()`.
+ */
+typedef struct {
+  /**
+   * The number of frames sent.
+   */
+  uint64_t frames_sent[NGHTTP2_STATS_FRAME_TYPE_MAX];
+  /**
+   * The number of bytes of the frames sent.
+   */
+  uint64_t bytes_sent[NGHTTP2_STATS_FRAME_TYPE_MAX];
+  /**
+   * The number of frames received, including ignored DATA frames.
+   */
+  uint64_t frames_recv[NGHTTP2_STATS_FRAME_TYPE_MAX];
+  /**
+   * The number of bytes of the frames received.
+   */
+  uint64_t bytes_recv[NGHTTP2_STATS_FRAME_TYPE_MAX];
+  /**
+   * The total length of the names and values of the header fields
+   * given to the header compressor.
+   */
+  uint64_t deflate_in_bytes;
+  /**
+   * The total length of the header blocks produced by the header
+   * compressor.
+   */
+  uint64_t deflate_out_bytes;
+  /**
+   * The total length of the header blocks given to the header
+   * decompressor.
+   */
+  uint64_t inflate_in_bytes;
+  /**
+   * The total length of the names and values of the header fields
+   * produced by the header decompressor.
+   */
+  uint64_t inflate_out_bytes;
+  /**
+   * The number of times DATA was deferred because the read callback
+   * returned :enum:`NGHTTP2_ERR_DEFERRED`.
+   */
+  uint64_t data_deferred;
+  /**
+   * The number of times DATA was deferred because the flow control
+   * window was exhausted.
+   */
+  uint64_t data_fc_blocked;
+  /**
+   * The number of frames in the queue for frames other than
+   * stream-creating HEADERS and the control frames counted in
+   * |ob_ctrl_len|.
+   */
+  size_t ob_pq_len;
+  /**
+   * The number of PING, SETTINGS, RST_STREAM, PRIORITY and
+   * WINDOW_UPDATE frames in the queue. See
+   * :enum:`NGHTTP2_OPT_MAX_OUTBOUND_CTRL`.
+   */
+  size_t ob_ctrl_len;
+  /**
+   * The number of stream-creating HEADERS frames in the queue.
+   */
+  size_t ob_ss_pq_len;
+  /**
+   * The number of streams whose DATA is currently deferred, including
+   * the ones blocked by flow control.
+   */
+  size_t num_deferred_data;
+  /**
+   * The number of streams whose DATA is currently blocked by flow
+   * control.
+   */
+  size_t num_fc_blocked;
+  /**
+   * The number of bytes allocated for outbound frame buffers.
+   */
+  size_t framebuf_bytes;
+  /**
+   * The number of bytes allocated for the inbound frame buffer.
+   */
+  size_t iframe_buf_bytes;
+  /**
+   * The number of bytes allocated for the header compressor,
+   * including its header table.
+   */
+  size_t deflater_bytes;
+  /**
+   * The number of bytes allocated for the header decompressor,
+   * including its header table.
+   */
+  size_t inflater_bytes;
+  /**
+   * The number of bytes allocated for the pools of streams and
+   * outbound frames.
+   */
+  size_t pool_bytes;
+} nghttp2_session_stats;
+
+/**
+ * @function
+ *
+ * Stores the statistics of the |session| in |*stats|. The counters
+ * are accumulated since the |session| was created. The other fields
+ * are computed on each call, which visits all streams, so this
+ * function should not be called for every frame.
+ *
+ * The library has no time source, so the time DATA was blocked by
+ * flow control is not available. Use
+ * :member:`nghttp2_session_stats.data_fc_blocked` and
+ * :member:`nghttp2_session_stats.num_fc_blocked` instead.
+ */
+void nghttp2_session_get_stats(nghttp2_session *session,
+                               nghttp2_session_stats *stats);
+
+/**
+ * @function
+ *
+ * Releases the memory which the |session| keeps for later use: the
+ * frame buffers, the working buffers of the header compressor and
+ * decompressor, and the pools of streams and outbound frames if they
+ * have no object in use. Buffers which are in use, for example the
+ * buffer holding a partially sent frame, are kept. The released
+ * memory is reallocated when it is needed again. The header tables
+ * are kept, since they are part of the connection state.
+ *
+ * The application should call this function when the connection
+ * becomes idle. Use `nghttp2_session_get_stats()` to see how much
+ * memory the |session| holds before and after this call.
+ */
+void nghttp2_session_shrink(nghttp2_session *session);
+
 /**
  * @function
  *
@@ -1512,6 +2418,94 @@ int nghttp2_submit_response(nghttp2_session *session,
                             int32_t stream_id, const char **nv,
                             const nghttp2_data_provider *data_prd);
 
+/**
+ * @function
+ *
+ * Same as `nghttp2_submit_request()`, but the name/value pairs are
+ * given in |nva| with explicit lengths. The |nvlen| is the number of
+ * name/value pairs in |nva|.
+ *
+ * Unlike `nghttp2_submit_request()`, this function copies names and
+ * values only if :enum:`NGHTTP2_NV_FLAG_NO_COPY` is not set in
+ * :member:`nghttp2_nv.flags`, and lower-cases names only if
+ * :enum:`NGHTTP2_NV_FLAG_LOWERCASE` is not set. The array |nva|
+ * itself is not referred after this function returns.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * :enum:`NGHTTP2_ERR_INVALID_ARGUMENT`
+ *     The |pri| is invalid; or the |nva| includes empty name, name
+ *     with control characters, or ``NULL`` value with non-zero
+ *     length.
+ * :enum:`NGHTTP2_ERR_NOMEM`
+ *     Out of memory.
+ */
+int nghttp2_submit_request2(nghttp2_session *session, int32_t pri,
+                            const nghttp2_nv *nva, size_t nvlen,
+                            const nghttp2_data_provider *data_prd,
+                            void *stream_user_data);
+
+/**
+ * @function
+ *
+ * Same as `nghttp2_submit_request2()`, but this function may be
+ * called from any thread, while the other functions of |session| are
+ * only called from the thread which owns it. The name/value pairs are
+ * copied (subject to :enum:`NGHTTP2_NV_FLAG_NO_COPY`) and the request
+ * is queued without locking. The owner thread submits the queued
+ * requests in batch at the next call of `nghttp2_session_send()` or
+ * `nghttp2_session_mem_send()`. The callbacks of |data_prd| and the
+ * callbacks for the stream are invoked by the owner thread. If the
+ * request cannot be submitted then,
+ * :member:`nghttp2_session_callbacks.on_request_async_fail_callback`
+ * is invoked with |stream_user_data|.
+ *
+ * This function does not wake the owner thread up. The application
+ * has to notify it, so that it calls `nghttp2_session_send()` or
+ * `nghttp2_session_mem_send()`.
+ * `nghttp2_session_want_write()` returns nonzero while anything is
+ * queued. The |session| must not be deleted while other threads may
+ * call this function. The memory allocator of |session| must be
+ * thread-safe.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * :enum:`NGHTTP2_ERR_INVALID_ARGUMENT`
+ *     The |pri| is invalid; or the |nva| includes empty name, name
+ *     with control characters, or ``NULL`` value with non-zero
+ *     length.
+ * :enum:`NGHTTP2_ERR_NOMEM`
+ *     Out of memory.
+ */
+int nghttp2_submit_request_async(nghttp2_session *session, int32_t pri,
+                                 const nghttp2_nv *nva, size_t nvlen,
+                                 const nghttp2_data_provider *data_prd,
+                                 void *stream_user_data);
+
+/**
+ * @function
+ *
+ * Same as `nghttp2_submit_response()`, but the name/value pairs are
+ * given in |nva| with explicit lengths. The |nvlen| is the number of
+ * name/value pairs in |nva|. See `nghttp2_submit_request2()` for how
+ * :member:`nghttp2_nv.flags` is treated.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * :enum:`NGHTTP2_ERR_INVALID_ARGUMENT`
+ *     The |nva| includes empty name, name with control characters,
+ *     or ``NULL`` value with non-zero length.
+ * :enum:`NGHTTP2_ERR_NOMEM`
+ *     Out of memory.
+ */
+int nghttp2_submit_response2(nghttp2_session *session,
+                             int32_t stream_id,
+                             const nghttp2_nv *nva, size_t nvlen,
+                             const nghttp2_data_provider *data_prd);
+
 /**
  * @function
  *
@@ -206,9 +206,9 @@ void nghttp2_frame_headers_init(nghttp2_headers *frame,
   frame->cat = NGHTTP2_HCAT_REQUEST;
 }
 
-void nghttp2_frame_headers_free(nghttp2_headers *frame)
+void nghttp2_frame_headers_free(nghttp2_headers *frame, nghttp2_mem *mem)
 {
-  nghttp2_nv_array_del(frame->nva);
+  nghttp2_nv_array_del(frame->nva, mem);
 }
 
 void nghttp2_frame_priority_init(nghttp2_priority *frame, int32_t stream_id,
@@ -247,9 +247,9 @@ void nghttp2_frame_settings_init(nghttp2_settings *frame,
   frame->iv = iv;
 }
 
-void nghttp2_frame_settings_free(nghttp2_settings *frame)
+void nghttp2_frame_settings_free(nghttp2_settings *frame, nghttp2_mem *mem)
 {
-  free(frame->iv);
+  nghttp2_mem_free(mem, frame->iv);
 }
 
 void nghttp2_frame_push_promise_init(nghttp2_push_promise *frame,
@@ -264,9 +264,10 @@ void nghttp2_frame_push_promise_init(nghttp2_push_promise *frame,
   frame->nvlen = nvlen;
 }
 
-void nghttp2_frame_push_promise_free(nghttp2_push_promise *frame)
+void nghttp2_frame_push_promise_free(nghttp2_push_promise *frame,
+                                     nghttp2_mem *mem)
 {
-  nghttp2_nv_array_del(frame->nva);
+  nghttp2_nv_array_del(frame->nva, mem);
 }
 
 void nghttp2_frame_ping_init(nghttp2_ping *frame, uint8_t flags,
@@ -295,9 +296,9 @@ void nghttp2_frame_goaway_init(nghttp2_goaway *frame, int32_t last_stream_id,
   frame->opaque_data_len = opaque_data_len;
 }
 
-void nghttp2_frame_goaway_free(nghttp2_goaway *frame)
+void nghttp2_frame_goaway_free(nghttp2_goaway *frame, nghttp2_mem *mem)
 {
-  free(frame->opaque_data);
+  nghttp2_mem_free(mem, frame->opaque_data);
 }
 
 void nghttp2_frame_window_update_init(nghttp2_window_update *frame,
@@ -352,7 +353,7 @@ ssize_t nghttp2_frame_pack_headers(uint8_t **buf_ptr,
   frame->hd.length = framelen - NGHTTP2_FRAME_HEAD_LENGTH;
   /* If frame->nvlen == 0, *buflen_ptr may be smaller than
      nv_offset */
-  rv = nghttp2_reserve_buffer(buf_ptr, buflen_ptr, nv_offset);
+  rv = nghttp2_reserve_buffer(buf_ptr, buflen_ptr, nv_offset, deflater->mem);
   if(rv < 0) {
     return rv;
   }
@@ -379,7 +380,7 @@ int nghttp2_frame_unpack_headers(nghttp2_headers *frame,
   }
   pnv_offset = headers_nv_offset(frame) - NGHTTP2_FRAME_HEAD_LENGTH;
   r = nghttp2_hd_inflate_hd(inflater, &frame->nva,
-                            (uint8_t*)payload + pnv_offset,
+                            payload + pnv_offset,
                             payloadlen - pnv_offset);
   if(r < 0) {
     return r;
@@ -409,11 +410,12 @@ int nghttp2_frame_unpack_headers_without_nv(nghttp2_headers *frame,
 }
 
 ssize_t nghttp2_frame_pack_priority(uint8_t **buf_ptr, size_t *buflen_ptr,
-                                    nghttp2_priority *frame)
+                                    nghttp2_priority *frame,
+                                    nghttp2_mem *mem)
 {
   ssize_t framelen= NGHTTP2_FRAME_HEAD_LENGTH + 4;
   int r;
-  r = nghttp2_reserve_buffer(buf_ptr, buflen_ptr, framelen);
+  r = nghttp2_reserve_buffer(buf_ptr, buflen_ptr, framelen, mem);
   if(r != 0) {
     return r;
   }
@@ -437,11 +439,12 @@ int nghttp2_frame_unpack_priority(nghttp2_priority *frame,
 }
 
 ssize_t nghttp2_frame_pack_rst_stream(uint8_t **buf_ptr, size_t *buflen_ptr,
-                                      nghttp2_rst_stream *frame)
+                                      nghttp2_rst_stream *frame,
+                                      nghttp2_mem *mem)
 {
   ssize_t framelen = NGHTTP2_FRAME_HEAD_LENGTH + 4;
   int r;
-  r = nghttp2_reserve_buffer(buf_ptr, buflen_ptr, framelen);
+  r = nghttp2_reserve_buffer(buf_ptr, buflen_ptr, framelen, mem);
   if(r != 0) {
     return r;
   }
@@ -464,11 +467,12 @@ int nghttp2_frame_unpack_rst_stream(nghttp2_rst_stream *frame,
 }
 
 ssize_t nghttp2_frame_pack_settings(uint8_t **buf_ptr, size_t *buflen_ptr,
-                                    nghttp2_settings *frame)
+                                    nghttp2_settings *frame,
+                                    nghttp2_mem *mem)
 {
   ssize_t framelen = NGHTTP2_FRAME_HEAD_LENGTH + frame->hd.length;
   int r;
-  r = nghttp2_reserve_buffer(buf_ptr, buflen_ptr, framelen);
+  r = nghttp2_reserve_buffer(buf_ptr, buflen_ptr, framelen, mem);
   if(r != 0) {
     return r;
   }
@@ -492,7 +496,8 @@ size_t nghttp2_frame_pack_settings_payload(uint8_t *buf,
 
 int nghttp2_frame_unpack_settings(nghttp2_settings *frame,
                                   const uint8_t *head, size_t headlen,
-                                  const uint8_t *payload, size_t payloadlen)
+                                  const uint8_t *payload, size_t payloadlen,
+                                  nghttp2_mem *mem)
 {
   int rv;
   if(payloadlen % 8) {
@@ -500,7 +505,7 @@ int nghttp2_frame_unpack_settings(nghttp2_settings *frame,
   }
   nghttp2_frame_unpack_frame_hd(&frame->hd, head);
   rv = nghttp2_frame_unpack_settings_payload(&frame->iv, &frame->niv,
-                                             payload, payloadlen);
+                                             payload, payloadlen, mem);
   if(rv != 0) {
     return rv;
   }
@@ -510,11 +515,12 @@ int nghttp2_frame_unpack_settings(nghttp2_settings *frame,
 int nghttp2_frame_unpack_settings_payload(nghttp2_settings_entry **iv_ptr,
                                           size_t *niv_ptr,
                                           const uint8_t *payload,
-                                          size_t payloadlen)
+                                          size_t payloadlen,
+                                          nghttp2_mem *mem)
 {
   size_t i;
   *niv_ptr = payloadlen / 8;
-  *iv_ptr = malloc((*niv_ptr)*sizeof(nghttp2_settings_entry));
+  *iv_ptr = nghttp2_mem_malloc(mem, (*niv_ptr)*sizeof(nghttp2_settings_entry));
   if(*iv_ptr == NULL) {
     return NGHTTP2_ERR_NOMEM;
   }
@@ -544,7 +550,7 @@ ssize_t nghttp2_frame_pack_push_promise(uint8_t **buf_ptr,
   frame->hd.length = framelen - NGHTTP2_FRAME_HEAD_LENGTH;
   /* If frame->nvlen == 0, *buflen_ptr may be smaller than
      nv_offset */
-  rv = nghttp2_reserve_buffer(buf_ptr, buflen_ptr, nv_offset);
+  rv = nghttp2_reserve_buffer(buf_ptr, buflen_ptr, nv_offset, deflater->mem);
   if(rv < 0) {
     return rv;
   }
@@ -568,7 +574,7 @@ int nghttp2_frame_unpack_push_promise(nghttp2_push_promise *frame,
     return r;
   }
   r = nghttp2_hd_inflate_hd(inflater, &frame->nva,
-                            (uint8_t*)payload + 4, payloadlen - 4);
+                            payload + 4, payloadlen - 4);
   if(r < 0) {
     return r;
   }
@@ -594,11 +600,12 @@ int nghttp2_frame_unpack_push_promise_without_nv(nghttp2_push_promise *frame,
 }
 
 ssize_t nghttp2_frame_pack_ping(uint8_t **buf_ptr, size_t *buflen_ptr,
-                                nghttp2_ping *frame)
+                                nghttp2_ping *frame,
+                                nghttp2_mem *mem)
 {
   ssize_t framelen = NGHTTP2_FRAME_HEAD_LENGTH + 8;
   int r;
-  r = nghttp2_reserve_buffer(buf_ptr, buflen_ptr, framelen);
+  r = nghttp2_reserve_buffer(buf_ptr, buflen_ptr, framelen, mem);
   if(r != 0) {
     return r;
   }
@@ -622,11 +629,12 @@ int nghttp2_frame_unpack_ping(nghttp2_ping *frame,
 
 
 ssize_t nghttp2_frame_pack_goaway(uint8_t **buf_ptr, size_t *buflen_ptr,
-                                  nghttp2_goaway *frame)
+                                  nghttp2_goaway *frame,
+                                  nghttp2_mem *mem)
 {
   ssize_t framelen = NGHTTP2_FRAME_HEAD_LENGTH + frame->hd.length;
   int r;
-  r = nghttp2_reserve_buffer(buf_ptr, buflen_ptr, framelen);
+  r = nghttp2_reserve_buffer(buf_ptr, buflen_ptr, framelen, mem);
   if(r != 0) {
     return r;
   }
@@ -640,7 +648,8 @@ ssize_t nghttp2_frame_pack_goaway(uint8_t **buf_ptr, size_t *buflen_ptr,
 
 int nghttp2_frame_unpack_goaway(nghttp2_goaway *frame,
                                 const uint8_t *head, size_t headlen,
-                                const uint8_t *payload, size_t payloadlen)
+                                const uint8_t *payload, size_t payloadlen,
+                                nghttp2_mem *mem)
 {
   nghttp2_frame_unpack_frame_hd(&frame->hd, head);
   if(payloadlen < 8) {
@@ -652,7 +661,7 @@ int nghttp2_frame_unpack_goaway(nghttp2_goaway *frame,
   if(frame->opaque_data_len == 0) {
     frame->opaque_data = NULL;
   } else {
-    frame->opaque_data = malloc(frame->opaque_data_len);
+    frame->opaque_data = nghttp2_mem_malloc(mem, frame->opaque_data_len);
     if(frame->opaque_data == NULL) {
       return NGHTTP2_ERR_NOMEM;
     }
@@ -662,11 +671,12 @@ int nghttp2_frame_unpack_goaway(nghttp2_goaway *frame,
 }
 
 ssize_t nghttp2_frame_pack_window_update(uint8_t **buf_ptr, size_t *buflen_ptr,
-                                         nghttp2_window_update *frame)
+                                         nghttp2_window_update *frame,
+                                         nghttp2_mem *mem)
 {
   ssize_t framelen = NGHTTP2_FRAME_HEAD_LENGTH + 4;
   int r;
-  r = nghttp2_reserve_buffer(buf_ptr, buflen_ptr, framelen);
+  r = nghttp2_reserve_buffer(buf_ptr, buflen_ptr, framelen, mem);
   if(r != 0) {
     return r;
   }
@@ -691,11 +701,11 @@ int nghttp2_frame_unpack_window_update(nghttp2_window_update *frame,
 }
 
 nghttp2_settings_entry* nghttp2_frame_iv_copy(const nghttp2_settings_entry *iv,
-                                              size_t niv)
+                                              size_t niv, nghttp2_mem *mem)
 {
   nghttp2_settings_entry *iv_copy;
   size_t len = niv*sizeof(nghttp2_settings_entry);
-  iv_copy = malloc(len);
+  iv_copy = nghttp2_mem_malloc(mem, len);
   if(iv_copy == NULL) {
     return NULL;
   }
@@ -754,9 +764,9 @@ int nghttp2_nv_equal(const nghttp2_nv *a, const nghttp2_nv *b)
     memcmp(a->value, b->value, a->valuelen) == 0;
 }
 
-void nghttp2_nv_array_del(nghttp2_nv *nva)
+void nghttp2_nv_array_del(nghttp2_nv *nva, nghttp2_mem *mem)
 {
-  free(nva);
+  nghttp2_mem_free(mem, nva);
 }
 
 static int nghttp2_nv_name_compar(const void *lhs, const void *rhs)
@@ -786,7 +796,8 @@ void nghttp2_nv_array_sort(nghttp2_nv *nva, size_t nvlen)
   qsort(nva, nvlen, sizeof(nghttp2_nv), nghttp2_nv_name_compar);
 }
 
-ssize_t nghttp2_nv_array_from_cstr(nghttp2_nv **nva_ptr, const char **nv)
+ssize_t nghttp2_nv_array_from_cstr(nghttp2_nv **nva_ptr, const char **nv,
+                                   nghttp2_mem *mem)
 {
   int i;
   uint8_t *data;
@@ -806,7 +817,7 @@ ssize_t nghttp2_nv_array_from_cstr(nghttp2_nv **nva_ptr, const char **nv)
     return 0;
   }
   buflen += sizeof(nghttp2_nv)*nvlen;
-  *nva_ptr = malloc(buflen);
+  *nva_ptr = nghttp2_mem_malloc(mem, buflen);
   if(*nva_ptr == NULL) {
     return NGHTTP2_ERR_NOMEM;
   }
@@ -824,6 +835,7 @@ ssize_t nghttp2_nv_array_from_cstr(nghttp2_nv **nva_ptr, const char **nv)
     memcpy(data, nv[i+1], len);
     p->value = data;
     p->valuelen = len;
+    p->flags = NGHTTP2_NV_FLAG_NONE;
     data += len;
     ++p;
   }
@@ -831,6 +843,101 @@ ssize_t nghttp2_nv_array_from_cstr(nghttp2_nv **nva_ptr, const char **nv)
   return nvlen;
 }
 
+/*
+ * Returns nonzero if the name of |nv| must be copied to be
+ * lower-cased.
+ */
+static int nv_name_needs_downcase(const nghttp2_nv *nv)
+{
+  size_t i;
+  if(nv->flags & NGHTTP2_NV_FLAG_LOWERCASE) {
+    return 0;
+  }
+  for(i = 0; i < nv->namelen; ++i) {
+    if('A' <= nv->name[i] && nv->name[i] <= 'Z') {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+ssize_t nghttp2_nv_array_copy(nghttp2_nv **nva_ptr, const nghttp2_nv *nva,
+                              size_t nvlen, nghttp2_mem *mem)
+{
+  size_t i;
+  uint8_t *data;
+  size_t buflen = 0;
+  nghttp2_nv *p;
+  for(i = 0; i < nvlen; ++i) {
+    if(nva[i].valuelen > NGHTTP2_MAX_HD_VALUE_LENGTH) {
+      return NGHTTP2_ERR_INVALID_ARGUMENT;
+    }
+    if(nva[i].flags & NGHTTP2_NV_FLAG_NO_COPY) {
+      if(nv_name_needs_downcase(&nva[i])) {
+        buflen += nva[i].namelen;
+      }
+    } else {
+      buflen += nva[i].namelen + nva[i].valuelen;
+    }
+  }
+  if(nvlen == 0) {
+    *nva_ptr = NULL;
+    return 0;
+  }
+  buflen += sizeof(nghttp2_nv)*nvlen;
+  *nva_ptr = nghttp2_mem_malloc(mem, buflen);
+  if(*nva_ptr == NULL) {
+    return NGHTTP2_ERR_NOMEM;
+  }
+  p = *nva_ptr;
+  data = (uint8_t*)(*nva_ptr) + sizeof(nghttp2_nv)*nvlen;
+
+  for(i = 0; i < nvlen; ++i, ++p) {
+    *p = nva[i];
+    p->flags = NGHTTP2_NV_FLAG_NONE;
+    if(nva[i].flags & NGHTTP2_NV_FLAG_NO_COPY) {
+      if(nv_name_needs_downcase(&nva[i])) {
+        memcpy(data, nva[i].name, nva[i].namelen);
+        p->name = data;
+        nghttp2_downcase(p->name, p->namelen);
+        data += nva[i].namelen;
+      }
+      continue;
+    }
+    memcpy(data, nva[i].name, nva[i].namelen);
+    p->name = data;
+    if(!(nva[i].flags & NGHTTP2_NV_FLAG_LOWERCASE)) {
+      nghttp2_downcase(p->name, p->namelen);
+    }
+    data += nva[i].namelen;
+    if(nva[i].valuelen > 0) {
+      memcpy(data, nva[i].value, nva[i].valuelen);
+      p->value = data;
+      data += nva[i].valuelen;
+    }
+  }
+  nghttp2_nv_array_sort(*nva_ptr, nvlen);
+  return nvlen;
+}
+
+int nghttp2_nv_array_check_null(const nghttp2_nv *nva, size_t nvlen)
+{
+  size_t i, j;
+  for(i = 0; i < nvlen; ++i) {
+    if(nva[i].name == NULL || nva[i].namelen == 0 ||
+       (nva[i].value == NULL && nva[i].valuelen > 0)) {
+      return 0;
+    }
+    for(j = 0; j < nva[i].namelen; ++j) {
+      uint8_t c = nva[i].name[j];
+      if(c < 0x20 || c > 0x7e) {
+        return 0;
+      }
+    }
+  }
+  return 1;
+}
+
 int nghttp2_settings_check_duplicate(const nghttp2_settings_entry *iv,
                                      size_t niv)
 {
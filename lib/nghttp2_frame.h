@@ -50,7 +50,8 @@
 #define NGHTTP2_WINDOW_SIZE_INCREMENT_MASK 0x7fffffff
 #define NGHTTP2_SETTINGS_ID_MASK 0xffffff
 
-/* The maximum length of DATA frame payload. */
+/* The default maximum length of DATA frame payload. This is also the
+   initial DATA payload length of each stream. */
 #define NGHTTP2_DATA_PAYLOAD_LENGTH 4096
 
 /* The number of bytes of frame header. */
@@ -79,6 +80,13 @@ typedef struct {
    * exclusively by nghttp2 library and not in the spec.
    */
   uint8_t eof;
+  /**
+   * The flag to indicate whether the payload of the last packed frame
+   * was not copied (see NGHTTP2_DATA_FLAG_NO_COPY). If it is 1, only
+   * the frame header is packed and the payload is sent by
+   * send_data_callback. This is used exclusively by nghttp2 library.
+   */
+  uint8_t no_copy;
   /**
    * The data to be sent for this DATA frame.
    */
@@ -122,7 +130,10 @@ ssize_t nghttp2_frame_pack_headers(uint8_t **buf_ptr,
  * headlen is 8 bytes. |payload| is the data after frame header and
  * just before name/value header block.
  *
- * The |inflater| inflates name/value header block.
+ * The |inflater| inflates name/value header block. The |frame->nva|
+ * is owned by |inflater| and is valid until nghttp2_hd_end_headers()
+ * is called for |inflater|. It must not be freed; in other words,
+ * nghttp2_frame_headers_free() must not be called for |frame|.
  *
  * This function also validates the name/value pairs. If unpacking
  * succeeds but validation fails, it is indicated by returning
@@ -174,7 +185,8 @@ int nghttp2_frame_unpack_headers_without_nv(nghttp2_headers *frame,
  *     Out of memory.
  */
 ssize_t nghttp2_frame_pack_priority(uint8_t **buf_ptr, size_t *buflen_ptr,
-                                    nghttp2_priority *frame);
+                                    nghttp2_priority *frame,
+                                    nghttp2_mem *mem);
 
 /*
  * Unpacks PRIORITY wire format into |frame|.
@@ -203,7 +215,8 @@ int nghttp2_frame_unpack_priority(nghttp2_priority *frame,
  *     Out of memory.
  */
 ssize_t nghttp2_frame_pack_rst_stream(uint8_t **buf_ptr, size_t *buflen_ptr,
-                                      nghttp2_rst_stream *frame);
+                                      nghttp2_rst_stream *frame,
+                                      nghttp2_mem *mem);
 
 /*
  * Unpacks RST_STREAM frame byte sequence into |frame|.
@@ -231,7 +244,8 @@ int nghttp2_frame_unpack_rst_stream(nghttp2_rst_stream *frame,
  *     Out of memory.
  */
 ssize_t nghttp2_frame_pack_settings(uint8_t **buf_ptr, size_t *buflen_ptr,
-                                    nghttp2_settings *frame);
+                                    nghttp2_settings *frame,
+                                    nghttp2_mem *mem);
 
 /*
  * Packs the |iv|, which includes |niv| entries, in the |buf|,
@@ -256,14 +270,15 @@ size_t nghttp2_frame_pack_settings_payload(uint8_t *buf,
  */
 int nghttp2_frame_unpack_settings(nghttp2_settings *frame,
                                   const uint8_t *head, size_t headlen,
-                                  const uint8_t *payload, size_t payloadlen);
+                                  const uint8_t *payload, size_t payloadlen,
+                                  nghttp2_mem *mem);
 
 
 /*
  * Unpacks SETTINGS payload into |*iv_ptr|. The number of entries are
  * assigned to the |*niv_ptr|. This function allocates enough memory
- * to store the result in |*iv_ptr|. The caller is responsible to free
- * |*iv_ptr| after its use.
+ * to store the result in |*iv_ptr| using |mem|. The caller is
+ * responsible to free |*iv_ptr| after its use.
  *
  * This function returns 0 if it succeeds or one of the following
  * negative error codes:
@@ -274,7 +289,8 @@ int nghttp2_frame_unpack_settings(nghttp2_settings *frame,
 int nghttp2_frame_unpack_settings_payload(nghttp2_settings_entry **iv_ptr,
                                           size_t *niv_ptr,
                                           const uint8_t *payload,
-                                          size_t payloadlen);
+                                          size_t payloadlen,
+                                          nghttp2_mem *mem);
 
 /*
  * Packs PUSH_PROMISE frame |frame| in wire format and store it in
@@ -307,7 +323,10 @@ ssize_t nghttp2_frame_pack_push_promise(uint8_t **buf_ptr,
  * headlen is 8 bytes. |payload| is the data after frame header and
  * just before name/value header block.
  *
- * The |inflater| inflates name/value header block.
+ * The |inflater| inflates name/value header block. The |frame->nva|
+ * is owned by |inflater| and is valid until nghttp2_hd_end_headers()
+ * is called for |inflater|. It must not be freed; in other words,
+ * nghttp2_frame_push_promise_free() must not be called for |frame|.
  *
  * This function also validates the name/value pairs. If unpacking
  * succeeds but validation fails, it is indicated by returning
@@ -360,7 +379,8 @@ int nghttp2_frame_unpack_push_promise_without_nv(nghttp2_push_promise *frame,
  *     Out of memory.
  */
 ssize_t nghttp2_frame_pack_ping(uint8_t **buf_ptr, size_t *buflen_ptr,
-                                nghttp2_ping *frame);
+                                nghttp2_ping *frame,
+                                nghttp2_mem *mem);
 
 /*
  * Unpacks PING wire format into |frame|.
@@ -388,7 +408,8 @@ int nghttp2_frame_unpack_ping(nghttp2_ping *frame,
  *     Out of memory.
  */
 ssize_t nghttp2_frame_pack_goaway(uint8_t **buf_ptr, size_t *buflen_ptr,
-                                  nghttp2_goaway *frame);
+                                  nghttp2_goaway *frame,
+                                  nghttp2_mem *mem);
 
 /*
  * Unpacks GOAWAY wire format into |frame|.
@@ -403,7 +424,8 @@ ssize_t nghttp2_frame_pack_goaway(uint8_t **buf_ptr, size_t *buflen_ptr,
  */
 int nghttp2_frame_unpack_goaway(nghttp2_goaway *frame,
                                 const uint8_t *head, size_t headlen,
-                                const uint8_t *payload, size_t payloadlen);
+                                const uint8_t *payload, size_t payloadlen,
+                                nghttp2_mem *mem);
 
 /*
  * Packs WINDOW_UPDATE frame |frame| in wire frame format and store it
@@ -419,7 +441,8 @@ int nghttp2_frame_unpack_goaway(nghttp2_goaway *frame,
  *     Out of memory.
  */
 ssize_t nghttp2_frame_pack_window_update(uint8_t **buf_ptr, size_t *buflen_ptr,
-                                         nghttp2_window_update *frame);
+                                         nghttp2_window_update *frame,
+                                         nghttp2_mem *mem);
 
 /*
  * Unpacks WINDOW_UPDATE frame byte sequence into |frame|.
@@ -462,7 +485,7 @@ void nghttp2_frame_headers_init(nghttp2_headers *frame,
                                 uint8_t flags, int32_t stream_id, int32_t pri,
                                 nghttp2_nv *nva, size_t nvlen);
 
-void nghttp2_frame_headers_free(nghttp2_headers *frame);
+void nghttp2_frame_headers_free(nghttp2_headers *frame, nghttp2_mem *mem);
 
 
 void nghttp2_frame_priority_init(nghttp2_priority *frame, int32_t stream_id,
@@ -485,7 +508,8 @@ void nghttp2_frame_push_promise_init(nghttp2_push_promise *frame,
                                      int32_t promised_stream_id,
                                      nghttp2_nv *nva, size_t nvlen);
 
-void nghttp2_frame_push_promise_free(nghttp2_push_promise *frame);
+void nghttp2_frame_push_promise_free(nghttp2_push_promise *frame,
+                                     nghttp2_mem *mem);
 
 /*
  * Initializes SETTINGS frame |frame| with given values. |frame| takes
@@ -495,7 +519,7 @@ void nghttp2_frame_push_promise_free(nghttp2_push_promise *frame);
 void nghttp2_frame_settings_init(nghttp2_settings *frame,
                                  nghttp2_settings_entry *iv, size_t niv);
 
-void nghttp2_frame_settings_free(nghttp2_settings *frame);
+void nghttp2_frame_settings_free(nghttp2_settings *frame, nghttp2_mem *mem);
 
 /*
  * Initializes PING frame |frame| with given values. If the
@@ -517,7 +541,7 @@ void nghttp2_frame_goaway_init(nghttp2_goaway *frame, int32_t last_stream_id,
                                nghttp2_error_code error_code,
                                uint8_t *opaque_data, size_t opaque_data_len);
 
-void nghttp2_frame_goaway_free(nghttp2_goaway *frame);
+void nghttp2_frame_goaway_free(nghttp2_goaway *frame, nghttp2_mem *mem);
 
 void nghttp2_frame_window_update_init(nghttp2_window_update *frame,
                                       uint8_t flags,
@@ -567,11 +591,11 @@ char** nghttp2_frame_nv_norm_copy(const char **nv);
 
 /*
  * Makes copy of |iv| and return the copy. The |niv| is the number of
- * entries in |iv|. This function returns the pointer to the copy if
- * it succeeds, or NULL.
+ * entries in |iv|. The copy is allocated using |mem|. This function
+ * returns the pointer to the copy if it succeeds, or NULL.
  */
 nghttp2_settings_entry* nghttp2_frame_iv_copy(const nghttp2_settings_entry *iv,
-                                              size_t niv);
+                                              size_t niv, nghttp2_mem *mem);
 
 /*
  * Sorts the |iv| with the ascending order of the settings_id member.
@@ -603,7 +627,7 @@ void nghttp2_nv_array_sort(nghttp2_nv *nva, size_t nvlen);
 
 /*
  * Copies name/value pairs from |nv| to |*nva_ptr|, which is
- * dynamically allocated so that all items can be stored.
+ * dynamically allocated using |mem| so that all items can be stored.
  *
  * This function returns the number of name/value pairs in |*nva_ptr|,
  * or one of the following negative error codes:
@@ -614,7 +638,27 @@ void nghttp2_nv_array_sort(nghttp2_nv *nva, size_t nvlen);
  *     The length of name or value in |nv| is strictly larger than (1
  *     << 16) - 1.
  */
-ssize_t nghttp2_nv_array_from_cstr(nghttp2_nv **nva_ptr, const char **nv);
+ssize_t nghttp2_nv_array_from_cstr(nghttp2_nv **nva_ptr, const char **nv,
+                                   nghttp2_mem *mem);
+
+/*
+ * Copies name/value pairs from |nva|, which has |nvlen| entries, to
+ * |*nva_ptr|, which is dynamically allocated using |mem|. The names
+ * and values of the entries with NGHTTP2_NV_FLAG_NO_COPY are not
+ * copied and |*nva_ptr| refers to them. The names are lower-cased
+ * unless NGHTTP2_NV_FLAG_LOWERCASE is set.
+ *
+ * This function returns the number of name/value pairs in |*nva_ptr|,
+ * or one of the following negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory.
+ * NGHTTP2_ERR_INVALID_ARGUMENT
+ *     The length of value in |nva| is strictly larger than
+ *     NGHTTP2_MAX_HD_VALUE_LENGTH.
+ */
+ssize_t nghttp2_nv_array_copy(nghttp2_nv **nva_ptr, const nghttp2_nv *nva,
+                              size_t nvlen, nghttp2_mem *mem);
 
 /*
  * Returns nonzero if the name/value pair |a| equals to |b|. The name
@@ -624,17 +668,17 @@ ssize_t nghttp2_nv_array_from_cstr(nghttp2_nv **nva_ptr, const char **nv);
 int nghttp2_nv_equal(const nghttp2_nv *a, const nghttp2_nv *b);
 
 /*
- * Frees |nva|.
+ * Frees |nva|, which was allocated using |mem|.
  */
-void nghttp2_nv_array_del(nghttp2_nv *nva);
+void nghttp2_nv_array_del(nghttp2_nv *nva, nghttp2_mem *mem);
 
 /*
  * Checks names are not empty string and do not contain control
- * characters and values are not NULL.
+ * characters and values are not NULL unless their length is 0.
  *
  * This function returns nonzero if it succeeds, or 0.
  */
-int nghttp2_nv_array_check_null(nghttp2_nv *nva, size_t nvlen);
+int nghttp2_nv_array_check_null(const nghttp2_nv *nva, size_t nvlen);
 
 
 /*
@@ -30,91 +30,133 @@
 
 #include "nghttp2_frame.h"
 #include "nghttp2_helper.h"
+#include "nghttp2_hd_huffman.h"
 
-static const char *reqhd_table[] = {
-  ":scheme", "http",
-  ":scheme", "https",
-  ":host", "",
-  ":path", "/",
-  ":method", "GET",
-  "accept", "",
-  "accept-charset", "",
-  "accept-encoding", "",
-  "accept-language", "",
-  "cookie", "",
-  "if-modified-since", "",
-  "keep-alive", "",
-  "user-agent", "",
-  "proxy-connection", "",
-  "referer", "",
-  "accept-datetime", "",
-  "authorization", "",
-  "allow", "",
-  "cache-control", "",
-  "connection", "",
-  "content-length", "",
-  "content-md5", "",
-  "content-type", "",
-  "date", "",
-  "expect", "",
-  "from", "",
-  "if-match", "",
-  "if-none-match", "",
-  "if-range", "",
-  "if-unmodified-since", "",
-  "max-forwards", "",
-  "pragma", "",
-  "proxy-authorization", "",
-  "range", "",
-  "te", "",
-  "upgrade", "",
-  "via", "",
-  "warning", "",
-  NULL
+/*
+ * The initial header tables. They are shared by all contexts and
+ * copied into nghttp2_hd_context.ini_table on initialization, so
+ * that no allocation is needed for them. The name and name/value
+ * hashes are precomputed with hash_name() and hash_nv() below.
+ */
+#define MAKE_ENT(N, V, NH, VH)                                          \
+  { { (uint8_t*)N, (uint8_t*)V, sizeof(N) - 1, sizeof(V) - 1,          \
+        NGHTTP2_NV_FLAG_NONE },                                         \
+      NULL, NULL, NH, VH, 1, NGHTTP2_HD_INVALID_INDEX,                  \
+      NGHTTP2_HD_FLAG_STATIC }
+
+static const nghttp2_hd_entry reqhd_entries[] = {
+  MAKE_ENT(":scheme", "http", 2510477674u, 2533382262u),
+  MAKE_ENT(":scheme", "https", 2510477674u, 3129642975u),
+  MAKE_ENT(":host", "", 477098839u, 456921589u),
+  MAKE_ENT(":path", "/", 3292848686u, 3345381023u),
+  MAKE_ENT(":method", "GET", 695666056u, 1731284580u),
+  MAKE_ENT("accept", "", 136609321u, 4201814667u),
+  MAKE_ENT("accept-charset", "", 3664010344u, 872249272u),
+  MAKE_ENT("accept-encoding", "", 3379649177u, 3060899547u),
+  MAKE_ENT("accept-language", "", 1979086614u, 3372054434u),
+  MAKE_ENT("cookie", "", 2007449791u, 457895085u),
+  MAKE_ENT("if-modified-since", "", 2213050793u, 1341621515u),
+  MAKE_ENT("keep-alive", "", 3784235904u, 2481162880u),
+  MAKE_ENT("user-agent", "", 606444526u, 3576985514u),
+  MAKE_ENT("proxy-connection", "", 851484070u, 2335714386u),
+  MAKE_ENT("referer", "", 3969579366u, 3723926418u),
+  MAKE_ENT("accept-datetime", "", 4009626241u, 3135932691u),
+  MAKE_ENT("authorization", "", 2436257726u, 1452023834u),
+  MAKE_ENT("allow", "", 2930878514u, 866895542u),
+  MAKE_ENT("cache-control", "", 1355326669u, 4175130295u),
+  MAKE_ENT("connection", "", 951688921u, 624234395u),
+  MAKE_ENT("content-length", "", 1308181789u, 3697790119u),
+  MAKE_ENT("content-md5", "", 3140605035u, 443638897u),
+  MAKE_ENT("content-type", "", 4244048277u, 3454277007u),
+  MAKE_ENT("date", "", 3564297305u, 3385909275u),
+  MAKE_ENT("expect", "", 2530896728u, 3520527240u),
+  MAKE_ENT("from", "", 2513272949u, 1199650863u),
+  MAKE_ENT("if-match", "", 3597694698u, 2097885790u),
+  MAKE_ENT("if-none-match", "", 2536202615u, 1883926101u),
+  MAKE_ENT("if-range", "", 2340978238u, 3856579482u),
+  MAKE_ENT("if-unmodified-since", "", 3794814858u, 2617286206u),
+  MAKE_ENT("max-forwards", "", 1826162134u, 799289314u),
+  MAKE_ENT("pragma", "", 435832357u, 167537727u),
+  MAKE_ENT("proxy-authorization", "", 2686392507u, 3421761121u),
+  MAKE_ENT("range", "", 4208725202u, 3127389846u),
+  MAKE_ENT("te", "", 1011170994u, 2466361910u),
+  MAKE_ENT("upgrade", "", 3700935799u, 3119963989u),
+  MAKE_ENT("via", "", 1762798611u, 2057003497u),
+  MAKE_ENT("warning", "", 2032210671u, 2651901501u),
 };
 
-static const char *reshd_table[] = {
-  ":status", "200",
-  "age", "",
-  "cache-control", "",
-  "content-length", "",
-  "content-type", "",
-  "date", "",
-  "etag", "",
-  "expires", "",
-  "last-modified", "",
-  "server", "",
-  "set-cookie", "",
-  "vary", "",
-  "via", "",
-  "access-control-allow-origin", "",
-  "accept-ranges", "",
-  "allow", "",
-  "connection", "",
-  "content-disposition", "",
-  "content-encoding", "",
-  "content-language", "",
-  "content-location", "",
-  "content-md5", "",
-  "content-range", "",
-  "link", "",
-  "location", "",
-  "p3p", "",
-  "pragma", "",
-  "proxy-authenticate", "",
-  "refresh", "",
-  "retry-after", "",
-  "strict-transport-security", "",
-  "trailer", "",
-  "transfer-encoding", "",
-  "warning", "",
-  "www-authenticate", "",
-  NULL
+static const nghttp2_hd_entry reshd_entries[] = {
+  MAKE_ENT(":status", "200", 4000288983u, 570698317u),
+  MAKE_ENT("age", "", 742476188u, 1187438740u),
+  MAKE_ENT("cache-control", "", 1355326669u, 4175130295u),
+  MAKE_ENT("content-length", "", 1308181789u, 3697790119u),
+  MAKE_ENT("content-type", "", 4244048277u, 3454277007u),
+  MAKE_ENT("date", "", 3564297305u, 3385909275u),
+  MAKE_ENT("etag", "", 113792960u, 1835148096u),
+  MAKE_ENT("expires", "", 1049544579u, 4257485625u),
+  MAKE_ENT("last-modified", "", 3226950251u, 881022577u),
+  MAKE_ENT("server", "", 1085029842u, 2703577494u),
+  MAKE_ENT("set-cookie", "", 1848371000u, 2803694888u),
+  MAKE_ENT("vary", "", 1085005381u, 328132255u),
+  MAKE_ENT("via", "", 1762798611u, 2057003497u),
+  MAKE_ENT("access-control-allow-origin", "", 2710797292u, 1194071172u),
+  MAKE_ENT("accept-ranges", "", 1713753958u, 864386450u),
+  MAKE_ENT("allow", "", 2930878514u, 866895542u),
+  MAKE_ENT("connection", "", 951688921u, 624234395u),
+  MAKE_ENT("content-disposition", "", 3889184348u, 1221733076u),
+  MAKE_ENT("content-encoding", "", 65203592u, 2788945176u),
+  MAKE_ENT("content-language", "", 24973587u, 1793188073u),
+  MAKE_ENT("content-location", "", 2302364718u, 911797354u),
+  MAKE_ENT("content-md5", "", 3140605035u, 443638897u),
+  MAKE_ENT("content-range", "", 3555523146u, 3893232254u),
+  MAKE_ENT("link", "", 232457833u, 952833867u),
+  MAKE_ENT("location", "", 200649126u, 2042237010u),
+  MAKE_ENT("p3p", "", 1511416236u, 2101068228u),
+  MAKE_ENT("pragma", "", 435832357u, 167537727u),
+  MAKE_ENT("proxy-authenticate", "", 2709445359u, 699573821u),
+  MAKE_ENT("refresh", "", 3572655668u, 1838605276u),
+  MAKE_ENT("retry-after", "", 3336180598u, 2135728834u),
+  MAKE_ENT("strict-transport-security", "", 4138147361u, 1779723763u),
+  MAKE_ENT("trailer", "", 2171596256u, 2738059168u),
+  MAKE_ENT("transfer-encoding", "", 3719590988u, 1326650276u),
+  MAKE_ENT("warning", "", 2032210671u, 2651901501u),
+  MAKE_ENT("www-authenticate", "", 779865858u, 786882598u),
 };
 
-int nghttp2_hd_entry_init(nghttp2_hd_entry *ent, uint8_t index, uint8_t flags,
+/*
+ * Computes FNV-1a hash of the |len| bytes from |s|, continuing from
+ * the hash value |h|.
+ */
+static uint32_t hash_update(uint32_t h, const uint8_t *s, size_t len)
+{
+  size_t i;
+  for(i = 0; i < len; ++i) {
+    h ^= s[i];
+    h *= 16777619u;
+  }
+  return h;
+}
+
+static uint32_t hash_name(const uint8_t *name, size_t namelen)
+{
+  return hash_update(2166136261u, name, namelen);
+}
+
+/*
+ * Computes hash of the name/value pair from the hash of the name
+ * |name_hash|.
+ */
+static uint32_t hash_nv(uint32_t name_hash,
+                        const uint8_t *value, size_t valuelen)
+{
+  /* Mix in the separator so that name/value boundary matters */
+  return hash_update(name_hash * 16777619u, value, valuelen);
+}
+
+int nghttp2_hd_entry_init(nghttp2_hd_entry *ent, uint8_t slot, uint8_t flags,
                           uint8_t *name, uint16_t namelen,
-                          uint8_t *value, uint16_t valuelen)
+                          uint8_t *value, uint16_t valuelen,
+                          nghttp2_mem *mem)
 {
   int rv = 0;
   if(flags & NGHTTP2_HD_FLAG_NAME_ALLOC) {
@@ -122,7 +164,7 @@ int nghttp2_hd_entry_init(nghttp2_hd_entry *ent, uint8_t index, uint8_t flags,
       /* We should not allow empty header field name */
       ent->nv.name = NULL;
     } else {
-      ent->nv.name = nghttp2_memdup(name, namelen);
+      ent->nv.name = nghttp2_memdup(name, namelen, mem);
       if(ent->nv.name == NULL) {
         rv = NGHTTP2_ERR_NOMEM;
         goto fail;
@@ -135,7 +177,7 @@ int nghttp2_hd_entry_init(nghttp2_hd_entry *ent, uint8_t index, uint8_t flags,
     if(valuelen == 0) {
       ent->nv.value = NULL;
     } else {
-      ent->nv.value = nghttp2_memdup(value, valuelen);
+      ent->nv.value = nghttp2_memdup(value, valuelen, mem);
       if(ent->nv.value == NULL) {
         rv = NGHTTP2_ERR_NOMEM;
         goto fail2;
@@ -146,81 +188,173 @@ int nghttp2_hd_entry_init(nghttp2_hd_entry *ent, uint8_t index, uint8_t flags,
   }
   ent->nv.namelen = namelen;
   ent->nv.valuelen = valuelen;
+  ent->nv.flags = NGHTTP2_NV_FLAG_NONE;
+  ent->nv_next = NULL;
+  ent->name_next = NULL;
+  ent->name_hash = hash_name(name, namelen);
+  ent->nv_hash = hash_nv(ent->name_hash, value, valuelen);
   ent->ref = 1;
-  ent->index = index;
+  ent->slot = slot;
   ent->flags = flags;
   return 0;
 
  fail2:
   if(flags & NGHTTP2_HD_FLAG_NAME_ALLOC) {
-    free(ent->nv.name);
+    nghttp2_mem_free(mem, ent->nv.name);
   }
  fail:
   return rv;
 }
 
-void nghttp2_hd_entry_free(nghttp2_hd_entry *ent)
+void nghttp2_hd_entry_free(nghttp2_hd_entry *ent, nghttp2_mem *mem)
 {
   assert(ent->ref == 0);
   if(ent->flags & NGHTTP2_HD_FLAG_NAME_ALLOC) {
-    free(ent->nv.name);
+    nghttp2_mem_free(mem, ent->nv.name);
   }
   if(ent->flags & NGHTTP2_HD_FLAG_VALUE_ALLOC) {
-    free(ent->nv.value);
+    nghttp2_mem_free(mem, ent->nv.value);
+  }
+}
+
+nghttp2_hd_entry* nghttp2_hd_table_get(nghttp2_hd_context *context,
+                                       size_t index)
+{
+  assert(index < context->hd_tablelen);
+  return context->hd_table[(context->hd_table_first + index) &
+                           (context->hd_table_capacity - 1)];
+}
+
+/*
+ * Decrements the reference count of |ent| and frees it if the count
+ * drops to 0. The initial entries are stored in
+ * context->ini_table and are never freed individually.
+ */
+static void hd_entry_unref(nghttp2_hd_context *context,
+                           nghttp2_hd_entry *ent)
+{
+  if(--ent->ref == 0) {
+    nghttp2_hd_entry_free(ent, context->mem);
+    if((ent->flags & NGHTTP2_HD_FLAG_STATIC) == 0) {
+      nghttp2_mem_free(context->mem, ent);
+    }
+  }
+}
+
+/*
+ * Returns the current index of |ent| in the header table of
+ * |context|, or NGHTTP2_HD_INVALID_INDEX if |ent| is not in the
+ * header table.
+ */
+static uint8_t entry_index(nghttp2_hd_context *context,
+                           nghttp2_hd_entry *ent)
+{
+  if(ent->slot == NGHTTP2_HD_INVALID_INDEX) {
+    return NGHTTP2_HD_INVALID_INDEX;
   }
+  return (ent->slot - context->hd_table_first) &
+    (context->hd_table_capacity - 1);
+}
+
+/*
+ * Adds |ent| to the hash index of |context|.
+ */
+static void hd_index_add(nghttp2_hd_context *context, nghttp2_hd_entry *ent)
+{
+  size_t idx;
+  idx = ent->nv_hash & (NGHTTP2_HD_INDEX_BUCKET_SIZE - 1);
+  ent->nv_next = context->nv_index[idx];
+  context->nv_index[idx] = ent;
+  idx = ent->name_hash & (NGHTTP2_HD_INDEX_BUCKET_SIZE - 1);
+  ent->name_next = context->name_index[idx];
+  context->name_index[idx] = ent;
+}
+
+/*
+ * Removes |ent| from the hash index of |context|. The |ent| must be
+ * in the index.
+ */
+static void hd_index_remove(nghttp2_hd_context *context,
+                            nghttp2_hd_entry *ent)
+{
+  nghttp2_hd_entry **p;
+  for(p = &context->nv_index[ent->nv_hash &
+                             (NGHTTP2_HD_INDEX_BUCKET_SIZE - 1)];
+      *p != ent; p = &(*p)->nv_next);
+  *p = ent->nv_next;
+  ent->nv_next = NULL;
+  for(p = &context->name_index[ent->name_hash &
+                               (NGHTTP2_HD_INDEX_BUCKET_SIZE - 1)];
+      *p != ent; p = &(*p)->name_next);
+  *p = ent->name_next;
+  ent->name_next = NULL;
 }
 
 static int nghttp2_hd_context_init(nghttp2_hd_context *context,
-                                   nghttp2_hd_side side)
+                                   nghttp2_hd_side side,
+                                   nghttp2_mem *mem)
 {
-  int i;
-  const char **ini_table;
+  size_t i, ini_tablelen;
+  const nghttp2_hd_entry *ini_table;
+  context->mem = mem;
+  context->select_indexing = NULL;
+  context->select_indexing_arg = NULL;
   context->bad = 0;
-  context->hd_table = malloc(sizeof(nghttp2_hd_entry*)*
+  context->nv_bytes = 0;
+  context->block_bytes = 0;
+  context->hd_table = nghttp2_mem_malloc(mem, sizeof(nghttp2_hd_entry*)*
                              NGHTTP2_INITIAL_HD_TABLE_SIZE);
   memset(context->hd_table, 0, sizeof(nghttp2_hd_entry*)*
          NGHTTP2_INITIAL_HD_TABLE_SIZE);
   context->hd_table_capacity = NGHTTP2_INITIAL_HD_TABLE_SIZE;
   context->hd_tablelen = 0;
+  context->hd_table_first = 0;
+  context->deflate_table_size = NGHTTP2_HD_MAX_BUFFER_SIZE;
+  context->huffman = 0;
 
-  context->refset = malloc(sizeof(nghttp2_hd_entry*)*
-                           NGHTTP2_INITIAL_REFSET_SIZE);
+  context->refset = nghttp2_mem_malloc(mem, sizeof(nghttp2_hd_entry*)*
+                                       NGHTTP2_INITIAL_REFSET_SIZE);
   context->refset_capacity = NGHTTP2_INITIAL_REFSET_SIZE;
   context->refsetlen = 0;
 
-  context->ws = malloc(sizeof(nghttp2_hd_ws_entry)*NGHTTP2_INITIAL_WS_SIZE);
+  context->ws = nghttp2_mem_malloc(mem, sizeof(nghttp2_hd_ws_entry)*
+                                   NGHTTP2_INITIAL_WS_SIZE);
   context->ws_capacity = NGHTTP2_INITIAL_WS_SIZE;
   context->wslen = 0;
 
+  context->nvabuf = NULL;
+  context->strbuf = NULL;
+  context->strbuflen = 0;
+  context->stroffset = 0;
+  context->blocklen = 0;
+  context->copy_strings = 0;
+  context->inflating = 0;
+
+  memset(context->nv_index, 0, sizeof(context->nv_index));
+  memset(context->name_index, 0, sizeof(context->name_index));
+
   if(side == NGHTTP2_HD_SIDE_CLIENT) {
-    ini_table = reqhd_table;
+    ini_table = reqhd_entries;
+    ini_tablelen = sizeof(reqhd_entries)/sizeof(reqhd_entries[0]);
   } else {
-    ini_table = reshd_table;
+    ini_table = reshd_entries;
+    ini_tablelen = sizeof(reshd_entries)/sizeof(reshd_entries[0]);
   }
+  assert(ini_tablelen <= NGHTTP2_HD_INI_TABLE_MAX);
+  memcpy(context->ini_table, ini_table,
+         sizeof(nghttp2_hd_entry) * ini_tablelen);
   context->hd_table_bufsize = 0;
-  for(i = 0; ini_table[i]; i += 2) {
-    nghttp2_hd_entry *p = malloc(sizeof(nghttp2_hd_entry));
-    nghttp2_hd_entry_init(p, i / 2, NGHTTP2_HD_FLAG_NONE,
-                          (uint8_t*)ini_table[i], strlen(ini_table[i]),
-                          (uint8_t*)ini_table[i + 1],
-                          strlen(ini_table[i+1]));
+  for(i = 0; i < ini_tablelen; ++i) {
+    nghttp2_hd_entry *p = &context->ini_table[i];
+    p->slot = i;
     context->hd_table[context->hd_tablelen++] = p;
+    hd_index_add(context, p);
     context->hd_table_bufsize += NGHTTP2_HD_ENTRY_OVERHEAD +
       p->nv.namelen + p->nv.valuelen;
   }
   return 0;
 }
 
-int nghttp2_hd_deflate_init(nghttp2_hd_context *deflater, nghttp2_hd_side side)
-{
-  return nghttp2_hd_context_init(deflater, side);
-}
-
-int nghttp2_hd_inflate_init(nghttp2_hd_context *inflater, nghttp2_hd_side side)
-{
-  return nghttp2_hd_context_init(inflater, side^1);
-}
-
 static void nghttp2_hd_context_free(nghttp2_hd_context *context)
 {
   size_t i;
@@ -228,16 +362,10 @@ static void nghttp2_hd_context_free(nghttp2_hd_context *context)
     nghttp2_hd_ws_entry *ent = &context->ws[i];
     switch(ent->cat) {
     case NGHTTP2_HD_CAT_INDEXED:
-      if(--ent->indexed.entry->ref == 0) {
-        nghttp2_hd_entry_free(ent->indexed.entry);
-        free(ent->indexed.entry);
-      }
+      hd_entry_unref(context, ent->indexed.entry);
       break;
     case NGHTTP2_HD_CAT_INDNAME:
-      if(--ent->indname.entry->ref == 0) {
-        nghttp2_hd_entry_free(ent->indname.entry);
-        free(ent->indname.entry);
-      }
+      hd_entry_unref(context, ent->indname.entry);
       break;
     default:
       break;
@@ -245,20 +373,39 @@ static void nghttp2_hd_context_free(nghttp2_hd_context *context)
   }
   for(i = 0; i < context->refsetlen; ++i) {
     nghttp2_hd_entry *ent = context->refset[i];
-    if(--ent->ref == 0) {
-      nghttp2_hd_entry_free(ent);
-      free(ent);
-    }
+    hd_entry_unref(context, ent);
   }
   for(i = 0; i < context->hd_tablelen; ++i) {
-    nghttp2_hd_entry *ent = context->hd_table[i];
-    --ent->ref;
-    nghttp2_hd_entry_free(ent);
-    free(ent);
+    hd_entry_unref(context, nghttp2_hd_table_get(context, i));
   }
-  free(context->ws);
-  free(context->refset);
-  free(context->hd_table);
+  nghttp2_mem_free(context->mem, context->strbuf);
+  nghttp2_mem_free(context->mem, context->nvabuf);
+  nghttp2_mem_free(context->mem, context->ws);
+  nghttp2_mem_free(context->mem, context->refset);
+  nghttp2_mem_free(context->mem, context->hd_table);
+}
+
+int nghttp2_hd_deflate_init(nghttp2_hd_context *deflater, nghttp2_hd_side side,
+                            nghttp2_mem *mem)
+{
+  return nghttp2_hd_context_init(deflater, side, mem);
+}
+
+int nghttp2_hd_inflate_init(nghttp2_hd_context *inflater, nghttp2_hd_side side,
+                            nghttp2_mem *mem)
+{
+  int rv;
+  rv = nghttp2_hd_context_init(inflater, side^1, mem);
+  if(rv != 0) {
+    return rv;
+  }
+  inflater->nvabuf = nghttp2_mem_malloc(mem, sizeof(nghttp2_nv)*
+                                        inflater->ws_capacity);
+  if(inflater->nvabuf == NULL) {
+    nghttp2_hd_context_free(inflater);
+    return NGHTTP2_ERR_NOMEM;
+  }
+  return 0;
 }
 
 void nghttp2_hd_deflate_free(nghttp2_hd_context *deflater)
@@ -271,16 +418,260 @@ void nghttp2_hd_inflate_free(nghttp2_hd_context *inflater)
   nghttp2_hd_context_free(inflater);
 }
 
+size_t nghttp2_hd_get_mem_usage(nghttp2_hd_context *context)
+{
+  size_t i, n;
+  n = sizeof(nghttp2_hd_entry*) * context->hd_table_capacity;
+  if(context->ws) {
+    n += sizeof(nghttp2_hd_entry*) * context->refset_capacity +
+      sizeof(nghttp2_hd_ws_entry) * context->ws_capacity;
+  } else {
+    n += sizeof(nghttp2_hd_entry*) * context->refsetlen;
+  }
+  if(context->nvabuf) {
+    n += sizeof(nghttp2_nv) * context->ws_capacity;
+  }
+  n += context->strbuflen;
+  for(i = 0; i < context->hd_tablelen; ++i) {
+    nghttp2_hd_entry *ent = nghttp2_hd_table_get(context, i);
+    if((ent->flags & NGHTTP2_HD_FLAG_STATIC) == 0) {
+      n += sizeof(nghttp2_hd_entry);
+    }
+    if(ent->flags & NGHTTP2_HD_FLAG_NAME_ALLOC) {
+      n += ent->nv.namelen;
+    }
+    if(ent->flags & NGHTTP2_HD_FLAG_VALUE_ALLOC) {
+      n += ent->nv.valuelen;
+    }
+  }
+  return n;
+}
+
+void nghttp2_hd_shrink(nghttp2_hd_context *context)
+{
+  nghttp2_hd_entry **refset;
+  if(context->ws == NULL || context->wslen > 0 || context->inflating) {
+    return;
+  }
+  nghttp2_mem_free(context->mem, context->ws);
+  context->ws = NULL;
+  nghttp2_mem_free(context->mem, context->nvabuf);
+  context->nvabuf = NULL;
+  nghttp2_mem_free(context->mem, context->strbuf);
+  context->strbuf = NULL;
+  context->strbuflen = 0;
+  if(context->refsetlen == 0) {
+    nghttp2_mem_free(context->mem, context->refset);
+    context->refset = NULL;
+  } else {
+    refset = nghttp2_mem_realloc(context->mem, context->refset,
+                                 sizeof(nghttp2_hd_entry*)*
+                                 context->refsetlen);
+    /* Keep the original one if realloc failed */
+    if(refset) {
+      context->refset = refset;
+    }
+  }
+}
+
+/*
+ * Reallocates the working set and the reference set of |context| if
+ * they were released by nghttp2_hd_shrink(). If |inflate| is nonzero,
+ * the inflated name/value buffer is reallocated as well.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory.
+ */
+static int hd_context_ensure_ws(nghttp2_hd_context *context, int inflate)
+{
+  if(context->ws == NULL) {
+    nghttp2_hd_entry **refset;
+    refset = nghttp2_mem_realloc(context->mem, context->refset,
+                                 sizeof(nghttp2_hd_entry*)*
+                                 context->refset_capacity);
+    if(refset == NULL) {
+      return NGHTTP2_ERR_NOMEM;
+    }
+    context->refset = refset;
+    context->ws = nghttp2_mem_malloc(context->mem, sizeof(nghttp2_hd_ws_entry)*
+                                     context->ws_capacity);
+    if(context->ws == NULL) {
+      return NGHTTP2_ERR_NOMEM;
+    }
+  }
+  if(inflate && context->nvabuf == NULL) {
+    context->nvabuf = nghttp2_mem_malloc(context->mem, sizeof(nghttp2_nv)*
+                                         context->ws_capacity);
+    if(context->nvabuf == NULL) {
+      return NGHTTP2_ERR_NOMEM;
+    }
+  }
+  return 0;
+}
+
 static size_t entry_room(size_t namelen, size_t valuelen)
 {
   return NGHTTP2_HD_ENTRY_OVERHEAD + namelen + valuelen;
 }
 
+void nghttp2_hd_deflate_set_table_size(nghttp2_hd_context *deflater,
+                                       size_t size)
+{
+  assert(size <= NGHTTP2_HD_MAX_BUFFER_SIZE);
+  deflater->deflate_table_size = size;
+}
+
+int nghttp2_hd_set_max_header_fields(nghttp2_hd_context *context, size_t n)
+{
+  nghttp2_hd_entry **refset;
+  nghttp2_hd_ws_entry *ws;
+  nghttp2_nv *nvabuf = NULL;
+  if(n == 0 || n > NGHTTP2_DEFAULT_MAX_HEADER_FIELDS ||
+     context->wslen > 0 || context->refsetlen > n) {
+    return NGHTTP2_ERR_INVALID_ARGUMENT;
+  }
+  if(context->ws == NULL) {
+    /* Released by nghttp2_hd_shrink(). They are allocated with the
+       new capacity when they are needed. */
+    context->refset_capacity = context->ws_capacity = n;
+    return 0;
+  }
+  refset = nghttp2_mem_malloc(context->mem, sizeof(nghttp2_hd_entry*)*n);
+  if(refset == NULL) {
+    goto fail_refset;
+  }
+  ws = nghttp2_mem_malloc(context->mem, sizeof(nghttp2_hd_ws_entry)*n);
+  if(ws == NULL) {
+    goto fail_ws;
+  }
+  if(context->nvabuf) {
+    nvabuf = nghttp2_mem_malloc(context->mem, sizeof(nghttp2_nv)*n);
+    if(nvabuf == NULL) {
+      goto fail_nvabuf;
+    }
+    nghttp2_mem_free(context->mem, context->nvabuf);
+    context->nvabuf = nvabuf;
+  }
+  memcpy(refset, context->refset,
+         sizeof(nghttp2_hd_entry*)*context->refsetlen);
+  nghttp2_mem_free(context->mem, context->refset);
+  nghttp2_mem_free(context->mem, context->ws);
+  context->refset = refset;
+  context->ws = ws;
+  context->refset_capacity = context->ws_capacity = n;
+  return 0;
+ fail_nvabuf:
+  nghttp2_mem_free(context->mem, ws);
+ fail_ws:
+  nghttp2_mem_free(context->mem, refset);
+ fail_refset:
+  return NGHTTP2_ERR_NOMEM;
+}
+
+void nghttp2_hd_set_huffman(nghttp2_hd_context *context, int enable)
+{
+  context->huffman = enable != 0;
+}
+
+void nghttp2_hd_deflate_set_select_indexing
+(nghttp2_hd_context *deflater, nghttp2_hd_select_indexing select_indexing,
+ void *arg)
+{
+  deflater->select_indexing = select_indexing;
+  deflater->select_indexing_arg = arg;
+}
+
+/*
+ * Returns nonzero if the header table of |deflater| has entries with
+ * the name of |nv|, which were added by |deflater|, and none of them
+ * has been reused. The values of such a name are likely to be unique,
+ * like dates and content-length.
+ */
+static int hd_deflate_name_is_volatile(nghttp2_hd_context *deflater,
+                                       nghttp2_nv *nv, uint32_t name_hash)
+{
+  nghttp2_hd_entry *ent;
+  int found = 0;
+  for(ent = deflater->name_index[name_hash &
+                                 (NGHTTP2_HD_INDEX_BUCKET_SIZE - 1)];
+      ent; ent = ent->name_next) {
+    if(ent->name_hash == name_hash && ent->nv.namelen == nv->namelen &&
+       (ent->flags & NGHTTP2_HD_FLAG_STATIC) == 0 &&
+       memcmp(ent->nv.name, nv->name, nv->namelen) == 0) {
+      if(ent->flags & NGHTTP2_HD_FLAG_REUSED) {
+        return 0;
+      }
+      found = 1;
+    }
+  }
+  return found;
+}
+
+/*
+ * Returns nonzero if |deflater| should add the name/value pair |nv|
+ * to the header table. Large entries are never added. If the table
+ * is limited by nghttp2_hd_deflate_set_table_size(), the entry is
+ * added only if the table does not grow beyond the limit. Otherwise,
+ * deflater->select_indexing decides, and the default policy skips
+ * the volatile names.
+ */
+static int hd_deflate_should_index(nghttp2_hd_context *deflater,
+                                   nghttp2_nv *nv, uint32_t name_hash)
+{
+  size_t room = entry_room(nv->namelen, nv->valuelen);
+  int indexing = NGHTTP2_HD_INDEXING_DEFAULT;
+  if(room >= NGHTTP2_HD_MAX_ENTRY_SIZE) {
+    return 0;
+  }
+  /* With the full size, eviction keeps the table within the limit */
+  if(deflater->deflate_table_size != NGHTTP2_HD_MAX_BUFFER_SIZE &&
+     deflater->hd_table_bufsize + room > deflater->deflate_table_size) {
+    return 0;
+  }
+  if(deflater->select_indexing) {
+    indexing = deflater->select_indexing(nv, deflater->select_indexing_arg);
+  }
+  switch(indexing) {
+  case NGHTTP2_HD_INDEXING_INCREMENTAL:
+    return 1;
+  case NGHTTP2_HD_INDEXING_NONE:
+    return 0;
+  default:
+    return !hd_deflate_name_is_volatile(deflater, nv, name_hash);
+  }
+}
+
+/*
+ * Removes |ent| from the header table of |context|. The slot of |ent|
+ * is not reclaimed by this function.
+ */
+static void hd_table_unlink(nghttp2_hd_context *context,
+                            nghttp2_hd_entry *ent)
+{
+  hd_index_remove(context, ent);
+  ent->slot = NGHTTP2_HD_INVALID_INDEX;
+  hd_entry_unref(context, ent);
+}
+
+/*
+ * Evicts the first entry of the header table of |context|.
+ */
+static void hd_table_pop_front(nghttp2_hd_context *context)
+{
+  hd_table_unlink(context, nghttp2_hd_table_get(context, 0));
+  context->hd_table_first = (context->hd_table_first + 1) &
+    (context->hd_table_capacity - 1);
+  --context->hd_tablelen;
+}
+
 static nghttp2_hd_entry* add_hd_table_incremental(nghttp2_hd_context *context,
                                                   nghttp2_nv *nv)
 {
   int rv;
-  size_t i;
+  size_t slot;
   nghttp2_hd_entry *new_ent;
   size_t room = entry_room(nv->namelen, nv->valuelen);
   if(context->hd_tablelen == context->hd_table_capacity ||
@@ -288,36 +679,30 @@ static nghttp2_hd_entry* add_hd_table_incremental(nghttp2_hd_context *context,
     return NULL;
   }
   context->hd_table_bufsize += room;
-  for(i = 0; i < context->hd_tablelen &&
-        context->hd_table_bufsize > NGHTTP2_HD_MAX_BUFFER_SIZE; ++i) {
-    nghttp2_hd_entry *ent = context->hd_table[i];
+  while(context->hd_tablelen > 0 &&
+        context->hd_table_bufsize > NGHTTP2_HD_MAX_BUFFER_SIZE) {
+    nghttp2_hd_entry *ent = nghttp2_hd_table_get(context, 0);
     context->hd_table_bufsize -= entry_room(ent->nv.namelen, ent->nv.valuelen);
-    ent->index = NGHTTP2_HD_INVALID_INDEX;
-    if(--ent->ref == 0) {
-      nghttp2_hd_entry_free(ent);
-      free(ent);
-    }
-  }
-  if(i > 0) {
-    size_t j;
-    for(j = 0; i < context->hd_tablelen; ++i, ++j) {
-      context->hd_table[j] = context->hd_table[i];
-      context->hd_table[j]->index = j;
-    }
-    context->hd_tablelen = j;
+    hd_table_pop_front(context);
   }
-  new_ent = malloc(sizeof(nghttp2_hd_entry));
+  new_ent = nghttp2_mem_malloc(context->mem, sizeof(nghttp2_hd_entry));
   if(new_ent == NULL) {
     return NULL;
   }
-  rv = nghttp2_hd_entry_init(new_ent, context->hd_tablelen,
+  slot = (context->hd_table_first + context->hd_tablelen) &
+    (context->hd_table_capacity - 1);
+  rv = nghttp2_hd_entry_init(new_ent, slot,
                              NGHTTP2_HD_FLAG_NAME_ALLOC |
                              NGHTTP2_HD_FLAG_VALUE_ALLOC,
-                             nv->name, nv->namelen, nv->value, nv->valuelen);
+                             nv->name, nv->namelen, nv->value, nv->valuelen,
+                             context->mem);
   if(rv < 0) {
+    nghttp2_mem_free(context->mem, new_ent);
     return NULL;
   }
-  context->hd_table[context->hd_tablelen++] = new_ent;
+  context->hd_table[slot] = new_ent;
+  ++context->hd_tablelen;
+  hd_index_add(context, new_ent);
   return new_ent;
 }
 
@@ -327,68 +712,69 @@ static nghttp2_hd_entry* add_hd_table_subst(nghttp2_hd_context *context,
   int rv;
   size_t i;
   int k;
+  size_t slot;
   nghttp2_hd_entry *new_ent;
   size_t room = entry_room(nv->namelen, nv->valuelen);
   if(room > NGHTTP2_HD_MAX_BUFFER_SIZE ||
      context->hd_tablelen <= subindex) {
     return NULL;
   }
-  context->hd_table_bufsize -=
-    entry_room(context->hd_table[subindex]->nv.namelen,
-               context->hd_table[subindex]->nv.valuelen);
+  new_ent = nghttp2_hd_table_get(context, subindex);
+  context->hd_table_bufsize -= entry_room(new_ent->nv.namelen,
+                                          new_ent->nv.valuelen);
   context->hd_table_bufsize += room;
   k = subindex;
-  for(i = 0; i < context->hd_tablelen &&
+  for(i = 0; context->hd_tablelen > 0 &&
         context->hd_table_bufsize > NGHTTP2_HD_MAX_BUFFER_SIZE; ++i, --k) {
-    nghttp2_hd_entry *ent = context->hd_table[i];
+    nghttp2_hd_entry *ent = nghttp2_hd_table_get(context, 0);
     if(i != subindex) {
       context->hd_table_bufsize -= entry_room(ent->nv.namelen,
                                               ent->nv.valuelen);
     }
-    ent->index = NGHTTP2_HD_INVALID_INDEX;
-    if(--ent->ref == 0) {
-      nghttp2_hd_entry_free(ent);
-      free(ent);
-    }
+    hd_table_pop_front(context);
   }
-  if(i > 0) {
-    size_t j;
-    if(k < 0) {
-      j = 1;
-    } else {
-      j = 0;
-    }
-    for(; i < context->hd_tablelen; ++i, ++j) {
-      context->hd_table[j] = context->hd_table[i];
-      context->hd_table[j]->index = j;
-    }
-    context->hd_tablelen = j;
-  }
-  new_ent = malloc(sizeof(nghttp2_hd_entry));
+  new_ent = nghttp2_mem_malloc(context->mem, sizeof(nghttp2_hd_entry));
   if(new_ent == NULL) {
     return NULL;
   }
   if(k >= 0) {
-    nghttp2_hd_entry *ent = context->hd_table[k];
-    ent->index = NGHTTP2_HD_INVALID_INDEX;
-    if(--ent->ref == 0) {
-      nghttp2_hd_entry_free(ent);
-      free(ent);
-    }
+    nghttp2_hd_entry *ent = nghttp2_hd_table_get(context, k);
+    slot = ent->slot;
+    hd_table_unlink(context, ent);
   } else {
-    k = 0;
+    /* The entry to be substituted was evicted. The new entry is
+       prepended to the header table. */
+    context->hd_table_first = (context->hd_table_first - 1) &
+      (context->hd_table_capacity - 1);
+    ++context->hd_tablelen;
+    slot = context->hd_table_first;
   }
-  rv = nghttp2_hd_entry_init(new_ent, k,
+  rv = nghttp2_hd_entry_init(new_ent, slot,
                              NGHTTP2_HD_FLAG_NAME_ALLOC |
                              NGHTTP2_HD_FLAG_VALUE_ALLOC,
-                             nv->name, nv->namelen, nv->value, nv->valuelen);
+                             nv->name, nv->namelen, nv->value, nv->valuelen,
+                             context->mem);
   if(rv < 0) {
+    nghttp2_mem_free(context->mem, new_ent);
     return NULL;
   }
-  context->hd_table[new_ent->index] = new_ent;
+  context->hd_table[slot] = new_ent;
+  hd_index_add(context, new_ent);
   return new_ent;
 }
 
+/*
+ * Adds the last entry of the working set of |context| to the working
+ * set hash index.
+ */
+static void ws_index_add_last(nghttp2_hd_context *context)
+{
+  nghttp2_hd_ws_entry *ws_ent = &context->ws[context->wslen - 1];
+  size_t idx = ws_ent->nv_hash & (NGHTTP2_HD_WS_INDEX_BUCKET_SIZE - 1);
+  ws_ent->next = context->ws_index[idx];
+  context->ws_index[idx] = context->wslen;
+}
+
 static int add_workingset(nghttp2_hd_context *context, nghttp2_hd_entry *ent)
 {
   nghttp2_hd_ws_entry *ws_ent;
@@ -397,9 +783,11 @@ static int add_workingset(nghttp2_hd_context *context, nghttp2_hd_entry *ent)
   }
   ws_ent = &context->ws[context->wslen++];
   ws_ent->cat = NGHTTP2_HD_CAT_INDEXED;
+  ws_ent->nv_hash = ent->nv_hash;
   ws_ent->indexed.entry = ent;
-  ws_ent->indexed.index = ent->index;
+  ws_ent->indexed.index = entry_index(context, ent);
   ++ent->ref;
+  ws_index_add_last(context);
   return 0;
 }
 
@@ -412,7 +800,10 @@ static int add_workingset_newname(nghttp2_hd_context *context,
   }
   ws_ent = &context->ws[context->wslen++];
   ws_ent->cat = NGHTTP2_HD_CAT_NEWNAME;
+  ws_ent->nv_hash = hash_nv(hash_name(nv->name, nv->namelen),
+                            nv->value, nv->valuelen);
   ws_ent->newname.nv = *nv;
+  ws_index_add_last(context);
   return 0;
 }
 
@@ -426,53 +817,51 @@ static int add_workingset_indname(nghttp2_hd_context *context,
   }
   ws_ent = &context->ws[context->wslen++];
   ws_ent->cat = NGHTTP2_HD_CAT_INDNAME;
+  ws_ent->nv_hash = hash_nv(ent->name_hash, value, valuelen);
   ws_ent->indname.entry = ent;
   ++ent->ref;
   ws_ent->indname.value = value;
   ws_ent->indname.valuelen = valuelen;
+  ws_index_add_last(context);
   return 0;
 }
 
-static nghttp2_hd_ws_entry* find_in_workingset(nghttp2_hd_context *context,
-                                               nghttp2_nv *nv)
+/*
+ * Returns nonzero if the working set entry |ent| represents the
+ * name/value pair |nv|. The entries removed from the working set
+ * never match.
+ */
+static int ws_entry_equal(nghttp2_hd_ws_entry *ent, nghttp2_nv *nv)
 {
-  size_t i;
-  for(i = 0; i < context->wslen; ++i) {
-    nghttp2_hd_ws_entry *ent = &context->ws[i];
-    switch(ent->cat) {
-    case NGHTTP2_HD_CAT_INDEXED:
-      if(nghttp2_nv_equal(&ent->indexed.entry->nv, nv)) {
-        return ent;
-      }
-      break;
-    case NGHTTP2_HD_CAT_INDNAME:
-      if(ent->indname.entry->nv.namelen == nv->namelen &&
-         ent->indname.valuelen == nv->valuelen &&
-         memcmp(ent->indname.entry->nv.name, nv->name, nv->namelen) == 0 &&
-         memcmp(ent->indname.value, nv->value, nv->valuelen) == 0) {
-        return ent;
-      }
-      break;
-    case NGHTTP2_HD_CAT_NEWNAME:
-      if(nghttp2_nv_equal(&ent->newname.nv, nv)) {
-        return ent;
-      }
-    default:
-      break;
-    }
+  switch(ent->cat) {
+  case NGHTTP2_HD_CAT_INDEXED:
+    return nghttp2_nv_equal(&ent->indexed.entry->nv, nv);
+  case NGHTTP2_HD_CAT_INDNAME:
+    return ent->indname.entry->nv.namelen == nv->namelen &&
+      ent->indname.valuelen == nv->valuelen &&
+      memcmp(ent->indname.entry->nv.name, nv->name, nv->namelen) == 0 &&
+      memcmp(ent->indname.value, nv->value, nv->valuelen) == 0;
+  case NGHTTP2_HD_CAT_NEWNAME:
+    return nghttp2_nv_equal(&ent->newname.nv, nv);
+  default:
+    return 0;
   }
-  return NULL;
 }
 
-static nghttp2_hd_ws_entry* find_in_workingset_by_index
-(nghttp2_hd_context *context, size_t index)
+/*
+ * Finds the entry which has the name/value pair |nv| in the working
+ * set using the hash index. The |nv_hash| is the hash value of |nv|.
+ */
+static nghttp2_hd_ws_entry* find_in_workingset(nghttp2_hd_context *context,
+                                               nghttp2_nv *nv,
+                                               uint32_t nv_hash)
 {
-  size_t i;
-  for(i = 0; i < context->wslen; ++i) {
-    nghttp2_hd_ws_entry *ent = &context->ws[i];
-    /* Compare against *frozen* index, not the current header table
-       index. */
-    if(ent->cat == NGHTTP2_HD_CAT_INDEXED && ent->indexed.index == index) {
+  size_t pos;
+  for(pos = context->ws_index[nv_hash &
+                              (NGHTTP2_HD_WS_INDEX_BUCKET_SIZE - 1)];
+      pos; pos = context->ws[pos - 1].next) {
+    nghttp2_hd_ws_entry *ent = &context->ws[pos - 1];
+    if(ent->nv_hash == nv_hash && ws_entry_equal(ent, nv)) {
       return ent;
     }
   }
@@ -491,51 +880,66 @@ static size_t remove_from_workingset_by_index
     if(ws_ent->cat == NGHTTP2_HD_CAT_INDEXED &&
        ws_ent->indexed.index == index) {
       ++res;
-      if(--ws_ent->indexed.entry->ref == 0) {
-        nghttp2_hd_entry_free(ws_ent->indexed.entry);
-        free(ws_ent->indexed.entry);
-      }
+      hd_entry_unref(context, ws_ent->indexed.entry);
       ws_ent->cat = NGHTTP2_HD_CAT_NONE;
     }
   }
   return res;
 }
 
+/*
+ * Finds the entry which has the name/value pair |nv| in the header
+ * table using the hash index. The |nv_hash| is the hash value of
+ * |nv|. If there are several matches, the one with the smallest index
+ * is returned.
+ */
 static nghttp2_hd_entry* find_in_hd_table(nghttp2_hd_context *context,
-                                          nghttp2_nv *nv)
+                                          nghttp2_nv *nv, uint32_t nv_hash)
 {
-  size_t i;
-  for(i = 0; i < context->hd_tablelen; ++i) {
-    nghttp2_hd_entry *ent = context->hd_table[i];
-    if(nghttp2_nv_equal(&ent->nv, nv)) {
-      return ent;
+  nghttp2_hd_entry *ent, *res = NULL;
+  for(ent = context->nv_index[nv_hash & (NGHTTP2_HD_INDEX_BUCKET_SIZE - 1)];
+      ent; ent = ent->nv_next) {
+    if(ent->nv_hash == nv_hash && nghttp2_nv_equal(&ent->nv, nv) &&
+       (res == NULL ||
+        entry_index(context, ent) < entry_index(context, res))) {
+      res = ent;
     }
   }
-  return NULL;
+  return res;
 }
 
+/*
+ * Finds the entry which has the name of |nv| in the header table
+ * using the hash index. The |name_hash| is the hash value of the
+ * name. If there are several matches, the one with the smallest index
+ * is returned.
+ */
 static nghttp2_hd_entry* find_name_in_hd_table(nghttp2_hd_context *context,
-                                               nghttp2_nv *nv)
+                                               nghttp2_nv *nv,
+                                               uint32_t name_hash)
 {
-  size_t i;
-  for(i = 0; i < context->hd_tablelen; ++i) {
-    nghttp2_hd_entry *ent = context->hd_table[i];
-    if(ent->nv.namelen == nv->namelen &&
-       memcmp(ent->nv.name, nv->name, nv->namelen) == 0) {
-      return ent;
+  nghttp2_hd_entry *ent, *res = NULL;
+  for(ent = context->name_index[name_hash &
+                                (NGHTTP2_HD_INDEX_BUCKET_SIZE - 1)];
+      ent; ent = ent->name_next) {
+    if(ent->name_hash == name_hash && ent->nv.namelen == nv->namelen &&
+       memcmp(ent->nv.name, nv->name, nv->namelen) == 0 &&
+       (res == NULL ||
+        entry_index(context, ent) < entry_index(context, res))) {
+      res = ent;
     }
   }
-  return NULL;
+  return res;
 }
 
 static int ensure_write_buffer(uint8_t **buf_ptr, size_t *buflen_ptr,
-                               size_t offset, size_t need)
+                               size_t offset, size_t need, nghttp2_mem *mem)
 {
   int rv;
   if(need + offset > NGHTTP2_MAX_FRAME_LENGTH) {
     return NGHTTP2_ERR_HEADER_COMP;
   }
-  rv = nghttp2_reserve_buffer(buf_ptr, buflen_ptr, offset + need);
+  rv = nghttp2_reserve_buffer(buf_ptr, buflen_ptr, offset + need, mem);
   if(rv != 0) {
     return NGHTTP2_ERR_NOMEM;
   }
@@ -588,56 +992,100 @@ static size_t encode_length(uint8_t *buf, size_t n, int prefix)
   return len;
 }
 
+/*
+ * Returns the number of bytes required to emit the string |s| of
+ * length |len|. If |huffman| is nonzero, the length is prefixed with
+ * 7 bits, and the string is Huffman encoded if it gets shorter. In
+ * that case, the encoded length is stored in |*hufflen_ptr|.
+ * Otherwise, 0 is stored in |*hufflen_ptr|.
+ */
+static size_t count_string_length(const uint8_t *s, size_t len, int huffman,
+                                  size_t *hufflen_ptr)
+{
+  size_t hufflen;
+  *hufflen_ptr = 0;
+  if(!huffman) {
+    return count_encoded_length(len, 8) + len;
+  }
+  hufflen = nghttp2_hd_huff_encode_count(s, len);
+  if(hufflen < len) {
+    *hufflen_ptr = hufflen;
+    return count_encoded_length(hufflen, 7) + hufflen;
+  }
+  return count_encoded_length(len, 7) + len;
+}
+
+/*
+ * Emits the string |s| of length |len| to |buf|. The |huffman| and
+ * the |hufflen| must be the values given to and obtained from
+ * count_string_length() respectively. This function returns the
+ * number of bytes written.
+ */
+static size_t emit_string(uint8_t *buf, const uint8_t *s, size_t len,
+                          int huffman, size_t hufflen)
+{
+  size_t n;
+  if(!huffman) {
+    n = encode_length(buf, len, 8);
+    memcpy(buf + n, s, len);
+    return n + len;
+  }
+  if(hufflen) {
+    n = encode_length(buf, hufflen, 7);
+    *buf |= 0x80u;
+    return n + nghttp2_hd_huff_encode(buf + n, s, len);
+  }
+  n = encode_length(buf, len, 7);
+  memcpy(buf + n, s, len);
+  return n + len;
+}
+
 /*
  * Decodes |prefx| prefixed integer stored from |in|. The |last|
  * represents the 1 beyond the last of the valid contiguous memory
  * region from |in|. The decoded integer must be strictly less than 1
  * << 16.
  *
- * This function returns the next byte of read byte. This function
- * stores the decoded integer in |*res| if it succeeds, or stores -1
- * in |*res|, indicating decoding error.
+ * This function stores the decoded integer in |*res| and returns the
+ * number of bytes read if it succeeds. It returns 0 if |in| ends
+ * before the integer does, or NGHTTP2_ERR_HEADER_COMP if the integer
+ * is too large.
  */
-static  uint8_t* decode_length(ssize_t *res, uint8_t *in, uint8_t *last,
-                               int prefix)
+static ssize_t decode_length(ssize_t *res, const uint8_t *in,
+                             const uint8_t *last, int prefix)
 {
   int k = (1 << prefix) - 1, r;
+  const uint8_t *first = in;
   if(in == last) {
-    *res = -1;
-    return in;
+    return 0;
   }
   if((*in & k) == k) {
     *res = k;
   } else {
     *res = (*in) & k;
-    return in + 1;
+    return 1;
   }
   ++in;
   for(r = 0; in != last; ++in, r += 7) {
     *res += (*in & 0x7f) << r;
     if(*res >= (1 << 16)) {
-      *res = -1;
-      return in + 1;
+      return NGHTTP2_ERR_HEADER_COMP;
     }
     if((*in & (1 << 7)) == 0) {
-      break;
+      return in + 1 - first;
     }
   }
-  if(*in & (1 << 7)) {
-    *res = -1;
-    return NULL;
-  } else {
-    return in + 1;
-  }
+  return 0;
 }
 
 static int emit_indexed_block(uint8_t **buf_ptr, size_t *buflen_ptr,
-                              size_t *offset_ptr, size_t index)
+                              size_t *offset_ptr, size_t index,
+                              nghttp2_mem *mem)
 {
   int rv;
   uint8_t *bufp;
   size_t blocklen = count_encoded_length(index, 7);
-  rv = ensure_write_buffer(buf_ptr, buflen_ptr, *offset_ptr, blocklen);
+  rv = ensure_write_buffer(buf_ptr, buflen_ptr, *offset_ptr, blocklen, mem);
   if(rv != 0) {
     return rv;
   }
@@ -651,45 +1099,45 @@ static int emit_indexed_block(uint8_t **buf_ptr, size_t *buflen_ptr,
 static int emit_indname_block(uint8_t **buf_ptr, size_t *buflen_ptr,
                               size_t *offset_ptr, size_t index,
                               const uint8_t *value, size_t valuelen,
-                              int inc_indexing)
+                              int inc_indexing, int huffman, nghttp2_mem *mem)
 {
   int rv;
   uint8_t *bufp;
+  size_t hufflen;
   size_t blocklen = count_encoded_length(index + 1, 5) +
-    count_encoded_length(valuelen, 8) + valuelen;
-  rv = ensure_write_buffer(buf_ptr, buflen_ptr, *offset_ptr, blocklen);
+    count_string_length(value, valuelen, huffman, &hufflen);
+  rv = ensure_write_buffer(buf_ptr, buflen_ptr, *offset_ptr, blocklen, mem);
   if(rv != 0) {
     return rv;
   }
   bufp = *buf_ptr + *offset_ptr;
   bufp += encode_length(bufp, index + 1, 5);
-  bufp += encode_length(bufp, valuelen, 8);
-  memcpy(bufp, value, valuelen);
+  bufp += emit_string(bufp, value, valuelen, huffman, hufflen);
   (*buf_ptr)[*offset_ptr] |= inc_indexing ? 0x40u : 0x60u;
-  assert(bufp+valuelen - (*buf_ptr + *offset_ptr) == (ssize_t)blocklen);
+  assert(bufp - (*buf_ptr + *offset_ptr) == (ssize_t)blocklen);
   *offset_ptr += blocklen;
   return 0;
 }
 
 static int emit_newname_block(uint8_t **buf_ptr, size_t *buflen_ptr,
                               size_t *offset_ptr, nghttp2_nv *nv,
-                              int inc_indexing)
+                              int inc_indexing, int huffman, nghttp2_mem *mem)
 {
   int rv;
   uint8_t *bufp;
-  size_t blocklen = 1 + count_encoded_length(nv->namelen, 8) + nv->namelen +
-    count_encoded_length(nv->valuelen, 8) + nv->valuelen;
-  rv = ensure_write_buffer(buf_ptr, buflen_ptr, *offset_ptr, blocklen);
+  size_t namehufflen, valuehufflen;
+  size_t blocklen = 1 +
+    count_string_length(nv->name, nv->namelen, huffman, &namehufflen) +
+    count_string_length(nv->value, nv->valuelen, huffman, &valuehufflen);
+  rv = ensure_write_buffer(buf_ptr, buflen_ptr, *offset_ptr, blocklen, mem);
   if(rv != 0) {
     return rv;
   }
   bufp = *buf_ptr + *offset_ptr;
   *bufp++ = inc_indexing ? 0x40u : 0x60u;
-  bufp += encode_length(bufp, nv->namelen, 8);
-  memcpy(bufp, nv->name, nv->namelen);
-  bufp += nv->namelen;
-  bufp += encode_length(bufp, nv->valuelen, 8);
-  memcpy(bufp, nv->value, nv->valuelen);
+  bufp += emit_string(bufp, nv->name, nv->namelen, huffman, namehufflen);
+  bufp += emit_string(bufp, nv->value, nv->valuelen, huffman, valuehufflen);
+  assert(bufp - (*buf_ptr + *offset_ptr) == (ssize_t)blocklen);
   *offset_ptr += blocklen;
   return 0;
 }
@@ -697,14 +1145,14 @@ static int emit_newname_block(uint8_t **buf_ptr, size_t *buflen_ptr,
 static int emit_subst_indname_block(uint8_t **buf_ptr, size_t *buflen_ptr,
                                     size_t *offset_ptr, size_t index,
                                     const uint8_t *value, size_t valuelen,
-                                    size_t subindex)
+                                    size_t subindex, nghttp2_mem *mem)
 {
   int rv;
   uint8_t *bufp;
   size_t blocklen = count_encoded_length(index + 1, 6) +
     count_encoded_length(subindex, 8) +
     count_encoded_length(valuelen, 8) + valuelen;
-  rv = ensure_write_buffer(buf_ptr, buflen_ptr, *offset_ptr, blocklen);
+  rv = ensure_write_buffer(buf_ptr, buflen_ptr, *offset_ptr, blocklen, mem);
   if(rv != 0) {
     return rv;
   }
@@ -719,14 +1167,14 @@ static int emit_subst_indname_block(uint8_t **buf_ptr, size_t *buflen_ptr,
 
 static int emit_subst_newname_block(uint8_t **buf_ptr, size_t *buflen_ptr,
                                     size_t *offset_ptr, nghttp2_nv *nv,
-                                    size_t subindex)
+                                    size_t subindex, nghttp2_mem *mem)
 {
   int rv;
   uint8_t *bufp;
   size_t blocklen = 1 + count_encoded_length(nv->namelen, 8) + nv->namelen +
     count_encoded_length(subindex, 8) +
     count_encoded_length(nv->valuelen, 8) + nv->valuelen;
-  rv = ensure_write_buffer(buf_ptr, buflen_ptr, *offset_ptr, blocklen);
+  rv = ensure_write_buffer(buf_ptr, buflen_ptr, *offset_ptr, blocklen, mem);
   if(rv != 0) {
     return rv;
   }
@@ -745,84 +1193,144 @@ static int emit_subst_newname_block(uint8_t **buf_ptr, size_t *buflen_ptr,
 static void create_workingset(nghttp2_hd_context *context)
 {
   int i;
+  memset(context->ws_index, 0, sizeof(context->ws_index));
+  context->wslen = 0;
   for(i = 0; i < context->refsetlen; ++i) {
-    nghttp2_hd_ws_entry *ent = &context->ws[i];
+    nghttp2_hd_ws_entry *ent = &context->ws[context->wslen++];
     ent->cat = NGHTTP2_HD_CAT_INDEXED;
+    ent->nv_hash = context->refset[i]->nv_hash;
     ent->indexed.entry = context->refset[i];
-    ent->indexed.index = ent->indexed.entry->index;
+    ent->indexed.index = entry_index(context, ent->indexed.entry);
+    ws_index_add_last(context);
     context->refset[i] = NULL;
   }
-  context->wslen = context->refsetlen;
   context->refsetlen = 0;
 }
 
+/*
+ * Returns nonzero if |index| is marked in the bitmap |ws_indexes|.
+ */
+static int ws_indexes_has(const uint8_t *ws_indexes, size_t index)
+{
+  return (ws_indexes[index >> 3] & (1 << (index & 7))) != 0;
+}
+
+/*
+ * Adds |ent| to the working set of |deflater| like add_workingset(),
+ * and marks its index in |ws_indexes|, which is the bitmap of the
+ * indexes of the entries in the working set.
+ */
+static int deflate_add_workingset(nghttp2_hd_context *deflater,
+                                  nghttp2_hd_entry *ent, uint8_t *ws_indexes)
+{
+  int rv;
+  uint8_t index;
+  rv = add_workingset(deflater, ent);
+  if(rv < 0) {
+    return rv;
+  }
+  index = deflater->ws[deflater->wslen - 1].indexed.index;
+  ws_indexes[index >> 3] |= 1 << (index & 7);
+  return 0;
+}
+
 ssize_t nghttp2_hd_deflate_hd(nghttp2_hd_context *deflater,
                               uint8_t **buf_ptr, size_t *buflen_ptr,
                               size_t nv_offset,
                               nghttp2_nv *nv, size_t nvlen)
 {
-  size_t i, j, offset;
+  size_t i, pos, offset;
   int rv = 0;
+  /* Bitmap of the positions in the working set whose entries are in
+     |nv| */
+  uint8_t ws_keep[(NGHTTP2_DEFAULT_MAX_HEADER_FIELDS + 7) / 8];
+  /* Bitmap of the indexes of the entries in the working set */
+  uint8_t ws_indexes[NGHTTP2_INITIAL_HD_TABLE_SIZE / 8];
   if(deflater->bad) {
     return NGHTTP2_ERR_HEADER_COMP;
   }
+  rv = hd_context_ensure_ws(deflater, 0);
+  if(rv != 0) {
+    return rv;
+  }
   create_workingset(deflater);
   offset = nv_offset;
+  memset(ws_keep, 0, sizeof(ws_keep));
+  memset(ws_indexes, 0, sizeof(ws_indexes));
+  /* The working set only has the reference set now. Marks all entries
+     which are also in |nv|, so that the rest is toggled off below. */
+  for(i = 0; i < nvlen; ++i) {
+    uint32_t nv_hash = hash_nv(hash_name(nv[i].name, nv[i].namelen),
+                               nv[i].value, nv[i].valuelen);
+    for(pos = deflater->ws_index[nv_hash &
+                                 (NGHTTP2_HD_WS_INDEX_BUCKET_SIZE - 1)];
+        pos; pos = deflater->ws[pos - 1].next) {
+      nghttp2_hd_ws_entry *ws_ent = &deflater->ws[pos - 1];
+      if(ws_ent->nv_hash == nv_hash && ws_entry_equal(ws_ent, &nv[i])) {
+        ws_keep[(pos - 1) >> 3] |= 1 << ((pos - 1) & 7);
+      }
+    }
+  }
   /* Looks like we need to toggle first, because the index might be
      overlapped by eviction */
   for(i = 0; i < deflater->wslen; ++i) {
     nghttp2_hd_ws_entry *ws_ent = &deflater->ws[i];
-    int found = 0;
     assert(ws_ent->cat == NGHTTP2_HD_CAT_INDEXED);
-    for(j = 0; j < nvlen; ++j) {
-      if(nghttp2_nv_equal(&ws_ent->indexed.entry->nv, &nv[j])) {
-        found = 1;
-        break;
-      }
-    }
-    if(!found) {
+    if(ws_keep[i >> 3] & (1 << (i & 7))) {
+      ws_indexes[ws_ent->indexed.index >> 3] |=
+        1 << (ws_ent->indexed.index & 7);
+    } else {
       rv = emit_indexed_block(buf_ptr, buflen_ptr, &offset,
-                              ws_ent->indexed.index);
+                              ws_ent->indexed.index, deflater->mem);
       if(rv < 0) {
         goto fail;
       }
-      if(--ws_ent->indexed.entry->ref == 0) {
-        nghttp2_hd_entry_free(ws_ent->indexed.entry);
-        free(ws_ent->indexed.entry);
-      }
+      hd_entry_unref(deflater, ws_ent->indexed.entry);
       ws_ent->cat = NGHTTP2_HD_CAT_NONE;
     }
   }
   for(i = 0; i < nvlen; ++i) {
-    if(!find_in_workingset(deflater, &nv[i])) {
+    uint32_t name_hash = hash_name(nv[i].name, nv[i].namelen);
+    uint32_t nv_hash = hash_nv(name_hash, nv[i].value, nv[i].valuelen);
+    nghttp2_hd_ws_entry *ws_ent;
+    deflater->nv_bytes += nv[i].namelen + nv[i].valuelen;
+    ws_ent = find_in_workingset(deflater, &nv[i], nv_hash);
+    if(ws_ent) {
+      if(ws_ent->cat == NGHTTP2_HD_CAT_INDEXED) {
+        ws_ent->indexed.entry->flags |= NGHTTP2_HD_FLAG_REUSED;
+      }
+    } else {
       nghttp2_hd_entry *ent;
-      ent = find_in_hd_table(deflater, &nv[i]);
-      if(ent && find_in_workingset_by_index(deflater, ent->index) == NULL) {
+      ent = find_in_hd_table(deflater, &nv[i], nv_hash);
+      if(ent && !ws_indexes_has(ws_indexes, entry_index(deflater, ent))) {
         /* If nv[i] is found in hd_table and its index is not shadowed
-           by working set, use Indexed Header repr */
-        rv = add_workingset(deflater, ent);
+           by working set, use Indexed Header repr. The working set
+           compares against the *frozen* index, not the current
+           header table index. */
+        rv = deflate_add_workingset(deflater, ent, ws_indexes);
         if(rv < 0) {
           goto fail;
         }
-        rv = emit_indexed_block(buf_ptr, buflen_ptr, &offset, ent->index);
+        ent->flags |= NGHTTP2_HD_FLAG_REUSED;
+        rv = emit_indexed_block(buf_ptr, buflen_ptr, &offset,
+                                entry_index(deflater, ent), deflater->mem);
         if(rv < 0) {
           goto fail;
         }
       } else {
         /* Check name exists in hd_table */
-        ent = find_name_in_hd_table(deflater, &nv[i]);
+        ent = find_name_in_hd_table(deflater, &nv[i], name_hash);
         if(ent) {
-          uint8_t index = ent->index;
+          uint8_t index = entry_index(deflater, ent);
           int incidx = 0;
-          if(entry_room(nv[i].namelen, nv[i].valuelen)
-             < NGHTTP2_HD_MAX_ENTRY_SIZE) {
+          if(hd_deflate_should_index(deflater, &nv[i], name_hash)) {
             nghttp2_hd_entry *new_ent;
             new_ent = add_hd_table_incremental(deflater, &nv[i]);
             if(!new_ent) {
               rv = NGHTTP2_ERR_HEADER_COMP;
               goto fail;
             }
-            rv = add_workingset(deflater, new_ent);
+            rv = deflate_add_workingset(deflater, new_ent, ws_indexes);
             if(rv < 0) {
               goto fail;
             }
@@ -835,21 +1343,21 @@ ssize_t nghttp2_hd_deflate_hd(nghttp2_hd_context *deflater,
             }
           }
           rv = emit_indname_block(buf_ptr, buflen_ptr, &offset, index,
-                                  nv[i].value, nv[i].valuelen, incidx);
+                                  nv[i].value, nv[i].valuelen, incidx,
+                                  deflater->huffman, deflater->mem);
           if(rv < 0) {
             goto fail;
           }
         } else {
           int incidx = 0;
-          if(entry_room(nv[i].namelen, nv[i].valuelen)
-             < NGHTTP2_HD_MAX_ENTRY_SIZE) {
+          if(hd_deflate_should_index(deflater, &nv[i], name_hash)) {
             nghttp2_hd_entry *new_ent;
             new_ent = add_hd_table_incremental(deflater, &nv[i]);
             if(!new_ent) {
               rv = NGHTTP2_ERR_HEADER_COMP;
               goto fail;
             }
-            rv = add_workingset(deflater, new_ent);
+            rv = deflate_add_workingset(deflater, new_ent, ws_indexes);
             if(rv < 0) {
               goto fail;
             }
@@ -861,7 +1369,7 @@ ssize_t nghttp2_hd_deflate_hd(nghttp2_hd_context *deflater,
             }
           }
           rv = emit_newname_block(buf_ptr, buflen_ptr, &offset, &nv[i],
-                                  incidx);
+                                  incidx, deflater->huffman, deflater->mem);
           if(rv < 0) {
             goto fail;
           }
@@ -869,28 +1377,133 @@ ssize_t nghttp2_hd_deflate_hd(nghttp2_hd_context *deflater,
       }
     }
   }
+  deflater->block_bytes += offset - nv_offset;
   return offset - nv_offset;
  fail:
   deflater->bad = 1;
   return rv;
 }
 
-static ssize_t build_nv_array(nghttp2_hd_context *inflater,
-                              nghttp2_nv **nva_ptr)
+/*
+ * Reserves inflater->strbuf so that it can hold all strings of the
+ * current header block. Since the strings stored in it are referred
+ * until nghttp2_hd_end_headers(), it is never reallocated in the
+ * middle of a block.
+ */
+static int inflate_reserve_strbuf(nghttp2_hd_context *inflater)
 {
-  int nvlen = 0, i;
-  nghttp2_nv *nv;
-  for(i = 0; i < inflater->wslen; ++i) {
-    nghttp2_hd_ws_entry *ent = &inflater->ws[i];
-    if(ent->cat != NGHTTP2_HD_CAT_NONE) {
-      ++nvlen;
+  size_t n = inflater->blocklen;
+  if(inflater->huffman) {
+    /* Each symbol is at least NGHTTP2_HUFF_MIN_CODE_LENGTH bits */
+    n = n * 8 / NGHTTP2_HUFF_MIN_CODE_LENGTH;
+  }
+  return nghttp2_reserve_buffer(&inflater->strbuf, &inflater->strbuflen,
+                                n, inflater->mem);
+}
+
+/*
+ * Returns nonzero if |s| of length |len| contains upper case
+ * characters.
+ */
+static int has_upper(const uint8_t *s, size_t len)
+{
+  size_t i;
+  for(i = 0; i < len; ++i) {
+    if('A' <= s[i] && s[i] <= 'Z') {
+      return 1;
     }
   }
-  *nva_ptr = malloc(sizeof(nghttp2_nv)*nvlen);
-  if(*nva_ptr == NULL) {
-    return NGHTTP2_ERR_NOMEM;
+  return 0;
+}
+
+/*
+ * Decodes the string literal stored from |in|. The |last| represents
+ * the 1 beyond the last of the valid contiguous memory region from
+ * |in|. If |name| is nonzero, the string is a header name and is
+ * converted to lower case.
+ *
+ * The string is decoded or copied into inflater->strbuf if it is
+ * Huffman encoded, if it must be converted to lower case, or if
+ * |copy| is nonzero. Otherwise, the string refers to |in| directly.
+ * The |in| is never modified.
+ *
+ * This function stores the string in |*s_ptr| and its length in
+ * |*len_ptr|, and returns the number of bytes read if it succeeds. It
+ * returns 0 if |in| ends before the string does, or one of the
+ * following negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory.
+ * NGHTTP2_ERR_HEADER_COMP
+ *     The string is invalid.
+ */
+static ssize_t decode_string(nghttp2_hd_context *inflater,
+                             uint8_t **s_ptr, uint16_t *len_ptr,
+                             const uint8_t *in, const uint8_t *last,
+                             int name, int copy)
+{
+  ssize_t len = 0, n;
+  int huff = 0;
+  uint8_t *dest;
+  if(in == last) {
+    return 0;
+  }
+  if(inflater->huffman) {
+    huff = (*in & 0x80u) != 0;
+    n = decode_length(&len, in, last, 7);
+  } else {
+    n = decode_length(&len, in, last, 8);
+  }
+  if(n <= 0) {
+    return n;
+  }
+  in += n;
+  if(last - in < len) {
+    return 0;
   }
-  nv = *nva_ptr;
+  if(huff) {
+    ssize_t declen;
+    dest = inflater->strbuf + inflater->stroffset;
+    assert(inflater->stroffset + len * 8 / NGHTTP2_HUFF_MIN_CODE_LENGTH <=
+           inflater->strbuflen);
+    declen = nghttp2_hd_huff_decode(dest, in, len);
+    if(declen < 0 || declen >= (1 << 16)) {
+      return NGHTTP2_ERR_HEADER_COMP;
+    }
+    *len_ptr = declen;
+  } else if(copy || (name && has_upper(in, len))) {
+    int rv;
+    rv = inflate_reserve_strbuf(inflater);
+    if(rv != 0) {
+      return rv;
+    }
+    dest = inflater->strbuf + inflater->stroffset;
+    assert(inflater->stroffset + len <= inflater->strbuflen);
+    memcpy(dest, in, len);
+    *len_ptr = len;
+  } else {
+    /* The name has no upper case characters, so |in| is used as
+       is. */
+    *s_ptr = (uint8_t*)in;
+    *len_ptr = len;
+    return n + len;
+  }
+  if(name) {
+    nghttp2_downcase(dest, *len_ptr);
+  }
+  *s_ptr = dest;
+  inflater->stroffset += *len_ptr;
+  return n + len;
+}
+
+static ssize_t build_nv_array(nghttp2_hd_context *inflater,
+                              nghttp2_nv **nva_ptr)
+{
+  int nvlen, i;
+  nghttp2_nv *nv;
+  /* The number of name/value pairs never exceeds the number of
+     entries in working set, so inflater->nvabuf is large enough. */
+  *nva_ptr = nv = inflater->nvabuf;
   for(i = 0; i < inflater->wslen; ++i) {
     nghttp2_hd_ws_entry *ent = &inflater->ws[i];
     switch(ent->cat) {
@@ -913,230 +1526,252 @@ static ssize_t build_nv_array(nghttp2_hd_context *inflater,
       break;
     }
   }
+  nvlen = nv - *nva_ptr;
+  for(i = 0; i < nvlen; ++i) {
+    (*nva_ptr)[i].flags = NGHTTP2_NV_FLAG_NONE;
+    inflater->nv_bytes += (*nva_ptr)[i].namelen + (*nva_ptr)[i].valuelen;
+  }
   nghttp2_nv_array_sort(*nva_ptr, nvlen);
   return nvlen;
 }
 
-ssize_t nghttp2_hd_inflate_hd(nghttp2_hd_context *inflater,
-                              nghttp2_nv **nva_ptr,
-                              uint8_t *in, size_t inlen)
+/*
+ * A header representation parsed by inflate_parse_rep().
+ */
+typedef struct {
+  /* The first byte of the representation, which tells its type */
+  uint8_t c;
+  /* The index of the header table entry. For literal header
+     representations, this is -1 if the name is a new name. */
+  ssize_t index;
+  /* The substituted index, only for literal header representations
+     with substitution indexing */
+  ssize_t subindex;
+  /* The name and value. The name is only used when |index| is -1. */
+  nghttp2_nv nv;
+} nghttp2_hd_inflate_rep;
+
+/*
+ * Parses one header representation stored from |in| into |rep|
+ * without changing the header table and the working set. The string
+ * literals may be stored in inflater->strbuf.
+ *
+ * This function returns the number of bytes read if it succeeds. It
+ * returns 0 if |last| comes before the end of the representation, or
+ * one of the following negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory.
+ * NGHTTP2_ERR_HEADER_COMP
+ *     The representation is invalid.
+ */
+static ssize_t inflate_parse_rep(nghttp2_hd_context *inflater,
+                                 nghttp2_hd_inflate_rep *rep,
+                                 const uint8_t *in, const uint8_t *last)
 {
-  int rv = 0;
-  uint8_t *last = in + inlen;
+  const uint8_t *first = in;
+  ssize_t rv;
+  int copy;
+  rep->c = *in;
+  if(rep->c & 0x80u) {
+    /* Indexed Header Repr */
+    return decode_length(&rep->index, in, last, 7);
+  }
+  /* The strings of Literal Header without Indexing are referred
+     until nghttp2_hd_end_headers(). The others are copied into the
+     header table before |in| is discarded. */
+  copy = inflater->copy_strings && (rep->c & 0x60u) == 0x60u;
+  if(rep->c == 0x60u || rep->c == 0x40u || rep->c == 0) {
+    /* Literal Header - new name */
+    rep->index = -1;
+    rv = decode_string(inflater, &rep->nv.name, &rep->nv.namelen,
+                       in + 1, last, 1, copy);
+    if(rv <= 0) {
+      return rv;
+    }
+    in += 1 + rv;
+  } else {
+    /* Literal Header - indexed name. Literal Header with substitution
+       indexing uses 6 bit prefix, and the others use 5 bit prefix. */
+    rv = decode_length(&rep->index, in, last,
+                       (rep->c & 0x40u) ? 5 : 6);
+    if(rv <= 0) {
+      return rv;
+    }
+    in += rv;
+    if(--rep->index >= inflater->hd_tablelen) {
+      return NGHTTP2_ERR_HEADER_COMP;
+    }
+  }
+  if((rep->c & 0xc0u) == 0) {
+    /* Literal Header with substitution indexing */
+    rv = decode_length(&rep->subindex, in, last, 8);
+    if(rv <= 0) {
+      return rv;
+    }
+    in += rv;
+  }
+  rv = decode_string(inflater, &rep->nv.value, &rep->nv.valuelen,
+                     in, last, 0, copy);
+  if(rv <= 0) {
+    return rv;
+  }
+  return in + rv - first;
+}
+
+/*
+ * Applies the header representation |rep| to the header table and
+ * the working set of |inflater|.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory.
+ * NGHTTP2_ERR_HEADER_COMP
+ *     The representation is invalid.
+ */
+static int inflate_apply_rep(nghttp2_hd_context *inflater,
+                             nghttp2_hd_inflate_rep *rep)
+{
+  nghttp2_hd_entry *ent = NULL, *new_ent;
+  int rv;
+  if(rep->c & 0x80u) {
+    /* If nothing was removed, add entry from header table to
+       workingset */
+    if(remove_from_workingset_by_index(inflater, rep->index) == 0) {
+      if(inflater->hd_tablelen <= rep->index) {
+        return NGHTTP2_ERR_HEADER_COMP;
+      }
+      return add_workingset(inflater,
+                            nghttp2_hd_table_get(inflater, rep->index));
+    }
+    return 0;
+  }
+  if(rep->index >= 0) {
+    ent = nghttp2_hd_table_get(inflater, rep->index);
+    if((rep->c & 0x60u) == 0x60u) {
+      /* Literal Header without Indexing - indexed name */
+      return add_workingset_indname(inflater, ent, rep->nv.value,
+                                    rep->nv.valuelen);
+    }
+    /* The entry may be evicted by the new one */
+    ++ent->ref;
+    rep->nv.name = ent->nv.name;
+    rep->nv.namelen = ent->nv.namelen;
+  } else if(rep->c == 0x60u) {
+    /* Literal Header without Indexing - new name */
+    return add_workingset_newname(inflater, &rep->nv);
+  }
+  if(rep->c & 0x40u) {
+    /* Literal Header with incremental indexing */
+    new_ent = add_hd_table_incremental(inflater, &rep->nv);
+  } else {
+    /* Literal Header with substitution indexing */
+    new_ent = add_hd_table_subst(inflater, &rep->nv, rep->subindex);
+  }
+  if(ent) {
+    hd_entry_unref(inflater, ent);
+  }
+  if(!new_ent) {
+    return NGHTTP2_ERR_HEADER_COMP;
+  }
+  rv = add_workingset(inflater, new_ent);
+  if(rv < 0) {
+    return rv;
+  }
+  return 0;
+}
+
+int nghttp2_hd_inflate_begin(nghttp2_hd_context *inflater, size_t blocklen,
+                             int copy_strings)
+{
+  int rv;
   if(inflater->bad) {
     return NGHTTP2_ERR_HEADER_COMP;
   }
+  rv = hd_context_ensure_ws(inflater, 1);
+  if(rv != 0) {
+    return rv;
+  }
+  inflater->blocklen = blocklen;
+  inflater->stroffset = 0;
+  inflater->copy_strings = copy_strings != 0;
+  if(inflater->huffman) {
+    rv = inflate_reserve_strbuf(inflater);
+    if(rv != 0) {
+      return rv;
+    }
+  }
+  inflater->inflating = 1;
+  inflater->block_bytes += blocklen;
   create_workingset(inflater);
-  for(; in != last;) {
-    uint8_t c = *in;
-    if(c & 0x80u) {
-      /* Indexed Header Repr */
-      ssize_t index;
-      in = decode_length(&index, in, last, 7);
-      if(index < 0) {
-        rv = NGHTTP2_ERR_HEADER_COMP;
-        goto fail;
-      }
-      /* If nothing was removed, add entry from header table to
-         workingset */
-      if(remove_from_workingset_by_index(inflater, index) == 0) {
-        nghttp2_hd_entry *ent;
-        if(inflater->hd_tablelen <= index) {
-          rv = NGHTTP2_ERR_HEADER_COMP;
-          goto fail;
-        }
-        ent = inflater->hd_table[index];
-        rv = add_workingset(inflater, ent);
-        if(rv < 0) {
-          goto fail;
-        }
-      }
-    } else if(c == 0x60u || c == 0x40u) {
-      /* Literal Header without Indexing - new name or Literal Header
-         with incremental indexing - new name */
-      nghttp2_nv nv;
-      ssize_t namelen, valuelen;
-      if(++in == last) {
-        rv = NGHTTP2_ERR_HEADER_COMP;
-        goto fail;
-      }
-      in = decode_length(&namelen, in, last, 8);
-      if(namelen < 0 || in + namelen > last) {
-        rv = NGHTTP2_ERR_HEADER_COMP;
-        goto fail;
-      }
-      nv.name = in;
-      in += namelen;
-      in = decode_length(&valuelen, in, last, 8);
-      if(valuelen < 0 || in + valuelen > last) {
-        rv =  NGHTTP2_ERR_HEADER_COMP;
-        goto fail;
-      }
-      nv.namelen = namelen;
-      nv.value = in;
-      nv.valuelen = valuelen;
-      in += valuelen;
-      nghttp2_downcase(nv.name, nv.namelen);
-      if(c == 0x60u) {
-        rv = add_workingset_newname(inflater, &nv);
-      } else {
-        nghttp2_hd_entry *ent = add_hd_table_incremental(inflater, &nv);
-        if(ent) {
-          rv = add_workingset(inflater, ent);
-        } else {
-          rv = NGHTTP2_ERR_HEADER_COMP;
-          goto fail;
-        }
-      }
-      if(rv < 0) {
-        goto fail;
-      }
-    } else if((c & 0x60u) == 0x60u || (c & 0x40) == 0x40u) {
-      /* Literal Header without Indexing - indexed name or Literal
-         Header with incremental indexing - indexed name */
-      nghttp2_hd_entry *ent;
-      uint8_t *value;
-      ssize_t valuelen;
-      ssize_t index;
-      in = decode_length(&index, in, last, 5);
-      if(index < 0) {
-        rv = NGHTTP2_ERR_HEADER_COMP;
-        goto fail;
-      }
-      --index;
-      if(inflater->hd_tablelen <= index) {
-        rv = NGHTTP2_ERR_HEADER_COMP;
-        goto fail;
-      }
-      ent = inflater->hd_table[index];
-      in = decode_length(&valuelen, in , last, 8);
-      if(valuelen < 0 || in + valuelen > last) {
-        rv = NGHTTP2_ERR_HEADER_COMP;
-        goto fail;
-      }
-      value = in;
-      in += valuelen;
-      if((c & 0x60u) == 0x60u) {
-        rv = add_workingset_indname(inflater, ent, value, valuelen);
-      } else {
-        nghttp2_nv nv;
-        nghttp2_hd_entry *new_ent;
-        ++ent->ref;
-        nv.name = ent->nv.name;
-        nv.namelen = ent->nv.namelen;
-        nv.value = value;
-        nv.valuelen = valuelen;
-        new_ent = add_hd_table_incremental(inflater, &nv);
-        if(--ent->ref == 0) {
-          nghttp2_hd_entry_free(ent);
-          free(ent);
-        }
-        if(new_ent) {
-          rv = add_workingset(inflater, new_ent);
-        } else {
-          rv = NGHTTP2_ERR_HEADER_COMP;
-          goto fail;
-        }
-      }
-      if(rv < 0) {
-        goto fail;
-      }
-    } else if(c == 0) {
-      /* Literal Header with substitution indexing - new name */
-      nghttp2_hd_entry *new_ent;
-      nghttp2_nv nv;
-      ssize_t namelen, valuelen, subindex;
-      if(++in == last) {
-        rv = NGHTTP2_ERR_HEADER_COMP;
-        goto fail;
-      }
-      in = decode_length(&namelen, in, last, 8);
-      if(namelen < 0 || in + namelen > last) {
-        rv = NGHTTP2_ERR_HEADER_COMP;
-        goto fail;
-      }
-      nv.name = in;
-      in += namelen;
-      in = decode_length(&subindex, in, last, 8);
-      if(subindex < 0) {
-        rv = NGHTTP2_ERR_HEADER_COMP;
-        goto fail;
-      }
-      in = decode_length(&valuelen, in, last, 8);
-      if(valuelen < 0 || in + valuelen > last) {
-        rv = NGHTTP2_ERR_HEADER_COMP;
-        goto fail;
-      }
-      nv.value = in;
-      nv.namelen = namelen;
-      nv.valuelen = valuelen;
-      in += valuelen;
-      nghttp2_downcase(nv.name, nv.namelen);
-      new_ent = add_hd_table_subst(inflater, &nv, subindex);
-      if(new_ent) {
-        rv = add_workingset(inflater, new_ent);
-        if(rv < 0) {
-          goto fail;
-        }
-      } else {
-        rv = NGHTTP2_ERR_HEADER_COMP;
-        goto fail;
-      }
-    } else {
-      /* Literal Header with substitution indexing - indexed name */
-      nghttp2_hd_entry *ent, *new_ent;
-      ssize_t valuelen;
-      ssize_t index, subindex;
-      nghttp2_nv nv;
-      in = decode_length(&index, in, last, 6);
-      if(index < 0) {
-        rv = NGHTTP2_ERR_HEADER_COMP;
-        goto fail;
-      }
-      --index;
-      if(inflater->hd_tablelen <= index) {
-        rv = NGHTTP2_ERR_HEADER_COMP;
-        goto fail;
-      }
-      ent = inflater->hd_table[index];
-      in = decode_length(&subindex, in, last, 8);
-      if(subindex < 0) {
-        rv = NGHTTP2_ERR_HEADER_COMP;
-        goto fail;
-      }
-      in = decode_length(&valuelen, in, last, 8);
-      if(valuelen < 0 || in + valuelen > last) {
-        rv = NGHTTP2_ERR_HEADER_COMP;
-        goto fail;
-      }
-      ++ent->ref;
-      nv.name = ent->nv.name;
-      nv.namelen = ent->nv.namelen;
-      nv.value = in;
-      nv.valuelen = valuelen;
-      in += valuelen;
-      new_ent = add_hd_table_subst(inflater, &nv, subindex);
-      if(--ent->ref == 0) {
-        nghttp2_hd_entry_free(ent);
-        free(ent);
-      }
-      if(new_ent) {
-        rv = add_workingset(inflater, new_ent);
-        if(rv < 0) {
-          goto fail;
-        }
-      } else {
+  return 0;
+}
+
+ssize_t nghttp2_hd_inflate_partial(nghttp2_hd_context *inflater,
+                                   const uint8_t *in, size_t inlen,
+                                   int final)
+{
+  const uint8_t *first = in, *last = in + inlen;
+  ssize_t rv;
+  if(inflater->bad) {
+    return NGHTTP2_ERR_HEADER_COMP;
+  }
+  while(in != last) {
+    nghttp2_hd_inflate_rep rep;
+    size_t stroffset = inflater->stroffset;
+    rv = inflate_parse_rep(inflater, &rep, in, last);
+    if(rv < 0) {
+      goto fail;
+    }
+    if(rv == 0) {
+      if(final) {
         rv = NGHTTP2_ERR_HEADER_COMP;
         goto fail;
       }
+      /* Discard the strings of the incomplete representation. They
+         are decoded again with the rest of it. */
+      inflater->stroffset = stroffset;
+      break;
+    }
+    in += rv;
+    rv = inflate_apply_rep(inflater, &rep);
+    if(rv < 0) {
+      goto fail;
     }
   }
-  return build_nv_array(inflater, nva_ptr);
+  return in - first;
  fail:
   inflater->bad = 1;
   return rv;
 }
 
+ssize_t nghttp2_hd_inflate_finish(nghttp2_hd_context *inflater,
+                                  nghttp2_nv **nva_ptr)
+{
+  if(inflater->bad) {
+    return NGHTTP2_ERR_HEADER_COMP;
+  }
+  return build_nv_array(inflater, nva_ptr);
+}
+
+ssize_t nghttp2_hd_inflate_hd(nghttp2_hd_context *inflater,
+                              nghttp2_nv **nva_ptr,
+                              const uint8_t *in, size_t inlen)
+{
+  ssize_t rv;
+  rv = nghttp2_hd_inflate_begin(inflater, inlen, 0);
+  if(rv != 0) {
+    return rv;
+  }
+  rv = nghttp2_hd_inflate_partial(inflater, in, inlen, 1);
+  if(rv < 0) {
+    return rv;
+  }
+  return nghttp2_hd_inflate_finish(inflater, nva_ptr);
+}
+
 int nghttp2_hd_end_headers(nghttp2_hd_context *context)
 {
   int i;
@@ -1147,60 +1782,56 @@ int nghttp2_hd_end_headers(nghttp2_hd_context *context)
     nghttp2_hd_ws_entry *ws_ent = &context->ws[i];
     switch(ws_ent->cat) {
     case NGHTTP2_HD_CAT_INDEXED:
-      if(ws_ent->indexed.entry->index != NGHTTP2_HD_INVALID_INDEX &&
-         checks[ws_ent->indexed.entry->index] == 0) {
-        checks[ws_ent->indexed.entry->index] = 1;
+      if(ws_ent->indexed.entry->slot != NGHTTP2_HD_INVALID_INDEX &&
+         checks[ws_ent->indexed.entry->slot] == 0) {
+        checks[ws_ent->indexed.entry->slot] = 1;
         context->refset[context->refsetlen++] = ws_ent->indexed.entry;
       } else {
-        if(--ws_ent->indexed.entry->ref == 0) {
-          nghttp2_hd_entry_free(ws_ent->indexed.entry);
-          free(ws_ent->indexed.entry);
-        }
+        hd_entry_unref(context, ws_ent->indexed.entry);
       }
       break;
     case NGHTTP2_HD_CAT_INDNAME:
-      if(--ws_ent->indname.entry->ref == 0) {
-        nghttp2_hd_entry_free(ws_ent->indname.entry);
-        free(ws_ent->indname.entry);
-      }
+      hd_entry_unref(context, ws_ent->indname.entry);
       break;
     default:
       break;
     }
   }
   context->wslen = 0;
+  context->inflating = 0;
   return 0;
 }
 
 int nghttp2_hd_emit_indname_block(uint8_t **buf_ptr, size_t *buflen_ptr,
                                   size_t *offset_ptr, size_t index,
                                   const uint8_t *value, size_t valuelen,
-                                  int inc_indexing)
+                                  int inc_indexing, nghttp2_mem *mem)
 {
   return emit_indname_block(buf_ptr, buflen_ptr, offset_ptr,
-                            index, value, valuelen, inc_indexing);
+                            index, value, valuelen, inc_indexing, 0, mem);
 }
 
 int nghttp2_hd_emit_newname_block(uint8_t **buf_ptr, size_t *buflen_ptr,
                                   size_t *offset_ptr, nghttp2_nv *nv,
-                                  int inc_indexing)
+                                  int inc_indexing, nghttp2_mem *mem)
 {
-  return emit_newname_block(buf_ptr, buflen_ptr, offset_ptr, nv, inc_indexing);
+  return emit_newname_block(buf_ptr, buflen_ptr, offset_ptr, nv, inc_indexing,
+                            0, mem);
 }
 
 int nghttp2_hd_emit_subst_indname_block(uint8_t **buf_ptr, size_t *buflen_ptr,
                                         size_t *offset_ptr, size_t index,
                                         const uint8_t *value, size_t valuelen,
-                                        size_t subindex)
+                                        size_t subindex, nghttp2_mem *mem)
 {
   return emit_subst_indname_block(buf_ptr, buflen_ptr, offset_ptr, index,
-                                  value, valuelen, subindex);
+                                  value, valuelen, subindex, mem);
 }
 
 int nghttp2_hd_emit_subst_newname_block(uint8_t **buf_ptr, size_t *buflen_ptr,
                                         size_t *offset_ptr, nghttp2_nv *nv,
-                                        size_t subindex)
+                                        size_t subindex, nghttp2_mem *mem)
 {
   return emit_subst_newname_block(buf_ptr, buflen_ptr, offset_ptr, nv,
-                                  subindex);
+                                  subindex, mem);
 }
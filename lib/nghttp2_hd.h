@@ -31,18 +31,34 @@
 
 #include <nghttp2/nghttp2.h>
 
+#include "nghttp2_mem.h"
+
+/* The capacity of the header table. This must be power of 2. */
 #define NGHTTP2_INITIAL_HD_TABLE_SIZE 128
-#define NGHTTP2_INITIAL_REFSET_SIZE 128
-#define NGHTTP2_INITIAL_WS_SIZE 128
+/* The default capacity of the reference set and the working set. See
+   nghttp2_hd_set_max_header_fields(). */
+#define NGHTTP2_INITIAL_REFSET_SIZE NGHTTP2_DEFAULT_MAX_HEADER_FIELDS
+#define NGHTTP2_INITIAL_WS_SIZE NGHTTP2_DEFAULT_MAX_HEADER_FIELDS
 
-#define NGHTTP2_HD_MAX_BUFFER_SIZE 4096
+#define NGHTTP2_HD_MAX_BUFFER_SIZE NGHTTP2_HD_TABLE_SIZE
 #define NGHTTP2_HD_MAX_ENTRY_SIZE 1024
 #define NGHTTP2_HD_ENTRY_OVERHEAD 32
 
+/* The number of buckets of the hash index over the header table. This
+   must be power of 2. */
+#define NGHTTP2_HD_INDEX_BUCKET_SIZE 128
+/* The number of buckets of the hash index over the working set. This
+   must be power of 2. */
+#define NGHTTP2_HD_WS_INDEX_BUCKET_SIZE 64
+
 /* This value is sensible to NGHTTP2_HD_MAX_BUFFER_SIZE. Currently,
-   the index is at most 128, so 255 is good choice */
+   the index and the slot in the header table are at most 128, so 255
+   is good choice */
 #define NGHTTP2_HD_INVALID_INDEX 255
 
+/* The maximum number of entries in the initial header tables */
+#define NGHTTP2_HD_INI_TABLE_MAX 38
+
 typedef enum {
   NGHTTP2_HD_SIDE_CLIENT = 0,
   NGHTTP2_HD_SIDE_SERVER = 1
@@ -54,14 +70,30 @@ typedef enum {
   NGHTTP2_HD_FLAG_NAME_ALLOC = 1,
   /* Indicates value was dynamically allocated and must be freed */
   NGHTTP2_HD_FLAG_VALUE_ALLOC = 1 << 1,
+  /* Indicates the entry is one of the initial entries, which is not
+     allocated individually and must not be freed */
+  NGHTTP2_HD_FLAG_STATIC = 1 << 2,
+  /* Indicates the deflater has reused the entry as a whole at least
+     once */
+  NGHTTP2_HD_FLAG_REUSED = 1 << 3
 } nghttp2_hd_flags;
 
-typedef struct {
+typedef struct nghttp2_hd_entry {
   nghttp2_nv nv;
+  /* The next entry in the same bucket of the name/value hash index */
+  struct nghttp2_hd_entry *nv_next;
+  /* The next entry in the same bucket of the name hash index */
+  struct nghttp2_hd_entry *name_next;
+  /* Hash value of the name */
+  uint32_t name_hash;
+  /* Hash value of the name/value pair */
+  uint32_t nv_hash;
   /* Reference count */
   uint8_t ref;
-  /* Index in the header table */
-  uint8_t index;
+  /* Slot in the header table ring buffer, or
+     NGHTTP2_HD_INVALID_INDEX if this entry is not in the header
+     table. The slot does not change until the entry is evicted. */
+  uint8_t slot;
   uint8_t flags;
 } nghttp2_hd_entry;
 
@@ -73,7 +105,13 @@ typedef enum {
 } nghttp2_hd_entry_cat;
 
 typedef struct nghttp2_hd_ws_entry {
-  nghttp2_hd_entry_cat cat;
+  /* One of nghttp2_hd_entry_cat */
+  uint8_t cat;
+  /* 1 + the position of the next entry in the same bucket of the
+     working set hash index, or 0 if this is the last one */
+  uint8_t next;
+  /* Hash value of the name/value pair this entry represents */
+  uint32_t nv_hash;
   union {
     /* For NGHTTP2_HD_CAT_INDEXED */
     struct {
@@ -94,17 +132,66 @@ typedef struct nghttp2_hd_ws_entry {
   };
 } nghttp2_hd_ws_entry;
 
+/*
+ * Callback function to choose how the deflater sends the header field
+ * |nv| which is not in the header table. It returns one of
+ * nghttp2_hd_indexing.
+ */
+typedef int (*nghttp2_hd_select_indexing)(const nghttp2_nv *nv, void *arg);
+
 typedef struct {
-  /* Header table */
+  /* Header table. This is a ring buffer of |hd_table_capacity|
+     slots. The entry at index i is stored in the slot
+     (hd_table_first + i) & (hd_table_capacity - 1). */
   nghttp2_hd_entry **hd_table;
-  /* Reference set */
+  /* Reference set. After nghttp2_hd_shrink(), this only has room
+     for |refsetlen| entries until the next header block. */
   nghttp2_hd_entry **refset;
-  /* Working set */
+  /* Working set. This is NULL after nghttp2_hd_shrink() until the
+     next header block. */
   nghttp2_hd_ws_entry *ws;
+  /* The buffer to store the inflated name/value pairs. It has
+     |ws_capacity| elements and is reused for each header block. This
+     is only allocated for inflater. */
+  nghttp2_nv *nvabuf;
+  /* The buffer to store the strings of the current header block
+     which cannot refer to the input directly: Huffman decoded
+     strings, names converted to lower case, and the strings of
+     literal header representations without indexing if
+     |copy_strings| is nonzero. This is only allocated for
+     inflater. */
+  uint8_t *strbuf;
+  /* The length of |strbuf| */
+  size_t strbuflen;
+  /* The number of bytes used in |strbuf| */
+  size_t stroffset;
+  /* The length of the header block being inflated */
+  size_t blocklen;
+  /* Memory allocator */
+  nghttp2_mem *mem;
+  /* The indexing policy of the deflater, or NULL to use
+     NGHTTP2_HD_INDEXING_DEFAULT for all header fields */
+  nghttp2_hd_select_indexing select_indexing;
+  /* The argument passed to |select_indexing| */
+  void *select_indexing_arg;
+  /* The copy of the initial header table. The initial entries
+     point to the shared static name/value strings. */
+  nghttp2_hd_entry ini_table[NGHTTP2_HD_INI_TABLE_MAX];
+  /* Hash index of the entries in |hd_table|, keyed by name/value
+     pair */
+  nghttp2_hd_entry *nv_index[NGHTTP2_HD_INDEX_BUCKET_SIZE];
+  /* Hash index of the entries in |hd_table|, keyed by name */
+  nghttp2_hd_entry *name_index[NGHTTP2_HD_INDEX_BUCKET_SIZE];
+  /* Hash index of the entries in |ws|, keyed by name/value pair. Each
+     bucket has 1 + the position of the first entry, or 0 if it is
+     empty. This is rebuilt for each header block. */
+  uint8_t ws_index[NGHTTP2_HD_WS_INDEX_BUCKET_SIZE];
   /* The capacity of the |hd_table| */
   uint16_t hd_table_capacity;
   /* the number of entry the |hd_table| contains */
   uint16_t hd_tablelen;
+  /* The slot of the first entry (index 0) in |hd_table| */
+  uint16_t hd_table_first;
   /* The capacity of the |refset| */
   uint16_t refset_capacity;
   /* The number of entry the |refset| contains */
@@ -117,6 +204,26 @@ typedef struct {
      is the sum of length of name/value in hd_table +
      NGHTTP2_HD_ENTRY_OVERHEAD bytes overhead per each entry. */
   uint16_t hd_table_bufsize;
+  /* The upper limit of hd_table_bufsize up to which the deflater adds
+     entries to the header table. This is at most
+     NGHTTP2_HD_MAX_BUFFER_SIZE. */
+  uint16_t deflate_table_size;
+  /* Nonzero if string literals are prefixed with the Huffman flag,
+     and the deflater Huffman encodes them when it is shorter. */
+  uint8_t huffman;
+  /* Nonzero if the inflater copies the strings referred until
+     nghttp2_hd_end_headers() to |strbuf|, so that the input need not
+     be kept until then */
+  uint8_t copy_strings;
+  /* Nonzero while a header block is being inflated, that is, from
+     nghttp2_hd_inflate_begin() until nghttp2_hd_end_headers() */
+  uint8_t inflating;
+  /* The total length of the names and values of the header fields
+     deflated or inflated so far */
+  uint64_t nv_bytes;
+  /* The total length of the header blocks deflated or inflated so
+     far */
+  uint64_t block_bytes;
   /* If inflate/deflate error occurred, this value is set to 1 and
      further invocation of inflate/deflate will fail with
      NGHTTP2_ERR_HEADER_COMP. */
@@ -128,7 +235,9 @@ typedef struct {
  * set in the |flags|, the content pointed by the |name| with length
  * |namelen| is copied. Likewise, if NGHTTP2_HD_FLAG_VALUE_ALLOC bit
  * set in the |flags|, the content pointed by the |value| with length
- * |valuelen| is copied.
+ * |valuelen| is copied. The copies are allocated using |mem|. The
+ * hash values of the name and the name/value pair are computed and
+ * stored in |ent|.
  *
  * This function returns 0 if it succeeds, or one of the following
  * negative error codes:
@@ -136,14 +245,23 @@ typedef struct {
  * NGHTTP2_ERR_NOMEM
  *     Out of memory.
  */
-int nghttp2_hd_entry_init(nghttp2_hd_entry *ent, uint8_t index, uint8_t flags,
+int nghttp2_hd_entry_init(nghttp2_hd_entry *ent, uint8_t slot, uint8_t flags,
                           uint8_t *name, uint16_t namelen,
-                          uint8_t *value, uint16_t valuelen);
+                          uint8_t *value, uint16_t valuelen,
+                          nghttp2_mem *mem);
+
+void nghttp2_hd_entry_free(nghttp2_hd_entry *ent, nghttp2_mem *mem);
 
-void nghttp2_hd_entry_free(nghttp2_hd_entry *ent);
+/*
+ * Returns the entry at the |index| in the header table of |context|.
+ * The |index| must be strictly less than |context->hd_tablelen|.
+ */
+nghttp2_hd_entry* nghttp2_hd_table_get(nghttp2_hd_context *context,
+                                       size_t index);
 
 /*
- * Initializes |deflater| for deflating name/values pairs.
+ * Initializes |deflater| for deflating name/values pairs. The memory
+ * for |deflater| is allocated using |mem|.
  *
  * This function returns 0 if it succeeds, or one of the following
  * negative error codes:
@@ -152,10 +270,12 @@ void nghttp2_hd_entry_free(nghttp2_hd_entry *ent);
  *     Out of memory.
  */
 int nghttp2_hd_deflate_init(nghttp2_hd_context *deflater,
-                            nghttp2_hd_side side);
+                            nghttp2_hd_side side,
+                            nghttp2_mem *mem);
 
 /*
- * Initializes |inflater| for inflating name/values pairs.
+ * Initializes |inflater| for inflating name/values pairs. The memory
+ * for |inflater| is allocated using |mem|.
  *
  * This function returns 0 if it succeeds, or one of the following
  * negative error codes:
@@ -164,7 +284,8 @@ int nghttp2_hd_deflate_init(nghttp2_hd_context *deflater,
  *     Out of memory.
  */
 int nghttp2_hd_inflate_init(nghttp2_hd_context *inflater,
-                            nghttp2_hd_side side);
+                            nghttp2_hd_side side,
+                            nghttp2_mem *mem);
 
 /*
  * Deallocates any resources allocated for |deflater|.
@@ -176,6 +297,72 @@ void nghttp2_hd_deflate_free(nghttp2_hd_context *deflater);
  */
 void nghttp2_hd_inflate_free(nghttp2_hd_context *inflater);
 
+/*
+ * Returns the number of bytes allocated for |context|, including the
+ * entries in its header table. The memory used by the initial
+ * entries is not counted since it is part of |context|.
+ */
+size_t nghttp2_hd_get_mem_usage(nghttp2_hd_context *context);
+
+/*
+ * Releases the working set and the inflated name/value buffer of
+ * |context|, and shrinks its reference set to the current number of
+ * entries. They are reallocated when the next header block is
+ * processed. This function does nothing while a header block is
+ * being processed, that is, before nghttp2_hd_end_headers() is
+ * called.
+ */
+void nghttp2_hd_shrink(nghttp2_hd_context *context);
+
+/*
+ * Limits the header table of |deflater| to |size| bytes, which must
+ * be at most NGHTTP2_HD_MAX_BUFFER_SIZE. The table is still
+ * NGHTTP2_HD_MAX_BUFFER_SIZE bytes for the inflater on the remote
+ * endpoint, so |deflater| just stops adding entries which do not fit
+ * in |size| bytes. The entries already in the table are kept.
+ */
+void nghttp2_hd_deflate_set_table_size(nghttp2_hd_context *deflater,
+                                       size_t size);
+
+/*
+ * Changes the capacity of the reference set and the working set of
+ * |context| to |n| entries. This is the maximum number of header
+ * fields in one header block |context| can deflate or inflate. This
+ * function must not be called while a header block is being
+ * processed.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_INVALID_ARGUMENT
+ *     The |n| is 0 or larger than NGHTTP2_DEFAULT_MAX_HEADER_FIELDS,
+ *     or the reference set currently has more than |n| entries.
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory.
+ */
+int nghttp2_hd_set_max_header_fields(nghttp2_hd_context *context, size_t n);
+
+/*
+ * Enables Huffman coding of string literals for |context| if
+ * |enable| is nonzero, or disables it otherwise. This changes the
+ * wire format of the string literals: the length is prefixed with 7
+ * bits instead of 8, and the most significant bit of the first byte
+ * tells whether the string is Huffman encoded. Therefore, the
+ * deflater and the inflater on the remote endpoint must agree on this
+ * setting before the first header block. It is disabled by default.
+ */
+void nghttp2_hd_set_huffman(nghttp2_hd_context *context, int enable);
+
+/*
+ * Sets the indexing policy of |deflater|. The |select_indexing| is
+ * called with |arg| for each header field the deflater is about to
+ * add to the header table. Passing NULL restores the default
+ * policy.
+ */
+void nghttp2_hd_deflate_set_select_indexing
+(nghttp2_hd_context *deflater, nghttp2_hd_select_indexing select_indexing,
+ void *arg);
+
 /*
  * Deflates the |nva|, which has the |nvlen| name/value pairs, into
  * the buffer pointed by the |*buf_ptr| with the length |*buflen_ptr|.
@@ -202,8 +389,19 @@ ssize_t nghttp2_hd_deflate_hd(nghttp2_hd_context *deflater,
 /*
  * Inflates name/value block stored in |in| with length |inlen|. This
  * function performs decompression. The |*nva_ptr| points to the final
- * result on succesful decompression. The caller must free |*nva_ptr|
- * using nghttp2_nv_array_del().
+ * result on succesful decompression. The |in| is not modified.
+ *
+ * The |*nva_ptr| points to the buffer owned by |inflater| and no
+ * memory is allocated for it. The name/value pairs in |*nva_ptr|
+ * refer to the header table entries, the |in| directly or the
+ * decoded strings in |inflater|. Therefore, |*nva_ptr| is valid until
+ * nghttp2_hd_end_headers() is called for |inflater|, and the |in|
+ * must be kept intact during that period. The caller must not free
+ * |*nva_ptr|.
+ *
+ * This function is equivalent to nghttp2_hd_inflate_begin() with
+ * |copy_strings| 0, nghttp2_hd_inflate_partial() with |final| 1 and
+ * nghttp2_hd_inflate_finish().
  *
  * This function returns the number of name/value pairs in |*nva_ptr|
  * if it succeeds, or one of the following negative error codes:
@@ -215,7 +413,60 @@ ssize_t nghttp2_hd_deflate_hd(nghttp2_hd_context *deflater,
  */
 ssize_t nghttp2_hd_inflate_hd(nghttp2_hd_context *inflater,
                               nghttp2_nv **nva_ptr,
-                              uint8_t *in, size_t inlen);
+                              const uint8_t *in, size_t inlen);
+
+/*
+ * Starts inflating a header block of length |blocklen|, which is
+ * then given in pieces by nghttp2_hd_inflate_partial(). If
+ * |copy_strings| is nonzero, the inflated strings never refer to the
+ * input, so the pieces need not be kept after they are consumed.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory.
+ * NGHTTP2_ERR_HEADER_COMP
+ *     Previous inflation has failed.
+ */
+int nghttp2_hd_inflate_begin(nghttp2_hd_context *inflater, size_t blocklen,
+                             int copy_strings);
+
+/*
+ * Inflates the next piece of the header block stored in |in| with
+ * length |inlen|. The header representations are processed as long
+ * as they are complete in |in|. The |final| must be nonzero if |in|
+ * contains the end of the header block.
+ *
+ * This function returns the number of bytes consumed if it succeeds.
+ * The remaining bytes are the beginning of an incomplete header
+ * representation, and the caller must give them again with the
+ * following bytes. Otherwise, it returns one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory.
+ * NGHTTP2_ERR_HEADER_COMP
+ *     Inflation process has failed, or |final| is nonzero and the
+ *     header block ends in the middle of a header representation.
+ */
+ssize_t nghttp2_hd_inflate_partial(nghttp2_hd_context *inflater,
+                                   const uint8_t *in, size_t inlen,
+                                   int final);
+
+/*
+ * Finishes inflating the header block and stores the result in
+ * |*nva_ptr|. The lifetime of |*nva_ptr| is the same as the one of
+ * nghttp2_hd_inflate_hd().
+ *
+ * This function returns the number of name/value pairs in |*nva_ptr|
+ * if it succeeds, or one of the following negative error codes:
+ *
+ * NGHTTP2_ERR_HEADER_COMP
+ *     Inflation process has failed.
+ */
+ssize_t nghttp2_hd_inflate_finish(nghttp2_hd_context *inflater,
+                                  nghttp2_nv **nva_ptr);
 
 /*
  * Signals the end of processing one header block. This function
@@ -230,22 +481,22 @@ int nghttp2_hd_end_headers(nghttp2_hd_context *deflater_or_inflater);
 int nghttp2_hd_emit_indname_block(uint8_t **buf_ptr, size_t *buflen_ptr,
                                   size_t *offset_ptr, size_t index,
                                   const uint8_t *value, size_t valuelen,
-                                  int inc_indexing);
+                                  int inc_indexing, nghttp2_mem *mem);
 
 /* For unittesting purpose */
 int nghttp2_hd_emit_newname_block(uint8_t **buf_ptr, size_t *buflen_ptr,
                                   size_t *offset_ptr, nghttp2_nv *nv,
-                                  int inc_indexing);
+                                  int inc_indexing, nghttp2_mem *mem);
 
 /* For unittesting purpose */
 int nghttp2_hd_emit_subst_indname_block(uint8_t **buf_ptr, size_t *buflen_ptr,
                                         size_t *offset_ptr, size_t index,
                                         const uint8_t *value, size_t valuelen,
-                                        size_t subindex);
+                                        size_t subindex, nghttp2_mem *mem);
 
 /* For unittesting purpose */
 int nghttp2_hd_emit_subst_newname_block(uint8_t **buf_ptr, size_t *buflen_ptr,
                                         size_t *offset_ptr, nghttp2_nv *nv,
-                                        size_t subindex);
+                                        size_t subindex, nghttp2_mem *mem);
 
 #endif /* NGHTTP2_HD_COMP_H */
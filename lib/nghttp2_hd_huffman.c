@@ -0,0 +1,93 @@
+/*
+ * nghttp2 - HTTP/2.0 C Library
+ *
+ * Copyright (c) 2014 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "nghttp2_hd_huffman.h"
+
+size_t nghttp2_hd_huff_encode_count(const uint8_t *src, size_t srclen)
+{
+  size_t nbits = 0;
+  size_t i;
+  for(i = 0; i < srclen; ++i) {
+    nbits += nghttp2_huff_sym_table[src[i]].nbits;
+  }
+  return (nbits + 7) / 8;
+}
+
+size_t nghttp2_hd_huff_encode(uint8_t *dest, const uint8_t *src,
+                              size_t srclen)
+{
+  uint8_t *p = dest;
+  /* Pending bits are kept in the least significant |nbits| bits of
+     |acc|. The longest code is shorter than 32 bits, so |acc| never
+     holds more than 7 + 32 bits. */
+  uint64_t acc = 0;
+  size_t nbits = 0;
+  size_t i;
+  for(i = 0; i < srclen; ++i) {
+    const nghttp2_huff_sym *sym = &nghttp2_huff_sym_table[src[i]];
+    acc = (acc << sym->nbits) | sym->code;
+    nbits += sym->nbits;
+    while(nbits >= 8) {
+      nbits -= 8;
+      *p++ = (uint8_t)(acc >> nbits);
+    }
+  }
+  if(nbits) {
+    /* Pad with the most significant bits of EOS, which are all 1 */
+    *p++ = (uint8_t)((acc << (8 - nbits)) | (0xff >> nbits));
+  }
+  return p - dest;
+}
+
+ssize_t nghttp2_hd_huff_decode(uint8_t *dest, const uint8_t *src,
+                               size_t srclen)
+{
+  uint8_t *p = dest;
+  uint8_t state = 0;
+  int accepted = 1;
+  size_t i;
+  for(i = 0; i < srclen; ++i) {
+    const nghttp2_huff_decode *t;
+    t = &nghttp2_huff_decode_table[state][src[i] >> 4];
+    if(t->flags & NGHTTP2_HUFF_FAIL) {
+      return NGHTTP2_ERR_HEADER_COMP;
+    }
+    if(t->flags & NGHTTP2_HUFF_SYM) {
+      *p++ = t->sym;
+    }
+    t = &nghttp2_huff_decode_table[t->state][src[i] & 0xf];
+    if(t->flags & NGHTTP2_HUFF_FAIL) {
+      return NGHTTP2_ERR_HEADER_COMP;
+    }
+    if(t->flags & NGHTTP2_HUFF_SYM) {
+      *p++ = t->sym;
+    }
+    state = t->state;
+    accepted = (t->flags & NGHTTP2_HUFF_ACCEPTED) != 0;
+  }
+  if(!accepted) {
+    return NGHTTP2_ERR_HEADER_COMP;
+  }
+  return p - dest;
+}
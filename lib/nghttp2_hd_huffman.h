@@ -0,0 +1,105 @@
+/*
+ * nghttp2 - HTTP/2.0 C Library
+ *
+ * Copyright (c) 2014 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NGHTTP2_HD_HUFFMAN_H
+#define NGHTTP2_HD_HUFFMAN_H
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <nghttp2/nghttp2.h>
+
+/*
+ * Static Huffman code for header name and value literals. The code
+ * table and the decoding table are generated by mkhufftbl.py.
+ */
+
+/* The length of the shortest code in bits. */
+#define NGHTTP2_HUFF_MIN_CODE_LENGTH 4
+
+typedef enum {
+  /* The decoder is at a place where the input may end. It means
+     either at symbol boundary, or inside the padding which is the
+     prefix of EOS and is at most 7 bits. */
+  NGHTTP2_HUFF_ACCEPTED = 1,
+  /* The transition emits a symbol. */
+  NGHTTP2_HUFF_SYM = 1 << 1,
+  /* The input is invalid. EOS is decoded. */
+  NGHTTP2_HUFF_FAIL = 1 << 2
+} nghttp2_huff_decode_flag;
+
+typedef struct {
+  /* The number of bits in the code */
+  uint32_t nbits;
+  /* The code, stored in the least significant |nbits| bits */
+  uint32_t code;
+} nghttp2_huff_sym;
+
+typedef struct {
+  /* The next state. The state is the node of the Huffman tree the
+     decoder is at, and 0 is the root. */
+  uint8_t state;
+  /* Bitwise OR of nghttp2_huff_decode_flag */
+  uint8_t flags;
+  /* The emitted symbol if flags has NGHTTP2_HUFF_SYM */
+  uint8_t sym;
+} nghttp2_huff_decode;
+
+/* The code of each octet and EOS (symbol 256) */
+extern const nghttp2_huff_sym nghttp2_huff_sym_table[];
+
+/* The state transition table indexed by the current state and the
+   next 4 bits of input */
+extern const nghttp2_huff_decode nghttp2_huff_decode_table[][16];
+
+/*
+ * Returns the number of bytes required to encode |src| of length
+ * |srclen|, including the padding.
+ */
+size_t nghttp2_hd_huff_encode_count(const uint8_t *src, size_t srclen);
+
+/*
+ * Encodes |src| of length |srclen| into |dest|, padding the last
+ * byte with the most significant bits of EOS. The |dest| must have
+ * at least nghttp2_hd_huff_encode_count(src, srclen) bytes. This
+ * function returns the number of bytes written.
+ */
+size_t nghttp2_hd_huff_encode(uint8_t *dest, const uint8_t *src,
+                              size_t srclen);
+
+/*
+ * Decodes |src| of length |srclen| into |dest|. The |dest| must have
+ * at least srclen * 8 / NGHTTP2_HUFF_MIN_CODE_LENGTH bytes. This
+ * function returns the number of bytes written, or one of the
+ * following negative error codes:
+ *
+ * NGHTTP2_ERR_HEADER_COMP
+ *     The input contains EOS, or is not terminated at symbol
+ *     boundary followed by the valid padding.
+ */
+ssize_t nghttp2_hd_huff_decode(uint8_t *dest, const uint8_t *src,
+                               size_t srclen);
+
+#endif /* NGHTTP2_HD_HUFFMAN_H */
@@ -0,0 +1,5155 @@
+/*
+ * nghttp2 - HTTP/2.0 C Library
+ *
+ * Copyright (c) 2014 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* This file is generated by mkhufftbl.py. Do not edit. */
+#include "nghttp2_hd_huffman.h"
+
+/* The shortest code is 4 bits, and the longest code is 14 bits. */
+
+const nghttp2_huff_sym nghttp2_huff_sym_table[] = {
+  { 14, 0x3f52u },
+  { 14, 0x3f53u },
+  { 14, 0x3f54u },
+  { 14, 0x3f55u },
+  { 14, 0x3f56u },
+  { 14, 0x3f57u },
+  { 14, 0x3f58u },
+  { 14, 0x3f59u },
+  { 14, 0x3f5au },
+  { 14, 0x3f5bu },
+  { 14, 0x3f5cu },
+  { 14, 0x3f5du },
+  { 14, 0x3f5eu },
+  { 14, 0x3f5fu },
+  { 14, 0x3f60u },
+  { 14, 0x3f61u },
+  { 14, 0x3f62u },
+  { 14, 0x3f63u },
+  { 14, 0x3f64u },
+  { 14, 0x3f65u },
+  { 14, 0x3f66u },
+  { 14, 0x3f67u },
+  { 14, 0x3f68u },
+  { 14, 0x3f69u },
+  { 14, 0x3f6au },
+  { 14, 0x3f6bu },
+  { 14, 0x3f6cu },
+  { 14, 0x3f6du },
+  { 14, 0x3f6eu },
+  { 14, 0x3f6fu },
+  { 14, 0x3f70u },
+  { 14, 0x3f71u },
+  { 5, 0x6u },
+  { 14, 0x3f72u },
+  { 9, 0x1eau },
+  { 14, 0x3f73u },
+  { 14, 0x3f74u },
+  { 14, 0x3f75u },
+  { 10, 0x3ecu },
+  { 14, 0x3f76u },
+  { 8, 0xe6u },
+  { 8, 0xe7u },
+  { 9, 0x1ebu },
+  { 10, 0x3edu },
+  { 7, 0x64u },
+  { 6, 0x26u },
+  { 5, 0x7u },
+  { 5, 0x8u },
+  { 5, 0x9u },
+  { 5, 0xau },
+  { 6, 0x27u },
+  { 6, 0x28u },
+  { 7, 0x65u },
+  { 6, 0x29u },
+  { 7, 0x66u },
+  { 7, 0x67u },
+  { 7, 0x68u },
+  { 7, 0x69u },
+  { 7, 0x6au },
+  { 7, 0x6bu },
+  { 11, 0x7e4u },
+  { 6, 0x2au },
+  { 11, 0x7e5u },
+  { 11, 0x7e6u },
+  { 14, 0x3f77u },
+  { 8, 0xe8u },
+  { 9, 0x1ecu },
+  { 9, 0x1edu },
+  { 9, 0x1eeu },
+  { 8, 0xe9u },
+  { 9, 0x1efu },
+  { 7, 0x6cu },
+  { 8, 0xeau },
+  { 8, 0xebu },
+  { 9, 0x1f0u },
+  { 8, 0xecu },
+  { 9, 0x1f1u },
+  { 7, 0x6du },
+  { 9, 0x1f2u },
+  { 8, 0xedu },
+  { 9, 0x1f3u },
+  { 10, 0x3eeu },
+  { 10, 0x3efu },
+  { 7, 0x6eu },
+  { 7, 0x6fu },
+  { 9, 0x1f4u },
+  { 10, 0x3f0u },
+  { 8, 0xeeu },
+  { 9, 0x1f5u },
+  { 11, 0x7e7u },
+  { 10, 0x3f1u },
+  { 14, 0x3f78u },
+  { 14, 0x3f79u },
+  { 14, 0x3f7au },
+  { 14, 0x3f7bu },
+  { 8, 0xefu },
+  { 14, 0x3f7cu },
+  { 4, 0x0u },
+  { 7, 0x70u },
+  { 5, 0xbu },
+  { 6, 0x2bu },
+  { 4, 0x1u },
+  { 6, 0x2cu },
+  { 6, 0x2du },
+  { 6, 0x2eu },
+  { 5, 0xcu },
+  { 8, 0xf0u },
+  { 7, 0x71u },
+  { 5, 0xdu },
+  { 6, 0x2fu },
+  { 5, 0xeu },
+  { 5, 0xfu },
+  { 5, 0x10u },
+  { 8, 0xf1u },
+  { 5, 0x11u },
+  { 5, 0x12u },
+  { 4, 0x2u },
+  { 6, 0x30u },
+  { 8, 0xf2u },
+  { 7, 0x72u },
+  { 6, 0x31u },
+  { 8, 0xf3u },
+  { 8, 0xf4u },
+  { 14, 0x3f7du },
+  { 11, 0x7e8u },
+  { 14, 0x3f7eu },
+  { 11, 0x7e9u },
+  { 14, 0x3f7fu },
+  { 14, 0x3f80u },
+  { 14, 0x3f81u },
+  { 14, 0x3f82u },
+  { 14, 0x3f83u },
+  { 14, 0x3f84u },
+  { 14, 0x3f85u },
+  { 14, 0x3f86u },
+  { 14, 0x3f87u },
+  { 14, 0x3f88u },
+  { 14, 0x3f89u },
+  { 14, 0x3f8au },
+  { 14, 0x3f8bu },
+  { 14, 0x3f8cu },
+  { 14, 0x3f8du },
+  { 14, 0x3f8eu },
+  { 14, 0x3f8fu },
+  { 14, 0x3f90u },
+  { 14, 0x3f91u },
+  { 14, 0x3f92u },
+  { 14, 0x3f93u },
+  { 14, 0x3f94u },
+  { 14, 0x3f95u },
+  { 14, 0x3f96u },
+  { 14, 0x3f97u },
+  { 14, 0x3f98u },
+  { 14, 0x3f99u },
+  { 14, 0x3f9au },
+  { 14, 0x3f9bu },
+  { 14, 0x3f9cu },
+  { 14, 0x3f9du },
+  { 14, 0x3f9eu },
+  { 14, 0x3f9fu },
+  { 14, 0x3fa0u },
+  { 14, 0x3fa1u },
+  { 14, 0x3fa2u },
+  { 14, 0x3fa3u },
+  { 14, 0x3fa4u },
+  { 14, 0x3fa5u },
+  { 14, 0x3fa6u },
+  { 14, 0x3fa7u },
+  { 14, 0x3fa8u },
+  { 14, 0x3fa9u },
+  { 14, 0x3faau },
+  { 14, 0x3fabu },
+  { 14, 0x3facu },
+  { 14, 0x3fadu },
+  { 14, 0x3faeu },
+  { 14, 0x3fafu },
+  { 14, 0x3fb0u },
+  { 14, 0x3fb1u },
+  { 14, 0x3fb2u },
+  { 14, 0x3fb3u },
+  { 14, 0x3fb4u },
+  { 14, 0x3fb5u },
+  { 14, 0x3fb6u },
+  { 14, 0x3fb7u },
+  { 14, 0x3fb8u },
+  { 14, 0x3fb9u },
+  { 14, 0x3fbau },
+  { 14, 0x3fbbu },
+  { 14, 0x3fbcu },
+  { 14, 0x3fbdu },
+  { 14, 0x3fbeu },
+  { 14, 0x3fbfu },
+  { 14, 0x3fc0u },
+  { 14, 0x3fc1u },
+  { 14, 0x3fc2u },
+  { 14, 0x3fc3u },
+  { 14, 0x3fc4u },
+  { 14, 0x3fc5u },
+  { 14, 0x3fc6u },
+  { 14, 0x3fc7u },
+  { 14, 0x3fc8u },
+  { 14, 0x3fc9u },
+  { 14, 0x3fcau },
+  { 14, 0x3fcbu },
+  { 14, 0x3fccu },
+  { 14, 0x3fcdu },
+  { 14, 0x3fceu },
+  { 14, 0x3fcfu },
+  { 14, 0x3fd0u },
+  { 14, 0x3fd1u },
+  { 14, 0x3fd2u },
+  { 14, 0x3fd3u },
+  { 14, 0x3fd4u },
+  { 14, 0x3fd5u },
+  { 14, 0x3fd6u },
+  { 14, 0x3fd7u },
+  { 14, 0x3fd8u },
+  { 14, 0x3fd9u },
+  { 14, 0x3fdau },
+  { 14, 0x3fdbu },
+  { 14, 0x3fdcu },
+  { 14, 0x3fddu },
+  { 14, 0x3fdeu },
+  { 14, 0x3fdfu },
+  { 14, 0x3fe0u },
+  { 14, 0x3fe1u },
+  { 14, 0x3fe2u },
+  { 14, 0x3fe3u },
+  { 14, 0x3fe4u },
+  { 14, 0x3fe5u },
+  { 14, 0x3fe6u },
+  { 14, 0x3fe7u },
+  { 14, 0x3fe8u },
+  { 14, 0x3fe9u },
+  { 14, 0x3feau },
+  { 14, 0x3febu },
+  { 14, 0x3fecu },
+  { 14, 0x3fedu },
+  { 14, 0x3feeu },
+  { 14, 0x3fefu },
+  { 14, 0x3ff0u },
+  { 14, 0x3ff1u },
+  { 14, 0x3ff2u },
+  { 14, 0x3ff3u },
+  { 14, 0x3ff4u },
+  { 14, 0x3ff5u },
+  { 14, 0x3ff6u },
+  { 14, 0x3ff7u },
+  { 14, 0x3ff8u },
+  { 14, 0x3ff9u },
+  { 14, 0x3ffau },
+  { 14, 0x3ffbu },
+  { 14, 0x3ffcu },
+  { 14, 0x3ffdu },
+  { 14, 0x3ffeu },
+  { 13, 0x1fa8u },
+  { 14, 0x3fffu }
+};
+
+const nghttp2_huff_decode nghttp2_huff_decode_table[][16] = {
+  /* 0 */
+  {
+    { 0, 0x03, 97 },
+    { 0, 0x03, 101 },
+    { 0, 0x03, 116 },
+    { 15, 0x00, 0 },
+    { 16, 0x00, 0 },
+    { 17, 0x00, 0 },
+    { 18, 0x00, 0 },
+    { 19, 0x00, 0 },
+    { 20, 0x00, 0 },
+    { 21, 0x00, 0 },
+    { 22, 0x00, 0 },
+    { 23, 0x00, 0 },
+    { 24, 0x00, 0 },
+    { 25, 0x00, 0 },
+    { 26, 0x00, 0 },
+    { 27, 0x01, 0 }
+  },
+  /* 1 */
+  {
+    { 1, 0x02, 97 },
+    { 2, 0x03, 97 },
+    { 1, 0x02, 101 },
+    { 2, 0x03, 101 },
+    { 1, 0x02, 116 },
+    { 2, 0x03, 116 },
+    { 0, 0x03, 32 },
+    { 0, 0x03, 46 },
+    { 0, 0x03, 47 },
+    { 0, 0x03, 48 },
+    { 0, 0x03, 49 },
+    { 0, 0x03, 99 },
+    { 0, 0x03, 105 },
+    { 0, 0x03, 108 },
+    { 0, 0x03, 110 },
+    { 0, 0x03, 111 }
+  },
+  /* 2 */
+  {
+    { 0, 0x03, 112 },
+    { 0, 0x03, 114 },
+    { 0, 0x03, 115 },
+    { 28, 0x00, 0 },
+    { 29, 0x00, 0 },
+    { 30, 0x00, 0 },
+    { 31, 0x00, 0 },
+    { 32, 0x00, 0 },
+    { 33, 0x00, 0 },
+    { 34, 0x00, 0 },
+    { 35, 0x00, 0 },
+    { 36, 0x00, 0 },
+    { 37, 0x00, 0 },
+    { 38, 0x00, 0 },
+    { 39, 0x00, 0 },
+    { 40, 0x01, 0 }
+  },
+  /* 3 */
+  {
+    { 3, 0x02, 97 },
+    { 4, 0x02, 97 },
+    { 5, 0x02, 97 },
+    { 6, 0x03, 97 },
+    { 3, 0x02, 101 },
+    { 4, 0x02, 101 },
+    { 5, 0x02, 101 },
+    { 6, 0x03, 101 },
+    { 3, 0x02, 116 },
+    { 4, 0x02, 116 },
+    { 5, 0x02, 116 },
+    { 6, 0x03, 116 },
+    { 1, 0x02, 32 },
+    { 2, 0x03, 32 },
+    { 1, 0x02, 46 },
+    { 2, 0x03, 46 }
+  },
+  /* 4 */
+  {
+    { 1, 0x02, 47 },
+    { 2, 0x03, 47 },
+    { 1, 0x02, 48 },
+    { 2, 0x03, 48 },
+    { 1, 0x02, 49 },
+    { 2, 0x03, 49 },
+    { 1, 0x02, 99 },
+    { 2, 0x03, 99 },
+    { 1, 0x02, 105 },
+    { 2, 0x03, 105 },
+    { 1, 0x02, 108 },
+    { 2, 0x03, 108 },
+    { 1, 0x02, 110 },
+    { 2, 0x03, 110 },
+    { 1, 0x02, 111 },
+    { 2, 0x03, 111 }
+  },
+  /* 5 */
+  {
+    { 1, 0x02, 112 },
+    { 2, 0x03, 112 },
+    { 1, 0x02, 114 },
+    { 2, 0x03, 114 },
+    { 1, 0x02, 115 },
+    { 2, 0x03, 115 },
+    { 0, 0x03, 45 },
+    { 0, 0x03, 50 },
+    { 0, 0x03, 51 },
+    { 0, 0x03, 53 },
+    { 0, 0x03, 61 },
+    { 0, 0x03, 100 },
+    { 0, 0x03, 102 },
+    { 0, 0x03, 103 },
+    { 0, 0x03, 104 },
+    { 0, 0x03, 109 }
+  },
+  /* 6 */
+  {
+    { 0, 0x03, 117 },
+    { 0, 0x03, 120 },
+    { 41, 0x00, 0 },
+    { 42, 0x00, 0 },
+    { 43, 0x00, 0 },
+    { 44, 0x00, 0 },
+    { 45, 0x00, 0 },
+    { 46, 0x00, 0 },
+    { 47, 0x00, 0 },
+    { 48, 0x00, 0 },
+    { 49, 0x00, 0 },
+    { 50, 0x00, 0 },
+    { 51, 0x00, 0 },
+    { 52, 0x00, 0 },
+    { 53, 0x00, 0 },
+    { 54, 0x01, 0 }
+  },
+  /* 7 */
+  {
+    { 7, 0x02, 97 },
+    { 8, 0x02, 97 },
+    { 9, 0x02, 97 },
+    { 10, 0x02, 97 },
+    { 11, 0x02, 97 },
+    { 12, 0x02, 97 },
+    { 13, 0x02, 97 },
+    { 14, 0x03, 97 },
+    { 7, 0x02, 101 },
+    { 8, 0x02, 101 },
+    { 9, 0x02, 101 },
+    { 10, 0x02, 101 },
+    { 11, 0x02, 101 },
+    { 12, 0x02, 101 },
+    { 13, 0x02, 101 },
+    { 14, 0x03, 101 }
+  },
+  /* 8 */
+  {
+    { 7, 0x02, 116 },
+    { 8, 0x02, 116 },
+    { 9, 0x02, 116 },
+    { 10, 0x02, 116 },
+    { 11, 0x02, 116 },
+    { 12, 0x02, 116 },
+    { 13, 0x02, 116 },
+    { 14, 0x03, 116 },
+    { 3, 0x02, 32 },
+    { 4, 0x02, 32 },
+    { 5, 0x02, 32 },
+    { 6, 0x03, 32 },
+    { 3, 0x02, 46 },
+    { 4, 0x02, 46 },
+    { 5, 0x02, 46 },
+    { 6, 0x03, 46 }
+  },
+  /* 9 */
+  {
+    { 3, 0x02, 47 },
+    { 4, 0x02, 47 },
+    { 5, 0x02, 47 },
+    { 6, 0x03, 47 },
+    { 3, 0x02, 48 },
+    { 4, 0x02, 48 },
+    { 5, 0x02, 48 },
+    { 6, 0x03, 48 },
+    { 3, 0x02, 49 },
+    { 4, 0x02, 49 },
+    { 5, 0x02, 49 },
+    { 6, 0x03, 49 },
+    { 3, 0x02, 99 },
+    { 4, 0x02, 99 },
+    { 5, 0x02, 99 },
+    { 6, 0x03, 99 }
+  },
+  /* 10 */
+  {
+    { 3, 0x02, 105 },
+    { 4, 0x02, 105 },
+    { 5, 0x02, 105 },
+    { 6, 0x03, 105 },
+    { 3, 0x02, 108 },
+    { 4, 0x02, 108 },
+    { 5, 0x02, 108 },
+    { 6, 0x03, 108 },
+    { 3, 0x02, 110 },
+    { 4, 0x02, 110 },
+    { 5, 0x02, 110 },
+    { 6, 0x03, 110 },
+    { 3, 0x02, 111 },
+    { 4, 0x02, 111 },
+    { 5, 0x02, 111 },
+    { 6, 0x03, 111 }
+  },
+  /* 11 */
+  {
+    { 3, 0x02, 112 },
+    { 4, 0x02, 112 },
+    { 5, 0x02, 112 },
+    { 6, 0x03, 112 },
+    { 3, 0x02, 114 },
+    { 4, 0x02, 114 },
+    { 5, 0x02, 114 },
+    { 6, 0x03, 114 },
+    { 3, 0x02, 115 },
+    { 4, 0x02, 115 },
+    { 5, 0x02, 115 },
+    { 6, 0x03, 115 },
+    { 1, 0x02, 45 },
+    { 2, 0x03, 45 },
+    { 1, 0x02, 50 },
+    { 2, 0x03, 50 }
+  },
+  /* 12 */
+  {
+    { 1, 0x02, 51 },
+    { 2, 0x03, 51 },
+    { 1, 0x02, 53 },
+    { 2, 0x03, 53 },
+    { 1, 0x02, 61 },
+    { 2, 0x03, 61 },
+    { 1, 0x02, 100 },
+    { 2, 0x03, 100 },
+    { 1, 0x02, 102 },
+    { 2, 0x03, 102 },
+    { 1, 0x02, 103 },
+    { 2, 0x03, 103 },
+    { 1, 0x02, 104 },
+    { 2, 0x03, 104 },
+    { 1, 0x02, 109 },
+    { 2, 0x03, 109 }
+  },
+  /* 13 */
+  {
+    { 1, 0x02, 117 },
+    { 2, 0x03, 117 },
+    { 1, 0x02, 120 },
+    { 2, 0x03, 120 },
+    { 0, 0x03, 44 },
+    { 0, 0x03, 52 },
+    { 0, 0x03, 54 },
+    { 0, 0x03, 55 },
+    { 0, 0x03, 56 },
+    { 0, 0x03, 57 },
+    { 0, 0x03, 58 },
+    { 0, 0x03, 59 },
+    { 0, 0x03, 71 },
+    { 0, 0x03, 77 },
+    { 0, 0x03, 83 },
+    { 0, 0x03, 84 }
+  },
+  /* 14 */
+  {
+    { 0, 0x03, 98 },
+    { 0, 0x03, 107 },
+    { 0, 0x03, 119 },
+    { 55, 0x00, 0 },
+    { 56, 0x00, 0 },
+    { 57, 0x00, 0 },
+    { 58, 0x00, 0 },
+    { 59, 0x00, 0 },
+    { 60, 0x00, 0 },
+    { 61, 0x00, 0 },
+    { 62, 0x00, 0 },
+    { 63, 0x00, 0 },
+    { 64, 0x00, 0 },
+    { 65, 0x00, 0 },
+    { 66, 0x00, 0 },
+    { 67, 0x01, 0 }
+  },
+  /* 15 */
+  {
+    { 7, 0x02, 32 },
+    { 8, 0x02, 32 },
+    { 9, 0x02, 32 },
+    { 10, 0x02, 32 },
+    { 11, 0x02, 32 },
+    { 12, 0x02, 32 },
+    { 13, 0x02, 32 },
+    { 14, 0x03, 32 },
+    { 7, 0x02, 46 },
+    { 8, 0x02, 46 },
+    { 9, 0x02, 46 },
+    { 10, 0x02, 46 },
+    { 11, 0x02, 46 },
+    { 12, 0x02, 46 },
+    { 13, 0x02, 46 },
+    { 14, 0x03, 46 }
+  },
+  /* 16 */
+  {
+    { 7, 0x02, 47 },
+    { 8, 0x02, 47 },
+    { 9, 0x02, 47 },
+    { 10, 0x02, 47 },
+    { 11, 0x02, 47 },
+    { 12, 0x02, 47 },
+    { 13, 0x02, 47 },
+    { 14, 0x03, 47 },
+    { 7, 0x02, 48 },
+    { 8, 0x02, 48 },
+    { 9, 0x02, 48 },
+    { 10, 0x02, 48 },
+    { 11, 0x02, 48 },
+    { 12, 0x02, 48 },
+    { 13, 0x02, 48 },
+    { 14, 0x03, 48 }
+  },
+  /* 17 */
+  {
+    { 7, 0x02, 49 },
+    { 8, 0x02, 49 },
+    { 9, 0x02, 49 },
+    { 10, 0x02, 49 },
+    { 11, 0x02, 49 },
+    { 12, 0x02, 49 },
+    { 13, 0x02, 49 },
+    { 14, 0x03, 49 },
+    { 7, 0x02, 99 },
+    { 8, 0x02, 99 },
+    { 9, 0x02, 99 },
+    { 10, 0x02, 99 },
+    { 11, 0x02, 99 },
+    { 12, 0x02, 99 },
+    { 13, 0x02, 99 },
+    { 14, 0x03, 99 }
+  },
+  /* 18 */
+  {
+    { 7, 0x02, 105 },
+    { 8, 0x02, 105 },
+    { 9, 0x02, 105 },
+    { 10, 0x02, 105 },
+    { 11, 0x02, 105 },
+    { 12, 0x02, 105 },
+    { 13, 0x02, 105 },
+    { 14, 0x03, 105 },
+    { 7, 0x02, 108 },
+    { 8, 0x02, 108 },
+    { 9, 0x02, 108 },
+    { 10, 0x02, 108 },
+    { 11, 0x02, 108 },
+    { 12, 0x02, 108 },
+    { 13, 0x02, 108 },
+    { 14, 0x03, 108 }
+  },
+  /* 19 */
+  {
+    { 7, 0x02, 110 },
+    { 8, 0x02, 110 },
+    { 9, 0x02, 110 },
+    { 10, 0x02, 110 },
+    { 11, 0x02, 110 },
+    { 12, 0x02, 110 },
+    { 13, 0x02, 110 },
+    { 14, 0x03, 110 },
+    { 7, 0x02, 111 },
+    { 8, 0x02, 111 },
+    { 9, 0x02, 111 },
+    { 10, 0x02, 111 },
+    { 11, 0x02, 111 },
+    { 12, 0x02, 111 },
+    { 13, 0x02, 111 },
+    { 14, 0x03, 111 }
+  },
+  /* 20 */
+  {
+    { 7, 0x02, 112 },
+    { 8, 0x02, 112 },
+    { 9, 0x02, 112 },
+    { 10, 0x02, 112 },
+    { 11, 0x02, 112 },
+    { 12, 0x02, 112 },
+    { 13, 0x02, 112 },
+    { 14, 0x03, 112 },
+    { 7, 0x02, 114 },
+    { 8, 0x02, 114 },
+    { 9, 0x02, 114 },
+    { 10, 0x02, 114 },
+    { 11, 0x02, 114 },
+    { 12, 0x02, 114 },
+    { 13, 0x02, 114 },
+    { 14, 0x03, 114 }
+  },
+  /* 21 */
+  {
+    { 7, 0x02, 115 },
+    { 8, 0x02, 115 },
+    { 9, 0x02, 115 },
+    { 10, 0x02, 115 },
+    { 11, 0x02, 115 },
+    { 12, 0x02, 115 },
+    { 13, 0x02, 115 },
+    { 14, 0x03, 115 },
+    { 3, 0x02, 45 },
+    { 4, 0x02, 45 },
+    { 5, 0x02, 45 },
+    { 6, 0x03, 45 },
+    { 3, 0x02, 50 },
+    { 4, 0x02, 50 },
+    { 5, 0x02, 50 },
+    { 6, 0x03, 50 }
+  },
+  /* 22 */
+  {
+    { 3, 0x02, 51 },
+    { 4, 0x02, 51 },
+    { 5, 0x02, 51 },
+    { 6, 0x03, 51 },
+    { 3, 0x02, 53 },
+    { 4, 0x02, 53 },
+    { 5, 0x02, 53 },
+    { 6, 0x03, 53 },
+    { 3, 0x02, 61 },
+    { 4, 0x02, 61 },
+    { 5, 0x02, 61 },
+    { 6, 0x03, 61 },
+    { 3, 0x02, 100 },
+    { 4, 0x02, 100 },
+    { 5, 0x02, 100 },
+    { 6, 0x03, 100 }
+  },
+  /* 23 */
+  {
+    { 3, 0x02, 102 },
+    { 4, 0x02, 102 },
+    { 5, 0x02, 102 },
+    { 6, 0x03, 102 },
+    { 3, 0x02, 103 },
+    { 4, 0x02, 103 },
+    { 5, 0x02, 103 },
+    { 6, 0x03, 103 },
+    { 3, 0x02, 104 },
+    { 4, 0x02, 104 },
+    { 5, 0x02, 104 },
+    { 6, 0x03, 104 },
+    { 3, 0x02, 109 },
+    { 4, 0x02, 109 },
+    { 5, 0x02, 109 },
+    { 6, 0x03, 109 }
+  },
+  /* 24 */
+  {
+    { 3, 0x02, 117 },
+    { 4, 0x02, 117 },
+    { 5, 0x02, 117 },
+    { 6, 0x03, 117 },
+    { 3, 0x02, 120 },
+    { 4, 0x02, 120 },
+    { 5, 0x02, 120 },
+    { 6, 0x03, 120 },
+    { 1, 0x02, 44 },
+    { 2, 0x03, 44 },
+    { 1, 0x02, 52 },
+    { 2, 0x03, 52 },
+    { 1, 0x02, 54 },
+    { 2, 0x03, 54 },
+    { 1, 0x02, 55 },
+    { 2, 0x03, 55 }
+  },
+  /* 25 */
+  {
+    { 1, 0x02, 56 },
+    { 2, 0x03, 56 },
+    { 1, 0x02, 57 },
+    { 2, 0x03, 57 },
+    { 1, 0x02, 58 },
+    { 2, 0x03, 58 },
+    { 1, 0x02, 59 },
+    { 2, 0x03, 59 },
+    { 1, 0x02, 71 },
+    { 2, 0x03, 71 },
+    { 1, 0x02, 77 },
+    { 2, 0x03, 77 },
+    { 1, 0x02, 83 },
+    { 2, 0x03, 83 },
+    { 1, 0x02, 84 },
+    { 2, 0x03, 84 }
+  },
+  /* 26 */
+  {
+    { 1, 0x02, 98 },
+    { 2, 0x03, 98 },
+    { 1, 0x02, 107 },
+    { 2, 0x03, 107 },
+    { 1, 0x02, 119 },
+    { 2, 0x03, 119 },
+    { 0, 0x03, 40 },
+    { 0, 0x03, 41 },
+    { 0, 0x03, 65 },
+    { 0, 0x03, 69 },
+    { 0, 0x03, 72 },
+    { 0, 0x03, 73 },
+    { 0, 0x03, 75 },
+    { 0, 0x03, 79 },
+    { 0, 0x03, 87 },
+    { 0, 0x03, 95 }
+  },
+  /* 27 */
+  {
+    { 0, 0x03, 106 },
+    { 0, 0x03, 113 },
+    { 0, 0x03, 118 },
+    { 0, 0x03, 121 },
+    { 0, 0x03, 122 },
+    { 68, 0x00, 0 },
+    { 69, 0x00, 0 },
+    { 70, 0x00, 0 },
+    { 71, 0x00, 0 },
+    { 72, 0x00, 0 },
+    { 73, 0x00, 0 },
+    { 74, 0x00, 0 },
+    { 75, 0x00, 0 },
+    { 76, 0x00, 0 },
+    { 77, 0x00, 0 },
+    { 78, 0x00, 0 }
+  },
+  /* 28 */
+  {
+    { 7, 0x02, 45 },
+    { 8, 0x02, 45 },
+    { 9, 0x02, 45 },
+    { 10, 0x02, 45 },
+    { 11, 0x02, 45 },
+    { 12, 0x02, 45 },
+    { 13, 0x02, 45 },
+    { 14, 0x03, 45 },
+    { 7, 0x02, 50 },
+    { 8, 0x02, 50 },
+    { 9, 0x02, 50 },
+    { 10, 0x02, 50 },
+    { 11, 0x02, 50 },
+    { 12, 0x02, 50 },
+    { 13, 0x02, 50 },
+    { 14, 0x03, 50 }
+  },
+  /* 29 */
+  {
+    { 7, 0x02, 51 },
+    { 8, 0x02, 51 },
+    { 9, 0x02, 51 },
+    { 10, 0x02, 51 },
+    { 11, 0x02, 51 },
+    { 12, 0x02, 51 },
+    { 13, 0x02, 51 },
+    { 14, 0x03, 51 },
+    { 7, 0x02, 53 },
+    { 8, 0x02, 53 },
+    { 9, 0x02, 53 },
+    { 10, 0x02, 53 },
+    { 11, 0x02, 53 },
+    { 12, 0x02, 53 },
+    { 13, 0x02, 53 },
+    { 14, 0x03, 53 }
+  },
+  /* 30 */
+  {
+    { 7, 0x02, 61 },
+    { 8, 0x02, 61 },
+    { 9, 0x02, 61 },
+    { 10, 0x02, 61 },
+    { 11, 0x02, 61 },
+    { 12, 0x02, 61 },
+    { 13, 0x02, 61 },
+    { 14, 0x03, 61 },
+    { 7, 0x02, 100 },
+    { 8, 0x02, 100 },
+    { 9, 0x02, 100 },
+    { 10, 0x02, 100 },
+    { 11, 0x02, 100 },
+    { 12, 0x02, 100 },
+    { 13, 0x02, 100 },
+    { 14, 0x03, 100 }
+  },
+  /* 31 */
+  {
+    { 7, 0x02, 102 },
+    { 8, 0x02, 102 },
+    { 9, 0x02, 102 },
+    { 10, 0x02, 102 },
+    { 11, 0x02, 102 },
+    { 12, 0x02, 102 },
+    { 13, 0x02, 102 },
+    { 14, 0x03, 102 },
+    { 7, 0x02, 103 },
+    { 8, 0x02, 103 },
+    { 9, 0x02, 103 },
+    { 10, 0x02, 103 },
+    { 11, 0x02, 103 },
+    { 12, 0x02, 103 },
+    { 13, 0x02, 103 },
+    { 14, 0x03, 103 }
+  },
+  /* 32 */
+  {
+    { 7, 0x02, 104 },
+    { 8, 0x02, 104 },
+    { 9, 0x02, 104 },
+    { 10, 0x02, 104 },
+    { 11, 0x02, 104 },
+    { 12, 0x02, 104 },
+    { 13, 0x02, 104 },
+    { 14, 0x03, 104 },
+    { 7, 0x02, 109 },
+    { 8, 0x02, 109 },
+    { 9, 0x02, 109 },
+    { 10, 0x02, 109 },
+    { 11, 0x02, 109 },
+    { 12, 0x02, 109 },
+    { 13, 0x02, 109 },
+    { 14, 0x03, 109 }
+  },
+  /* 33 */
+  {
+    { 7, 0x02, 117 },
+    { 8, 0x02, 117 },
+    { 9, 0x02, 117 },
+    { 10, 0x02, 117 },
+    { 11, 0x02, 117 },
+    { 12, 0x02, 117 },
+    { 13, 0x02, 117 },
+    { 14, 0x03, 117 },
+    { 7, 0x02, 120 },
+    { 8, 0x02, 120 },
+    { 9, 0x02, 120 },
+    { 10, 0x02, 120 },
+    { 11, 0x02, 120 },
+    { 12, 0x02, 120 },
+    { 13, 0x02, 120 },
+    { 14, 0x03, 120 }
+  },
+  /* 34 */
+  {
+    { 3, 0x02, 44 },
+    { 4, 0x02, 44 },
+    { 5, 0x02, 44 },
+    { 6, 0x03, 44 },
+    { 3, 0x02, 52 },
+    { 4, 0x02, 52 },
+    { 5, 0x02, 52 },
+    { 6, 0x03, 52 },
+    { 3, 0x02, 54 },
+    { 4, 0x02, 54 },
+    { 5, 0x02, 54 },
+    { 6, 0x03, 54 },
+    { 3, 0x02, 55 },
+    { 4, 0x02, 55 },
+    { 5, 0x02, 55 },
+    { 6, 0x03, 55 }
+  },
+  /* 35 */
+  {
+    { 3, 0x02, 56 },
+    { 4, 0x02, 56 },
+    { 5, 0x02, 56 },
+    { 6, 0x03, 56 },
+    { 3, 0x02, 57 },
+    { 4, 0x02, 57 },
+    { 5, 0x02, 57 },
+    { 6, 0x03, 57 },
+    { 3, 0x02, 58 },
+    { 4, 0x02, 58 },
+    { 5, 0x02, 58 },
+    { 6, 0x03, 58 },
+    { 3, 0x02, 59 },
+    { 4, 0x02, 59 },
+    { 5, 0x02, 59 },
+    { 6, 0x03, 59 }
+  },
+  /* 36 */
+  {
+    { 3, 0x02, 71 },
+    { 4, 0x02, 71 },
+    { 5, 0x02, 71 },
+    { 6, 0x03, 71 },
+    { 3, 0x02, 77 },
+    { 4, 0x02, 77 },
+    { 5, 0x02, 77 },
+    { 6, 0x03, 77 },
+    { 3, 0x02, 83 },
+    { 4, 0x02, 83 },
+    { 5, 0x02, 83 },
+    { 6, 0x03, 83 },
+    { 3, 0x02, 84 },
+    { 4, 0x02, 84 },
+    { 5, 0x02, 84 },
+    { 6, 0x03, 84 }
+  },
+  /* 37 */
+  {
+    { 3, 0x02, 98 },
+    { 4, 0x02, 98 },
+    { 5, 0x02, 98 },
+    { 6, 0x03, 98 },
+    { 3, 0x02, 107 },
+    { 4, 0x02, 107 },
+    { 5, 0x02, 107 },
+    { 6, 0x03, 107 },
+    { 3, 0x02, 119 },
+    { 4, 0x02, 119 },
+    { 5, 0x02, 119 },
+    { 6, 0x03, 119 },
+    { 1, 0x02, 40 },
+    { 2, 0x03, 40 },
+    { 1, 0x02, 41 },
+    { 2, 0x03, 41 }
+  },
+  /* 38 */
+  {
+    { 1, 0x02, 65 },
+    { 2, 0x03, 65 },
+    { 1, 0x02, 69 },
+    { 2, 0x03, 69 },
+    { 1, 0x02, 72 },
+    { 2, 0x03, 72 },
+    { 1, 0x02, 73 },
+    { 2, 0x03, 73 },
+    { 1, 0x02, 75 },
+    { 2, 0x03, 75 },
+    { 1, 0x02, 79 },
+    { 2, 0x03, 79 },
+    { 1, 0x02, 87 },
+    { 2, 0x03, 87 },
+    { 1, 0x02, 95 },
+    { 2, 0x03, 95 }
+  },
+  /* 39 */
+  {
+    { 1, 0x02, 106 },
+    { 2, 0x03, 106 },
+    { 1, 0x02, 113 },
+    { 2, 0x03, 113 },
+    { 1, 0x02, 118 },
+    { 2, 0x03, 118 },
+    { 1, 0x02, 121 },
+    { 2, 0x03, 121 },
+    { 1, 0x02, 122 },
+    { 2, 0x03, 122 },
+    { 0, 0x03, 34 },
+    { 0, 0x03, 42 },
+    { 0, 0x03, 66 },
+    { 0, 0x03, 67 },
+    { 0, 0x03, 68 },
+    { 0, 0x03, 70 }
+  },
+  /* 40 */
+  {
+    { 0, 0x03, 74 },
+    { 0, 0x03, 76 },
+    { 0, 0x03, 78 },
+    { 0, 0x03, 80 },
+    { 0, 0x03, 85 },
+    { 0, 0x03, 88 },
+    { 79, 0x00, 0 },
+    { 80, 0x00, 0 },
+    { 81, 0x00, 0 },
+    { 82, 0x00, 0 },
+    { 83, 0x00, 0 },
+    { 84, 0x00, 0 },
+    { 85, 0x00, 0 },
+    { 86, 0x00, 0 },
+    { 87, 0x00, 0 },
+    { 88, 0x00, 0 }
+  },
+  /* 41 */
+  {
+    { 7, 0x02, 44 },
+    { 8, 0x02, 44 },
+    { 9, 0x02, 44 },
+    { 10, 0x02, 44 },
+    { 11, 0x02, 44 },
+    { 12, 0x02, 44 },
+    { 13, 0x02, 44 },
+    { 14, 0x03, 44 },
+    { 7, 0x02, 52 },
+    { 8, 0x02, 52 },
+    { 9, 0x02, 52 },
+    { 10, 0x02, 52 },
+    { 11, 0x02, 52 },
+    { 12, 0x02, 52 },
+    { 13, 0x02, 52 },
+    { 14, 0x03, 52 }
+  },
+  /* 42 */
+  {
+    { 7, 0x02, 54 },
+    { 8, 0x02, 54 },
+    { 9, 0x02, 54 },
+    { 10, 0x02, 54 },
+    { 11, 0x02, 54 },
+    { 12, 0x02, 54 },
+    { 13, 0x02, 54 },
+    { 14, 0x03, 54 },
+    { 7, 0x02, 55 },
+    { 8, 0x02, 55 },
+    { 9, 0x02, 55 },
+    { 10, 0x02, 55 },
+    { 11, 0x02, 55 },
+    { 12, 0x02, 55 },
+    { 13, 0x02, 55 },
+    { 14, 0x03, 55 }
+  },
+  /* 43 */
+  {
+    { 7, 0x02, 56 },
+    { 8, 0x02, 56 },
+    { 9, 0x02, 56 },
+    { 10, 0x02, 56 },
+    { 11, 0x02, 56 },
+    { 12, 0x02, 56 },
+    { 13, 0x02, 56 },
+    { 14, 0x03, 56 },
+    { 7, 0x02, 57 },
+    { 8, 0x02, 57 },
+    { 9, 0x02, 57 },
+    { 10, 0x02, 57 },
+    { 11, 0x02, 57 },
+    { 12, 0x02, 57 },
+    { 13, 0x02, 57 },
+    { 14, 0x03, 57 }
+  },
+  /* 44 */
+  {
+    { 7, 0x02, 58 },
+    { 8, 0x02, 58 },
+    { 9, 0x02, 58 },
+    { 10, 0x02, 58 },
+    { 11, 0x02, 58 },
+    { 12, 0x02, 58 },
+    { 13, 0x02, 58 },
+    { 14, 0x03, 58 },
+    { 7, 0x02, 59 },
+    { 8, 0x02, 59 },
+    { 9, 0x02, 59 },
+    { 10, 0x02, 59 },
+    { 11, 0x02, 59 },
+    { 12, 0x02, 59 },
+    { 13, 0x02, 59 },
+    { 14, 0x03, 59 }
+  },
+  /* 45 */
+  {
+    { 7, 0x02, 71 },
+    { 8, 0x02, 71 },
+    { 9, 0x02, 71 },
+    { 10, 0x02, 71 },
+    { 11, 0x02, 71 },
+    { 12, 0x02, 71 },
+    { 13, 0x02, 71 },
+    { 14, 0x03, 71 },
+    { 7, 0x02, 77 },
+    { 8, 0x02, 77 },
+    { 9, 0x02, 77 },
+    { 10, 0x02, 77 },
+    { 11, 0x02, 77 },
+    { 12, 0x02, 77 },
+    { 13, 0x02, 77 },
+    { 14, 0x03, 77 }
+  },
+  /* 46 */
+  {
+    { 7, 0x02, 83 },
+    { 8, 0x02, 83 },
+    { 9, 0x02, 83 },
+    { 10, 0x02, 83 },
+    { 11, 0x02, 83 },
+    { 12, 0x02, 83 },
+    { 13, 0x02, 83 },
+    { 14, 0x03, 83 },
+    { 7, 0x02, 84 },
+    { 8, 0x02, 84 },
+    { 9, 0x02, 84 },
+    { 10, 0x02, 84 },
+    { 11, 0x02, 84 },
+    { 12, 0x02, 84 },
+    { 13, 0x02, 84 },
+    { 14, 0x03, 84 }
+  },
+  /* 47 */
+  {
+    { 7, 0x02, 98 },
+    { 8, 0x02, 98 },
+    { 9, 0x02, 98 },
+    { 10, 0x02, 98 },
+    { 11, 0x02, 98 },
+    { 12, 0x02, 98 },
+    { 13, 0x02, 98 },
+    { 14, 0x03, 98 },
+    { 7, 0x02, 107 },
+    { 8, 0x02, 107 },
+    { 9, 0x02, 107 },
+    { 10, 0x02, 107 },
+    { 11, 0x02, 107 },
+    { 12, 0x02, 107 },
+    { 13, 0x02, 107 },
+    { 14, 0x03, 107 }
+  },
+  /* 48 */
+  {
+    { 7, 0x02, 119 },
+    { 8, 0x02, 119 },
+    { 9, 0x02, 119 },
+    { 10, 0x02, 119 },
+    { 11, 0x02, 119 },
+    { 12, 0x02, 119 },
+    { 13, 0x02, 119 },
+    { 14, 0x03, 119 },
+    { 3, 0x02, 40 },
+    { 4, 0x02, 40 },
+    { 5, 0x02, 40 },
+    { 6, 0x03, 40 },
+    { 3, 0x02, 41 },
+    { 4, 0x02, 41 },
+    { 5, 0x02, 41 },
+    { 6, 0x03, 41 }
+  },
+  /* 49 */
+  {
+    { 3, 0x02, 65 },
+    { 4, 0x02, 65 },
+    { 5, 0x02, 65 },
+    { 6, 0x03, 65 },
+    { 3, 0x02, 69 },
+    { 4, 0x02, 69 },
+    { 5, 0x02, 69 },
+    { 6, 0x03, 69 },
+    { 3, 0x02, 72 },
+    { 4, 0x02, 72 },
+    { 5, 0x02, 72 },
+    { 6, 0x03, 72 },
+    { 3, 0x02, 73 },
+    { 4, 0x02, 73 },
+    { 5, 0x02, 73 },
+    { 6, 0x03, 73 }
+  },
+  /* 50 */
+  {
+    { 3, 0x02, 75 },
+    { 4, 0x02, 75 },
+    { 5, 0x02, 75 },
+    { 6, 0x03, 75 },
+    { 3, 0x02, 79 },
+    { 4, 0x02, 79 },
+    { 5, 0x02, 79 },
+    { 6, 0x03, 79 },
+    { 3, 0x02, 87 },
+    { 4, 0x02, 87 },
+    { 5, 0x02, 87 },
+    { 6, 0x03, 87 },
+    { 3, 0x02, 95 },
+    { 4, 0x02, 95 },
+    { 5, 0x02, 95 },
+    { 6, 0x03, 95 }
+  },
+  /* 51 */
+  {
+    { 3, 0x02, 106 },
+    { 4, 0x02, 106 },
+    { 5, 0x02, 106 },
+    { 6, 0x03, 106 },
+    { 3, 0x02, 113 },
+    { 4, 0x02, 113 },
+    { 5, 0x02, 113 },
+    { 6, 0x03, 113 },
+    { 3, 0x02, 118 },
+    { 4, 0x02, 118 },
+    { 5, 0x02, 118 },
+    { 6, 0x03, 118 },
+    { 3, 0x02, 121 },
+    { 4, 0x02, 121 },
+    { 5, 0x02, 121 },
+    { 6, 0x03, 121 }
+  },
+  /* 52 */
+  {
+    { 3, 0x02, 122 },
+    { 4, 0x02, 122 },
+    { 5, 0x02, 122 },
+    { 6, 0x03, 122 },
+    { 1, 0x02, 34 },
+    { 2, 0x03, 34 },
+    { 1, 0x02, 42 },
+    { 2, 0x03, 42 },
+    { 1, 0x02, 66 },
+    { 2, 0x03, 66 },
+    { 1, 0x02, 67 },
+    { 2, 0x03, 67 },
+    { 1, 0x02, 68 },
+    { 2, 0x03, 68 },
+    { 1, 0x02, 70 },
+    { 2, 0x03, 70 }
+  },
+  /* 53 */
+  {
+    { 1, 0x02, 74 },
+    { 2, 0x03, 74 },
+    { 1, 0x02, 76 },
+    { 2, 0x03, 76 },
+    { 1, 0x02, 78 },
+    { 2, 0x03, 78 },
+    { 1, 0x02, 80 },
+    { 2, 0x03, 80 },
+    { 1, 0x02, 85 },
+    { 2, 0x03, 85 },
+    { 1, 0x02, 88 },
+    { 2, 0x03, 88 },
+    { 0, 0x03, 38 },
+    { 0, 0x03, 43 },
+    { 0, 0x03, 81 },
+    { 0, 0x03, 82 }
+  },
+  /* 54 */
+  {
+    { 0, 0x03, 86 },
+    { 0, 0x03, 90 },
+    { 89, 0x00, 0 },
+    { 90, 0x00, 0 },
+    { 91, 0x00, 0 },
+    { 92, 0x00, 0 },
+    { 93, 0x00, 0 },
+    { 94, 0x00, 0 },
+    { 95, 0x00, 0 },
+    { 96, 0x00, 0 },
+    { 97, 0x00, 0 },
+    { 98, 0x00, 0 },
+    { 99, 0x00, 0 },
+    { 100, 0x00, 0 },
+    { 101, 0x00, 0 },
+    { 102, 0x00, 0 }
+  },
+  /* 55 */
+  {
+    { 7, 0x02, 40 },
+    { 8, 0x02, 40 },
+    { 9, 0x02, 40 },
+    { 10, 0x02, 40 },
+    { 11, 0x02, 40 },
+    { 12, 0x02, 40 },
+    { 13, 0x02, 40 },
+    { 14, 0x03, 40 },
+    { 7, 0x02, 41 },
+    { 8, 0x02, 41 },
+    { 9, 0x02, 41 },
+    { 10, 0x02, 41 },
+    { 11, 0x02, 41 },
+    { 12, 0x02, 41 },
+    { 13, 0x02, 41 },
+    { 14, 0x03, 41 }
+  },
+  /* 56 */
+  {
+    { 7, 0x02, 65 },
+    { 8, 0x02, 65 },
+    { 9, 0x02, 65 },
+    { 10, 0x02, 65 },
+    { 11, 0x02, 65 },
+    { 12, 0x02, 65 },
+    { 13, 0x02, 65 },
+    { 14, 0x03, 65 },
+    { 7, 0x02, 69 },
+    { 8, 0x02, 69 },
+    { 9, 0x02, 69 },
+    { 10, 0x02, 69 },
+    { 11, 0x02, 69 },
+    { 12, 0x02, 69 },
+    { 13, 0x02, 69 },
+    { 14, 0x03, 69 }
+  },
+  /* 57 */
+  {
+    { 7, 0x02, 72 },
+    { 8, 0x02, 72 },
+    { 9, 0x02, 72 },
+    { 10, 0x02, 72 },
+    { 11, 0x02, 72 },
+    { 12, 0x02, 72 },
+    { 13, 0x02, 72 },
+    { 14, 0x03, 72 },
+    { 7, 0x02, 73 },
+    { 8, 0x02, 73 },
+    { 9, 0x02, 73 },
+    { 10, 0x02, 73 },
+    { 11, 0x02, 73 },
+    { 12, 0x02, 73 },
+    { 13, 0x02, 73 },
+    { 14, 0x03, 73 }
+  },
+  /* 58 */
+  {
+    { 7, 0x02, 75 },
+    { 8, 0x02, 75 },
+    { 9, 0x02, 75 },
+    { 10, 0x02, 75 },
+    { 11, 0x02, 75 },
+    { 12, 0x02, 75 },
+    { 13, 0x02, 75 },
+    { 14, 0x03, 75 },
+    { 7, 0x02, 79 },
+    { 8, 0x02, 79 },
+    { 9, 0x02, 79 },
+    { 10, 0x02, 79 },
+    { 11, 0x02, 79 },
+    { 12, 0x02, 79 },
+    { 13, 0x02, 79 },
+    { 14, 0x03, 79 }
+  },
+  /* 59 */
+  {
+    { 7, 0x02, 87 },
+    { 8, 0x02, 87 },
+    { 9, 0x02, 87 },
+    { 10, 0x02, 87 },
+    { 11, 0x02, 87 },
+    { 12, 0x02, 87 },
+    { 13, 0x02, 87 },
+    { 14, 0x03, 87 },
+    { 7, 0x02, 95 },
+    { 8, 0x02, 95 },
+    { 9, 0x02, 95 },
+    { 10, 0x02, 95 },
+    { 11, 0x02, 95 },
+    { 12, 0x02, 95 },
+    { 13, 0x02, 95 },
+    { 14, 0x03, 95 }
+  },
+  /* 60 */
+  {
+    { 7, 0x02, 106 },
+    { 8, 0x02, 106 },
+    { 9, 0x02, 106 },
+    { 10, 0x02, 106 },
+    { 11, 0x02, 106 },
+    { 12, 0x02, 106 },
+    { 13, 0x02, 106 },
+    { 14, 0x03, 106 },
+    { 7, 0x02, 113 },
+    { 8, 0x02, 113 },
+    { 9, 0x02, 113 },
+    { 10, 0x02, 113 },
+    { 11, 0x02, 113 },
+    { 12, 0x02, 113 },
+    { 13, 0x02, 113 },
+    { 14, 0x03, 113 }
+  },
+  /* 61 */
+  {
+    { 7, 0x02, 118 },
+    { 8, 0x02, 118 },
+    { 9, 0x02, 118 },
+    { 10, 0x02, 118 },
+    { 11, 0x02, 118 },
+    { 12, 0x02, 118 },
+    { 13, 0x02, 118 },
+    { 14, 0x03, 118 },
+    { 7, 0x02, 121 },
+    { 8, 0x02, 121 },
+    { 9, 0x02, 121 },
+    { 10, 0x02, 121 },
+    { 11, 0x02, 121 },
+    { 12, 0x02, 121 },
+    { 13, 0x02, 121 },
+    { 14, 0x03, 121 }
+  },
+  /* 62 */
+  {
+    { 7, 0x02, 122 },
+    { 8, 0x02, 122 },
+    { 9, 0x02, 122 },
+    { 10, 0x02, 122 },
+    { 11, 0x02, 122 },
+    { 12, 0x02, 122 },
+    { 13, 0x02, 122 },
+    { 14, 0x03, 122 },
+    { 3, 0x02, 34 },
+    { 4, 0x02, 34 },
+    { 5, 0x02, 34 },
+    { 6, 0x03, 34 },
+    { 3, 0x02, 42 },
+    { 4, 0x02, 42 },
+    { 5, 0x02, 42 },
+    { 6, 0x03, 42 }
+  },
+  /* 63 */
+  {
+    { 3, 0x02, 66 },
+    { 4, 0x02, 66 },
+    { 5, 0x02, 66 },
+    { 6, 0x03, 66 },
+    { 3, 0x02, 67 },
+    { 4, 0x02, 67 },
+    { 5, 0x02, 67 },
+    { 6, 0x03, 67 },
+    { 3, 0x02, 68 },
+    { 4, 0x02, 68 },
+    { 5, 0x02, 68 },
+    { 6, 0x03, 68 },
+    { 3, 0x02, 70 },
+    { 4, 0x02, 70 },
+    { 5, 0x02, 70 },
+    { 6, 0x03, 70 }
+  },
+  /* 64 */
+  {
+    { 3, 0x02, 74 },
+    { 4, 0x02, 74 },
+    { 5, 0x02, 74 },
+    { 6, 0x03, 74 },
+    { 3, 0x02, 76 },
+    { 4, 0x02, 76 },
+    { 5, 0x02, 76 },
+    { 6, 0x03, 76 },
+    { 3, 0x02, 78 },
+    { 4, 0x02, 78 },
+    { 5, 0x02, 78 },
+    { 6, 0x03, 78 },
+    { 3, 0x02, 80 },
+    { 4, 0x02, 80 },
+    { 5, 0x02, 80 },
+    { 6, 0x03, 80 }
+  },
+  /* 65 */
+  {
+    { 3, 0x02, 85 },
+    { 4, 0x02, 85 },
+    { 5, 0x02, 85 },
+    { 6, 0x03, 85 },
+    { 3, 0x02, 88 },
+    { 4, 0x02, 88 },
+    { 5, 0x02, 88 },
+    { 6, 0x03, 88 },
+    { 1, 0x02, 38 },
+    { 2, 0x03, 38 },
+    { 1, 0x02, 43 },
+    { 2, 0x03, 43 },
+    { 1, 0x02, 81 },
+    { 2, 0x03, 81 },
+    { 1, 0x02, 82 },
+    { 2, 0x03, 82 }
+  },
+  /* 66 */
+  {
+    { 1, 0x02, 86 },
+    { 2, 0x03, 86 },
+    { 1, 0x02, 90 },
+    { 2, 0x03, 90 },
+    { 0, 0x03, 60 },
+    { 0, 0x03, 62 },
+    { 0, 0x03, 63 },
+    { 0, 0x03, 89 },
+    { 0, 0x03, 124 },
+    { 0, 0x03, 126 },
+    { 103, 0x00, 0 },
+    { 104, 0x00, 0 },
+    { 105, 0x00, 0 },
+    { 106, 0x00, 0 },
+    { 107, 0x00, 0 },
+    { 108, 0x00, 0 }
+  },
+  /* 67 */
+  {
+    { 109, 0x00, 0 },
+    { 110, 0x00, 0 },
+    { 111, 0x00, 0 },
+    { 112, 0x00, 0 },
+    { 113, 0x00, 0 },
+    { 114, 0x00, 0 },
+    { 115, 0x00, 0 },
+    { 116, 0x00, 0 },
+    { 117, 0x00, 0 },
+    { 118, 0x00, 0 },
+    { 119, 0x00, 0 },
+    { 120, 0x00, 0 },
+    { 121, 0x00, 0 },
+    { 122, 0x00, 0 },
+    { 123, 0x00, 0 },
+    { 124, 0x00, 0 }
+  },
+  /* 68 */
+  {
+    { 7, 0x02, 34 },
+    { 8, 0x02, 34 },
+    { 9, 0x02, 34 },
+    { 10, 0x02, 34 },
+    { 11, 0x02, 34 },
+    { 12, 0x02, 34 },
+    { 13, 0x02, 34 },
+    { 14, 0x03, 34 },
+    { 7, 0x02, 42 },
+    { 8, 0x02, 42 },
+    { 9, 0x02, 42 },
+    { 10, 0x02, 42 },
+    { 11, 0x02, 42 },
+    { 12, 0x02, 42 },
+    { 13, 0x02, 42 },
+    { 14, 0x03, 42 }
+  },
+  /* 69 */
+  {
+    { 7, 0x02, 66 },
+    { 8, 0x02, 66 },
+    { 9, 0x02, 66 },
+    { 10, 0x02, 66 },
+    { 11, 0x02, 66 },
+    { 12, 0x02, 66 },
+    { 13, 0x02, 66 },
+    { 14, 0x03, 66 },
+    { 7, 0x02, 67 },
+    { 8, 0x02, 67 },
+    { 9, 0x02, 67 },
+    { 10, 0x02, 67 },
+    { 11, 0x02, 67 },
+    { 12, 0x02, 67 },
+    { 13, 0x02, 67 },
+    { 14, 0x03, 67 }
+  },
+  /* 70 */
+  {
+    { 7, 0x02, 68 },
+    { 8, 0x02, 68 },
+    { 9, 0x02, 68 },
+    { 10, 0x02, 68 },
+    { 11, 0x02, 68 },
+    { 12, 0x02, 68 },
+    { 13, 0x02, 68 },
+    { 14, 0x03, 68 },
+    { 7, 0x02, 70 },
+    { 8, 0x02, 70 },
+    { 9, 0x02, 70 },
+    { 10, 0x02, 70 },
+    { 11, 0x02, 70 },
+    { 12, 0x02, 70 },
+    { 13, 0x02, 70 },
+    { 14, 0x03, 70 }
+  },
+  /* 71 */
+  {
+    { 7, 0x02, 74 },
+    { 8, 0x02, 74 },
+    { 9, 0x02, 74 },
+    { 10, 0x02, 74 },
+    { 11, 0x02, 74 },
+    { 12, 0x02, 74 },
+    { 13, 0x02, 74 },
+    { 14, 0x03, 74 },
+    { 7, 0x02, 76 },
+    { 8, 0x02, 76 },
+    { 9, 0x02, 76 },
+    { 10, 0x02, 76 },
+    { 11, 0x02, 76 },
+    { 12, 0x02, 76 },
+    { 13, 0x02, 76 },
+    { 14, 0x03, 76 }
+  },
+  /* 72 */
+  {
+    { 7, 0x02, 78 },
+    { 8, 0x02, 78 },
+    { 9, 0x02, 78 },
+    { 10, 0x02, 78 },
+    { 11, 0x02, 78 },
+    { 12, 0x02, 78 },
+    { 13, 0x02, 78 },
+    { 14, 0x03, 78 },
+    { 7, 0x02, 80 },
+    { 8, 0x02, 80 },
+    { 9, 0x02, 80 },
+    { 10, 0x02, 80 },
+    { 11, 0x02, 80 },
+    { 12, 0x02, 80 },
+    { 13, 0x02, 80 },
+    { 14, 0x03, 80 }
+  },
+  /* 73 */
+  {
+    { 7, 0x02, 85 },
+    { 8, 0x02, 85 },
+    { 9, 0x02, 85 },
+    { 10, 0x02, 85 },
+    { 11, 0x02, 85 },
+    { 12, 0x02, 85 },
+    { 13, 0x02, 85 },
+    { 14, 0x03, 85 },
+    { 7, 0x02, 88 },
+    { 8, 0x02, 88 },
+    { 9, 0x02, 88 },
+    { 10, 0x02, 88 },
+    { 11, 0x02, 88 },
+    { 12, 0x02, 88 },
+    { 13, 0x02, 88 },
+    { 14, 0x03, 88 }
+  },
+  /* 74 */
+  {
+    { 3, 0x02, 38 },
+    { 4, 0x02, 38 },
+    { 5, 0x02, 38 },
+    { 6, 0x03, 38 },
+    { 3, 0x02, 43 },
+    { 4, 0x02, 43 },
+    { 5, 0x02, 43 },
+    { 6, 0x03, 43 },
+    { 3, 0x02, 81 },
+    { 4, 0x02, 81 },
+    { 5, 0x02, 81 },
+    { 6, 0x03, 81 },
+    { 3, 0x02, 82 },
+    { 4, 0x02, 82 },
+    { 5, 0x02, 82 },
+    { 6, 0x03, 82 }
+  },
+  /* 75 */
+  {
+    { 3, 0x02, 86 },
+    { 4, 0x02, 86 },
+    { 5, 0x02, 86 },
+    { 6, 0x03, 86 },
+    { 3, 0x02, 90 },
+    { 4, 0x02, 90 },
+    { 5, 0x02, 90 },
+    { 6, 0x03, 90 },
+    { 1, 0x02, 60 },
+    { 2, 0x03, 60 },
+    { 1, 0x02, 62 },
+    { 2, 0x03, 62 },
+    { 1, 0x02, 63 },
+    { 2, 0x03, 63 },
+    { 1, 0x02, 89 },
+    { 2, 0x03, 89 }
+  },
+  /* 76 */
+  {
+    { 1, 0x02, 124 },
+    { 2, 0x03, 124 },
+    { 1, 0x02, 126 },
+    { 2, 0x03, 126 },
+    { 125, 0x00, 0 },
+    { 126, 0x00, 0 },
+    { 127, 0x00, 0 },
+    { 128, 0x00, 0 },
+    { 129, 0x00, 0 },
+    { 130, 0x00, 0 },
+    { 131, 0x00, 0 },
+    { 132, 0x00, 0 },
+    { 133, 0x00, 0 },
+    { 134, 0x00, 0 },
+    { 135, 0x00, 0 },
+    { 136, 0x00, 0 }
+  },
+  /* 77 */
+  {
+    { 137, 0x00, 0 },
+    { 138, 0x00, 0 },
+    { 139, 0x00, 0 },
+    { 140, 0x00, 0 },
+    { 141, 0x00, 0 },
+    { 142, 0x00, 0 },
+    { 143, 0x00, 0 },
+    { 144, 0x00, 0 },
+    { 145, 0x00, 0 },
+    { 146, 0x00, 0 },
+    { 147, 0x00, 0 },
+    { 148, 0x00, 0 },
+    { 149, 0x00, 0 },
+    { 150, 0x00, 0 },
+    { 151, 0x00, 0 },
+    { 152, 0x00, 0 }
+  },
+  /* 78 */
+  {
+    { 153, 0x00, 0 },
+    { 154, 0x00, 0 },
+    { 155, 0x00, 0 },
+    { 156, 0x00, 0 },
+    { 157, 0x00, 0 },
+    { 158, 0x00, 0 },
+    { 159, 0x00, 0 },
+    { 160, 0x00, 0 },
+    { 161, 0x00, 0 },
+    { 162, 0x00, 0 },
+    { 163, 0x00, 0 },
+    { 164, 0x00, 0 },
+    { 165, 0x00, 0 },
+    { 166, 0x00, 0 },
+    { 167, 0x00, 0 },
+    { 168, 0x00, 0 }
+  },
+  /* 79 */
+  {
+    { 7, 0x02, 38 },
+    { 8, 0x02, 38 },
+    { 9, 0x02, 38 },
+    { 10, 0x02, 38 },
+    { 11, 0x02, 38 },
+    { 12, 0x02, 38 },
+    { 13, 0x02, 38 },
+    { 14, 0x03, 38 },
+    { 7, 0x02, 43 },
+    { 8, 0x02, 43 },
+    { 9, 0x02, 43 },
+    { 10, 0x02, 43 },
+    { 11, 0x02, 43 },
+    { 12, 0x02, 43 },
+    { 13, 0x02, 43 },
+    { 14, 0x03, 43 }
+  },
+  /* 80 */
+  {
+    { 7, 0x02, 81 },
+    { 8, 0x02, 81 },
+    { 9, 0x02, 81 },
+    { 10, 0x02, 81 },
+    { 11, 0x02, 81 },
+    { 12, 0x02, 81 },
+    { 13, 0x02, 81 },
+    { 14, 0x03, 81 },
+    { 7, 0x02, 82 },
+    { 8, 0x02, 82 },
+    { 9, 0x02, 82 },
+    { 10, 0x02, 82 },
+    { 11, 0x02, 82 },
+    { 12, 0x02, 82 },
+    { 13, 0x02, 82 },
+    { 14, 0x03, 82 }
+  },
+  /* 81 */
+  {
+    { 7, 0x02, 86 },
+    { 8, 0x02, 86 },
+    { 9, 0x02, 86 },
+    { 10, 0x02, 86 },
+    { 11, 0x02, 86 },
+    { 12, 0x02, 86 },
+    { 13, 0x02, 86 },
+    { 14, 0x03, 86 },
+    { 7, 0x02, 90 },
+    { 8, 0x02, 90 },
+    { 9, 0x02, 90 },
+    { 10, 0x02, 90 },
+    { 11, 0x02, 90 },
+    { 12, 0x02, 90 },
+    { 13, 0x02, 90 },
+    { 14, 0x03, 90 }
+  },
+  /* 82 */
+  {
+    { 3, 0x02, 60 },
+    { 4, 0x02, 60 },
+    { 5, 0x02, 60 },
+    { 6, 0x03, 60 },
+    { 3, 0x02, 62 },
+    { 4, 0x02, 62 },
+    { 5, 0x02, 62 },
+    { 6, 0x03, 62 },
+    { 3, 0x02, 63 },
+    { 4, 0x02, 63 },
+    { 5, 0x02, 63 },
+    { 6, 0x03, 63 },
+    { 3, 0x02, 89 },
+    { 4, 0x02, 89 },
+    { 5, 0x02, 89 },
+    { 6, 0x03, 89 }
+  },
+  /* 83 */
+  {
+    { 3, 0x02, 124 },
+    { 4, 0x02, 124 },
+    { 5, 0x02, 124 },
+    { 6, 0x03, 124 },
+    { 3, 0x02, 126 },
+    { 4, 0x02, 126 },
+    { 5, 0x02, 126 },
+    { 6, 0x03, 126 },
+    { 0, 0x03, 255 },
+    { 169, 0x00, 0 },
+    { 170, 0x00, 0 },
+    { 171, 0x00, 0 },
+    { 172, 0x00, 0 },
+    { 173, 0x00, 0 },
+    { 174, 0x00, 0 },
+    { 175, 0x00, 0 }
+  },
+  /* 84 */
+  {
+    { 176, 0x00, 0 },
+    { 177, 0x00, 0 },
+    { 178, 0x00, 0 },
+    { 179, 0x00, 0 },
+    { 180, 0x00, 0 },
+    { 181, 0x00, 0 },
+    { 182, 0x00, 0 },
+    { 183, 0x00, 0 },
+    { 184, 0x00, 0 },
+    { 185, 0x00, 0 },
+    { 186, 0x00, 0 },
+    { 187, 0x00, 0 },
+    { 188, 0x00, 0 },
+    { 189, 0x00, 0 },
+    { 190, 0x00, 0 },
+    { 191, 0x00, 0 }
+  },
+  /* 85 */
+  {
+    { 192, 0x00, 0 },
+    { 193, 0x00, 0 },
+    { 194, 0x00, 0 },
+    { 195, 0x00, 0 },
+    { 196, 0x00, 0 },
+    { 197, 0x00, 0 },
+    { 198, 0x00, 0 },
+    { 199, 0x00, 0 },
+    { 200, 0x00, 0 },
+    { 201, 0x00, 0 },
+    { 202, 0x00, 0 },
+    { 203, 0x00, 0 },
+    { 204, 0x00, 0 },
+    { 205, 0x00, 0 },
+    { 206, 0x00, 0 },
+    { 207, 0x00, 0 }
+  },
+  /* 86 */
+  {
+    { 208, 0x00, 0 },
+    { 209, 0x00, 0 },
+    { 210, 0x00, 0 },
+    { 211, 0x00, 0 },
+    { 212, 0x00, 0 },
+    { 213, 0x00, 0 },
+    { 214, 0x00, 0 },
+    { 215, 0x00, 0 },
+    { 216, 0x00, 0 },
+    { 217, 0x00, 0 },
+    { 218, 0x00, 0 },
+    { 219, 0x00, 0 },
+    { 220, 0x00, 0 },
+    { 221, 0x00, 0 },
+    { 222, 0x00, 0 },
+    { 223, 0x00, 0 }
+  },
+  /* 87 */
+  {
+    { 224, 0x00, 0 },
+    { 225, 0x00, 0 },
+    { 226, 0x00, 0 },
+    { 227, 0x00, 0 },
+    { 228, 0x00, 0 },
+    { 229, 0x00, 0 },
+    { 230, 0x00, 0 },
+    { 231, 0x00, 0 },
+    { 232, 0x00, 0 },
+    { 233, 0x00, 0 },
+    { 234, 0x00, 0 },
+    { 235, 0x00, 0 },
+    { 236, 0x00, 0 },
+    { 237, 0x00, 0 },
+    { 238, 0x00, 0 },
+    { 239, 0x00, 0 }
+  },
+  /* 88 */
+  {
+    { 240, 0x00, 0 },
+    { 241, 0x00, 0 },
+    { 242, 0x00, 0 },
+    { 243, 0x00, 0 },
+    { 244, 0x00, 0 },
+    { 245, 0x00, 0 },
+    { 246, 0x00, 0 },
+    { 247, 0x00, 0 },
+    { 248, 0x00, 0 },
+    { 249, 0x00, 0 },
+    { 250, 0x00, 0 },
+    { 251, 0x00, 0 },
+    { 252, 0x00, 0 },
+    { 253, 0x00, 0 },
+    { 254, 0x00, 0 },
+    { 255, 0x00, 0 }
+  },
+  /* 89 */
+  {
+    { 7, 0x02, 60 },
+    { 8, 0x02, 60 },
+    { 9, 0x02, 60 },
+    { 10, 0x02, 60 },
+    { 11, 0x02, 60 },
+    { 12, 0x02, 60 },
+    { 13, 0x02, 60 },
+    { 14, 0x03, 60 },
+    { 7, 0x02, 62 },
+    { 8, 0x02, 62 },
+    { 9, 0x02, 62 },
+    { 10, 0x02, 62 },
+    { 11, 0x02, 62 },
+    { 12, 0x02, 62 },
+    { 13, 0x02, 62 },
+    { 14, 0x03, 62 }
+  },
+  /* 90 */
+  {
+    { 7, 0x02, 63 },
+    { 8, 0x02, 63 },
+    { 9, 0x02, 63 },
+    { 10, 0x02, 63 },
+    { 11, 0x02, 63 },
+    { 12, 0x02, 63 },
+    { 13, 0x02, 63 },
+    { 14, 0x03, 63 },
+    { 7, 0x02, 89 },
+    { 8, 0x02, 89 },
+    { 9, 0x02, 89 },
+    { 10, 0x02, 89 },
+    { 11, 0x02, 89 },
+    { 12, 0x02, 89 },
+    { 13, 0x02, 89 },
+    { 14, 0x03, 89 }
+  },
+  /* 91 */
+  {
+    { 7, 0x02, 124 },
+    { 8, 0x02, 124 },
+    { 9, 0x02, 124 },
+    { 10, 0x02, 124 },
+    { 11, 0x02, 124 },
+    { 12, 0x02, 124 },
+    { 13, 0x02, 124 },
+    { 14, 0x03, 124 },
+    { 7, 0x02, 126 },
+    { 8, 0x02, 126 },
+    { 9, 0x02, 126 },
+    { 10, 0x02, 126 },
+    { 11, 0x02, 126 },
+    { 12, 0x02, 126 },
+    { 13, 0x02, 126 },
+    { 14, 0x03, 126 }
+  },
+  /* 92 */
+  {
+    { 1, 0x02, 255 },
+    { 2, 0x03, 255 },
+    { 0, 0x03, 0 },
+    { 0, 0x03, 1 },
+    { 0, 0x03, 2 },
+    { 0, 0x03, 3 },
+    { 0, 0x03, 4 },
+    { 0, 0x03, 5 },
+    { 0, 0x03, 6 },
+    { 0, 0x03, 7 },
+    { 0, 0x03, 8 },
+    { 0, 0x03, 9 },
+    { 0, 0x03, 10 },
+    { 0, 0x03, 11 },
+    { 0, 0x03, 12 },
+    { 0, 0x03, 13 }
+  },
+  /* 93 */
+  {
+    { 0, 0x03, 14 },
+    { 0, 0x03, 15 },
+    { 0, 0x03, 16 },
+    { 0, 0x03, 17 },
+    { 0, 0x03, 18 },
+    { 0, 0x03, 19 },
+    { 0, 0x03, 20 },
+    { 0, 0x03, 21 },
+    { 0, 0x03, 22 },
+    { 0, 0x03, 23 },
+    { 0, 0x03, 24 },
+    { 0, 0x03, 25 },
+    { 0, 0x03, 26 },
+    { 0, 0x03, 27 },
+    { 0, 0x03, 28 },
+    { 0, 0x03, 29 }
+  },
+  /* 94 */
+  {
+    { 0, 0x03, 30 },
+    { 0, 0x03, 31 },
+    { 0, 0x03, 33 },
+    { 0, 0x03, 35 },
+    { 0, 0x03, 36 },
+    { 0, 0x03, 37 },
+    { 0, 0x03, 39 },
+    { 0, 0x03, 64 },
+    { 0, 0x03, 91 },
+    { 0, 0x03, 92 },
+    { 0, 0x03, 93 },
+    { 0, 0x03, 94 },
+    { 0, 0x03, 96 },
+    { 0, 0x03, 123 },
+    { 0, 0x03, 125 },
+    { 0, 0x03, 127 }
+  },
+  /* 95 */
+  {
+    { 0, 0x03, 128 },
+    { 0, 0x03, 129 },
+    { 0, 0x03, 130 },
+    { 0, 0x03, 131 },
+    { 0, 0x03, 132 },
+    { 0, 0x03, 133 },
+    { 0, 0x03, 134 },
+    { 0, 0x03, 135 },
+    { 0, 0x03, 136 },
+    { 0, 0x03, 137 },
+    { 0, 0x03, 138 },
+    { 0, 0x03, 139 },
+    { 0, 0x03, 140 },
+    { 0, 0x03, 141 },
+    { 0, 0x03, 142 },
+    { 0, 0x03, 143 }
+  },
+  /* 96 */
+  {
+    { 0, 0x03, 144 },
+    { 0, 0x03, 145 },
+    { 0, 0x03, 146 },
+    { 0, 0x03, 147 },
+    { 0, 0x03, 148 },
+    { 0, 0x03, 149 },
+    { 0, 0x03, 150 },
+    { 0, 0x03, 151 },
+    { 0, 0x03, 152 },
+    { 0, 0x03, 153 },
+    { 0, 0x03, 154 },
+    { 0, 0x03, 155 },
+    { 0, 0x03, 156 },
+    { 0, 0x03, 157 },
+    { 0, 0x03, 158 },
+    { 0, 0x03, 159 }
+  },
+  /* 97 */
+  {
+    { 0, 0x03, 160 },
+    { 0, 0x03, 161 },
+    { 0, 0x03, 162 },
+    { 0, 0x03, 163 },
+    { 0, 0x03, 164 },
+    { 0, 0x03, 165 },
+    { 0, 0x03, 166 },
+    { 0, 0x03, 167 },
+    { 0, 0x03, 168 },
+    { 0, 0x03, 169 },
+    { 0, 0x03, 170 },
+    { 0, 0x03, 171 },
+    { 0, 0x03, 172 },
+    { 0, 0x03, 173 },
+    { 0, 0x03, 174 },
+    { 0, 0x03, 175 }
+  },
+  /* 98 */
+  {
+    { 0, 0x03, 176 },
+    { 0, 0x03, 177 },
+    { 0, 0x03, 178 },
+    { 0, 0x03, 179 },
+    { 0, 0x03, 180 },
+    { 0, 0x03, 181 },
+    { 0, 0x03, 182 },
+    { 0, 0x03, 183 },
+    { 0, 0x03, 184 },
+    { 0, 0x03, 185 },
+    { 0, 0x03, 186 },
+    { 0, 0x03, 187 },
+    { 0, 0x03, 188 },
+    { 0, 0x03, 189 },
+    { 0, 0x03, 190 },
+    { 0, 0x03, 191 }
+  },
+  /* 99 */
+  {
+    { 0, 0x03, 192 },
+    { 0, 0x03, 193 },
+    { 0, 0x03, 194 },
+    { 0, 0x03, 195 },
+    { 0, 0x03, 196 },
+    { 0, 0x03, 197 },
+    { 0, 0x03, 198 },
+    { 0, 0x03, 199 },
+    { 0, 0x03, 200 },
+    { 0, 0x03, 201 },
+    { 0, 0x03, 202 },
+    { 0, 0x03, 203 },
+    { 0, 0x03, 204 },
+    { 0, 0x03, 205 },
+    { 0, 0x03, 206 },
+    { 0, 0x03, 207 }
+  },
+  /* 100 */
+  {
+    { 0, 0x03, 208 },
+    { 0, 0x03, 209 },
+    { 0, 0x03, 210 },
+    { 0, 0x03, 211 },
+    { 0, 0x03, 212 },
+    { 0, 0x03, 213 },
+    { 0, 0x03, 214 },
+    { 0, 0x03, 215 },
+    { 0, 0x03, 216 },
+    { 0, 0x03, 217 },
+    { 0, 0x03, 218 },
+    { 0, 0x03, 219 },
+    { 0, 0x03, 220 },
+    { 0, 0x03, 221 },
+    { 0, 0x03, 222 },
+    { 0, 0x03, 223 }
+  },
+  /* 101 */
+  {
+    { 0, 0x03, 224 },
+    { 0, 0x03, 225 },
+    { 0, 0x03, 226 },
+    { 0, 0x03, 227 },
+    { 0, 0x03, 228 },
+    { 0, 0x03, 229 },
+    { 0, 0x03, 230 },
+    { 0, 0x03, 231 },
+    { 0, 0x03, 232 },
+    { 0, 0x03, 233 },
+    { 0, 0x03, 234 },
+    { 0, 0x03, 235 },
+    { 0, 0x03, 236 },
+    { 0, 0x03, 237 },
+    { 0, 0x03, 238 },
+    { 0, 0x03, 239 }
+  },
+  /* 102 */
+  {
+    { 0, 0x03, 240 },
+    { 0, 0x03, 241 },
+    { 0, 0x03, 242 },
+    { 0, 0x03, 243 },
+    { 0, 0x03, 244 },
+    { 0, 0x03, 245 },
+    { 0, 0x03, 246 },
+    { 0, 0x03, 247 },
+    { 0, 0x03, 248 },
+    { 0, 0x03, 249 },
+    { 0, 0x03, 250 },
+    { 0, 0x03, 251 },
+    { 0, 0x03, 252 },
+    { 0, 0x03, 253 },
+    { 0, 0x03, 254 },
+    { 0, 0x04, 0 }
+  },
+  /* 103 */
+  {
+    { 3, 0x02, 255 },
+    { 4, 0x02, 255 },
+    { 5, 0x02, 255 },
+    { 6, 0x03, 255 },
+    { 1, 0x02, 0 },
+    { 2, 0x03, 0 },
+    { 1, 0x02, 1 },
+    { 2, 0x03, 1 },
+    { 1, 0x02, 2 },
+    { 2, 0x03, 2 },
+    { 1, 0x02, 3 },
+    { 2, 0x03, 3 },
+    { 1, 0x02, 4 },
+    { 2, 0x03, 4 },
+    { 1, 0x02, 5 },
+    { 2, 0x03, 5 }
+  },
+  /* 104 */
+  {
+    { 1, 0x02, 6 },
+    { 2, 0x03, 6 },
+    { 1, 0x02, 7 },
+    { 2, 0x03, 7 },
+    { 1, 0x02, 8 },
+    { 2, 0x03, 8 },
+    { 1, 0x02, 9 },
+    { 2, 0x03, 9 },
+    { 1, 0x02, 10 },
+    { 2, 0x03, 10 },
+    { 1, 0x02, 11 },
+    { 2, 0x03, 11 },
+    { 1, 0x02, 12 },
+    { 2, 0x03, 12 },
+    { 1, 0x02, 13 },
+    { 2, 0x03, 13 }
+  },
+  /* 105 */
+  {
+    { 1, 0x02, 14 },
+    { 2, 0x03, 14 },
+    { 1, 0x02, 15 },
+    { 2, 0x03, 15 },
+    { 1, 0x02, 16 },
+    { 2, 0x03, 16 },
+    { 1, 0x02, 17 },
+    { 2, 0x03, 17 },
+    { 1, 0x02, 18 },
+    { 2, 0x03, 18 },
+    { 1, 0x02, 19 },
+    { 2, 0x03, 19 },
+    { 1, 0x02, 20 },
+    { 2, 0x03, 20 },
+    { 1, 0x02, 21 },
+    { 2, 0x03, 21 }
+  },
+  /* 106 */
+  {
+    { 1, 0x02, 22 },
+    { 2, 0x03, 22 },
+    { 1, 0x02, 23 },
+    { 2, 0x03, 23 },
+    { 1, 0x02, 24 },
+    { 2, 0x03, 24 },
+    { 1, 0x02, 25 },
+    { 2, 0x03, 25 },
+    { 1, 0x02, 26 },
+    { 2, 0x03, 26 },
+    { 1, 0x02, 27 },
+    { 2, 0x03, 27 },
+    { 1, 0x02, 28 },
+    { 2, 0x03, 28 },
+    { 1, 0x02, 29 },
+    { 2, 0x03, 29 }
+  },
+  /* 107 */
+  {
+    { 1, 0x02, 30 },
+    { 2, 0x03, 30 },
+    { 1, 0x02, 31 },
+    { 2, 0x03, 31 },
+    { 1, 0x02, 33 },
+    { 2, 0x03, 33 },
+    { 1, 0x02, 35 },
+    { 2, 0x03, 35 },
+    { 1, 0x02, 36 },
+    { 2, 0x03, 36 },
+    { 1, 0x02, 37 },
+    { 2, 0x03, 37 },
+    { 1, 0x02, 39 },
+    { 2, 0x03, 39 },
+    { 1, 0x02, 64 },
+    { 2, 0x03, 64 }
+  },
+  /* 108 */
+  {
+    { 1, 0x02, 91 },
+    { 2, 0x03, 91 },
+    { 1, 0x02, 92 },
+    { 2, 0x03, 92 },
+    { 1, 0x02, 93 },
+    { 2, 0x03, 93 },
+    { 1, 0x02, 94 },
+    { 2, 0x03, 94 },
+    { 1, 0x02, 96 },
+    { 2, 0x03, 96 },
+    { 1, 0x02, 123 },
+    { 2, 0x03, 123 },
+    { 1, 0x02, 125 },
+    { 2, 0x03, 125 },
+    { 1, 0x02, 127 },
+    { 2, 0x03, 127 }
+  },
+  /* 109 */
+  {
+    { 1, 0x02, 128 },
+    { 2, 0x03, 128 },
+    { 1, 0x02, 129 },
+    { 2, 0x03, 129 },
+    { 1, 0x02, 130 },
+    { 2, 0x03, 130 },
+    { 1, 0x02, 131 },
+    { 2, 0x03, 131 },
+    { 1, 0x02, 132 },
+    { 2, 0x03, 132 },
+    { 1, 0x02, 133 },
+    { 2, 0x03, 133 },
+    { 1, 0x02, 134 },
+    { 2, 0x03, 134 },
+    { 1, 0x02, 135 },
+    { 2, 0x03, 135 }
+  },
+  /* 110 */
+  {
+    { 1, 0x02, 136 },
+    { 2, 0x03, 136 },
+    { 1, 0x02, 137 },
+    { 2, 0x03, 137 },
+    { 1, 0x02, 138 },
+    { 2, 0x03, 138 },
+    { 1, 0x02, 139 },
+    { 2, 0x03, 139 },
+    { 1, 0x02, 140 },
+    { 2, 0x03, 140 },
+    { 1, 0x02, 141 },
+    { 2, 0x03, 141 },
+    { 1, 0x02, 142 },
+    { 2, 0x03, 142 },
+    { 1, 0x02, 143 },
+    { 2, 0x03, 143 }
+  },
+  /* 111 */
+  {
+    { 1, 0x02, 144 },
+    { 2, 0x03, 144 },
+    { 1, 0x02, 145 },
+    { 2, 0x03, 145 },
+    { 1, 0x02, 146 },
+    { 2, 0x03, 146 },
+    { 1, 0x02, 147 },
+    { 2, 0x03, 147 },
+    { 1, 0x02, 148 },
+    { 2, 0x03, 148 },
+    { 1, 0x02, 149 },
+    { 2, 0x03, 149 },
+    { 1, 0x02, 150 },
+    { 2, 0x03, 150 },
+    { 1, 0x02, 151 },
+    { 2, 0x03, 151 }
+  },
+  /* 112 */
+  {
+    { 1, 0x02, 152 },
+    { 2, 0x03, 152 },
+    { 1, 0x02, 153 },
+    { 2, 0x03, 153 },
+    { 1, 0x02, 154 },
+    { 2, 0x03, 154 },
+    { 1, 0x02, 155 },
+    { 2, 0x03, 155 },
+    { 1, 0x02, 156 },
+    { 2, 0x03, 156 },
+    { 1, 0x02, 157 },
+    { 2, 0x03, 157 },
+    { 1, 0x02, 158 },
+    { 2, 0x03, 158 },
+    { 1, 0x02, 159 },
+    { 2, 0x03, 159 }
+  },
+  /* 113 */
+  {
+    { 1, 0x02, 160 },
+    { 2, 0x03, 160 },
+    { 1, 0x02, 161 },
+    { 2, 0x03, 161 },
+    { 1, 0x02, 162 },
+    { 2, 0x03, 162 },
+    { 1, 0x02, 163 },
+    { 2, 0x03, 163 },
+    { 1, 0x02, 164 },
+    { 2, 0x03, 164 },
+    { 1, 0x02, 165 },
+    { 2, 0x03, 165 },
+    { 1, 0x02, 166 },
+    { 2, 0x03, 166 },
+    { 1, 0x02, 167 },
+    { 2, 0x03, 167 }
+  },
+  /* 114 */
+  {
+    { 1, 0x02, 168 },
+    { 2, 0x03, 168 },
+    { 1, 0x02, 169 },
+    { 2, 0x03, 169 },
+    { 1, 0x02, 170 },
+    { 2, 0x03, 170 },
+    { 1, 0x02, 171 },
+    { 2, 0x03, 171 },
+    { 1, 0x02, 172 },
+    { 2, 0x03, 172 },
+    { 1, 0x02, 173 },
+    { 2, 0x03, 173 },
+    { 1, 0x02, 174 },
+    { 2, 0x03, 174 },
+    { 1, 0x02, 175 },
+    { 2, 0x03, 175 }
+  },
+  /* 115 */
+  {
+    { 1, 0x02, 176 },
+    { 2, 0x03, 176 },
+    { 1, 0x02, 177 },
+    { 2, 0x03, 177 },
+    { 1, 0x02, 178 },
+    { 2, 0x03, 178 },
+    { 1, 0x02, 179 },
+    { 2, 0x03, 179 },
+    { 1, 0x02, 180 },
+    { 2, 0x03, 180 },
+    { 1, 0x02, 181 },
+    { 2, 0x03, 181 },
+    { 1, 0x02, 182 },
+    { 2, 0x03, 182 },
+    { 1, 0x02, 183 },
+    { 2, 0x03, 183 }
+  },
+  /* 116 */
+  {
+    { 1, 0x02, 184 },
+    { 2, 0x03, 184 },
+    { 1, 0x02, 185 },
+    { 2, 0x03, 185 },
+    { 1, 0x02, 186 },
+    { 2, 0x03, 186 },
+    { 1, 0x02, 187 },
+    { 2, 0x03, 187 },
+    { 1, 0x02, 188 },
+    { 2, 0x03, 188 },
+    { 1, 0x02, 189 },
+    { 2, 0x03, 189 },
+    { 1, 0x02, 190 },
+    { 2, 0x03, 190 },
+    { 1, 0x02, 191 },
+    { 2, 0x03, 191 }
+  },
+  /* 117 */
+  {
+    { 1, 0x02, 192 },
+    { 2, 0x03, 192 },
+    { 1, 0x02, 193 },
+    { 2, 0x03, 193 },
+    { 1, 0x02, 194 },
+    { 2, 0x03, 194 },
+    { 1, 0x02, 195 },
+    { 2, 0x03, 195 },
+    { 1, 0x02, 196 },
+    { 2, 0x03, 196 },
+    { 1, 0x02, 197 },
+    { 2, 0x03, 197 },
+    { 1, 0x02, 198 },
+    { 2, 0x03, 198 },
+    { 1, 0x02, 199 },
+    { 2, 0x03, 199 }
+  },
+  /* 118 */
+  {
+    { 1, 0x02, 200 },
+    { 2, 0x03, 200 },
+    { 1, 0x02, 201 },
+    { 2, 0x03, 201 },
+    { 1, 0x02, 202 },
+    { 2, 0x03, 202 },
+    { 1, 0x02, 203 },
+    { 2, 0x03, 203 },
+    { 1, 0x02, 204 },
+    { 2, 0x03, 204 },
+    { 1, 0x02, 205 },
+    { 2, 0x03, 205 },
+    { 1, 0x02, 206 },
+    { 2, 0x03, 206 },
+    { 1, 0x02, 207 },
+    { 2, 0x03, 207 }
+  },
+  /* 119 */
+  {
+    { 1, 0x02, 208 },
+    { 2, 0x03, 208 },
+    { 1, 0x02, 209 },
+    { 2, 0x03, 209 },
+    { 1, 0x02, 210 },
+    { 2, 0x03, 210 },
+    { 1, 0x02, 211 },
+    { 2, 0x03, 211 },
+    { 1, 0x02, 212 },
+    { 2, 0x03, 212 },
+    { 1, 0x02, 213 },
+    { 2, 0x03, 213 },
+    { 1, 0x02, 214 },
+    { 2, 0x03, 214 },
+    { 1, 0x02, 215 },
+    { 2, 0x03, 215 }
+  },
+  /* 120 */
+  {
+    { 1, 0x02, 216 },
+    { 2, 0x03, 216 },
+    { 1, 0x02, 217 },
+    { 2, 0x03, 217 },
+    { 1, 0x02, 218 },
+    { 2, 0x03, 218 },
+    { 1, 0x02, 219 },
+    { 2, 0x03, 219 },
+    { 1, 0x02, 220 },
+    { 2, 0x03, 220 },
+    { 1, 0x02, 221 },
+    { 2, 0x03, 221 },
+    { 1, 0x02, 222 },
+    { 2, 0x03, 222 },
+    { 1, 0x02, 223 },
+    { 2, 0x03, 223 }
+  },
+  /* 121 */
+  {
+    { 1, 0x02, 224 },
+    { 2, 0x03, 224 },
+    { 1, 0x02, 225 },
+    { 2, 0x03, 225 },
+    { 1, 0x02, 226 },
+    { 2, 0x03, 226 },
+    { 1, 0x02, 227 },
+    { 2, 0x03, 227 },
+    { 1, 0x02, 228 },
+    { 2, 0x03, 228 },
+    { 1, 0x02, 229 },
+    { 2, 0x03, 229 },
+    { 1, 0x02, 230 },
+    { 2, 0x03, 230 },
+    { 1, 0x02, 231 },
+    { 2, 0x03, 231 }
+  },
+  /* 122 */
+  {
+    { 1, 0x02, 232 },
+    { 2, 0x03, 232 },
+    { 1, 0x02, 233 },
+    { 2, 0x03, 233 },
+    { 1, 0x02, 234 },
+    { 2, 0x03, 234 },
+    { 1, 0x02, 235 },
+    { 2, 0x03, 235 },
+    { 1, 0x02, 236 },
+    { 2, 0x03, 236 },
+    { 1, 0x02, 237 },
+    { 2, 0x03, 237 },
+    { 1, 0x02, 238 },
+    { 2, 0x03, 238 },
+    { 1, 0x02, 239 },
+    { 2, 0x03, 239 }
+  },
+  /* 123 */
+  {
+    { 1, 0x02, 240 },
+    { 2, 0x03, 240 },
+    { 1, 0x02, 241 },
+    { 2, 0x03, 241 },
+    { 1, 0x02, 242 },
+    { 2, 0x03, 242 },
+    { 1, 0x02, 243 },
+    { 2, 0x03, 243 },
+    { 1, 0x02, 244 },
+    { 2, 0x03, 244 },
+    { 1, 0x02, 245 },
+    { 2, 0x03, 245 },
+    { 1, 0x02, 246 },
+    { 2, 0x03, 246 },
+    { 1, 0x02, 247 },
+    { 2, 0x03, 247 }
+  },
+  /* 124 */
+  {
+    { 1, 0x02, 248 },
+    { 2, 0x03, 248 },
+    { 1, 0x02, 249 },
+    { 2, 0x03, 249 },
+    { 1, 0x02, 250 },
+    { 2, 0x03, 250 },
+    { 1, 0x02, 251 },
+    { 2, 0x03, 251 },
+    { 1, 0x02, 252 },
+    { 2, 0x03, 252 },
+    { 1, 0x02, 253 },
+    { 2, 0x03, 253 },
+    { 1, 0x02, 254 },
+    { 2, 0x03, 254 },
+    { 0, 0x04, 0 },
+    { 0, 0x04, 0 }
+  },
+  /* 125 */
+  {
+    { 7, 0x02, 255 },
+    { 8, 0x02, 255 },
+    { 9, 0x02, 255 },
+    { 10, 0x02, 255 },
+    { 11, 0x02, 255 },
+    { 12, 0x02, 255 },
+    { 13, 0x02, 255 },
+    { 14, 0x03, 255 },
+    { 3, 0x02, 0 },
+    { 4, 0x02, 0 },
+    { 5, 0x02, 0 },
+    { 6, 0x03, 0 },
+    { 3, 0x02, 1 },
+    { 4, 0x02, 1 },
+    { 5, 0x02, 1 },
+    { 6, 0x03, 1 }
+  },
+  /* 126 */
+  {
+    { 3, 0x02, 2 },
+    { 4, 0x02, 2 },
+    { 5, 0x02, 2 },
+    { 6, 0x03, 2 },
+    { 3, 0x02, 3 },
+    { 4, 0x02, 3 },
+    { 5, 0x02, 3 },
+    { 6, 0x03, 3 },
+    { 3, 0x02, 4 },
+    { 4, 0x02, 4 },
+    { 5, 0x02, 4 },
+    { 6, 0x03, 4 },
+    { 3, 0x02, 5 },
+    { 4, 0x02, 5 },
+    { 5, 0x02, 5 },
+    { 6, 0x03, 5 }
+  },
+  /* 127 */
+  {
+    { 3, 0x02, 6 },
+    { 4, 0x02, 6 },
+    { 5, 0x02, 6 },
+    { 6, 0x03, 6 },
+    { 3, 0x02, 7 },
+    { 4, 0x02, 7 },
+    { 5, 0x02, 7 },
+    { 6, 0x03, 7 },
+    { 3, 0x02, 8 },
+    { 4, 0x02, 8 },
+    { 5, 0x02, 8 },
+    { 6, 0x03, 8 },
+    { 3, 0x02, 9 },
+    { 4, 0x02, 9 },
+    { 5, 0x02, 9 },
+    { 6, 0x03, 9 }
+  },
+  /* 128 */
+  {
+    { 3, 0x02, 10 },
+    { 4, 0x02, 10 },
+    { 5, 0x02, 10 },
+    { 6, 0x03, 10 },
+    { 3, 0x02, 11 },
+    { 4, 0x02, 11 },
+    { 5, 0x02, 11 },
+    { 6, 0x03, 11 },
+    { 3, 0x02, 12 },
+    { 4, 0x02, 12 },
+    { 5, 0x02, 12 },
+    { 6, 0x03, 12 },
+    { 3, 0x02, 13 },
+    { 4, 0x02, 13 },
+    { 5, 0x02, 13 },
+    { 6, 0x03, 13 }
+  },
+  /* 129 */
+  {
+    { 3, 0x02, 14 },
+    { 4, 0x02, 14 },
+    { 5, 0x02, 14 },
+    { 6, 0x03, 14 },
+    { 3, 0x02, 15 },
+    { 4, 0x02, 15 },
+    { 5, 0x02, 15 },
+    { 6, 0x03, 15 },
+    { 3, 0x02, 16 },
+    { 4, 0x02, 16 },
+    { 5, 0x02, 16 },
+    { 6, 0x03, 16 },
+    { 3, 0x02, 17 },
+    { 4, 0x02, 17 },
+    { 5, 0x02, 17 },
+    { 6, 0x03, 17 }
+  },
+  /* 130 */
+  {
+    { 3, 0x02, 18 },
+    { 4, 0x02, 18 },
+    { 5, 0x02, 18 },
+    { 6, 0x03, 18 },
+    { 3, 0x02, 19 },
+    { 4, 0x02, 19 },
+    { 5, 0x02, 19 },
+    { 6, 0x03, 19 },
+    { 3, 0x02, 20 },
+    { 4, 0x02, 20 },
+    { 5, 0x02, 20 },
+    { 6, 0x03, 20 },
+    { 3, 0x02, 21 },
+    { 4, 0x02, 21 },
+    { 5, 0x02, 21 },
+    { 6, 0x03, 21 }
+  },
+  /* 131 */
+  {
+    { 3, 0x02, 22 },
+    { 4, 0x02, 22 },
+    { 5, 0x02, 22 },
+    { 6, 0x03, 22 },
+    { 3, 0x02, 23 },
+    { 4, 0x02, 23 },
+    { 5, 0x02, 23 },
+    { 6, 0x03, 23 },
+    { 3, 0x02, 24 },
+    { 4, 0x02, 24 },
+    { 5, 0x02, 24 },
+    { 6, 0x03, 24 },
+    { 3, 0x02, 25 },
+    { 4, 0x02, 25 },
+    { 5, 0x02, 25 },
+    { 6, 0x03, 25 }
+  },
+  /* 132 */
+  {
+    { 3, 0x02, 26 },
+    { 4, 0x02, 26 },
+    { 5, 0x02, 26 },
+    { 6, 0x03, 26 },
+    { 3, 0x02, 27 },
+    { 4, 0x02, 27 },
+    { 5, 0x02, 27 },
+    { 6, 0x03, 27 },
+    { 3, 0x02, 28 },
+    { 4, 0x02, 28 },
+    { 5, 0x02, 28 },
+    { 6, 0x03, 28 },
+    { 3, 0x02, 29 },
+    { 4, 0x02, 29 },
+    { 5, 0x02, 29 },
+    { 6, 0x03, 29 }
+  },
+  /* 133 */
+  {
+    { 3, 0x02, 30 },
+    { 4, 0x02, 30 },
+    { 5, 0x02, 30 },
+    { 6, 0x03, 30 },
+    { 3, 0x02, 31 },
+    { 4, 0x02, 31 },
+    { 5, 0x02, 31 },
+    { 6, 0x03, 31 },
+    { 3, 0x02, 33 },
+    { 4, 0x02, 33 },
+    { 5, 0x02, 33 },
+    { 6, 0x03, 33 },
+    { 3, 0x02, 35 },
+    { 4, 0x02, 35 },
+    { 5, 0x02, 35 },
+    { 6, 0x03, 35 }
+  },
+  /* 134 */
+  {
+    { 3, 0x02, 36 },
+    { 4, 0x02, 36 },
+    { 5, 0x02, 36 },
+    { 6, 0x03, 36 },
+    { 3, 0x02, 37 },
+    { 4, 0x02, 37 },
+    { 5, 0x02, 37 },
+    { 6, 0x03, 37 },
+    { 3, 0x02, 39 },
+    { 4, 0x02, 39 },
+    { 5, 0x02, 39 },
+    { 6, 0x03, 39 },
+    { 3, 0x02, 64 },
+    { 4, 0x02, 64 },
+    { 5, 0x02, 64 },
+    { 6, 0x03, 64 }
+  },
+  /* 135 */
+  {
+    { 3, 0x02, 91 },
+    { 4, 0x02, 91 },
+    { 5, 0x02, 91 },
+    { 6, 0x03, 91 },
+    { 3, 0x02, 92 },
+    { 4, 0x02, 92 },
+    { 5, 0x02, 92 },
+    { 6, 0x03, 92 },
+    { 3, 0x02, 93 },
+    { 4, 0x02, 93 },
+    { 5, 0x02, 93 },
+    { 6, 0x03, 93 },
+    { 3, 0x02, 94 },
+    { 4, 0x02, 94 },
+    { 5, 0x02, 94 },
+    { 6, 0x03, 94 }
+  },
+  /* 136 */
+  {
+    { 3, 0x02, 96 },
+    { 4, 0x02, 96 },
+    { 5, 0x02, 96 },
+    { 6, 0x03, 96 },
+    { 3, 0x02, 123 },
+    { 4, 0x02, 123 },
+    { 5, 0x02, 123 },
+    { 6, 0x03, 123 },
+    { 3, 0x02, 125 },
+    { 4, 0x02, 125 },
+    { 5, 0x02, 125 },
+    { 6, 0x03, 125 },
+    { 3, 0x02, 127 },
+    { 4, 0x02, 127 },
+    { 5, 0x02, 127 },
+    { 6, 0x03, 127 }
+  },
+  /* 137 */
+  {
+    { 3, 0x02, 128 },
+    { 4, 0x02, 128 },
+    { 5, 0x02, 128 },
+    { 6, 0x03, 128 },
+    { 3, 0x02, 129 },
+    { 4, 0x02, 129 },
+    { 5, 0x02, 129 },
+    { 6, 0x03, 129 },
+    { 3, 0x02, 130 },
+    { 4, 0x02, 130 },
+    { 5, 0x02, 130 },
+    { 6, 0x03, 130 },
+    { 3, 0x02, 131 },
+    { 4, 0x02, 131 },
+    { 5, 0x02, 131 },
+    { 6, 0x03, 131 }
+  },
+  /* 138 */
+  {
+    { 3, 0x02, 132 },
+    { 4, 0x02, 132 },
+    { 5, 0x02, 132 },
+    { 6, 0x03, 132 },
+    { 3, 0x02, 133 },
+    { 4, 0x02, 133 },
+    { 5, 0x02, 133 },
+    { 6, 0x03, 133 },
+    { 3, 0x02, 134 },
+    { 4, 0x02, 134 },
+    { 5, 0x02, 134 },
+    { 6, 0x03, 134 },
+    { 3, 0x02, 135 },
+    { 4, 0x02, 135 },
+    { 5, 0x02, 135 },
+    { 6, 0x03, 135 }
+  },
+  /* 139 */
+  {
+    { 3, 0x02, 136 },
+    { 4, 0x02, 136 },
+    { 5, 0x02, 136 },
+    { 6, 0x03, 136 },
+    { 3, 0x02, 137 },
+    { 4, 0x02, 137 },
+    { 5, 0x02, 137 },
+    { 6, 0x03, 137 },
+    { 3, 0x02, 138 },
+    { 4, 0x02, 138 },
+    { 5, 0x02, 138 },
+    { 6, 0x03, 138 },
+    { 3, 0x02, 139 },
+    { 4, 0x02, 139 },
+    { 5, 0x02, 139 },
+    { 6, 0x03, 139 }
+  },
+  /* 140 */
+  {
+    { 3, 0x02, 140 },
+    { 4, 0x02, 140 },
+    { 5, 0x02, 140 },
+    { 6, 0x03, 140 },
+    { 3, 0x02, 141 },
+    { 4, 0x02, 141 },
+    { 5, 0x02, 141 },
+    { 6, 0x03, 141 },
+    { 3, 0x02, 142 },
+    { 4, 0x02, 142 },
+    { 5, 0x02, 142 },
+    { 6, 0x03, 142 },
+    { 3, 0x02, 143 },
+    { 4, 0x02, 143 },
+    { 5, 0x02, 143 },
+    { 6, 0x03, 143 }
+  },
+  /* 141 */
+  {
+    { 3, 0x02, 144 },
+    { 4, 0x02, 144 },
+    { 5, 0x02, 144 },
+    { 6, 0x03, 144 },
+    { 3, 0x02, 145 },
+    { 4, 0x02, 145 },
+    { 5, 0x02, 145 },
+    { 6, 0x03, 145 },
+    { 3, 0x02, 146 },
+    { 4, 0x02, 146 },
+    { 5, 0x02, 146 },
+    { 6, 0x03, 146 },
+    { 3, 0x02, 147 },
+    { 4, 0x02, 147 },
+    { 5, 0x02, 147 },
+    { 6, 0x03, 147 }
+  },
+  /* 142 */
+  {
+    { 3, 0x02, 148 },
+    { 4, 0x02, 148 },
+    { 5, 0x02, 148 },
+    { 6, 0x03, 148 },
+    { 3, 0x02, 149 },
+    { 4, 0x02, 149 },
+    { 5, 0x02, 149 },
+    { 6, 0x03, 149 },
+    { 3, 0x02, 150 },
+    { 4, 0x02, 150 },
+    { 5, 0x02, 150 },
+    { 6, 0x03, 150 },
+    { 3, 0x02, 151 },
+    { 4, 0x02, 151 },
+    { 5, 0x02, 151 },
+    { 6, 0x03, 151 }
+  },
+  /* 143 */
+  {
+    { 3, 0x02, 152 },
+    { 4, 0x02, 152 },
+    { 5, 0x02, 152 },
+    { 6, 0x03, 152 },
+    { 3, 0x02, 153 },
+    { 4, 0x02, 153 },
+    { 5, 0x02, 153 },
+    { 6, 0x03, 153 },
+    { 3, 0x02, 154 },
+    { 4, 0x02, 154 },
+    { 5, 0x02, 154 },
+    { 6, 0x03, 154 },
+    { 3, 0x02, 155 },
+    { 4, 0x02, 155 },
+    { 5, 0x02, 155 },
+    { 6, 0x03, 155 }
+  },
+  /* 144 */
+  {
+    { 3, 0x02, 156 },
+    { 4, 0x02, 156 },
+    { 5, 0x02, 156 },
+    { 6, 0x03, 156 },
+    { 3, 0x02, 157 },
+    { 4, 0x02, 157 },
+    { 5, 0x02, 157 },
+    { 6, 0x03, 157 },
+    { 3, 0x02, 158 },
+    { 4, 0x02, 158 },
+    { 5, 0x02, 158 },
+    { 6, 0x03, 158 },
+    { 3, 0x02, 159 },
+    { 4, 0x02, 159 },
+    { 5, 0x02, 159 },
+    { 6, 0x03, 159 }
+  },
+  /* 145 */
+  {
+    { 3, 0x02, 160 },
+    { 4, 0x02, 160 },
+    { 5, 0x02, 160 },
+    { 6, 0x03, 160 },
+    { 3, 0x02, 161 },
+    { 4, 0x02, 161 },
+    { 5, 0x02, 161 },
+    { 6, 0x03, 161 },
+    { 3, 0x02, 162 },
+    { 4, 0x02, 162 },
+    { 5, 0x02, 162 },
+    { 6, 0x03, 162 },
+    { 3, 0x02, 163 },
+    { 4, 0x02, 163 },
+    { 5, 0x02, 163 },
+    { 6, 0x03, 163 }
+  },
+  /* 146 */
+  {
+    { 3, 0x02, 164 },
+    { 4, 0x02, 164 },
+    { 5, 0x02, 164 },
+    { 6, 0x03, 164 },
+    { 3, 0x02, 165 },
+    { 4, 0x02, 165 },
+    { 5, 0x02, 165 },
+    { 6, 0x03, 165 },
+    { 3, 0x02, 166 },
+    { 4, 0x02, 166 },
+    { 5, 0x02, 166 },
+    { 6, 0x03, 166 },
+    { 3, 0x02, 167 },
+    { 4, 0x02, 167 },
+    { 5, 0x02, 167 },
+    { 6, 0x03, 167 }
+  },
+  /* 147 */
+  {
+    { 3, 0x02, 168 },
+    { 4, 0x02, 168 },
+    { 5, 0x02, 168 },
+    { 6, 0x03, 168 },
+    { 3, 0x02, 169 },
+    { 4, 0x02, 169 },
+    { 5, 0x02, 169 },
+    { 6, 0x03, 169 },
+    { 3, 0x02, 170 },
+    { 4, 0x02, 170 },
+    { 5, 0x02, 170 },
+    { 6, 0x03, 170 },
+    { 3, 0x02, 171 },
+    { 4, 0x02, 171 },
+    { 5, 0x02, 171 },
+    { 6, 0x03, 171 }
+  },
+  /* 148 */
+  {
+    { 3, 0x02, 172 },
+    { 4, 0x02, 172 },
+    { 5, 0x02, 172 },
+    { 6, 0x03, 172 },
+    { 3, 0x02, 173 },
+    { 4, 0x02, 173 },
+    { 5, 0x02, 173 },
+    { 6, 0x03, 173 },
+    { 3, 0x02, 174 },
+    { 4, 0x02, 174 },
+    { 5, 0x02, 174 },
+    { 6, 0x03, 174 },
+    { 3, 0x02, 175 },
+    { 4, 0x02, 175 },
+    { 5, 0x02, 175 },
+    { 6, 0x03, 175 }
+  },
+  /* 149 */
+  {
+    { 3, 0x02, 176 },
+    { 4, 0x02, 176 },
+    { 5, 0x02, 176 },
+    { 6, 0x03, 176 },
+    { 3, 0x02, 177 },
+    { 4, 0x02, 177 },
+    { 5, 0x02, 177 },
+    { 6, 0x03, 177 },
+    { 3, 0x02, 178 },
+    { 4, 0x02, 178 },
+    { 5, 0x02, 178 },
+    { 6, 0x03, 178 },
+    { 3, 0x02, 179 },
+    { 4, 0x02, 179 },
+    { 5, 0x02, 179 },
+    { 6, 0x03, 179 }
+  },
+  /* 150 */
+  {
+    { 3, 0x02, 180 },
+    { 4, 0x02, 180 },
+    { 5, 0x02, 180 },
+    { 6, 0x03, 180 },
+    { 3, 0x02, 181 },
+    { 4, 0x02, 181 },
+    { 5, 0x02, 181 },
+    { 6, 0x03, 181 },
+    { 3, 0x02, 182 },
+    { 4, 0x02, 182 },
+    { 5, 0x02, 182 },
+    { 6, 0x03, 182 },
+    { 3, 0x02, 183 },
+    { 4, 0x02, 183 },
+    { 5, 0x02, 183 },
+    { 6, 0x03, 183 }
+  },
+  /* 151 */
+  {
+    { 3, 0x02, 184 },
+    { 4, 0x02, 184 },
+    { 5, 0x02, 184 },
+    { 6, 0x03, 184 },
+    { 3, 0x02, 185 },
+    { 4, 0x02, 185 },
+    { 5, 0x02, 185 },
+    { 6, 0x03, 185 },
+    { 3, 0x02, 186 },
+    { 4, 0x02, 186 },
+    { 5, 0x02, 186 },
+    { 6, 0x03, 186 },
+    { 3, 0x02, 187 },
+    { 4, 0x02, 187 },
+    { 5, 0x02, 187 },
+    { 6, 0x03, 187 }
+  },
+  /* 152 */
+  {
+    { 3, 0x02, 188 },
+    { 4, 0x02, 188 },
+    { 5, 0x02, 188 },
+    { 6, 0x03, 188 },
+    { 3, 0x02, 189 },
+    { 4, 0x02, 189 },
+    { 5, 0x02, 189 },
+    { 6, 0x03, 189 },
+    { 3, 0x02, 190 },
+    { 4, 0x02, 190 },
+    { 5, 0x02, 190 },
+    { 6, 0x03, 190 },
+    { 3, 0x02, 191 },
+    { 4, 0x02, 191 },
+    { 5, 0x02, 191 },
+    { 6, 0x03, 191 }
+  },
+  /* 153 */
+  {
+    { 3, 0x02, 192 },
+    { 4, 0x02, 192 },
+    { 5, 0x02, 192 },
+    { 6, 0x03, 192 },
+    { 3, 0x02, 193 },
+    { 4, 0x02, 193 },
+    { 5, 0x02, 193 },
+    { 6, 0x03, 193 },
+    { 3, 0x02, 194 },
+    { 4, 0x02, 194 },
+    { 5, 0x02, 194 },
+    { 6, 0x03, 194 },
+    { 3, 0x02, 195 },
+    { 4, 0x02, 195 },
+    { 5, 0x02, 195 },
+    { 6, 0x03, 195 }
+  },
+  /* 154 */
+  {
+    { 3, 0x02, 196 },
+    { 4, 0x02, 196 },
+    { 5, 0x02, 196 },
+    { 6, 0x03, 196 },
+    { 3, 0x02, 197 },
+    { 4, 0x02, 197 },
+    { 5, 0x02, 197 },
+    { 6, 0x03, 197 },
+    { 3, 0x02, 198 },
+    { 4, 0x02, 198 },
+    { 5, 0x02, 198 },
+    { 6, 0x03, 198 },
+    { 3, 0x02, 199 },
+    { 4, 0x02, 199 },
+    { 5, 0x02, 199 },
+    { 6, 0x03, 199 }
+  },
+  /* 155 */
+  {
+    { 3, 0x02, 200 },
+    { 4, 0x02, 200 },
+    { 5, 0x02, 200 },
+    { 6, 0x03, 200 },
+    { 3, 0x02, 201 },
+    { 4, 0x02, 201 },
+    { 5, 0x02, 201 },
+    { 6, 0x03, 201 },
+    { 3, 0x02, 202 },
+    { 4, 0x02, 202 },
+    { 5, 0x02, 202 },
+    { 6, 0x03, 202 },
+    { 3, 0x02, 203 },
+    { 4, 0x02, 203 },
+    { 5, 0x02, 203 },
+    { 6, 0x03, 203 }
+  },
+  /* 156 */
+  {
+    { 3, 0x02, 204 },
+    { 4, 0x02, 204 },
+    { 5, 0x02, 204 },
+    { 6, 0x03, 204 },
+    { 3, 0x02, 205 },
+    { 4, 0x02, 205 },
+    { 5, 0x02, 205 },
+    { 6, 0x03, 205 },
+    { 3, 0x02, 206 },
+    { 4, 0x02, 206 },
+    { 5, 0x02, 206 },
+    { 6, 0x03, 206 },
+    { 3, 0x02, 207 },
+    { 4, 0x02, 207 },
+    { 5, 0x02, 207 },
+    { 6, 0x03, 207 }
+  },
+  /* 157 */
+  {
+    { 3, 0x02, 208 },
+    { 4, 0x02, 208 },
+    { 5, 0x02, 208 },
+    { 6, 0x03, 208 },
+    { 3, 0x02, 209 },
+    { 4, 0x02, 209 },
+    { 5, 0x02, 209 },
+    { 6, 0x03, 209 },
+    { 3, 0x02, 210 },
+    { 4, 0x02, 210 },
+    { 5, 0x02, 210 },
+    { 6, 0x03, 210 },
+    { 3, 0x02, 211 },
+    { 4, 0x02, 211 },
+    { 5, 0x02, 211 },
+    { 6, 0x03, 211 }
+  },
+  /* 158 */
+  {
+    { 3, 0x02, 212 },
+    { 4, 0x02, 212 },
+    { 5, 0x02, 212 },
+    { 6, 0x03, 212 },
+    { 3, 0x02, 213 },
+    { 4, 0x02, 213 },
+    { 5, 0x02, 213 },
+    { 6, 0x03, 213 },
+    { 3, 0x02, 214 },
+    { 4, 0x02, 214 },
+    { 5, 0x02, 214 },
+    { 6, 0x03, 214 },
+    { 3, 0x02, 215 },
+    { 4, 0x02, 215 },
+    { 5, 0x02, 215 },
+    { 6, 0x03, 215 }
+  },
+  /* 159 */
+  {
+    { 3, 0x02, 216 },
+    { 4, 0x02, 216 },
+    { 5, 0x02, 216 },
+    { 6, 0x03, 216 },
+    { 3, 0x02, 217 },
+    { 4, 0x02, 217 },
+    { 5, 0x02, 217 },
+    { 6, 0x03, 217 },
+    { 3, 0x02, 218 },
+    { 4, 0x02, 218 },
+    { 5, 0x02, 218 },
+    { 6, 0x03, 218 },
+    { 3, 0x02, 219 },
+    { 4, 0x02, 219 },
+    { 5, 0x02, 219 },
+    { 6, 0x03, 219 }
+  },
+  /* 160 */
+  {
+    { 3, 0x02, 220 },
+    { 4, 0x02, 220 },
+    { 5, 0x02, 220 },
+    { 6, 0x03, 220 },
+    { 3, 0x02, 221 },
+    { 4, 0x02, 221 },
+    { 5, 0x02, 221 },
+    { 6, 0x03, 221 },
+    { 3, 0x02, 222 },
+    { 4, 0x02, 222 },
+    { 5, 0x02, 222 },
+    { 6, 0x03, 222 },
+    { 3, 0x02, 223 },
+    { 4, 0x02, 223 },
+    { 5, 0x02, 223 },
+    { 6, 0x03, 223 }
+  },
+  /* 161 */
+  {
+    { 3, 0x02, 224 },
+    { 4, 0x02, 224 },
+    { 5, 0x02, 224 },
+    { 6, 0x03, 224 },
+    { 3, 0x02, 225 },
+    { 4, 0x02, 225 },
+    { 5, 0x02, 225 },
+    { 6, 0x03, 225 },
+    { 3, 0x02, 226 },
+    { 4, 0x02, 226 },
+    { 5, 0x02, 226 },
+    { 6, 0x03, 226 },
+    { 3, 0x02, 227 },
+    { 4, 0x02, 227 },
+    { 5, 0x02, 227 },
+    { 6, 0x03, 227 }
+  },
+  /* 162 */
+  {
+    { 3, 0x02, 228 },
+    { 4, 0x02, 228 },
+    { 5, 0x02, 228 },
+    { 6, 0x03, 228 },
+    { 3, 0x02, 229 },
+    { 4, 0x02, 229 },
+    { 5, 0x02, 229 },
+    { 6, 0x03, 229 },
+    { 3, 0x02, 230 },
+    { 4, 0x02, 230 },
+    { 5, 0x02, 230 },
+    { 6, 0x03, 230 },
+    { 3, 0x02, 231 },
+    { 4, 0x02, 231 },
+    { 5, 0x02, 231 },
+    { 6, 0x03, 231 }
+  },
+  /* 163 */
+  {
+    { 3, 0x02, 232 },
+    { 4, 0x02, 232 },
+    { 5, 0x02, 232 },
+    { 6, 0x03, 232 },
+    { 3, 0x02, 233 },
+    { 4, 0x02, 233 },
+    { 5, 0x02, 233 },
+    { 6, 0x03, 233 },
+    { 3, 0x02, 234 },
+    { 4, 0x02, 234 },
+    { 5, 0x02, 234 },
+    { 6, 0x03, 234 },
+    { 3, 0x02, 235 },
+    { 4, 0x02, 235 },
+    { 5, 0x02, 235 },
+    { 6, 0x03, 235 }
+  },
+  /* 164 */
+  {
+    { 3, 0x02, 236 },
+    { 4, 0x02, 236 },
+    { 5, 0x02, 236 },
+    { 6, 0x03, 236 },
+    { 3, 0x02, 237 },
+    { 4, 0x02, 237 },
+    { 5, 0x02, 237 },
+    { 6, 0x03, 237 },
+    { 3, 0x02, 238 },
+    { 4, 0x02, 238 },
+    { 5, 0x02, 238 },
+    { 6, 0x03, 238 },
+    { 3, 0x02, 239 },
+    { 4, 0x02, 239 },
+    { 5, 0x02, 239 },
+    { 6, 0x03, 239 }
+  },
+  /* 165 */
+  {
+    { 3, 0x02, 240 },
+    { 4, 0x02, 240 },
+    { 5, 0x02, 240 },
+    { 6, 0x03, 240 },
+    { 3, 0x02, 241 },
+    { 4, 0x02, 241 },
+    { 5, 0x02, 241 },
+    { 6, 0x03, 241 },
+    { 3, 0x02, 242 },
+    { 4, 0x02, 242 },
+    { 5, 0x02, 242 },
+    { 6, 0x03, 242 },
+    { 3, 0x02, 243 },
+    { 4, 0x02, 243 },
+    { 5, 0x02, 243 },
+    { 6, 0x03, 243 }
+  },
+  /* 166 */
+  {
+    { 3, 0x02, 244 },
+    { 4, 0x02, 244 },
+    { 5, 0x02, 244 },
+    { 6, 0x03, 244 },
+    { 3, 0x02, 245 },
+    { 4, 0x02, 245 },
+    { 5, 0x02, 245 },
+    { 6, 0x03, 245 },
+    { 3, 0x02, 246 },
+    { 4, 0x02, 246 },
+    { 5, 0x02, 246 },
+    { 6, 0x03, 246 },
+    { 3, 0x02, 247 },
+    { 4, 0x02, 247 },
+    { 5, 0x02, 247 },
+    { 6, 0x03, 247 }
+  },
+  /* 167 */
+  {
+    { 3, 0x02, 248 },
+    { 4, 0x02, 248 },
+    { 5, 0x02, 248 },
+    { 6, 0x03, 248 },
+    { 3, 0x02, 249 },
+    { 4, 0x02, 249 },
+    { 5, 0x02, 249 },
+    { 6, 0x03, 249 },
+    { 3, 0x02, 250 },
+    { 4, 0x02, 250 },
+    { 5, 0x02, 250 },
+    { 6, 0x03, 250 },
+    { 3, 0x02, 251 },
+    { 4, 0x02, 251 },
+    { 5, 0x02, 251 },
+    { 6, 0x03, 251 }
+  },
+  /* 168 */
+  {
+    { 3, 0x02, 252 },
+    { 4, 0x02, 252 },
+    { 5, 0x02, 252 },
+    { 6, 0x03, 252 },
+    { 3, 0x02, 253 },
+    { 4, 0x02, 253 },
+    { 5, 0x02, 253 },
+    { 6, 0x03, 253 },
+    { 3, 0x02, 254 },
+    { 4, 0x02, 254 },
+    { 5, 0x02, 254 },
+    { 6, 0x03, 254 },
+    { 0, 0x04, 0 },
+    { 0, 0x04, 0 },
+    { 0, 0x04, 0 },
+    { 0, 0x04, 0 }
+  },
+  /* 169 */
+  {
+    { 7, 0x02, 0 },
+    { 8, 0x02, 0 },
+    { 9, 0x02, 0 },
+    { 10, 0x02, 0 },
+    { 11, 0x02, 0 },
+    { 12, 0x02, 0 },
+    { 13, 0x02, 0 },
+    { 14, 0x03, 0 },
+    { 7, 0x02, 1 },
+    { 8, 0x02, 1 },
+    { 9, 0x02, 1 },
+    { 10, 0x02, 1 },
+    { 11, 0x02, 1 },
+    { 12, 0x02, 1 },
+    { 13, 0x02, 1 },
+    { 14, 0x03, 1 }
+  },
+  /* 170 */
+  {
+    { 7, 0x02, 2 },
+    { 8, 0x02, 2 },
+    { 9, 0x02, 2 },
+    { 10, 0x02, 2 },
+    { 11, 0x02, 2 },
+    { 12, 0x02, 2 },
+    { 13, 0x02, 2 },
+    { 14, 0x03, 2 },
+    { 7, 0x02, 3 },
+    { 8, 0x02, 3 },
+    { 9, 0x02, 3 },
+    { 10, 0x02, 3 },
+    { 11, 0x02, 3 },
+    { 12, 0x02, 3 },
+    { 13, 0x02, 3 },
+    { 14, 0x03, 3 }
+  },
+  /* 171 */
+  {
+    { 7, 0x02, 4 },
+    { 8, 0x02, 4 },
+    { 9, 0x02, 4 },
+    { 10, 0x02, 4 },
+    { 11, 0x02, 4 },
+    { 12, 0x02, 4 },
+    { 13, 0x02, 4 },
+    { 14, 0x03, 4 },
+    { 7, 0x02, 5 },
+    { 8, 0x02, 5 },
+    { 9, 0x02, 5 },
+    { 10, 0x02, 5 },
+    { 11, 0x02, 5 },
+    { 12, 0x02, 5 },
+    { 13, 0x02, 5 },
+    { 14, 0x03, 5 }
+  },
+  /* 172 */
+  {
+    { 7, 0x02, 6 },
+    { 8, 0x02, 6 },
+    { 9, 0x02, 6 },
+    { 10, 0x02, 6 },
+    { 11, 0x02, 6 },
+    { 12, 0x02, 6 },
+    { 13, 0x02, 6 },
+    { 14, 0x03, 6 },
+    { 7, 0x02, 7 },
+    { 8, 0x02, 7 },
+    { 9, 0x02, 7 },
+    { 10, 0x02, 7 },
+    { 11, 0x02, 7 },
+    { 12, 0x02, 7 },
+    { 13, 0x02, 7 },
+    { 14, 0x03, 7 }
+  },
+  /* 173 */
+  {
+    { 7, 0x02, 8 },
+    { 8, 0x02, 8 },
+    { 9, 0x02, 8 },
+    { 10, 0x02, 8 },
+    { 11, 0x02, 8 },
+    { 12, 0x02, 8 },
+    { 13, 0x02, 8 },
+    { 14, 0x03, 8 },
+    { 7, 0x02, 9 },
+    { 8, 0x02, 9 },
+    { 9, 0x02, 9 },
+    { 10, 0x02, 9 },
+    { 11, 0x02, 9 },
+    { 12, 0x02, 9 },
+    { 13, 0x02, 9 },
+    { 14, 0x03, 9 }
+  },
+  /* 174 */
+  {
+    { 7, 0x02, 10 },
+    { 8, 0x02, 10 },
+    { 9, 0x02, 10 },
+    { 10, 0x02, 10 },
+    { 11, 0x02, 10 },
+    { 12, 0x02, 10 },
+    { 13, 0x02, 10 },
+    { 14, 0x03, 10 },
+    { 7, 0x02, 11 },
+    { 8, 0x02, 11 },
+    { 9, 0x02, 11 },
+    { 10, 0x02, 11 },
+    { 11, 0x02, 11 },
+    { 12, 0x02, 11 },
+    { 13, 0x02, 11 },
+    { 14, 0x03, 11 }
+  },
+  /* 175 */
+  {
+    { 7, 0x02, 12 },
+    { 8, 0x02, 12 },
+    { 9, 0x02, 12 },
+    { 10, 0x02, 12 },
+    { 11, 0x02, 12 },
+    { 12, 0x02, 12 },
+    { 13, 0x02, 12 },
+    { 14, 0x03, 12 },
+    { 7, 0x02, 13 },
+    { 8, 0x02, 13 },
+    { 9, 0x02, 13 },
+    { 10, 0x02, 13 },
+    { 11, 0x02, 13 },
+    { 12, 0x02, 13 },
+    { 13, 0x02, 13 },
+    { 14, 0x03, 13 }
+  },
+  /* 176 */
+  {
+    { 7, 0x02, 14 },
+    { 8, 0x02, 14 },
+    { 9, 0x02, 14 },
+    { 10, 0x02, 14 },
+    { 11, 0x02, 14 },
+    { 12, 0x02, 14 },
+    { 13, 0x02, 14 },
+    { 14, 0x03, 14 },
+    { 7, 0x02, 15 },
+    { 8, 0x02, 15 },
+    { 9, 0x02, 15 },
+    { 10, 0x02, 15 },
+    { 11, 0x02, 15 },
+    { 12, 0x02, 15 },
+    { 13, 0x02, 15 },
+    { 14, 0x03, 15 }
+  },
+  /* 177 */
+  {
+    { 7, 0x02, 16 },
+    { 8, 0x02, 16 },
+    { 9, 0x02, 16 },
+    { 10, 0x02, 16 },
+    { 11, 0x02, 16 },
+    { 12, 0x02, 16 },
+    { 13, 0x02, 16 },
+    { 14, 0x03, 16 },
+    { 7, 0x02, 17 },
+    { 8, 0x02, 17 },
+    { 9, 0x02, 17 },
+    { 10, 0x02, 17 },
+    { 11, 0x02, 17 },
+    { 12, 0x02, 17 },
+    { 13, 0x02, 17 },
+    { 14, 0x03, 17 }
+  },
+  /* 178 */
+  {
+    { 7, 0x02, 18 },
+    { 8, 0x02, 18 },
+    { 9, 0x02, 18 },
+    { 10, 0x02, 18 },
+    { 11, 0x02, 18 },
+    { 12, 0x02, 18 },
+    { 13, 0x02, 18 },
+    { 14, 0x03, 18 },
+    { 7, 0x02, 19 },
+    { 8, 0x02, 19 },
+    { 9, 0x02, 19 },
+    { 10, 0x02, 19 },
+    { 11, 0x02, 19 },
+    { 12, 0x02, 19 },
+    { 13, 0x02, 19 },
+    { 14, 0x03, 19 }
+  },
+  /* 179 */
+  {
+    { 7, 0x02, 20 },
+    { 8, 0x02, 20 },
+    { 9, 0x02, 20 },
+    { 10, 0x02, 20 },
+    { 11, 0x02, 20 },
+    { 12, 0x02, 20 },
+    { 13, 0x02, 20 },
+    { 14, 0x03, 20 },
+    { 7, 0x02, 21 },
+    { 8, 0x02, 21 },
+    { 9, 0x02, 21 },
+    { 10, 0x02, 21 },
+    { 11, 0x02, 21 },
+    { 12, 0x02, 21 },
+    { 13, 0x02, 21 },
+    { 14, 0x03, 21 }
+  },
+  /* 180 */
+  {
+    { 7, 0x02, 22 },
+    { 8, 0x02, 22 },
+    { 9, 0x02, 22 },
+    { 10, 0x02, 22 },
+    { 11, 0x02, 22 },
+    { 12, 0x02, 22 },
+    { 13, 0x02, 22 },
+    { 14, 0x03, 22 },
+    { 7, 0x02, 23 },
+    { 8, 0x02, 23 },
+    { 9, 0x02, 23 },
+    { 10, 0x02, 23 },
+    { 11, 0x02, 23 },
+    { 12, 0x02, 23 },
+    { 13, 0x02, 23 },
+    { 14, 0x03, 23 }
+  },
+  /* 181 */
+  {
+    { 7, 0x02, 24 },
+    { 8, 0x02, 24 },
+    { 9, 0x02, 24 },
+    { 10, 0x02, 24 },
+    { 11, 0x02, 24 },
+    { 12, 0x02, 24 },
+    { 13, 0x02, 24 },
+    { 14, 0x03, 24 },
+    { 7, 0x02, 25 },
+    { 8, 0x02, 25 },
+    { 9, 0x02, 25 },
+    { 10, 0x02, 25 },
+    { 11, 0x02, 25 },
+    { 12, 0x02, 25 },
+    { 13, 0x02, 25 },
+    { 14, 0x03, 25 }
+  },
+  /* 182 */
+  {
+    { 7, 0x02, 26 },
+    { 8, 0x02, 26 },
+    { 9, 0x02, 26 },
+    { 10, 0x02, 26 },
+    { 11, 0x02, 26 },
+    { 12, 0x02, 26 },
+    { 13, 0x02, 26 },
+    { 14, 0x03, 26 },
+    { 7, 0x02, 27 },
+    { 8, 0x02, 27 },
+    { 9, 0x02, 27 },
+    { 10, 0x02, 27 },
+    { 11, 0x02, 27 },
+    { 12, 0x02, 27 },
+    { 13, 0x02, 27 },
+    { 14, 0x03, 27 }
+  },
+  /* 183 */
+  {
+    { 7, 0x02, 28 },
+    { 8, 0x02, 28 },
+    { 9, 0x02, 28 },
+    { 10, 0x02, 28 },
+    { 11, 0x02, 28 },
+    { 12, 0x02, 28 },
+    { 13, 0x02, 28 },
+    { 14, 0x03, 28 },
+    { 7, 0x02, 29 },
+    { 8, 0x02, 29 },
+    { 9, 0x02, 29 },
+    { 10, 0x02, 29 },
+    { 11, 0x02, 29 },
+    { 12, 0x02, 29 },
+    { 13, 0x02, 29 },
+    { 14, 0x03, 29 }
+  },
+  /* 184 */
+  {
+    { 7, 0x02, 30 },
+    { 8, 0x02, 30 },
+    { 9, 0x02, 30 },
+    { 10, 0x02, 30 },
+    { 11, 0x02, 30 },
+    { 12, 0x02, 30 },
+    { 13, 0x02, 30 },
+    { 14, 0x03, 30 },
+    { 7, 0x02, 31 },
+    { 8, 0x02, 31 },
+    { 9, 0x02, 31 },
+    { 10, 0x02, 31 },
+    { 11, 0x02, 31 },
+    { 12, 0x02, 31 },
+    { 13, 0x02, 31 },
+    { 14, 0x03, 31 }
+  },
+  /* 185 */
+  {
+    { 7, 0x02, 33 },
+    { 8, 0x02, 33 },
+    { 9, 0x02, 33 },
+    { 10, 0x02, 33 },
+    { 11, 0x02, 33 },
+    { 12, 0x02, 33 },
+    { 13, 0x02, 33 },
+    { 14, 0x03, 33 },
+    { 7, 0x02, 35 },
+    { 8, 0x02, 35 },
+    { 9, 0x02, 35 },
+    { 10, 0x02, 35 },
+    { 11, 0x02, 35 },
+    { 12, 0x02, 35 },
+    { 13, 0x02, 35 },
+    { 14, 0x03, 35 }
+  },
+  /* 186 */
+  {
+    { 7, 0x02, 36 },
+    { 8, 0x02, 36 },
+    { 9, 0x02, 36 },
+    { 10, 0x02, 36 },
+    { 11, 0x02, 36 },
+    { 12, 0x02, 36 },
+    { 13, 0x02, 36 },
+    { 14, 0x03, 36 },
+    { 7, 0x02, 37 },
+    { 8, 0x02, 37 },
+    { 9, 0x02, 37 },
+    { 10, 0x02, 37 },
+    { 11, 0x02, 37 },
+    { 12, 0x02, 37 },
+    { 13, 0x02, 37 },
+    { 14, 0x03, 37 }
+  },
+  /* 187 */
+  {
+    { 7, 0x02, 39 },
+    { 8, 0x02, 39 },
+    { 9, 0x02, 39 },
+    { 10, 0x02, 39 },
+    { 11, 0x02, 39 },
+    { 12, 0x02, 39 },
+    { 13, 0x02, 39 },
+    { 14, 0x03, 39 },
+    { 7, 0x02, 64 },
+    { 8, 0x02, 64 },
+    { 9, 0x02, 64 },
+    { 10, 0x02, 64 },
+    { 11, 0x02, 64 },
+    { 12, 0x02, 64 },
+    { 13, 0x02, 64 },
+    { 14, 0x03, 64 }
+  },
+  /* 188 */
+  {
+    { 7, 0x02, 91 },
+    { 8, 0x02, 91 },
+    { 9, 0x02, 91 },
+    { 10, 0x02, 91 },
+    { 11, 0x02, 91 },
+    { 12, 0x02, 91 },
+    { 13, 0x02, 91 },
+    { 14, 0x03, 91 },
+    { 7, 0x02, 92 },
+    { 8, 0x02, 92 },
+    { 9, 0x02, 92 },
+    { 10, 0x02, 92 },
+    { 11, 0x02, 92 },
+    { 12, 0x02, 92 },
+    { 13, 0x02, 92 },
+    { 14, 0x03, 92 }
+  },
+  /* 189 */
+  {
+    { 7, 0x02, 93 },
+    { 8, 0x02, 93 },
+    { 9, 0x02, 93 },
+    { 10, 0x02, 93 },
+    { 11, 0x02, 93 },
+    { 12, 0x02, 93 },
+    { 13, 0x02, 93 },
+    { 14, 0x03, 93 },
+    { 7, 0x02, 94 },
+    { 8, 0x02, 94 },
+    { 9, 0x02, 94 },
+    { 10, 0x02, 94 },
+    { 11, 0x02, 94 },
+    { 12, 0x02, 94 },
+    { 13, 0x02, 94 },
+    { 14, 0x03, 94 }
+  },
+  /* 190 */
+  {
+    { 7, 0x02, 96 },
+    { 8, 0x02, 96 },
+    { 9, 0x02, 96 },
+    { 10, 0x02, 96 },
+    { 11, 0x02, 96 },
+    { 12, 0x02, 96 },
+    { 13, 0x02, 96 },
+    { 14, 0x03, 96 },
+    { 7, 0x02, 123 },
+    { 8, 0x02, 123 },
+    { 9, 0x02, 123 },
+    { 10, 0x02, 123 },
+    { 11, 0x02, 123 },
+    { 12, 0x02, 123 },
+    { 13, 0x02, 123 },
+    { 14, 0x03, 123 }
+  },
+  /* 191 */
+  {
+    { 7, 0x02, 125 },
+    { 8, 0x02, 125 },
+    { 9, 0x02, 125 },
+    { 10, 0x02, 125 },
+    { 11, 0x02, 125 },
+    { 12, 0x02, 125 },
+    { 13, 0x02, 125 },
+    { 14, 0x03, 125 },
+    { 7, 0x02, 127 },
+    { 8, 0x02, 127 },
+    { 9, 0x02, 127 },
+    { 10, 0x02, 127 },
+    { 11, 0x02, 127 },
+    { 12, 0x02, 127 },
+    { 13, 0x02, 127 },
+    { 14, 0x03, 127 }
+  },
+  /* 192 */
+  {
+    { 7, 0x02, 128 },
+    { 8, 0x02, 128 },
+    { 9, 0x02, 128 },
+    { 10, 0x02, 128 },
+    { 11, 0x02, 128 },
+    { 12, 0x02, 128 },
+    { 13, 0x02, 128 },
+    { 14, 0x03, 128 },
+    { 7, 0x02, 129 },
+    { 8, 0x02, 129 },
+    { 9, 0x02, 129 },
+    { 10, 0x02, 129 },
+    { 11, 0x02, 129 },
+    { 12, 0x02, 129 },
+    { 13, 0x02, 129 },
+    { 14, 0x03, 129 }
+  },
+  /* 193 */
+  {
+    { 7, 0x02, 130 },
+    { 8, 0x02, 130 },
+    { 9, 0x02, 130 },
+    { 10, 0x02, 130 },
+    { 11, 0x02, 130 },
+    { 12, 0x02, 130 },
+    { 13, 0x02, 130 },
+    { 14, 0x03, 130 },
+    { 7, 0x02, 131 },
+    { 8, 0x02, 131 },
+    { 9, 0x02, 131 },
+    { 10, 0x02, 131 },
+    { 11, 0x02, 131 },
+    { 12, 0x02, 131 },
+    { 13, 0x02, 131 },
+    { 14, 0x03, 131 }
+  },
+  /* 194 */
+  {
+    { 7, 0x02, 132 },
+    { 8, 0x02, 132 },
+    { 9, 0x02, 132 },
+    { 10, 0x02, 132 },
+    { 11, 0x02, 132 },
+    { 12, 0x02, 132 },
+    { 13, 0x02, 132 },
+    { 14, 0x03, 132 },
+    { 7, 0x02, 133 },
+    { 8, 0x02, 133 },
+    { 9, 0x02, 133 },
+    { 10, 0x02, 133 },
+    { 11, 0x02, 133 },
+    { 12, 0x02, 133 },
+    { 13, 0x02, 133 },
+    { 14, 0x03, 133 }
+  },
+  /* 195 */
+  {
+    { 7, 0x02, 134 },
+    { 8, 0x02, 134 },
+    { 9, 0x02, 134 },
+    { 10, 0x02, 134 },
+    { 11, 0x02, 134 },
+    { 12, 0x02, 134 },
+    { 13, 0x02, 134 },
+    { 14, 0x03, 134 },
+    { 7, 0x02, 135 },
+    { 8, 0x02, 135 },
+    { 9, 0x02, 135 },
+    { 10, 0x02, 135 },
+    { 11, 0x02, 135 },
+    { 12, 0x02, 135 },
+    { 13, 0x02, 135 },
+    { 14, 0x03, 135 }
+  },
+  /* 196 */
+  {
+    { 7, 0x02, 136 },
+    { 8, 0x02, 136 },
+    { 9, 0x02, 136 },
+    { 10, 0x02, 136 },
+    { 11, 0x02, 136 },
+    { 12, 0x02, 136 },
+    { 13, 0x02, 136 },
+    { 14, 0x03, 136 },
+    { 7, 0x02, 137 },
+    { 8, 0x02, 137 },
+    { 9, 0x02, 137 },
+    { 10, 0x02, 137 },
+    { 11, 0x02, 137 },
+    { 12, 0x02, 137 },
+    { 13, 0x02, 137 },
+    { 14, 0x03, 137 }
+  },
+  /* 197 */
+  {
+    { 7, 0x02, 138 },
+    { 8, 0x02, 138 },
+    { 9, 0x02, 138 },
+    { 10, 0x02, 138 },
+    { 11, 0x02, 138 },
+    { 12, 0x02, 138 },
+    { 13, 0x02, 138 },
+    { 14, 0x03, 138 },
+    { 7, 0x02, 139 },
+    { 8, 0x02, 139 },
+    { 9, 0x02, 139 },
+    { 10, 0x02, 139 },
+    { 11, 0x02, 139 },
+    { 12, 0x02, 139 },
+    { 13, 0x02, 139 },
+    { 14, 0x03, 139 }
+  },
+  /* 198 */
+  {
+    { 7, 0x02, 140 },
+    { 8, 0x02, 140 },
+    { 9, 0x02, 140 },
+    { 10, 0x02, 140 },
+    { 11, 0x02, 140 },
+    { 12, 0x02, 140 },
+    { 13, 0x02, 140 },
+    { 14, 0x03, 140 },
+    { 7, 0x02, 141 },
+    { 8, 0x02, 141 },
+    { 9, 0x02, 141 },
+    { 10, 0x02, 141 },
+    { 11, 0x02, 141 },
+    { 12, 0x02, 141 },
+    { 13, 0x02, 141 },
+    { 14, 0x03, 141 }
+  },
+  /* 199 */
+  {
+    { 7, 0x02, 142 },
+    { 8, 0x02, 142 },
+    { 9, 0x02, 142 },
+    { 10, 0x02, 142 },
+    { 11, 0x02, 142 },
+    { 12, 0x02, 142 },
+    { 13, 0x02, 142 },
+    { 14, 0x03, 142 },
+    { 7, 0x02, 143 },
+    { 8, 0x02, 143 },
+    { 9, 0x02, 143 },
+    { 10, 0x02, 143 },
+    { 11, 0x02, 143 },
+    { 12, 0x02, 143 },
+    { 13, 0x02, 143 },
+    { 14, 0x03, 143 }
+  },
+  /* 200 */
+  {
+    { 7, 0x02, 144 },
+    { 8, 0x02, 144 },
+    { 9, 0x02, 144 },
+    { 10, 0x02, 144 },
+    { 11, 0x02, 144 },
+    { 12, 0x02, 144 },
+    { 13, 0x02, 144 },
+    { 14, 0x03, 144 },
+    { 7, 0x02, 145 },
+    { 8, 0x02, 145 },
+    { 9, 0x02, 145 },
+    { 10, 0x02, 145 },
+    { 11, 0x02, 145 },
+    { 12, 0x02, 145 },
+    { 13, 0x02, 145 },
+    { 14, 0x03, 145 }
+  },
+  /* 201 */
+  {
+    { 7, 0x02, 146 },
+    { 8, 0x02, 146 },
+    { 9, 0x02, 146 },
+    { 10, 0x02, 146 },
+    { 11, 0x02, 146 },
+    { 12, 0x02, 146 },
+    { 13, 0x02, 146 },
+    { 14, 0x03, 146 },
+    { 7, 0x02, 147 },
+    { 8, 0x02, 147 },
+    { 9, 0x02, 147 },
+    { 10, 0x02, 147 },
+    { 11, 0x02, 147 },
+    { 12, 0x02, 147 },
+    { 13, 0x02, 147 },
+    { 14, 0x03, 147 }
+  },
+  /* 202 */
+  {
+    { 7, 0x02, 148 },
+    { 8, 0x02, 148 },
+    { 9, 0x02, 148 },
+    { 10, 0x02, 148 },
+    { 11, 0x02, 148 },
+    { 12, 0x02, 148 },
+    { 13, 0x02, 148 },
+    { 14, 0x03, 148 },
+    { 7, 0x02, 149 },
+    { 8, 0x02, 149 },
+    { 9, 0x02, 149 },
+    { 10, 0x02, 149 },
+    { 11, 0x02, 149 },
+    { 12, 0x02, 149 },
+    { 13, 0x02, 149 },
+    { 14, 0x03, 149 }
+  },
+  /* 203 */
+  {
+    { 7, 0x02, 150 },
+    { 8, 0x02, 150 },
+    { 9, 0x02, 150 },
+    { 10, 0x02, 150 },
+    { 11, 0x02, 150 },
+    { 12, 0x02, 150 },
+    { 13, 0x02, 150 },
+    { 14, 0x03, 150 },
+    { 7, 0x02, 151 },
+    { 8, 0x02, 151 },
+    { 9, 0x02, 151 },
+    { 10, 0x02, 151 },
+    { 11, 0x02, 151 },
+    { 12, 0x02, 151 },
+    { 13, 0x02, 151 },
+    { 14, 0x03, 151 }
+  },
+  /* 204 */
+  {
+    { 7, 0x02, 152 },
+    { 8, 0x02, 152 },
+    { 9, 0x02, 152 },
+    { 10, 0x02, 152 },
+    { 11, 0x02, 152 },
+    { 12, 0x02, 152 },
+    { 13, 0x02, 152 },
+    { 14, 0x03, 152 },
+    { 7, 0x02, 153 },
+    { 8, 0x02, 153 },
+    { 9, 0x02, 153 },
+    { 10, 0x02, 153 },
+    { 11, 0x02, 153 },
+    { 12, 0x02, 153 },
+    { 13, 0x02, 153 },
+    { 14, 0x03, 153 }
+  },
+  /* 205 */
+  {
+    { 7, 0x02, 154 },
+    { 8, 0x02, 154 },
+    { 9, 0x02, 154 },
+    { 10, 0x02, 154 },
+    { 11, 0x02, 154 },
+    { 12, 0x02, 154 },
+    { 13, 0x02, 154 },
+    { 14, 0x03, 154 },
+    { 7, 0x02, 155 },
+    { 8, 0x02, 155 },
+    { 9, 0x02, 155 },
+    { 10, 0x02, 155 },
+    { 11, 0x02, 155 },
+    { 12, 0x02, 155 },
+    { 13, 0x02, 155 },
+    { 14, 0x03, 155 }
+  },
+  /* 206 */
+  {
+    { 7, 0x02, 156 },
+    { 8, 0x02, 156 },
+    { 9, 0x02, 156 },
+    { 10, 0x02, 156 },
+    { 11, 0x02, 156 },
+    { 12, 0x02, 156 },
+    { 13, 0x02, 156 },
+    { 14, 0x03, 156 },
+    { 7, 0x02, 157 },
+    { 8, 0x02, 157 },
+    { 9, 0x02, 157 },
+    { 10, 0x02, 157 },
+    { 11, 0x02, 157 },
+    { 12, 0x02, 157 },
+    { 13, 0x02, 157 },
+    { 14, 0x03, 157 }
+  },
+  /* 207 */
+  {
+    { 7, 0x02, 158 },
+    { 8, 0x02, 158 },
+    { 9, 0x02, 158 },
+    { 10, 0x02, 158 },
+    { 11, 0x02, 158 },
+    { 12, 0x02, 158 },
+    { 13, 0x02, 158 },
+    { 14, 0x03, 158 },
+    { 7, 0x02, 159 },
+    { 8, 0x02, 159 },
+    { 9, 0x02, 159 },
+    { 10, 0x02, 159 },
+    { 11, 0x02, 159 },
+    { 12, 0x02, 159 },
+    { 13, 0x02, 159 },
+    { 14, 0x03, 159 }
+  },
+  /* 208 */
+  {
+    { 7, 0x02, 160 },
+    { 8, 0x02, 160 },
+    { 9, 0x02, 160 },
+    { 10, 0x02, 160 },
+    { 11, 0x02, 160 },
+    { 12, 0x02, 160 },
+    { 13, 0x02, 160 },
+    { 14, 0x03, 160 },
+    { 7, 0x02, 161 },
+    { 8, 0x02, 161 },
+    { 9, 0x02, 161 },
+    { 10, 0x02, 161 },
+    { 11, 0x02, 161 },
+    { 12, 0x02, 161 },
+    { 13, 0x02, 161 },
+    { 14, 0x03, 161 }
+  },
+  /* 209 */
+  {
+    { 7, 0x02, 162 },
+    { 8, 0x02, 162 },
+    { 9, 0x02, 162 },
+    { 10, 0x02, 162 },
+    { 11, 0x02, 162 },
+    { 12, 0x02, 162 },
+    { 13, 0x02, 162 },
+    { 14, 0x03, 162 },
+    { 7, 0x02, 163 },
+    { 8, 0x02, 163 },
+    { 9, 0x02, 163 },
+    { 10, 0x02, 163 },
+    { 11, 0x02, 163 },
+    { 12, 0x02, 163 },
+    { 13, 0x02, 163 },
+    { 14, 0x03, 163 }
+  },
+  /* 210 */
+  {
+    { 7, 0x02, 164 },
+    { 8, 0x02, 164 },
+    { 9, 0x02, 164 },
+    { 10, 0x02, 164 },
+    { 11, 0x02, 164 },
+    { 12, 0x02, 164 },
+    { 13, 0x02, 164 },
+    { 14, 0x03, 164 },
+    { 7, 0x02, 165 },
+    { 8, 0x02, 165 },
+    { 9, 0x02, 165 },
+    { 10, 0x02, 165 },
+    { 11, 0x02, 165 },
+    { 12, 0x02, 165 },
+    { 13, 0x02, 165 },
+    { 14, 0x03, 165 }
+  },
+  /* 211 */
+  {
+    { 7, 0x02, 166 },
+    { 8, 0x02, 166 },
+    { 9, 0x02, 166 },
+    { 10, 0x02, 166 },
+    { 11, 0x02, 166 },
+    { 12, 0x02, 166 },
+    { 13, 0x02, 166 },
+    { 14, 0x03, 166 },
+    { 7, 0x02, 167 },
+    { 8, 0x02, 167 },
+    { 9, 0x02, 167 },
+    { 10, 0x02, 167 },
+    { 11, 0x02, 167 },
+    { 12, 0x02, 167 },
+    { 13, 0x02, 167 },
+    { 14, 0x03, 167 }
+  },
+  /* 212 */
+  {
+    { 7, 0x02, 168 },
+    { 8, 0x02, 168 },
+    { 9, 0x02, 168 },
+    { 10, 0x02, 168 },
+    { 11, 0x02, 168 },
+    { 12, 0x02, 168 },
+    { 13, 0x02, 168 },
+    { 14, 0x03, 168 },
+    { 7, 0x02, 169 },
+    { 8, 0x02, 169 },
+    { 9, 0x02, 169 },
+    { 10, 0x02, 169 },
+    { 11, 0x02, 169 },
+    { 12, 0x02, 169 },
+    { 13, 0x02, 169 },
+    { 14, 0x03, 169 }
+  },
+  /* 213 */
+  {
+    { 7, 0x02, 170 },
+    { 8, 0x02, 170 },
+    { 9, 0x02, 170 },
+    { 10, 0x02, 170 },
+    { 11, 0x02, 170 },
+    { 12, 0x02, 170 },
+    { 13, 0x02, 170 },
+    { 14, 0x03, 170 },
+    { 7, 0x02, 171 },
+    { 8, 0x02, 171 },
+    { 9, 0x02, 171 },
+    { 10, 0x02, 171 },
+    { 11, 0x02, 171 },
+    { 12, 0x02, 171 },
+    { 13, 0x02, 171 },
+    { 14, 0x03, 171 }
+  },
+  /* 214 */
+  {
+    { 7, 0x02, 172 },
+    { 8, 0x02, 172 },
+    { 9, 0x02, 172 },
+    { 10, 0x02, 172 },
+    { 11, 0x02, 172 },
+    { 12, 0x02, 172 },
+    { 13, 0x02, 172 },
+    { 14, 0x03, 172 },
+    { 7, 0x02, 173 },
+    { 8, 0x02, 173 },
+    { 9, 0x02, 173 },
+    { 10, 0x02, 173 },
+    { 11, 0x02, 173 },
+    { 12, 0x02, 173 },
+    { 13, 0x02, 173 },
+    { 14, 0x03, 173 }
+  },
+  /* 215 */
+  {
+    { 7, 0x02, 174 },
+    { 8, 0x02, 174 },
+    { 9, 0x02, 174 },
+    { 10, 0x02, 174 },
+    { 11, 0x02, 174 },
+    { 12, 0x02, 174 },
+    { 13, 0x02, 174 },
+    { 14, 0x03, 174 },
+    { 7, 0x02, 175 },
+    { 8, 0x02, 175 },
+    { 9, 0x02, 175 },
+    { 10, 0x02, 175 },
+    { 11, 0x02, 175 },
+    { 12, 0x02, 175 },
+    { 13, 0x02, 175 },
+    { 14, 0x03, 175 }
+  },
+  /* 216 */
+  {
+    { 7, 0x02, 176 },
+    { 8, 0x02, 176 },
+    { 9, 0x02, 176 },
+    { 10, 0x02, 176 },
+    { 11, 0x02, 176 },
+    { 12, 0x02, 176 },
+    { 13, 0x02, 176 },
+    { 14, 0x03, 176 },
+    { 7, 0x02, 177 },
+    { 8, 0x02, 177 },
+    { 9, 0x02, 177 },
+    { 10, 0x02, 177 },
+    { 11, 0x02, 177 },
+    { 12, 0x02, 177 },
+    { 13, 0x02, 177 },
+    { 14, 0x03, 177 }
+  },
+  /* 217 */
+  {
+    { 7, 0x02, 178 },
+    { 8, 0x02, 178 },
+    { 9, 0x02, 178 },
+    { 10, 0x02, 178 },
+    { 11, 0x02, 178 },
+    { 12, 0x02, 178 },
+    { 13, 0x02, 178 },
+    { 14, 0x03, 178 },
+    { 7, 0x02, 179 },
+    { 8, 0x02, 179 },
+    { 9, 0x02, 179 },
+    { 10, 0x02, 179 },
+    { 11, 0x02, 179 },
+    { 12, 0x02, 179 },
+    { 13, 0x02, 179 },
+    { 14, 0x03, 179 }
+  },
+  /* 218 */
+  {
+    { 7, 0x02, 180 },
+    { 8, 0x02, 180 },
+    { 9, 0x02, 180 },
+    { 10, 0x02, 180 },
+    { 11, 0x02, 180 },
+    { 12, 0x02, 180 },
+    { 13, 0x02, 180 },
+    { 14, 0x03, 180 },
+    { 7, 0x02, 181 },
+    { 8, 0x02, 181 },
+    { 9, 0x02, 181 },
+    { 10, 0x02, 181 },
+    { 11, 0x02, 181 },
+    { 12, 0x02, 181 },
+    { 13, 0x02, 181 },
+    { 14, 0x03, 181 }
+  },
+  /* 219 */
+  {
+    { 7, 0x02, 182 },
+    { 8, 0x02, 182 },
+    { 9, 0x02, 182 },
+    { 10, 0x02, 182 },
+    { 11, 0x02, 182 },
+    { 12, 0x02, 182 },
+    { 13, 0x02, 182 },
+    { 14, 0x03, 182 },
+    { 7, 0x02, 183 },
+    { 8, 0x02, 183 },
+    { 9, 0x02, 183 },
+    { 10, 0x02, 183 },
+    { 11, 0x02, 183 },
+    { 12, 0x02, 183 },
+    { 13, 0x02, 183 },
+    { 14, 0x03, 183 }
+  },
+  /* 220 */
+  {
+    { 7, 0x02, 184 },
+    { 8, 0x02, 184 },
+    { 9, 0x02, 184 },
+    { 10, 0x02, 184 },
+    { 11, 0x02, 184 },
+    { 12, 0x02, 184 },
+    { 13, 0x02, 184 },
+    { 14, 0x03, 184 },
+    { 7, 0x02, 185 },
+    { 8, 0x02, 185 },
+    { 9, 0x02, 185 },
+    { 10, 0x02, 185 },
+    { 11, 0x02, 185 },
+    { 12, 0x02, 185 },
+    { 13, 0x02, 185 },
+    { 14, 0x03, 185 }
+  },
+  /* 221 */
+  {
+    { 7, 0x02, 186 },
+    { 8, 0x02, 186 },
+    { 9, 0x02, 186 },
+    { 10, 0x02, 186 },
+    { 11, 0x02, 186 },
+    { 12, 0x02, 186 },
+    { 13, 0x02, 186 },
+    { 14, 0x03, 186 },
+    { 7, 0x02, 187 },
+    { 8, 0x02, 187 },
+    { 9, 0x02, 187 },
+    { 10, 0x02, 187 },
+    { 11, 0x02, 187 },
+    { 12, 0x02, 187 },
+    { 13, 0x02, 187 },
+    { 14, 0x03, 187 }
+  },
+  /* 222 */
+  {
+    { 7, 0x02, 188 },
+    { 8, 0x02, 188 },
+    { 9, 0x02, 188 },
+    { 10, 0x02, 188 },
+    { 11, 0x02, 188 },
+    { 12, 0x02, 188 },
+    { 13, 0x02, 188 },
+    { 14, 0x03, 188 },
+    { 7, 0x02, 189 },
+    { 8, 0x02, 189 },
+    { 9, 0x02, 189 },
+    { 10, 0x02, 189 },
+    { 11, 0x02, 189 },
+    { 12, 0x02, 189 },
+    { 13, 0x02, 189 },
+    { 14, 0x03, 189 }
+  },
+  /* 223 */
+  {
+    { 7, 0x02, 190 },
+    { 8, 0x02, 190 },
+    { 9, 0x02, 190 },
+    { 10, 0x02, 190 },
+    { 11, 0x02, 190 },
+    { 12, 0x02, 190 },
+    { 13, 0x02, 190 },
+    { 14, 0x03, 190 },
+    { 7, 0x02, 191 },
+    { 8, 0x02, 191 },
+    { 9, 0x02, 191 },
+    { 10, 0x02, 191 },
+    { 11, 0x02, 191 },
+    { 12, 0x02, 191 },
+    { 13, 0x02, 191 },
+    { 14, 0x03, 191 }
+  },
+  /* 224 */
+  {
+    { 7, 0x02, 192 },
+    { 8, 0x02, 192 },
+    { 9, 0x02, 192 },
+    { 10, 0x02, 192 },
+    { 11, 0x02, 192 },
+    { 12, 0x02, 192 },
+    { 13, 0x02, 192 },
+    { 14, 0x03, 192 },
+    { 7, 0x02, 193 },
+    { 8, 0x02, 193 },
+    { 9, 0x02, 193 },
+    { 10, 0x02, 193 },
+    { 11, 0x02, 193 },
+    { 12, 0x02, 193 },
+    { 13, 0x02, 193 },
+    { 14, 0x03, 193 }
+  },
+  /* 225 */
+  {
+    { 7, 0x02, 194 },
+    { 8, 0x02, 194 },
+    { 9, 0x02, 194 },
+    { 10, 0x02, 194 },
+    { 11, 0x02, 194 },
+    { 12, 0x02, 194 },
+    { 13, 0x02, 194 },
+    { 14, 0x03, 194 },
+    { 7, 0x02, 195 },
+    { 8, 0x02, 195 },
+    { 9, 0x02, 195 },
+    { 10, 0x02, 195 },
+    { 11, 0x02, 195 },
+    { 12, 0x02, 195 },
+    { 13, 0x02, 195 },
+    { 14, 0x03, 195 }
+  },
+  /* 226 */
+  {
+    { 7, 0x02, 196 },
+    { 8, 0x02, 196 },
+    { 9, 0x02, 196 },
+    { 10, 0x02, 196 },
+    { 11, 0x02, 196 },
+    { 12, 0x02, 196 },
+    { 13, 0x02, 196 },
+    { 14, 0x03, 196 },
+    { 7, 0x02, 197 },
+    { 8, 0x02, 197 },
+    { 9, 0x02, 197 },
+    { 10, 0x02, 197 },
+    { 11, 0x02, 197 },
+    { 12, 0x02, 197 },
+    { 13, 0x02, 197 },
+    { 14, 0x03, 197 }
+  },
+  /* 227 */
+  {
+    { 7, 0x02, 198 },
+    { 8, 0x02, 198 },
+    { 9, 0x02, 198 },
+    { 10, 0x02, 198 },
+    { 11, 0x02, 198 },
+    { 12, 0x02, 198 },
+    { 13, 0x02, 198 },
+    { 14, 0x03, 198 },
+    { 7, 0x02, 199 },
+    { 8, 0x02, 199 },
+    { 9, 0x02, 199 },
+    { 10, 0x02, 199 },
+    { 11, 0x02, 199 },
+    { 12, 0x02, 199 },
+    { 13, 0x02, 199 },
+    { 14, 0x03, 199 }
+  },
+  /* 228 */
+  {
+    { 7, 0x02, 200 },
+    { 8, 0x02, 200 },
+    { 9, 0x02, 200 },
+    { 10, 0x02, 200 },
+    { 11, 0x02, 200 },
+    { 12, 0x02, 200 },
+    { 13, 0x02, 200 },
+    { 14, 0x03, 200 },
+    { 7, 0x02, 201 },
+    { 8, 0x02, 201 },
+    { 9, 0x02, 201 },
+    { 10, 0x02, 201 },
+    { 11, 0x02, 201 },
+    { 12, 0x02, 201 },
+    { 13, 0x02, 201 },
+    { 14, 0x03, 201 }
+  },
+  /* 229 */
+  {
+    { 7, 0x02, 202 },
+    { 8, 0x02, 202 },
+    { 9, 0x02, 202 },
+    { 10, 0x02, 202 },
+    { 11, 0x02, 202 },
+    { 12, 0x02, 202 },
+    { 13, 0x02, 202 },
+    { 14, 0x03, 202 },
+    { 7, 0x02, 203 },
+    { 8, 0x02, 203 },
+    { 9, 0x02, 203 },
+    { 10, 0x02, 203 },
+    { 11, 0x02, 203 },
+    { 12, 0x02, 203 },
+    { 13, 0x02, 203 },
+    { 14, 0x03, 203 }
+  },
+  /* 230 */
+  {
+    { 7, 0x02, 204 },
+    { 8, 0x02, 204 },
+    { 9, 0x02, 204 },
+    { 10, 0x02, 204 },
+    { 11, 0x02, 204 },
+    { 12, 0x02, 204 },
+    { 13, 0x02, 204 },
+    { 14, 0x03, 204 },
+    { 7, 0x02, 205 },
+    { 8, 0x02, 205 },
+    { 9, 0x02, 205 },
+    { 10, 0x02, 205 },
+    { 11, 0x02, 205 },
+    { 12, 0x02, 205 },
+    { 13, 0x02, 205 },
+    { 14, 0x03, 205 }
+  },
+  /* 231 */
+  {
+    { 7, 0x02, 206 },
+    { 8, 0x02, 206 },
+    { 9, 0x02, 206 },
+    { 10, 0x02, 206 },
+    { 11, 0x02, 206 },
+    { 12, 0x02, 206 },
+    { 13, 0x02, 206 },
+    { 14, 0x03, 206 },
+    { 7, 0x02, 207 },
+    { 8, 0x02, 207 },
+    { 9, 0x02, 207 },
+    { 10, 0x02, 207 },
+    { 11, 0x02, 207 },
+    { 12, 0x02, 207 },
+    { 13, 0x02, 207 },
+    { 14, 0x03, 207 }
+  },
+  /* 232 */
+  {
+    { 7, 0x02, 208 },
+    { 8, 0x02, 208 },
+    { 9, 0x02, 208 },
+    { 10, 0x02, 208 },
+    { 11, 0x02, 208 },
+    { 12, 0x02, 208 },
+    { 13, 0x02, 208 },
+    { 14, 0x03, 208 },
+    { 7, 0x02, 209 },
+    { 8, 0x02, 209 },
+    { 9, 0x02, 209 },
+    { 10, 0x02, 209 },
+    { 11, 0x02, 209 },
+    { 12, 0x02, 209 },
+    { 13, 0x02, 209 },
+    { 14, 0x03, 209 }
+  },
+  /* 233 */
+  {
+    { 7, 0x02, 210 },
+    { 8, 0x02, 210 },
+    { 9, 0x02, 210 },
+    { 10, 0x02, 210 },
+    { 11, 0x02, 210 },
+    { 12, 0x02, 210 },
+    { 13, 0x02, 210 },
+    { 14, 0x03, 210 },
+    { 7, 0x02, 211 },
+    { 8, 0x02, 211 },
+    { 9, 0x02, 211 },
+    { 10, 0x02, 211 },
+    { 11, 0x02, 211 },
+    { 12, 0x02, 211 },
+    { 13, 0x02, 211 },
+    { 14, 0x03, 211 }
+  },
+  /* 234 */
+  {
+    { 7, 0x02, 212 },
+    { 8, 0x02, 212 },
+    { 9, 0x02, 212 },
+    { 10, 0x02, 212 },
+    { 11, 0x02, 212 },
+    { 12, 0x02, 212 },
+    { 13, 0x02, 212 },
+    { 14, 0x03, 212 },
+    { 7, 0x02, 213 },
+    { 8, 0x02, 213 },
+    { 9, 0x02, 213 },
+    { 10, 0x02, 213 },
+    { 11, 0x02, 213 },
+    { 12, 0x02, 213 },
+    { 13, 0x02, 213 },
+    { 14, 0x03, 213 }
+  },
+  /* 235 */
+  {
+    { 7, 0x02, 214 },
+    { 8, 0x02, 214 },
+    { 9, 0x02, 214 },
+    { 10, 0x02, 214 },
+    { 11, 0x02, 214 },
+    { 12, 0x02, 214 },
+    { 13, 0x02, 214 },
+    { 14, 0x03, 214 },
+    { 7, 0x02, 215 },
+    { 8, 0x02, 215 },
+    { 9, 0x02, 215 },
+    { 10, 0x02, 215 },
+    { 11, 0x02, 215 },
+    { 12, 0x02, 215 },
+    { 13, 0x02, 215 },
+    { 14, 0x03, 215 }
+  },
+  /* 236 */
+  {
+    { 7, 0x02, 216 },
+    { 8, 0x02, 216 },
+    { 9, 0x02, 216 },
+    { 10, 0x02, 216 },
+    { 11, 0x02, 216 },
+    { 12, 0x02, 216 },
+    { 13, 0x02, 216 },
+    { 14, 0x03, 216 },
+    { 7, 0x02, 217 },
+    { 8, 0x02, 217 },
+    { 9, 0x02, 217 },
+    { 10, 0x02, 217 },
+    { 11, 0x02, 217 },
+    { 12, 0x02, 217 },
+    { 13, 0x02, 217 },
+    { 14, 0x03, 217 }
+  },
+  /* 237 */
+  {
+    { 7, 0x02, 218 },
+    { 8, 0x02, 218 },
+    { 9, 0x02, 218 },
+    { 10, 0x02, 218 },
+    { 11, 0x02, 218 },
+    { 12, 0x02, 218 },
+    { 13, 0x02, 218 },
+    { 14, 0x03, 218 },
+    { 7, 0x02, 219 },
+    { 8, 0x02, 219 },
+    { 9, 0x02, 219 },
+    { 10, 0x02, 219 },
+    { 11, 0x02, 219 },
+    { 12, 0x02, 219 },
+    { 13, 0x02, 219 },
+    { 14, 0x03, 219 }
+  },
+  /* 238 */
+  {
+    { 7, 0x02, 220 },
+    { 8, 0x02, 220 },
+    { 9, 0x02, 220 },
+    { 10, 0x02, 220 },
+    { 11, 0x02, 220 },
+    { 12, 0x02, 220 },
+    { 13, 0x02, 220 },
+    { 14, 0x03, 220 },
+    { 7, 0x02, 221 },
+    { 8, 0x02, 221 },
+    { 9, 0x02, 221 },
+    { 10, 0x02, 221 },
+    { 11, 0x02, 221 },
+    { 12, 0x02, 221 },
+    { 13, 0x02, 221 },
+    { 14, 0x03, 221 }
+  },
+  /* 239 */
+  {
+    { 7, 0x02, 222 },
+    { 8, 0x02, 222 },
+    { 9, 0x02, 222 },
+    { 10, 0x02, 222 },
+    { 11, 0x02, 222 },
+    { 12, 0x02, 222 },
+    { 13, 0x02, 222 },
+    { 14, 0x03, 222 },
+    { 7, 0x02, 223 },
+    { 8, 0x02, 223 },
+    { 9, 0x02, 223 },
+    { 10, 0x02, 223 },
+    { 11, 0x02, 223 },
+    { 12, 0x02, 223 },
+    { 13, 0x02, 223 },
+    { 14, 0x03, 223 }
+  },
+  /* 240 */
+  {
+    { 7, 0x02, 224 },
+    { 8, 0x02, 224 },
+    { 9, 0x02, 224 },
+    { 10, 0x02, 224 },
+    { 11, 0x02, 224 },
+    { 12, 0x02, 224 },
+    { 13, 0x02, 224 },
+    { 14, 0x03, 224 },
+    { 7, 0x02, 225 },
+    { 8, 0x02, 225 },
+    { 9, 0x02, 225 },
+    { 10, 0x02, 225 },
+    { 11, 0x02, 225 },
+    { 12, 0x02, 225 },
+    { 13, 0x02, 225 },
+    { 14, 0x03, 225 }
+  },
+  /* 241 */
+  {
+    { 7, 0x02, 226 },
+    { 8, 0x02, 226 },
+    { 9, 0x02, 226 },
+    { 10, 0x02, 226 },
+    { 11, 0x02, 226 },
+    { 12, 0x02, 226 },
+    { 13, 0x02, 226 },
+    { 14, 0x03, 226 },
+    { 7, 0x02, 227 },
+    { 8, 0x02, 227 },
+    { 9, 0x02, 227 },
+    { 10, 0x02, 227 },
+    { 11, 0x02, 227 },
+    { 12, 0x02, 227 },
+    { 13, 0x02, 227 },
+    { 14, 0x03, 227 }
+  },
+  /* 242 */
+  {
+    { 7, 0x02, 228 },
+    { 8, 0x02, 228 },
+    { 9, 0x02, 228 },
+    { 10, 0x02, 228 },
+    { 11, 0x02, 228 },
+    { 12, 0x02, 228 },
+    { 13, 0x02, 228 },
+    { 14, 0x03, 228 },
+    { 7, 0x02, 229 },
+    { 8, 0x02, 229 },
+    { 9, 0x02, 229 },
+    { 10, 0x02, 229 },
+    { 11, 0x02, 229 },
+    { 12, 0x02, 229 },
+    { 13, 0x02, 229 },
+    { 14, 0x03, 229 }
+  },
+  /* 243 */
+  {
+    { 7, 0x02, 230 },
+    { 8, 0x02, 230 },
+    { 9, 0x02, 230 },
+    { 10, 0x02, 230 },
+    { 11, 0x02, 230 },
+    { 12, 0x02, 230 },
+    { 13, 0x02, 230 },
+    { 14, 0x03, 230 },
+    { 7, 0x02, 231 },
+    { 8, 0x02, 231 },
+    { 9, 0x02, 231 },
+    { 10, 0x02, 231 },
+    { 11, 0x02, 231 },
+    { 12, 0x02, 231 },
+    { 13, 0x02, 231 },
+    { 14, 0x03, 231 }
+  },
+  /* 244 */
+  {
+    { 7, 0x02, 232 },
+    { 8, 0x02, 232 },
+    { 9, 0x02, 232 },
+    { 10, 0x02, 232 },
+    { 11, 0x02, 232 },
+    { 12, 0x02, 232 },
+    { 13, 0x02, 232 },
+    { 14, 0x03, 232 },
+    { 7, 0x02, 233 },
+    { 8, 0x02, 233 },
+    { 9, 0x02, 233 },
+    { 10, 0x02, 233 },
+    { 11, 0x02, 233 },
+    { 12, 0x02, 233 },
+    { 13, 0x02, 233 },
+    { 14, 0x03, 233 }
+  },
+  /* 245 */
+  {
+    { 7, 0x02, 234 },
+    { 8, 0x02, 234 },
+    { 9, 0x02, 234 },
+    { 10, 0x02, 234 },
+    { 11, 0x02, 234 },
+    { 12, 0x02, 234 },
+    { 13, 0x02, 234 },
+    { 14, 0x03, 234 },
+    { 7, 0x02, 235 },
+    { 8, 0x02, 235 },
+    { 9, 0x02, 235 },
+    { 10, 0x02, 235 },
+    { 11, 0x02, 235 },
+    { 12, 0x02, 235 },
+    { 13, 0x02, 235 },
+    { 14, 0x03, 235 }
+  },
+  /* 246 */
+  {
+    { 7, 0x02, 236 },
+    { 8, 0x02, 236 },
+    { 9, 0x02, 236 },
+    { 10, 0x02, 236 },
+    { 11, 0x02, 236 },
+    { 12, 0x02, 236 },
+    { 13, 0x02, 236 },
+    { 14, 0x03, 236 },
+    { 7, 0x02, 237 },
+    { 8, 0x02, 237 },
+    { 9, 0x02, 237 },
+    { 10, 0x02, 237 },
+    { 11, 0x02, 237 },
+    { 12, 0x02, 237 },
+    { 13, 0x02, 237 },
+    { 14, 0x03, 237 }
+  },
+  /* 247 */
+  {
+    { 7, 0x02, 238 },
+    { 8, 0x02, 238 },
+    { 9, 0x02, 238 },
+    { 10, 0x02, 238 },
+    { 11, 0x02, 238 },
+    { 12, 0x02, 238 },
+    { 13, 0x02, 238 },
+    { 14, 0x03, 238 },
+    { 7, 0x02, 239 },
+    { 8, 0x02, 239 },
+    { 9, 0x02, 239 },
+    { 10, 0x02, 239 },
+    { 11, 0x02, 239 },
+    { 12, 0x02, 239 },
+    { 13, 0x02, 239 },
+    { 14, 0x03, 239 }
+  },
+  /* 248 */
+  {
+    { 7, 0x02, 240 },
+    { 8, 0x02, 240 },
+    { 9, 0x02, 240 },
+    { 10, 0x02, 240 },
+    { 11, 0x02, 240 },
+    { 12, 0x02, 240 },
+    { 13, 0x02, 240 },
+    { 14, 0x03, 240 },
+    { 7, 0x02, 241 },
+    { 8, 0x02, 241 },
+    { 9, 0x02, 241 },
+    { 10, 0x02, 241 },
+    { 11, 0x02, 241 },
+    { 12, 0x02, 241 },
+    { 13, 0x02, 241 },
+    { 14, 0x03, 241 }
+  },
+  /* 249 */
+  {
+    { 7, 0x02, 242 },
+    { 8, 0x02, 242 },
+    { 9, 0x02, 242 },
+    { 10, 0x02, 242 },
+    { 11, 0x02, 242 },
+    { 12, 0x02, 242 },
+    { 13, 0x02, 242 },
+    { 14, 0x03, 242 },
+    { 7, 0x02, 243 },
+    { 8, 0x02, 243 },
+    { 9, 0x02, 243 },
+    { 10, 0x02, 243 },
+    { 11, 0x02, 243 },
+    { 12, 0x02, 243 },
+    { 13, 0x02, 243 },
+    { 14, 0x03, 243 }
+  },
+  /* 250 */
+  {
+    { 7, 0x02, 244 },
+    { 8, 0x02, 244 },
+    { 9, 0x02, 244 },
+    { 10, 0x02, 244 },
+    { 11, 0x02, 244 },
+    { 12, 0x02, 244 },
+    { 13, 0x02, 244 },
+    { 14, 0x03, 244 },
+    { 7, 0x02, 245 },
+    { 8, 0x02, 245 },
+    { 9, 0x02, 245 },
+    { 10, 0x02, 245 },
+    { 11, 0x02, 245 },
+    { 12, 0x02, 245 },
+    { 13, 0x02, 245 },
+    { 14, 0x03, 245 }
+  },
+  /* 251 */
+  {
+    { 7, 0x02, 246 },
+    { 8, 0x02, 246 },
+    { 9, 0x02, 246 },
+    { 10, 0x02, 246 },
+    { 11, 0x02, 246 },
+    { 12, 0x02, 246 },
+    { 13, 0x02, 246 },
+    { 14, 0x03, 246 },
+    { 7, 0x02, 247 },
+    { 8, 0x02, 247 },
+    { 9, 0x02, 247 },
+    { 10, 0x02, 247 },
+    { 11, 0x02, 247 },
+    { 12, 0x02, 247 },
+    { 13, 0x02, 247 },
+    { 14, 0x03, 247 }
+  },
+  /* 252 */
+  {
+    { 7, 0x02, 248 },
+    { 8, 0x02, 248 },
+    { 9, 0x02, 248 },
+    { 10, 0x02, 248 },
+    { 11, 0x02, 248 },
+    { 12, 0x02, 248 },
+    { 13, 0x02, 248 },
+    { 14, 0x03, 248 },
+    { 7, 0x02, 249 },
+    { 8, 0x02, 249 },
+    { 9, 0x02, 249 },
+    { 10, 0x02, 249 },
+    { 11, 0x02, 249 },
+    { 12, 0x02, 249 },
+    { 13, 0x02, 249 },
+    { 14, 0x03, 249 }
+  },
+  /* 253 */
+  {
+    { 7, 0x02, 250 },
+    { 8, 0x02, 250 },
+    { 9, 0x02, 250 },
+    { 10, 0x02, 250 },
+    { 11, 0x02, 250 },
+    { 12, 0x02, 250 },
+    { 13, 0x02, 250 },
+    { 14, 0x03, 250 },
+    { 7, 0x02, 251 },
+    { 8, 0x02, 251 },
+    { 9, 0x02, 251 },
+    { 10, 0x02, 251 },
+    { 11, 0x02, 251 },
+    { 12, 0x02, 251 },
+    { 13, 0x02, 251 },
+    { 14, 0x03, 251 }
+  },
+  /* 254 */
+  {
+    { 7, 0x02, 252 },
+    { 8, 0x02, 252 },
+    { 9, 0x02, 252 },
+    { 10, 0x02, 252 },
+    { 11, 0x02, 252 },
+    { 12, 0x02, 252 },
+    { 13, 0x02, 252 },
+    { 14, 0x03, 252 },
+    { 7, 0x02, 253 },
+    { 8, 0x02, 253 },
+    { 9, 0x02, 253 },
+    { 10, 0x02, 253 },
+    { 11, 0x02, 253 },
+    { 12, 0x02, 253 },
+    { 13, 0x02, 253 },
+    { 14, 0x03, 253 }
+  },
+  /* 255 */
+  {
+    { 7, 0x02, 254 },
+    { 8, 0x02, 254 },
+    { 9, 0x02, 254 },
+    { 10, 0x02, 254 },
+    { 11, 0x02, 254 },
+    { 12, 0x02, 254 },
+    { 13, 0x02, 254 },
+    { 14, 0x03, 254 },
+    { 0, 0x04, 0 },
+    { 0, 0x04, 0 },
+    { 0, 0x04, 0 },
+    { 0, 0x04, 0 },
+    { 0, 0x04, 0 },
+    { 0, 0x04, 0 },
+    { 0, 0x04, 0 },
+    { 0, 0x04, 0 }
+  }
+};
@@ -55,12 +55,12 @@ uint32_t nghttp2_get_uint32(const uint8_t *data)
 }
 
 int nghttp2_reserve_buffer(uint8_t **buf_ptr, size_t *buflen_ptr,
-                           size_t min_length)
+                           size_t min_length, nghttp2_mem *mem)
 {
   if(min_length > *buflen_ptr) {
     uint8_t *temp;
     min_length = (min_length+4095)/4096*4096;
-    temp = realloc(*buf_ptr, min_length);
+    temp = nghttp2_mem_realloc(mem, *buf_ptr, min_length);
     if(temp == NULL) {
       return NGHTTP2_ERR_NOMEM;
     } else {
@@ -71,9 +71,9 @@ int nghttp2_reserve_buffer(uint8_t **buf_ptr, size_t *buflen_ptr,
   return 0;
 }
 
-void* nghttp2_memdup(const void* src, size_t n)
+void* nghttp2_memdup(const void* src, size_t n, nghttp2_mem *mem)
 {
-  void* dest = malloc(n);
+  void* dest = nghttp2_mem_malloc(mem, n);
   if(dest == NULL) {
     return NULL;
   }
@@ -175,6 +175,9 @@ const char* nghttp2_strerror(int error_code)
     return "Out of memory";
   case NGHTTP2_ERR_CALLBACK_FAILURE:
     return "The user callback function failed";
+  case NGHTTP2_ERR_FLOODED:
+    return "Flooding was detected in this HTTP/2 session, and it must be "
+      "closed";
   default:
     return "Unknown error code";
   }
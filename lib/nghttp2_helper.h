@@ -30,6 +30,7 @@
 #endif /* HAVE_CONFIG_H */
 
 #include <nghttp2/nghttp2.h>
+#include "nghttp2_mem.h"
 
 #define nghttp2_min(A, B) ((A) < (B) ? (A) : (B))
 #define nghttp2_max(A, B) ((A) > (B) ? (A) : (B))
@@ -66,7 +67,7 @@ uint32_t nghttp2_get_uint32(const uint8_t *data);
  * |*buflen_ptr|. The memory pointed by |*buf_ptr| previously is
  * freed. No memory copy is done between old and new buffer.
  * |*buf_ptr| and |*buflen_ptr| are only updated iff this function
- * succeeds.
+ * succeeds. The buffer is allocated using |mem|.
  *
  * This function returns 0 if it succeeds, or one of the following
  * negative error codes:
@@ -75,11 +76,12 @@ uint32_t nghttp2_get_uint32(const uint8_t *data);
  *     Out of memory.
  */
 int nghttp2_reserve_buffer(uint8_t **buf_ptr, size_t *buflen_ptr,
-                           size_t min_length);
+                           size_t min_length, nghttp2_mem *mem);
 
 /*
  * Allocates |n| bytes of memory and copy the meory region pointed by
  * |src| with the length |n| bytes into it. Returns the allocated memory.
+ * The memory is allocated using |mem|.
  *
  * This function returns pointer to allocated memory, or one of the
  * following negative error codes:
@@ -87,7 +89,7 @@ int nghttp2_reserve_buffer(uint8_t **buf_ptr, size_t *buflen_ptr,
  * NGHTTP2_ERR_NOMEM
  *     Out of memory.
  */
-void* nghttp2_memdup(const void* src, size_t n);
+void* nghttp2_memdup(const void* src, size_t n, nghttp2_mem *mem);
 
 void nghttp2_downcase(uint8_t *s, size_t len);
 
@@ -24,308 +24,156 @@
  */
 #include "nghttp2_map.h"
 
-void nghttp2_map_init(nghttp2_map *map)
-{
-  map->root = NULL;
-  map->size = 0;
-}
+#include <string.h>
 
-void nghttp2_map_free(nghttp2_map *map)
-{
-  map->root = NULL;
-}
+#define NGHTTP2_INITIAL_TABLE_LENBITS 4
+#define NGHTTP2_INITIAL_TABLE_LENGTH (1 << NGHTTP2_INITIAL_TABLE_LENBITS)
 
-/* Find left most node, which is not necessarily a leaf. */
-static nghttp2_map_entry* find_left_most(nghttp2_map_entry *entry)
+/* Fibonacci hashing. Stream IDs are dense, so multiplying by the
+   golden ratio spreads them over the upper bits. */
+static uint32_t hash(key_type key, uint32_t tablelenbits)
 {
-  while(entry->left) {
-    entry = entry->left;
-  }
-  return entry;
+  return (uint32_t)(key * 2654435769u) >> (32 - tablelenbits);
 }
 
-/* Find left most leaf. */
-static nghttp2_map_entry* find_left_most_leaf(nghttp2_map_entry *entry)
+int nghttp2_map_init(nghttp2_map *map, nghttp2_mem *mem)
 {
-  for(;;) {
-    entry = find_left_most(entry);
-    if(entry->right) {
-      entry = entry->right;
-    } else {
-      break;
-    }
+  map->mem = mem;
+  map->tablelen = NGHTTP2_INITIAL_TABLE_LENGTH;
+  map->tablelenbits = NGHTTP2_INITIAL_TABLE_LENBITS;
+  map->table = nghttp2_mem_calloc(mem, map->tablelen,
+                                  sizeof(nghttp2_map_entry*));
+  if(map->table == NULL) {
+    return NGHTTP2_ERR_NOMEM;
   }
-  return entry;
+  map->size = 0;
+  return 0;
 }
 
-/* Returns next node in postorder traversal. Returns NULL if there is
-   no next node. */
-static nghttp2_map_entry* traverse_postorder(nghttp2_map_entry *parent,
-                                             nghttp2_map_entry *entry)
+void nghttp2_map_free(nghttp2_map *map)
 {
-  if(!parent) {
-    return NULL;
-  }
-  if(parent->left == entry) {
-    if(parent->right) {
-      return find_left_most_leaf(parent->right);
-    } else {
-      return parent;
-    }
-  } else {
-    return parent;
-  }
+  nghttp2_mem_free(map->mem, map->table);
+  map->table = NULL;
 }
 
 void nghttp2_map_each_free(nghttp2_map *map,
                            int (*func)(nghttp2_map_entry *entry, void *ptr),
                            void *ptr)
 {
-  nghttp2_map_entry *entry;
-  if(!map->root) {
-    return;
-  }
-  entry = find_left_most_leaf(map->root);
-  while(entry) {
-    nghttp2_map_entry *parent = entry->parent;
-    /* Ignore return value. */
-    func(entry, ptr);
-    /* entry has been deleted. */
-    entry = traverse_postorder(parent, entry);
-  }
-  map->root = NULL;
-}
-
-/* Returns next node in inorder traversal. Returns NULL if there is no
-   next node. */
-static nghttp2_map_entry* traverse_inorder(nghttp2_map_entry *entry)
-{
-  nghttp2_map_entry *parent;
-  if(entry->right) {
-    return find_left_most(entry->right);
-  }
-  parent = entry->parent;
-  while(parent && parent->right == entry) {
-    entry = entry->parent;
-    parent = parent->parent;
+  uint32_t i;
+  for(i = 0; i < map->tablelen; ++i) {
+    if(map->table[i]) {
+      func(map->table[i], ptr);
+    }
   }
-  return parent;
+  nghttp2_map_free(map);
 }
 
 int nghttp2_map_each(nghttp2_map *map,
                      int (*func)(nghttp2_map_entry *entry, void *ptr),
                      void *ptr)
 {
-  nghttp2_map_entry *entry;
-  if(!map->root) {
-    return 0;
-  }
-  entry = find_left_most(map->root);
-  while(entry) {
-    int rv = func(entry, ptr);
-    if(rv != 0) {
-      return rv;
+  int rv;
+  uint32_t i;
+  for(i = 0; i < map->tablelen; ++i) {
+    if(map->table[i]) {
+      rv = func(map->table[i], ptr);
+      if(rv != 0) {
+        return rv;
+      }
     }
-    entry = traverse_inorder(entry);
   }
   return 0;
 }
 
-/*
- * 32 bit Mix Functions by Thomas Wang
- *
- * http://www.concentric.net/~Ttwang/tech/inthash.htm
- */
-static uint32_t hash32shift(uint32_t key)
-{
-  key = ~key + (key << 15); /* key = (key << 15) - key - 1; */
-  key = key ^ (key >> 12);
-  key = key + (key << 2);
-  key = key ^ (key >> 4);
-  key = key * 2057; /* key = (key + (key << 3)) + (key << 11); */
-  key = key ^ (key >> 16);
-  return key;
-}
-
 void nghttp2_map_entry_init(nghttp2_map_entry *entry, key_type key)
 {
   entry->key = key;
-  entry->parent = entry->left = entry->right = NULL;
-  entry->priority = hash32shift(key);
 }
 
-static nghttp2_map_entry* rotate_left(nghttp2_map_entry *entry)
-{
-  nghttp2_map_entry *root = entry->right;
-  entry->right = root->left;
-  root->left = entry;
-
-  root->parent = entry->parent;
-  entry->parent = root;
-  if(root->parent) {
-    if(root->parent->left == entry) {
-      root->parent->left = root;
-    } else {
-      root->parent->right = root;
-    }
-  }
-  if(entry->right) {
-    entry->right->parent = entry;
-  }
-  return root;
-}
-
-static nghttp2_map_entry* rotate_right(nghttp2_map_entry* entry)
-{
-  nghttp2_map_entry *root = entry->left;
-  entry->left = root->right;
-  root->right = entry;
-
-  root->parent = entry->parent;
-  entry->parent = root;
-  if(root->parent) {
-    if(root->parent->left == entry) {
-      root->parent->left = root;
-    } else {
-      root->parent->right = root;
+/*
+ * Returns the index of the slot which holds the entry with |key|, or
+ * the index of the empty slot where it would be inserted.
+ */
+static uint32_t find_slot(nghttp2_map_entry **table, uint32_t tablelen,
+                          uint32_t tablelenbits, key_type key)
+{
+  uint32_t i;
+  for(i = hash(key, tablelenbits); table[i] && table[i]->key != key;
+      i = (i + 1) & (tablelen - 1));
+  return i;
+}
+
+static int resize(nghttp2_map *map, uint32_t new_tablelenbits)
+{
+  uint32_t i;
+  uint32_t new_tablelen = 1u << new_tablelenbits;
+  nghttp2_map_entry **new_table;
+  new_table = nghttp2_mem_calloc(map->mem, new_tablelen,
+                                 sizeof(nghttp2_map_entry*));
+  if(new_table == NULL) {
+    return NGHTTP2_ERR_NOMEM;
+  }
+  for(i = 0; i < map->tablelen; ++i) {
+    nghttp2_map_entry *entry = map->table[i];
+    if(entry) {
+      new_table[find_slot(new_table, new_tablelen, new_tablelenbits,
+                          entry->key)] = entry;
     }
   }
-  if(entry->left) {
-    entry->left->parent = entry;
-  }
-  return root;
+  nghttp2_mem_free(map->mem, map->table);
+  map->table = new_table;
+  map->tablelen = new_tablelen;
+  map->tablelenbits = new_tablelenbits;
+  return 0;
 }
 
-int nghttp2_map_insert(nghttp2_map *map, nghttp2_map_entry *new_entry)
+int nghttp2_map_insert(nghttp2_map *map, nghttp2_map_entry *entry)
 {
-  nghttp2_map_entry *entry = map->root, *parent = NULL;
-  if(map->root == NULL) {
-    map->root = new_entry;
-    map->size = 1;
-    return 0;
-  }
-  /* Find position to insert. */
-  while(1) {
-    if(new_entry->key == entry->key) {
-      return NGHTTP2_ERR_INVALID_ARGUMENT;
-    } else {
-      if(new_entry->key < entry->key) {
-        if(entry->left) {
-          entry = entry->left;
-        } else {
-          parent = entry;
-          parent->left = new_entry;
-          break;
-        }
-      } else {
-        if(entry->right) {
-          entry = entry->right;
-        } else {
-          parent = entry;
-          parent->right = new_entry;
-          break;
-        }
-      }
+  int rv;
+  uint32_t i;
+  /* Keep the load factor at most 3/4 */
+  if((map->size + 1) * 4 > map->tablelen * 3) {
+    rv = resize(map, map->tablelenbits + 1);
+    if(rv != 0) {
+      return rv;
     }
   }
-  new_entry->parent = parent;
-
-  /* Rotate tree to satisfy heap property. */
-  for(entry = parent; ; entry = entry->parent) {
-    if(entry->left && entry->priority > entry->left->priority) {
-      entry = rotate_right(entry);
-    } else if(entry->right && entry->priority > entry->right->priority) {
-      entry = rotate_left(entry);
-    } else {
-      /* At this point, tree forms heap. */
-      break;
-    }
-    /* If no parent is assigned, then it is a root node. */
-    if(!entry->parent) {
-      map->root = entry;
-      break;
-    }
+  i = find_slot(map->table, map->tablelen, map->tablelenbits, entry->key);
+  if(map->table[i]) {
+    return NGHTTP2_ERR_INVALID_ARGUMENT;
   }
+  map->table[i] = entry;
   ++map->size;
   return 0;
 }
 
 nghttp2_map_entry* nghttp2_map_find(nghttp2_map *map, key_type key)
 {
-  nghttp2_map_entry *entry = map->root;
-  while(entry != NULL) {
-    if(key < entry->key) {
-      entry = entry->left;
-    } else if(key > entry->key) {
-      entry = entry->right;
-    } else {
-      return entry;
-    }
-  }
-  return NULL;
+  return map->table[find_slot(map->table, map->tablelen, map->tablelenbits,
+                              key)];
 }
 
 int nghttp2_map_remove(nghttp2_map *map, key_type key)
 {
-  nghttp2_map_entry *entry = map->root;
-
-  if(map->root == NULL) {
-    return NGHTTP2_ERR_INVALID_ARGUMENT;
-  }
-  /* Locate entry to delete. */
-  while(entry) {
-    if(key < entry->key) {
-      entry = entry->left;
-    } else if(key > entry->key) {
-      entry = entry->right;
-    } else {
-      break;
-    }
-  }
-  if(!entry) {
-    /* Not found */
+  uint32_t i, j, k;
+  uint32_t mask = map->tablelen - 1;
+  i = find_slot(map->table, map->tablelen, map->tablelenbits, key);
+  if(map->table[i] == NULL) {
     return NGHTTP2_ERR_INVALID_ARGUMENT;
   }
-  /* Rotate and bubble down to satisfy heap property. */
-  for(;;) {
-    if(!entry->left) {
-      if(!entry->parent) {
-        map->root = entry->right;
-      } else if(entry->parent->left == entry) {
-        entry->parent->left = entry->right;
-      } else {
-        entry->parent->right = entry->right;
-      }
-      if(entry->right) {
-        entry->right->parent = entry->parent;
-      }
-      break;
-    } else if(!entry->right) {
-      if(!entry->parent) {
-        map->root = entry->left;
-      } else if(entry->parent->left == entry) {
-        entry->parent->left = entry->left;
-      } else {
-        entry->parent->right = entry->left;
-      }
-      if(entry->left) {
-        entry->left->parent = entry->parent;
-      }
-      break;
-    } else if(entry->left->priority < entry->right->priority) {
-      entry = rotate_right(entry);
-      if(!entry->parent) {
-        map->root = entry;
-      }
-      entry = entry->right;
-    } else {
-      entry = rotate_left(entry);
-      if(!entry->parent) {
-        map->root = entry;
-      }
-      entry = entry->left;
+  /* Shift back the following entries in the same cluster, so that no
+     tombstone is needed. The entry at j can fill the hole at i only
+     if its home slot k is not cyclically in (i, j]. */
+  for(j = (i + 1) & mask; map->table[j]; j = (j + 1) & mask) {
+    k = hash(map->table[j]->key, map->tablelenbits);
+    if(i <= j ? (i < k && k <= j) : (i < k || k <= j)) {
+      continue;
     }
+    map->table[i] = map->table[j];
+    i = j;
   }
+  map->table[i] = NULL;
   --map->size;
   return 0;
 }
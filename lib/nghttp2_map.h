@@ -31,27 +31,38 @@
 
 #include <nghttp2/nghttp2.h>
 #include "nghttp2_int.h"
+#include "nghttp2_mem.h"
 
-/* Implementation of ordered map */
+/* Implementation of unordered map. This is a hash table with open
+   addressing (linear probing), which stores pointers to the
+   entries. */
 
 typedef uint32_t key_type;
-typedef uint32_t pri_type;
 
 typedef struct nghttp2_map_entry {
   key_type key;
-  struct nghttp2_map_entry *parent, *left, *right;
-  pri_type priority;
 } nghttp2_map_entry;
 
 typedef struct {
-  nghttp2_map_entry *root;
+  nghttp2_map_entry **table;
+  nghttp2_mem *mem;
   size_t size;
+  /* The number of slots in table. Always power of 2. */
+  uint32_t tablelen;
+  /* log2(tablelen) */
+  uint32_t tablelenbits;
 } nghttp2_map;
 
 /*
  * Initializes the map |map|.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory
  */
-void nghttp2_map_init(nghttp2_map *map);
+int nghttp2_map_init(nghttp2_map *map, nghttp2_mem *mem);
 
 /*
  * Deallocates any resources allocated for |map|. The stored entries
@@ -84,6 +95,8 @@ void nghttp2_map_entry_init(nghttp2_map_entry *entry, key_type key);
  *
  * NGHTTP2_ERR_INVALID_ARGUMENT
  *     The item associated by |key| already exists.
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory
  */
 int nghttp2_map_insert(nghttp2_map *map, nghttp2_map_entry *entry);
 
@@ -112,7 +125,8 @@ size_t nghttp2_map_size(nghttp2_map *map);
 
 /*
  * Applies the function |func| to each entry in the |map| with the
- * optional user supplied pointer |ptr|.
+ * optional user supplied pointer |ptr|. The entries are visited in
+ * no particular order. The |func| must not insert or remove entries.
  *
  * If the |func| returns 0, this function calls the |func| with the
  * next entry. If the |func| returns nonzero, it will not call the
@@ -0,0 +1,125 @@
+/*
+ * nghttp2 - HTTP/2.0 C Library
+ *
+ * Copyright (c) 2014 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "nghttp2_mempool.h"
+
+typedef union {
+  void *p;
+  double d;
+  int64_t i;
+} nghttp2_mempool_align;
+
+#define NGHTTP2_MEMPOOL_ALIGN(N)                                        \
+  (((N) + sizeof(nghttp2_mempool_align) - 1) &                          \
+   ~(sizeof(nghttp2_mempool_align) - 1))
+
+void nghttp2_mempool_init(nghttp2_mempool *pool, size_t objsize, size_t nobj,
+                          nghttp2_mem *mem)
+{
+  pool->blocks = NULL;
+  pool->freelist = NULL;
+  pool->mem = mem;
+  if(objsize < sizeof(nghttp2_mempool_obj)) {
+    objsize = sizeof(nghttp2_mempool_obj);
+  }
+  pool->objsize = NGHTTP2_MEMPOOL_ALIGN(objsize);
+  pool->nobj = nobj;
+  pool->nblocks = 0;
+  pool->nalloc = 0;
+}
+
+void nghttp2_mempool_free(nghttp2_mempool *pool)
+{
+  nghttp2_mempool_block *block, *next;
+  for(block = pool->blocks; block; block = next) {
+    next = block->next;
+    nghttp2_mem_free(pool->mem, block);
+  }
+  pool->blocks = NULL;
+  pool->freelist = NULL;
+  pool->nblocks = 0;
+}
+
+/*
+ * Allocates new block and pushes its objects to the free list.
+ */
+static int mempool_grow(nghttp2_mempool *pool)
+{
+  size_t hdlen = NGHTTP2_MEMPOOL_ALIGN(sizeof(nghttp2_mempool_block));
+  nghttp2_mempool_block *block;
+  uint8_t *p;
+  size_t i;
+  block = nghttp2_mem_malloc(pool->mem, hdlen + pool->objsize * pool->nobj);
+  if(block == NULL) {
+    return NGHTTP2_ERR_NOMEM;
+  }
+  block->next = pool->blocks;
+  pool->blocks = block;
+  ++pool->nblocks;
+  p = (uint8_t*)block + hdlen + pool->objsize * pool->nobj;
+  for(i = 0; i < pool->nobj; ++i) {
+    nghttp2_mempool_obj *obj;
+    p -= pool->objsize;
+    obj = (nghttp2_mempool_obj*)p;
+    obj->next = pool->freelist;
+    pool->freelist = obj;
+  }
+  return 0;
+}
+
+void* nghttp2_mempool_alloc(nghttp2_mempool *pool)
+{
+  nghttp2_mempool_obj *obj;
+  if(pool->freelist == NULL && mempool_grow(pool) != 0) {
+    return NULL;
+  }
+  obj = pool->freelist;
+  pool->freelist = obj->next;
+  ++pool->nalloc;
+  return obj;
+}
+
+void nghttp2_mempool_release(nghttp2_mempool *pool, void *obj)
+{
+  nghttp2_mempool_obj *o = obj;
+  if(o == NULL) {
+    return;
+  }
+  o->next = pool->freelist;
+  pool->freelist = o;
+  --pool->nalloc;
+}
+
+void nghttp2_mempool_shrink(nghttp2_mempool *pool)
+{
+  if(pool->nalloc == 0) {
+    nghttp2_mempool_free(pool);
+  }
+}
+
+size_t nghttp2_mempool_get_mem_usage(nghttp2_mempool *pool)
+{
+  return pool->nblocks * (NGHTTP2_MEMPOOL_ALIGN(sizeof(nghttp2_mempool_block))
+                          + pool->objsize * pool->nobj);
+}
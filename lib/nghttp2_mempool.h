@@ -0,0 +1,105 @@
+/*
+ * nghttp2 - HTTP/2.0 C Library
+ *
+ * Copyright (c) 2014 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NGHTTP2_MEMPOOL_H
+#define NGHTTP2_MEMPOOL_H
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <nghttp2/nghttp2.h>
+#include "nghttp2_mem.h"
+
+/*
+ * Pool of fixed size objects. The objects are carved out from blocks
+ * allocated by nghttp2_mem, and released objects are kept in the
+ * free list for later reuse. The blocks are not returned to the
+ * allocator until nghttp2_mempool_free() is called, or
+ * nghttp2_mempool_shrink() is called while no object is in use.
+ */
+
+typedef struct nghttp2_mempool_block {
+  struct nghttp2_mempool_block *next;
+} nghttp2_mempool_block;
+
+typedef struct nghttp2_mempool_obj {
+  struct nghttp2_mempool_obj *next;
+} nghttp2_mempool_obj;
+
+typedef struct {
+  /* Singly linked list of blocks allocated so far */
+  nghttp2_mempool_block *blocks;
+  /* Singly linked list of objects available for allocation */
+  nghttp2_mempool_obj *freelist;
+  nghttp2_mem *mem;
+  /* The size of each object, rounded up to the alignment */
+  size_t objsize;
+  /* The number of objects in each block */
+  size_t nobj;
+  /* The number of blocks allocated */
+  size_t nblocks;
+  /* The number of objects handed out and not released yet */
+  size_t nalloc;
+} nghttp2_mempool;
+
+/*
+ * Initializes |pool| which hands out objects of |objsize| bytes. The
+ * backing blocks hold |nobj| objects each and are allocated using
+ * |mem|. This function does not allocate memory.
+ */
+void nghttp2_mempool_init(nghttp2_mempool *pool, size_t objsize, size_t nobj,
+                          nghttp2_mem *mem);
+
+/*
+ * Deallocates all blocks allocated for |pool|. Any object obtained
+ * from |pool| becomes invalid.
+ */
+void nghttp2_mempool_free(nghttp2_mempool *pool);
+
+/*
+ * Returns uninitialized object from |pool|, or NULL if out of
+ * memory.
+ */
+void* nghttp2_mempool_alloc(nghttp2_mempool *pool);
+
+/*
+ * Returns |obj|, which must have been obtained from |pool|, to
+ * |pool|. If |obj| is NULL, this function does nothing.
+ */
+void nghttp2_mempool_release(nghttp2_mempool *pool, void *obj);
+
+/*
+ * Deallocates all blocks of |pool| if no object obtained from |pool|
+ * is in use. Otherwise, this function does nothing. The |pool| stays
+ * usable.
+ */
+void nghttp2_mempool_shrink(nghttp2_mempool *pool);
+
+/*
+ * Returns the number of bytes allocated for the blocks of |pool|.
+ */
+size_t nghttp2_mempool_get_mem_usage(nghttp2_mempool *pool);
+
+#endif /* NGHTTP2_MEMPOOL_H */
@@ -0,0 +1,101 @@
+/*
+ * nghttp2 - HTTP/2.0 C Library
+ *
+ * Copyright (c) 2014 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "nghttp2_mpscq.h"
+
+#include <stddef.h>
+
+/* The ordering we need: the producer publishes the entry with a
+   release store to the next link of the previous entry, and the
+   consumer reads the links with acquire loads. configure checks for
+   the C11 style builtins. Older GCC compatible compilers only have
+   the __sync builtins, which are full barriers. */
+#ifdef HAVE_ATOMIC_BUILTINS
+#  define mpscq_exchange(P, V) __atomic_exchange_n(P, V, __ATOMIC_ACQ_REL)
+#  define mpscq_load(P) __atomic_load_n(P, __ATOMIC_ACQUIRE)
+#  define mpscq_store(P, V) __atomic_store_n(P, V, __ATOMIC_RELEASE)
+#else /* !HAVE_ATOMIC_BUILTINS */
+#  define mpscq_exchange(P, V)                                          \
+  (__sync_synchronize(), __sync_lock_test_and_set(P, V))
+#  define mpscq_load(P) __sync_fetch_and_add(P, 0)
+#  define mpscq_store(P, V)                                             \
+  do { __sync_synchronize(); *(P) = (V); } while(0)
+#endif /* !HAVE_ATOMIC_BUILTINS */
+
+void nghttp2_mpscq_init(nghttp2_mpscq *q)
+{
+  q->stub.next = NULL;
+  q->head = &q->stub;
+  q->tail = &q->stub;
+}
+
+void nghttp2_mpscq_push(nghttp2_mpscq *q, nghttp2_mpscq_entry *ent)
+{
+  nghttp2_mpscq_entry *prev;
+  ent->next = NULL;
+  prev = mpscq_exchange(&q->head, ent);
+  /* Until this store, |ent| and anything pushed after it cannot be
+     reached from |tail|. */
+  mpscq_store(&prev->next, ent);
+}
+
+nghttp2_mpscq_entry* nghttp2_mpscq_pop(nghttp2_mpscq *q)
+{
+  nghttp2_mpscq_entry *tail = q->tail;
+  nghttp2_mpscq_entry *next = mpscq_load(&tail->next);
+  if(tail == &q->stub) {
+    if(next == NULL) {
+      return NULL;
+    }
+    /* Skip the stub */
+    q->tail = next;
+    tail = next;
+    next = mpscq_load(&tail->next);
+  }
+  if(next) {
+    q->tail = next;
+    return tail;
+  }
+  if(tail != mpscq_load(&q->head)) {
+    /* A producer has swapped |head| but not linked its entry yet */
+    return NULL;
+  }
+  /* |tail| is the last entry. Put the stub behind it, so that |tail|
+     can be handed out without leaving the queue empty. */
+  nghttp2_mpscq_push(q, &q->stub);
+  next = mpscq_load(&tail->next);
+  if(next) {
+    q->tail = next;
+    return tail;
+  }
+  return NULL;
+}
+
+int nghttp2_mpscq_empty(nghttp2_mpscq *q)
+{
+  /* The last entry stays at |tail| until the stub is put behind it,
+     so only the stub alone means empty. */
+  return q->tail == &q->stub && mpscq_load(&q->head) == &q->stub &&
+    mpscq_load(&q->stub.next) == NULL;
+}
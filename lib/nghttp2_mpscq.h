@@ -0,0 +1,87 @@
+/*
+ * nghttp2 - HTTP/2.0 C Library
+ *
+ * Copyright (c) 2014 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef NGHTTP2_MPSCQ_H
+#define NGHTTP2_MPSCQ_H
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <nghttp2/nghttp2.h>
+
+/*
+ * Intrusive multi-producer single-consumer queue. Any thread may push
+ * entries without taking a lock, while only one thread, the owner of
+ * the queue, may pop them. The entry is embedded in the object to be
+ * queued, so the queue itself never allocates memory.
+ *
+ * The producers serialize on one atomic exchange of |head|, and the
+ * consumer only reads |tail| and the next links. A producer which is
+ * preempted between the exchange and the link makes the entries
+ * behind it temporarily invisible to the consumer. They are popped
+ * on a later call once the link is in place.
+ */
+
+typedef struct nghttp2_mpscq_entry {
+  struct nghttp2_mpscq_entry *next;
+} nghttp2_mpscq_entry;
+
+typedef struct {
+  /* The entry pushed last. Updated by the producers. */
+  nghttp2_mpscq_entry *head;
+  /* The entry to be popped next, or |stub|. Only touched by the
+     consumer. */
+  nghttp2_mpscq_entry *tail;
+  /* Placeholder which keeps the queue non-empty, so that push never
+     has to touch |tail|. */
+  nghttp2_mpscq_entry stub;
+} nghttp2_mpscq;
+
+/*
+ * Initializes |q|. This function must be called before the queue is
+ * shared with the other threads.
+ */
+void nghttp2_mpscq_init(nghttp2_mpscq *q);
+
+/*
+ * Appends |ent| to |q|. This function may be called from any thread.
+ */
+void nghttp2_mpscq_push(nghttp2_mpscq *q, nghttp2_mpscq_entry *ent);
+
+/*
+ * Removes the oldest entry from |q| and returns it. This function
+ * returns NULL if |q| is empty, or the oldest entry is still being
+ * pushed. Only the owner thread may call this function.
+ */
+nghttp2_mpscq_entry* nghttp2_mpscq_pop(nghttp2_mpscq *q);
+
+/*
+ * Returns nonzero if there is no entry to pop from |q|, including
+ * the one still being pushed. Only the owner thread may call this
+ * function.
+ */
+int nghttp2_mpscq_empty(nghttp2_mpscq *q);
+
+#endif /* NGHTTP2_MPSCQ_H */
@@ -26,7 +26,7 @@
 
 #include <assert.h>
 
-void nghttp2_outbound_item_free(nghttp2_outbound_item *item)
+void nghttp2_outbound_item_free(nghttp2_outbound_item *item, nghttp2_mem *mem)
 {
   if(item == NULL) {
     return;
@@ -36,10 +36,7 @@ void nghttp2_outbound_item_free(nghttp2_outbound_item *item)
     frame = nghttp2_outbound_item_get_ctrl_frame(item);
     switch(frame->hd.type) {
     case NGHTTP2_HEADERS:
-      nghttp2_frame_headers_free(&frame->headers);
-      if(item->aux_data) {
-        free(((nghttp2_headers_aux_data*)item->aux_data)->data_prd);
-      }
+      nghttp2_frame_headers_free(&frame->headers, mem);
       break;
     case NGHTTP2_PRIORITY:
       nghttp2_frame_priority_free(&frame->priority);
@@ -48,16 +45,16 @@ void nghttp2_outbound_item_free(nghttp2_outbound_item *item)
       nghttp2_frame_rst_stream_free(&frame->rst_stream);
       break;
     case NGHTTP2_SETTINGS:
-      nghttp2_frame_settings_free(&frame->settings);
+      nghttp2_frame_settings_free(&frame->settings, mem);
       break;
     case NGHTTP2_PUSH_PROMISE:
-      nghttp2_frame_push_promise_free(&frame->push_promise);
+      nghttp2_frame_push_promise_free(&frame->push_promise, mem);
       break;
     case NGHTTP2_PING:
       nghttp2_frame_ping_free(&frame->ping);
       break;
     case NGHTTP2_GOAWAY:
-      nghttp2_frame_goaway_free(&frame->goaway);
+      nghttp2_frame_goaway_free(&frame->goaway, mem);
       break;
     case NGHTTP2_WINDOW_UPDATE:
       nghttp2_frame_window_update_free(&frame->window_update);
@@ -71,6 +68,40 @@ void nghttp2_outbound_item_free(nghttp2_outbound_item *item)
     /* Unreachable */
     assert(0);
   }
-  free(item->frame);
-  free(item->aux_data);
+  nghttp2_mem_free(mem, item->frame);
+  nghttp2_mem_free(mem, item->aux_data);
+}
+
+void nghttp2_outbound_queue_init(nghttp2_outbound_queue *q)
+{
+  q->head = q->tail = NULL;
+  q->n = 0;
+}
+
+void nghttp2_outbound_queue_push(nghttp2_outbound_queue *q,
+                                 nghttp2_outbound_item *item)
+{
+  item->qnext = NULL;
+  if(q->tail) {
+    q->tail->qnext = item;
+  } else {
+    q->head = item;
+  }
+  q->tail = item;
+  ++q->n;
+}
+
+nghttp2_outbound_item* nghttp2_outbound_queue_pop(nghttp2_outbound_queue *q)
+{
+  nghttp2_outbound_item *item = q->head;
+  if(item == NULL) {
+    return NULL;
+  }
+  q->head = item->qnext;
+  if(q->head == NULL) {
+    q->tail = NULL;
+  }
+  item->qnext = NULL;
+  --q->n;
+  return item;
 }
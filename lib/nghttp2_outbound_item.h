@@ -31,6 +31,7 @@
 
 #include <nghttp2/nghttp2.h>
 #include "nghttp2_frame.h"
+#include "nghttp2_pq.h"
 
 /* Priority for PING */
 #define NGHTTP2_OB_PRI_PING -10
@@ -38,11 +39,18 @@
 #define NGHTTP2_OB_PRI_SETTINGS -9
 
 typedef struct {
-  nghttp2_data_provider *data_prd;
+  /* The data provider for DATA frames following HEADERS. No DATA
+     frame is submitted if data_prd.read_callback is NULL. */
+  nghttp2_data_provider data_prd;
   void *stream_user_data;
 } nghttp2_headers_aux_data;
 
-typedef struct {
+struct nghttp2_stream;
+
+typedef struct nghttp2_outbound_item {
+  /* Intrusive priority queue entry. This must be the first member,
+     so that the compare function can cast the entry to the item. */
+  nghttp2_pq_entry pq_entry;
   /* Type of |frame|. NGHTTP2_CTRL: nghttp2_frame*, NGHTTP2_DATA:
      nghttp2_data* */
   nghttp2_frame_category frame_cat;
@@ -50,13 +58,35 @@ typedef struct {
   void *aux_data;
   int pri;
   int64_t seq;
+  /* The queue this item is currently in, or NULL. */
+  nghttp2_pq *queue;
+  /* The stream whose priority this item follows. This is only set
+     while the item is in the queue, and then the item is linked in
+     the list headed by stream->queued_items. */
+  struct nghttp2_stream *stream;
+  struct nghttp2_outbound_item *stream_prev, *stream_next;
+  /* The next item in nghttp2_outbound_queue */
+  struct nghttp2_outbound_item *qnext;
+  /* Nonzero if this control frame replies to a received frame */
+  uint8_t reply;
 } nghttp2_outbound_item;
 
 /*
- * Deallocates resource for |item|. If |item| is NULL, this function
- * does nothing.
+ * FIFO queue of outbound items, linked by nghttp2_outbound_item.qnext.
+ * Unlike nghttp2_pq, push and pop are O(1) and never allocate.
  */
-void nghttp2_outbound_item_free(nghttp2_outbound_item *item);
+typedef struct {
+  nghttp2_outbound_item *head, *tail;
+  /* The number of items in the queue */
+  size_t n;
+} nghttp2_outbound_queue;
+
+/*
+ * Deallocates resource for |item|, which were allocated using
+ * |mem|. The |item| itself is not freed by this function. If |item|
+ * is NULL, this function does nothing.
+ */
+void nghttp2_outbound_item_free(nghttp2_outbound_item *item, nghttp2_mem *mem);
 
 /* Macros to cast nghttp2_outbound_item.frame to the proper type. */
 #define nghttp2_outbound_item_get_ctrl_frame(ITEM) ((nghttp2_frame*)ITEM->frame)
@@ -64,4 +94,23 @@ void nghttp2_outbound_item_free(nghttp2_outbound_item *item);
   (((nghttp2_frame*)ITEM->frame)->hd.type)
 #define nghttp2_outbound_item_get_data_frame(ITEM) ((nghttp2_data*)ITEM->frame)
 
+void nghttp2_outbound_queue_init(nghttp2_outbound_queue *q);
+
+/*
+ * Appends |item| to the tail of |q|.
+ */
+void nghttp2_outbound_queue_push(nghttp2_outbound_queue *q,
+                                 nghttp2_outbound_item *item);
+
+/*
+ * Removes the head of |q| and returns it, or returns NULL if |q| is
+ * empty.
+ */
+nghttp2_outbound_item* nghttp2_outbound_queue_pop(nghttp2_outbound_queue *q);
+
+/* Returns the head of |q|, or NULL if |q| is empty */
+#define nghttp2_outbound_queue_top(Q) ((Q)->head)
+/* Returns the number of items in |q| */
+#define nghttp2_outbound_queue_size(Q) ((Q)->n)
+
 #endif /* NGHTTP2_OUTBOUND_ITEM_H */
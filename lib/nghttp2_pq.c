@@ -24,10 +24,13 @@
  */
 #include "nghttp2_pq.h"
 
-int nghttp2_pq_init(nghttp2_pq *pq, nghttp2_compar compar)
+#include <assert.h>
+
+int nghttp2_pq_init(nghttp2_pq *pq, nghttp2_compar compar, nghttp2_mem *mem)
 {
+  pq->mem = mem;
   pq->capacity = 4096;
-  pq->q = malloc(pq->capacity * sizeof(void*));
+  pq->q = nghttp2_mem_malloc(mem, pq->capacity * sizeof(nghttp2_pq_entry*));
   if(pq->q == NULL) {
     return NGHTTP2_ERR_NOMEM;
   }
@@ -38,15 +41,17 @@ int nghttp2_pq_init(nghttp2_pq *pq, nghttp2_compar compar)
 
 void nghttp2_pq_free(nghttp2_pq *pq)
 {
-  free(pq->q);
+  nghttp2_mem_free(pq->mem, pq->q);
   pq->q = NULL;
 }
 
 static void swap(nghttp2_pq *pq, size_t i, size_t j)
 {
-  void *t = pq->q[i];
+  nghttp2_pq_entry *t = pq->q[i];
   pq->q[i] = pq->q[j];
   pq->q[j] = t;
+  pq->q[i]->index = i;
+  pq->q[j]->index = j;
 }
 
 static void bubble_up(nghttp2_pq *pq, size_t index)
@@ -62,24 +67,27 @@ static void bubble_up(nghttp2_pq *pq, size_t index)
   }
 }
 
-int nghttp2_pq_push(nghttp2_pq *pq, void *item)
+int nghttp2_pq_push(nghttp2_pq *pq, nghttp2_pq_entry *item)
 {
   if(pq->capacity <= pq->length) {
     void *nq;
-    nq = realloc(pq->q, (pq->capacity*2) * sizeof(void*));
+    nq = nghttp2_mem_realloc(pq->mem, pq->q,
+                             (pq->capacity*2) *
+                             sizeof(nghttp2_pq_entry*));
     if(nq == NULL) {
       return NGHTTP2_ERR_NOMEM;
     }
     pq->capacity *= 2;
     pq->q = nq;
   }
+  item->index = pq->length;
   pq->q[pq->length] = item;
   ++pq->length;
   bubble_up(pq, pq->length-1);
   return 0;
 }
 
-void* nghttp2_pq_top(nghttp2_pq *pq)
+nghttp2_pq_entry* nghttp2_pq_top(nghttp2_pq *pq)
 {
   if(pq->length == 0) {
     return NULL;
@@ -112,11 +120,35 @@ void nghttp2_pq_pop(nghttp2_pq *pq)
 {
   if(pq->length > 0) {
     pq->q[0] = pq->q[pq->length-1];
+    pq->q[0]->index = 0;
     --pq->length;
     bubble_down(pq, 0);
   }
 }
 
+void nghttp2_pq_remove(nghttp2_pq *pq, nghttp2_pq_entry *item)
+{
+  size_t index = item->index;
+  assert(index < pq->length && pq->q[index] == item);
+  --pq->length;
+  if(index == pq->length) {
+    return;
+  }
+  pq->q[index] = pq->q[pq->length];
+  pq->q[index]->index = index;
+  nghttp2_pq_update_entry(pq, pq->q[index]);
+}
+
+void nghttp2_pq_update_entry(nghttp2_pq *pq, nghttp2_pq_entry *item)
+{
+  size_t index = item->index;
+  if(index > 0 && pq->compar(pq->q[(index-1)/2], item) > 0) {
+    bubble_up(pq, index);
+  } else {
+    bubble_down(pq, index);
+  }
+}
+
 int nghttp2_pq_empty(nghttp2_pq *pq)
 {
   return pq->length == 0;
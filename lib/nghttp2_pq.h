@@ -31,12 +31,22 @@
 
 #include <nghttp2/nghttp2.h>
 #include "nghttp2_int.h"
+#include "nghttp2_mem.h"
 
-/* Implementation of priority queue */
+/* Implementation of priority queue. The queue stores pointers to
+   the entries, and each entry records its current position in the
+   queue, so that an arbitrary entry can be removed or re-positioned
+   in O(log n). */
+
+typedef struct {
+  /* The index of this entry in nghttp2_pq.q. Only meaningful while
+     the entry is in a queue. */
+  size_t index;
+} nghttp2_pq_entry;
 
 typedef struct {
   /* The pointer to the pointer to the item stored */
-  void **q;
+  nghttp2_pq_entry **q;
   /* The number of items sotred */
   size_t length;
   /* The maximum number of items this pq can store. This is
@@ -44,10 +54,12 @@ typedef struct {
   size_t capacity;
   /* The compare function between items */
   nghttp2_compar compar;
+  nghttp2_mem *mem;
 } nghttp2_pq;
 
 /*
- * Initializes priority queue |pq| with compare function |cmp|.
+ * Initializes priority queue |pq| with compare function |cmp|. The
+ * memory for the queue is allocated using |mem|.
  *
  * This function returns 0 if it succeeds, or one of the following
  * negative error codes:
@@ -55,7 +67,7 @@ typedef struct {
  * NGHTTP2_ERR_NOMEM
  *     Out of memory.
  */
-int nghttp2_pq_init(nghttp2_pq *pq, nghttp2_compar cmp);
+int nghttp2_pq_init(nghttp2_pq *pq, nghttp2_compar cmp, nghttp2_mem *mem);
 
 /*
  * Deallocates any resources allocated for |pq|.  The stored items are
@@ -64,7 +76,8 @@ int nghttp2_pq_init(nghttp2_pq *pq, nghttp2_compar cmp);
 void nghttp2_pq_free(nghttp2_pq *pq);
 
 /*
- * Adds |item| to the priority queue |pq|.
+ * Adds |item| to the priority queue |pq|. The |item| must not be in
+ * any queue.
  *
  * This function returns 0 if it succeds, or one of the following
  * negative error codes:
@@ -72,13 +85,13 @@ void nghttp2_pq_free(nghttp2_pq *pq);
  * NGHTTP2_ERR_NOMEM
  *     Out of memory.
  */
-int nghttp2_pq_push(nghttp2_pq *pq, void *item);
+int nghttp2_pq_push(nghttp2_pq *pq, nghttp2_pq_entry *item);
 
 /*
  * Returns item at the top of the queue |pq|. If the queue is empty,
  * this function returns NULL.
  */
-void* nghttp2_pq_top(nghttp2_pq *pq);
+nghttp2_pq_entry* nghttp2_pq_top(nghttp2_pq *pq);
 
 /*
  * Pops item at the top of the queue |pq|. The popped item is not
@@ -96,7 +109,20 @@ int nghttp2_pq_empty(nghttp2_pq *pq);
  */
 size_t nghttp2_pq_size(nghttp2_pq *pq);
 
-typedef int (*nghttp2_pq_item_cb)(void *item, void *arg);
+/*
+ * Removes |item| from the priority queue |pq|. The |item| must be in
+ * |pq|. The removed item is not freed by this function.
+ */
+void nghttp2_pq_remove(nghttp2_pq *pq, nghttp2_pq_entry *item);
+
+/*
+ * Restores the ordering of |pq| after the key of |item| was
+ * modified. The |item| must be in |pq|. This function runs in
+ * O(log n), while nghttp2_pq_update() visits all items.
+ */
+void nghttp2_pq_update_entry(nghttp2_pq *pq, nghttp2_pq_entry *item);
+
+typedef int (*nghttp2_pq_item_cb)(nghttp2_pq_entry *item, void *arg);
 
 /*
  * Updates each item in |pq| using function |fun| and re-construct
@@ -31,6 +31,7 @@
 
 #include "nghttp2_helper.h"
 #include "nghttp2_net.h"
+#include "nghttp2_submit.h"
 
 /*
  * Returns non-zero if the number of outgoing opened streams is larger
@@ -124,19 +125,49 @@ static void nghttp2_inbound_frame_reset(nghttp2_inbound_frame *iframe)
   iframe->error_code = 0;
 }
 
+/*
+ * Calls nghttp2_session_callbacks.select_header_indexing_callback for
+ * the header compressor of the session |arg|.
+ */
+static int nghttp2_session_select_header_indexing(const nghttp2_nv *nv,
+                                                  void *arg)
+{
+  nghttp2_session *session = (nghttp2_session*)arg;
+  return session->callbacks.select_header_indexing_callback
+    (session, nv, session->user_data);
+}
+
 static int nghttp2_session_new(nghttp2_session **session_ptr,
                                const nghttp2_session_callbacks *callbacks,
                                void *user_data,
-                               nghttp2_hd_side side)
+                               nghttp2_hd_side side,
+                               const nghttp2_mem *mem)
 {
   int r;
-  *session_ptr = malloc(sizeof(nghttp2_session));
+  size_t i;
+  nghttp2_mem *smem;
+  if(mem == NULL) {
+    mem = nghttp2_mem_default();
+  }
+  *session_ptr = mem->malloc(sizeof(nghttp2_session), mem->mem_user_data);
   if(*session_ptr == NULL) {
     r = NGHTTP2_ERR_NOMEM;
     goto fail_session;
   }
   memset(*session_ptr, 0, sizeof(nghttp2_session));
 
+  /* All further allocations refer to the copy of |mem|, so that the
+     application does not have to keep |mem| alive. */
+  (*session_ptr)->mem = *mem;
+  smem = &(*session_ptr)->mem;
+
+  nghttp2_mempool_init(&(*session_ptr)->stream_pool, sizeof(nghttp2_stream),
+                       NGHTTP2_SESSION_POOL_BLOCK_NOBJ, smem);
+  nghttp2_mempool_init(&(*session_ptr)->item_pool,
+                       sizeof(nghttp2_outbound_item),
+                       NGHTTP2_SESSION_POOL_BLOCK_NOBJ, smem);
+  nghttp2_mpscq_init(&(*session_ptr)->async_q);
+
   /* next_stream_id and last_recv_stream_id are initialized in either
      nghttp2_session_client_new or nghttp2_session_server_new */
 
@@ -147,42 +178,50 @@ static int nghttp2_session_new(nghttp2_session **session_ptr,
   (*session_ptr)->remote_window_size = NGHTTP2_INITIAL_CONNECTION_WINDOW_SIZE;
   (*session_ptr)->recv_window_size = 0;
   (*session_ptr)->local_window_size = NGHTTP2_INITIAL_CONNECTION_WINDOW_SIZE;
+  (*session_ptr)->auto_window_max = 0;
+  (*session_ptr)->auto_window_size = NGHTTP2_INITIAL_WINDOW_SIZE;
+  (*session_ptr)->auto_window_bytes = 0;
+  (*session_ptr)->auto_window_ping_inflight = 0;
 
   (*session_ptr)->goaway_flags = NGHTTP2_GOAWAY_NONE;
   (*session_ptr)->last_stream_id = 0;
 
-  r = nghttp2_hd_deflate_init(&(*session_ptr)->hd_deflater, side);
+  r = nghttp2_hd_deflate_init(&(*session_ptr)->hd_deflater, side, smem);
   if(r != 0) {
     goto fail_hd_deflater;
   }
-  r = nghttp2_hd_inflate_init(&(*session_ptr)->hd_inflater, side);
+  r = nghttp2_hd_inflate_init(&(*session_ptr)->hd_inflater, side, smem);
   if(r != 0) {
     goto fail_hd_inflater;
   }
-  nghttp2_map_init(&(*session_ptr)->streams);
-  r = nghttp2_pq_init(&(*session_ptr)->ob_pq, nghttp2_outbound_item_compar);
+  r = nghttp2_map_init(&(*session_ptr)->streams, smem);
+  if(r != 0) {
+    goto fail_streams;
+  }
+  r = nghttp2_pq_init(&(*session_ptr)->ob_pq, nghttp2_outbound_item_compar,
+                      smem);
   if(r != 0) {
     goto fail_ob_pq;
   }
-  r = nghttp2_pq_init(&(*session_ptr)->ob_ss_pq, nghttp2_outbound_item_compar);
+  r = nghttp2_pq_init(&(*session_ptr)->ob_ss_pq, nghttp2_outbound_item_compar,
+                      smem);
   if(r != 0) {
     goto fail_ob_ss_pq;
   }
+  for(i = 0; i < NGHTTP2_OB_CTRL_NQUEUE; ++i) {
+    nghttp2_outbound_queue_init(&(*session_ptr)->ob_ctrl[i]);
+  }
+  (*session_ptr)->max_ob_ctrl = NGHTTP2_DEFAULT_MAX_OUTBOUND_CTRL;
 
-  (*session_ptr)->aob.framebuf = malloc
-    (NGHTTP2_INITIAL_OUTBOUND_FRAMEBUF_LENGTH);
+  (*session_ptr)->aob.framebuf = nghttp2_mem_malloc
+    (smem, NGHTTP2_INITIAL_OUTBOUND_FRAMEBUF_LENGTH);
   if((*session_ptr)->aob.framebuf == NULL) {
     r = NGHTTP2_ERR_NOMEM;
     goto fail_aob_framebuf;
   }
   (*session_ptr)->aob.framebufmax = NGHTTP2_INITIAL_OUTBOUND_FRAMEBUF_LENGTH;
-
-  (*session_ptr)->nvbuf = malloc(NGHTTP2_INITIAL_NV_BUFFER_LENGTH);
-  if((*session_ptr)->nvbuf == NULL) {
-    r = NGHTTP2_ERR_NOMEM;
-    goto fail_nvbuf;
-  }
-  (*session_ptr)->nvbuflen = NGHTTP2_INITIAL_NV_BUFFER_LENGTH;
+  (*session_ptr)->sendv_max_bytes = NGHTTP2_SENDV_DEFAULT_MAX_BYTES;
+  (*session_ptr)->max_data_payloadlen = NGHTTP2_DATA_PAYLOAD_LENGTH;
 
   memset((*session_ptr)->remote_settings, 0,
          sizeof((*session_ptr)->remote_settings));
@@ -201,32 +240,33 @@ static int nghttp2_session_new(nghttp2_session **session_ptr,
   (*session_ptr)->callbacks = *callbacks;
   (*session_ptr)->user_data = user_data;
 
-  (*session_ptr)->iframe.buf = malloc(NGHTTP2_INITIAL_INBOUND_FRAMEBUF_LENGTH);
-  if((*session_ptr)->iframe.buf == NULL) {
-    r = NGHTTP2_ERR_NOMEM;
-    goto fail_iframe_buf;
+  if(callbacks->select_header_indexing_callback) {
+    nghttp2_hd_deflate_set_select_indexing
+      (&(*session_ptr)->hd_deflater, nghttp2_session_select_header_indexing,
+       *session_ptr);
   }
-  (*session_ptr)->iframe.bufmax = NGHTTP2_INITIAL_INBOUND_FRAMEBUF_LENGTH;
+
+  /* iframe.buf is allocated when a frame is not contained in one
+     input */
+  (*session_ptr)->iframe.buf = NULL;
+  (*session_ptr)->iframe.bufmax = 0;
 
   nghttp2_inbound_frame_reset(&(*session_ptr)->iframe);
 
   return 0;
 
- fail_iframe_buf:
-  free((*session_ptr)->nvbuf);
- fail_nvbuf:
-  free((*session_ptr)->aob.framebuf);
  fail_aob_framebuf:
   nghttp2_pq_free(&(*session_ptr)->ob_ss_pq);
  fail_ob_ss_pq:
   nghttp2_pq_free(&(*session_ptr)->ob_pq);
  fail_ob_pq:
-  /* No need to free (*session_ptr)->streams) here. */
+  nghttp2_map_free(&(*session_ptr)->streams);
+ fail_streams:
   nghttp2_hd_inflate_free(&(*session_ptr)->hd_inflater);
  fail_hd_inflater:
   nghttp2_hd_deflate_free(&(*session_ptr)->hd_deflater);
  fail_hd_deflater:
-  free(*session_ptr);
+  mem->free(*session_ptr, mem->mem_user_data);
  fail_session:
   return r;
 }
@@ -234,11 +274,19 @@ static int nghttp2_session_new(nghttp2_session **session_ptr,
 int nghttp2_session_client_new(nghttp2_session **session_ptr,
                                const nghttp2_session_callbacks *callbacks,
                                void *user_data)
+{
+  return nghttp2_session_client_new2(session_ptr, callbacks, user_data, NULL);
+}
+
+int nghttp2_session_client_new2(nghttp2_session **session_ptr,
+                                const nghttp2_session_callbacks *callbacks,
+                                void *user_data,
+                                const nghttp2_mem *mem)
 {
   int r;
   /* For client side session, header compression is disabled. */
   r = nghttp2_session_new(session_ptr, callbacks, user_data,
-                          NGHTTP2_HD_SIDE_CLIENT);
+                          NGHTTP2_HD_SIDE_CLIENT, mem);
   if(r == 0) {
     /* IDs for use in client */
     (*session_ptr)->next_stream_id = 1;
@@ -250,11 +298,19 @@ int nghttp2_session_client_new(nghttp2_session **session_ptr,
 int nghttp2_session_server_new(nghttp2_session **session_ptr,
                                const nghttp2_session_callbacks *callbacks,
                                void *user_data)
+{
+  return nghttp2_session_server_new2(session_ptr, callbacks, user_data, NULL);
+}
+
+int nghttp2_session_server_new2(nghttp2_session **session_ptr,
+                                const nghttp2_session_callbacks *callbacks,
+                                void *user_data,
+                                const nghttp2_mem *mem)
 {
   int r;
   /* Enable header compression on server side. */
   r = nghttp2_session_new(session_ptr, callbacks, user_data,
-                          NGHTTP2_HD_SIDE_SERVER);
+                          NGHTTP2_HD_SIDE_SERVER, mem);
   if(r == 0) {
     (*session_ptr)->server = 1;
     /* IDs for use in client */
@@ -264,89 +320,318 @@ int nghttp2_session_server_new(nghttp2_session **session_ptr,
   return r;
 }
 
+void nghttp2_session_free_outbound_item(nghttp2_session *session,
+                                        nghttp2_outbound_item *item)
+{
+  if(item == NULL) {
+    return;
+  }
+  nghttp2_outbound_item_free(item, &session->mem);
+  nghttp2_mempool_release(&session->item_pool, item);
+}
+
+/*
+ * Pushes |item| to the queue |pq|. If |stream| is not NULL, |item|
+ * is linked to stream->queued_items, so that its priority follows
+ * the stream.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory.
+ */
+static int ob_item_push(nghttp2_pq *pq, nghttp2_outbound_item *item,
+                        nghttp2_stream *stream)
+{
+  int r;
+  r = nghttp2_pq_push(pq, &item->pq_entry);
+  if(r != 0) {
+    return r;
+  }
+  item->queue = pq;
+  item->stream = stream;
+  item->stream_prev = NULL;
+  item->stream_next = NULL;
+  if(stream) {
+    item->stream_next = stream->queued_items;
+    if(stream->queued_items) {
+      stream->queued_items->stream_prev = item;
+    }
+    stream->queued_items = item;
+  }
+  return 0;
+}
+
+/*
+ * Unlinks |item|, which has just been taken out of its queue, from
+ * its stream.
+ */
+static void ob_item_detach(nghttp2_outbound_item *item)
+{
+  if(item->stream) {
+    if(item->stream_prev) {
+      item->stream_prev->stream_next = item->stream_next;
+    } else {
+      item->stream->queued_items = item->stream_next;
+    }
+    if(item->stream_next) {
+      item->stream_next->stream_prev = item->stream_prev;
+    }
+  }
+  item->queue = NULL;
+  item->stream = NULL;
+  item->stream_prev = item->stream_next = NULL;
+}
+
+/*
+ * Pops the item at the top of |pq| and returns it.
+ */
+static nghttp2_outbound_item* ob_item_pop(nghttp2_pq *pq)
+{
+  nghttp2_outbound_item *item;
+  item = (nghttp2_outbound_item*)nghttp2_pq_top(pq);
+  nghttp2_pq_pop(pq);
+  ob_item_detach(item);
+  return item;
+}
+
+/*
+ * Removes the queued DATA frames of |stream| from the outbound queue
+ * and frees them. They would be rejected by
+ * nghttp2_session_predicate_data_send() anyway.
+ */
+static void nghttp2_session_cancel_queued_data(nghttp2_session *session,
+                                               nghttp2_stream *stream)
+{
+  nghttp2_outbound_item *item, *next;
+  for(item = stream->queued_items; item; item = next) {
+    next = item->stream_next;
+    if(item->frame_cat == NGHTTP2_CAT_DATA) {
+      nghttp2_pq_remove(item->queue, &item->pq_entry);
+      ob_item_detach(item);
+      nghttp2_session_free_outbound_item(session, item);
+    }
+  }
+}
+
+/*
+ * Returns nonzero if |stream| is in session->fc_blocked_streams.
+ */
+static int nghttp2_stream_fc_blocked(nghttp2_stream *stream)
+{
+  return stream->deferred_data &&
+    (stream->deferred_flags & NGHTTP2_DEFERRED_FLOW_CONTROL);
+}
+
+/*
+ * Removes |stream| from session->fc_blocked_streams.
+ */
+static void nghttp2_session_fc_blocked_remove(nghttp2_session *session,
+                                              nghttp2_stream *stream)
+{
+  if(stream->fc_prev) {
+    stream->fc_prev->fc_next = stream->fc_next;
+  } else {
+    session->fc_blocked_streams = stream->fc_next;
+  }
+  if(stream->fc_next) {
+    stream->fc_next->fc_prev = stream->fc_prev;
+  }
+  stream->fc_prev = stream->fc_next = NULL;
+}
+
+/*
+ * Defers DATA |item| of |stream|. If |flags| has
+ * NGHTTP2_DEFERRED_FLOW_CONTROL, the |stream| is added to
+ * session->fc_blocked_streams. Otherwise, the application has no
+ * data to send for now, and the DATA payload length of |stream| is
+ * reset.
+ */
+static void nghttp2_session_defer_data(nghttp2_session *session,
+                                       nghttp2_stream *stream,
+                                       nghttp2_outbound_item *item,
+                                       uint8_t flags)
+{
+  nghttp2_stream_defer_data(stream, item, flags);
+  if(flags & NGHTTP2_DEFERRED_FLOW_CONTROL) {
+    ++session->stats.data_fc_blocked;
+    stream->fc_prev = NULL;
+    stream->fc_next = session->fc_blocked_streams;
+    if(session->fc_blocked_streams) {
+      session->fc_blocked_streams->fc_prev = stream;
+    }
+    session->fc_blocked_streams = stream;
+  } else {
+    ++session->stats.data_deferred;
+    stream->data_payloadlen = NGHTTP2_DATA_PAYLOAD_LENGTH;
+  }
+}
+
+/*
+ * Pushes the deferred DATA of |stream| back to the outbound queue and
+ * detaches it from |stream|.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory.
+ */
+static int nghttp2_session_resume_deferred_data(nghttp2_session *session,
+                                                nghttp2_stream *stream)
+{
+  int r;
+  /* The stream lost its turn when DATA was deferred. Take a new turn
+     behind the frames of the same priority. */
+  stream->deferred_data->seq = session->next_seq++;
+  stream->data_credit = nghttp2_stream_quantum(stream);
+  r = ob_item_push(&session->ob_pq, stream->deferred_data, stream);
+  if(r != 0) {
+    return r;
+  }
+  if(nghttp2_stream_fc_blocked(stream)) {
+    nghttp2_session_fc_blocked_remove(session, stream);
+  }
+  nghttp2_stream_detach_deferred_data(stream);
+  return 0;
+}
+
+/*
+ * Deallocates |stream| including its deferred and queued DATA and
+ * returns it to the stream pool of |session|. The other queued
+ * frames of |stream| are left in the queue, and they are rejected
+ * when they are about to be sent.
+ */
+static void nghttp2_session_free_stream(nghttp2_session *session,
+                                        nghttp2_stream *stream)
+{
+  if(nghttp2_stream_fc_blocked(stream)) {
+    nghttp2_session_fc_blocked_remove(session, stream);
+  }
+  nghttp2_session_cancel_queued_data(session, stream);
+  while(stream->queued_items) {
+    ob_item_detach(stream->queued_items);
+  }
+  nghttp2_session_free_outbound_item(session, stream->deferred_data);
+  stream->deferred_data = NULL;
+  nghttp2_stream_free(stream);
+  nghttp2_mempool_release(&session->stream_pool, stream);
+}
+
 static int nghttp2_free_streams(nghttp2_map_entry *entry, void *ptr)
 {
-  nghttp2_stream_free((nghttp2_stream*)entry);
-  free(entry);
+  nghttp2_session_free_stream((nghttp2_session*)ptr, (nghttp2_stream*)entry);
   return 0;
 }
 
-static void nghttp2_session_ob_pq_free(nghttp2_pq *pq)
+static void nghttp2_session_ob_pq_free(nghttp2_session *session,
+                                       nghttp2_pq *pq)
 {
   while(!nghttp2_pq_empty(pq)) {
     nghttp2_outbound_item *item = (nghttp2_outbound_item*)nghttp2_pq_top(pq);
-    nghttp2_outbound_item_free(item);
-    free(item);
     nghttp2_pq_pop(pq);
+    nghttp2_session_free_outbound_item(session, item);
   }
   nghttp2_pq_free(pq);
 }
 
+static void nghttp2_session_ob_ctrl_free(nghttp2_session *session)
+{
+  size_t i;
+  nghttp2_outbound_item *item;
+  for(i = 0; i < NGHTTP2_OB_CTRL_NQUEUE; ++i) {
+    while((item = nghttp2_outbound_queue_pop(&session->ob_ctrl[i]))) {
+      nghttp2_session_free_outbound_item(session, item);
+    }
+  }
+}
+
+static void nghttp2_async_op_free(nghttp2_session *session,
+                                  nghttp2_async_op *op)
+{
+  if(op->type == NGHTTP2_ASYNC_OP_REQUEST) {
+    nghttp2_nv_array_del(op->nva, &session->mem);
+  }
+  nghttp2_mem_free(&session->mem, op);
+}
+
+static void nghttp2_session_async_q_free(nghttp2_session *session)
+{
+  nghttp2_mpscq_entry *ent;
+  while((ent = nghttp2_mpscq_pop(&session->async_q))) {
+    nghttp2_async_op_free(session, (nghttp2_async_op*)ent);
+  }
+}
+
 static void nghttp2_active_outbound_item_reset
-(nghttp2_active_outbound_item *aob)
+(nghttp2_session *session, nghttp2_active_outbound_item *aob)
 {
-  nghttp2_outbound_item_free(aob->item);
-  free(aob->item);
+  nghttp2_session_free_outbound_item(session, aob->item);
   aob->item = NULL;
   aob->framebuflen = aob->framebufoff = 0;
 }
 
 void nghttp2_session_del(nghttp2_session *session)
 {
+  nghttp2_mem mem;
+  size_t i;
   if(session == NULL) {
     return;
   }
-  nghttp2_map_each_free(&session->streams, nghttp2_free_streams, NULL);
-  nghttp2_session_ob_pq_free(&session->ob_pq);
-  nghttp2_session_ob_pq_free(&session->ob_ss_pq);
+  nghttp2_map_each_free(&session->streams, nghttp2_free_streams, session);
+  nghttp2_session_ob_pq_free(session, &session->ob_pq);
+  nghttp2_session_ob_pq_free(session, &session->ob_ss_pq);
+  nghttp2_session_ob_ctrl_free(session);
+  nghttp2_session_async_q_free(session);
   nghttp2_hd_deflate_free(&session->hd_deflater);
   nghttp2_hd_inflate_free(&session->hd_inflater);
-  nghttp2_active_outbound_item_reset(&session->aob);
-  free(session->aob.framebuf);
-  free(session->nvbuf);
-  free(session->iframe.buf);
-   free(session);
+  nghttp2_active_outbound_item_reset(session, &session->aob);
+  nghttp2_mempool_free(&session->item_pool);
+  nghttp2_mempool_free(&session->stream_pool);
+  nghttp2_mem_free(&session->mem, session->aob.framebuf);
+  for(i = 0; i < NGHTTP2_SENDV_MAX_IOVCNT; ++i) {
+    nghttp2_mem_free(&session->mem, session->sendv.bufs[i]);
+  }
+  nghttp2_mem_free(&session->mem, session->iframe.buf);
+  mem = session->mem;
+  nghttp2_mem_free(&mem, session);
 }
 
-static int outbound_item_update_pri
+static void outbound_item_update_pri
 (nghttp2_outbound_item *item, nghttp2_stream *stream)
 {
   if(item->frame_cat == NGHTTP2_CAT_CTRL) {
     if(((nghttp2_frame*)item->frame)->hd.stream_id != stream->stream_id) {
-      return 0;
+      return;
     }
     switch(((nghttp2_frame*)item->frame)->hd.type) {
     case NGHTTP2_HEADERS:
     case NGHTTP2_PUSH_PROMISE:
       break;
     default:
-      return 0;
+      return;
     }
   } else {
     if(((nghttp2_data*)item->frame)->hd.stream_id != stream->stream_id) {
-      return 0;
+      return;
     }
   }
   item->pri = stream->pri;
-  return 1;
-}
-
-static int update_stream_pri(void *ptr, void *arg)
-{
-  nghttp2_outbound_item *item = (nghttp2_outbound_item*)ptr;
-  nghttp2_stream *stream = (nghttp2_stream*)arg;
-  return outbound_item_update_pri(item, stream);
 }
 
 void nghttp2_session_reprioritize_stream
 (nghttp2_session *session, nghttp2_stream *stream, int32_t pri)
 {
+  nghttp2_outbound_item *item;
   if(stream->pri == pri) {
     return;
   }
   stream->pri = pri;
-  nghttp2_pq_update(&session->ob_pq, update_stream_pri, stream);
-  nghttp2_pq_update(&session->ob_ss_pq, update_stream_pri, stream);
+  for(item = stream->queued_items; item; item = item->stream_next) {
+    item->pri = pri;
+    nghttp2_pq_update_entry(item->queue, &item->pq_entry);
+  }
   if(stream->deferred_data) {
     stream->deferred_data->pri = pri;
   }
@@ -355,6 +640,63 @@ void nghttp2_session_reprioritize_stream
   }
 }
 
+/*
+ * Returns the index of nghttp2_session.ob_ctrl for the control frame
+ * with priority |pri|.
+ */
+static size_t ob_ctrl_queue_index(int pri)
+{
+  switch(pri) {
+  case NGHTTP2_OB_PRI_PING:
+    return 0;
+  case NGHTTP2_OB_PRI_SETTINGS:
+    return 1;
+  default:
+    return 2;
+  }
+}
+
+/*
+ * Returns the first item in the queues for control frames, or NULL
+ * if they are empty.
+ */
+static nghttp2_outbound_item* ob_ctrl_top(nghttp2_session *session)
+{
+  size_t i;
+  for(i = 0; i < NGHTTP2_OB_CTRL_NQUEUE; ++i) {
+    if(nghttp2_outbound_queue_top(&session->ob_ctrl[i])) {
+      return nghttp2_outbound_queue_top(&session->ob_ctrl[i]);
+    }
+  }
+  return NULL;
+}
+
+/*
+ * Returns the number of items in the queues for control frames.
+ */
+static size_t ob_ctrl_size(nghttp2_session *session)
+{
+  size_t i, n = 0;
+  for(i = 0; i < NGHTTP2_OB_CTRL_NQUEUE; ++i) {
+    n += nghttp2_outbound_queue_size(&session->ob_ctrl[i]);
+  }
+  return n;
+}
+
+/*
+ * Marks the control frame with priority |pri| which was just queued
+ * as a reply to the received frame. Only the replies count toward
+ * max_ob_ctrl, so the frames the application submits never make
+ * nghttp2_session_mem_recv() fail.
+ */
+static void ob_ctrl_mark_reply(nghttp2_session *session, int pri)
+{
+  nghttp2_outbound_item *item;
+  item = session->ob_ctrl[ob_ctrl_queue_index(pri)].tail;
+  item->reply = 1;
+  ++session->num_ob_ctrl_replies;
+}
+
 int nghttp2_session_add_frame(nghttp2_session *session,
                               nghttp2_frame_category frame_cat,
                               void *abs_frame,
@@ -364,7 +706,7 @@ int nghttp2_session_add_frame(nghttp2_session *session,
      stream presence. */
   int r = 0;
   nghttp2_outbound_item *item;
-  item = malloc(sizeof(nghttp2_outbound_item));
+  item = nghttp2_mempool_alloc(&session->item_pool);
   if(item == NULL) {
     return NGHTTP2_ERR_NOMEM;
   }
@@ -372,11 +714,14 @@ int nghttp2_session_add_frame(nghttp2_session *session,
   item->frame = abs_frame;
   item->aux_data = aux_data;
   item->seq = session->next_seq++;
+  item->reply = 0;
   /* Set priority to the default value at the moment. */
   item->pri = NGHTTP2_PRI_DEFAULT;
   if(frame_cat == NGHTTP2_CAT_CTRL) {
     nghttp2_frame *frame = (nghttp2_frame*)abs_frame;
+    /* The stream whose priority this frame follows */
     nghttp2_stream *stream = NULL;
+    nghttp2_stream *rst_stream;
     switch(frame->hd.type) {
     case NGHTTP2_HEADERS:
       if(frame->hd.stream_id == -1) {
@@ -395,9 +740,10 @@ int nghttp2_session_add_frame(nghttp2_session *session,
       item->pri = -1;
       break;
     case NGHTTP2_RST_STREAM:
-      stream = nghttp2_session_get_stream(session, frame->hd.stream_id);
-      if(stream) {
-        stream->state = NGHTTP2_STREAM_CLOSING;
+      rst_stream = nghttp2_session_get_stream(session, frame->hd.stream_id);
+      if(rst_stream) {
+        rst_stream->state = NGHTTP2_STREAM_CLOSING;
+        nghttp2_session_cancel_queued_data(session, rst_stream);
       }
       item->pri = -1;
       break;
@@ -422,16 +768,23 @@ int nghttp2_session_add_frame(nghttp2_session *session,
       item->pri = -1;
       break;
     }
-    if(frame->hd.type == NGHTTP2_HEADERS &&
+    if(item->pri < 0) {
+      /* PING, SETTINGS, RST_STREAM, PRIORITY and WINDOW_UPDATE */
+      size_t i = ob_ctrl_queue_index(item->pri);
+      item->queue = NULL;
+      item->stream = NULL;
+      item->stream_prev = item->stream_next = NULL;
+      nghttp2_outbound_queue_push(&session->ob_ctrl[i], item);
+    } else if(frame->hd.type == NGHTTP2_HEADERS &&
        (frame->hd.stream_id == -1 ||
         (stream && stream->state == NGHTTP2_STREAM_RESERVED &&
          session->server))) {
       /* TODO If 2 HEADERS are submitted for reserved stream, then
          both of them are queued into ob_ss_pq, which is not
          desirable. */
-      r = nghttp2_pq_push(&session->ob_ss_pq, item);
+      r = ob_item_push(&session->ob_ss_pq, item, stream);
     } else {
-      r = nghttp2_pq_push(&session->ob_pq, item);
+      r = ob_item_push(&session->ob_pq, item, stream);
     }
   } else if(frame_cat == NGHTTP2_CAT_DATA) {
     nghttp2_data *data_frame = (nghttp2_data*)abs_frame;
@@ -440,13 +793,13 @@ int nghttp2_session_add_frame(nghttp2_session *session,
     if(stream) {
       item->pri = stream->pri;
     }
-    r = nghttp2_pq_push(&session->ob_pq, item);
+    r = ob_item_push(&session->ob_pq, item, stream);
   } else {
     /* Unreachable */
     assert(0);
   }
   if(r != 0) {
-    free(item);
+    nghttp2_mempool_release(&session->item_pool, item);
     return r;
   }
   return 0;
@@ -458,7 +811,7 @@ int nghttp2_session_add_rst_stream(nghttp2_session *session,
 {
   int r;
   nghttp2_frame *frame;
-  frame = malloc(sizeof(nghttp2_frame));
+  frame = nghttp2_mem_malloc(&session->mem, sizeof(nghttp2_frame));
   if(frame == NULL) {
     return NGHTTP2_ERR_NOMEM;
   }
@@ -466,7 +819,7 @@ int nghttp2_session_add_rst_stream(nghttp2_session *session,
   r = nghttp2_session_add_frame(session, NGHTTP2_CAT_CTRL, frame, NULL);
   if(r != 0) {
     nghttp2_frame_rst_stream_free(&frame->rst_stream);
-    free(frame);
+    nghttp2_mem_free(&session->mem, frame);
     return r;
   }
   return 0;
@@ -479,7 +832,7 @@ nghttp2_stream* nghttp2_session_open_stream(nghttp2_session *session,
                                             void *stream_user_data)
 {
   int r;
-  nghttp2_stream *stream = malloc(sizeof(nghttp2_stream));
+  nghttp2_stream *stream = nghttp2_mempool_alloc(&session->stream_pool);
   if(stream == NULL) {
     return NULL;
   }
@@ -495,7 +848,7 @@ nghttp2_stream* nghttp2_session_open_stream(nghttp2_session *session,
                       stream_user_data);
   r = nghttp2_map_insert(&session->streams, &stream->map_entry);
   if(r != 0) {
-    free(stream);
+    nghttp2_mempool_release(&session->stream_pool, stream);
     return NULL;
   }
   if(initial_state == NGHTTP2_STREAM_RESERVED) {
@@ -540,8 +893,7 @@ int nghttp2_session_close_stream(nghttp2_session *session, int32_t stream_id,
       }
     }
     nghttp2_map_remove(&session->streams, stream_id);
-    nghttp2_stream_free(stream);
-    free(stream);
+    nghttp2_session_free_stream(session, stream);
     return 0;
   } else {
     return NGHTTP2_ERR_INVALID_ARGUMENT;
@@ -849,16 +1201,18 @@ static int nghttp2_session_predicate_window_update_send
 }
 
 /*
- * Returns the maximum length of next data read. If the
- * connection-level and/or stream-wise flow control are enabled, the
- * return value takes into account those current window sizes.
+ * Returns the maximum length of next data read. This is the current
+ * DATA payload length of |stream|. If the connection-level and/or
+ * stream-wise flow control are enabled, the return value takes into
+ * account those current window sizes.
  */
 static size_t nghttp2_session_next_data_read(nghttp2_session *session,
                                              nghttp2_stream *stream)
 {
-  /* TODO implement connection-level flow control here */
+  size_t payloadlen = nghttp2_min(stream->data_payloadlen,
+                                  session->max_data_payloadlen);
   if(session->remote_flow_control == 0 && stream->remote_flow_control == 0) {
-    return NGHTTP2_DATA_PAYLOAD_LENGTH;
+    return payloadlen;
   } else {
     int32_t session_window_size =
       session->remote_flow_control ? session->remote_window_size : INT32_MAX;
@@ -867,8 +1221,8 @@ static size_t nghttp2_session_next_data_read(nghttp2_session *session,
     int32_t window_size = nghttp2_min(session_window_size,
                                       stream_window_size);
     if(window_size > 0) {
-      return window_size < NGHTTP2_DATA_PAYLOAD_LENGTH ?
-        window_size : NGHTTP2_DATA_PAYLOAD_LENGTH;
+      return (size_t)window_size < payloadlen ? (size_t)window_size :
+        payloadlen;
     } else {
       return 0;
     }
@@ -1016,7 +1370,8 @@ static ssize_t nghttp2_session_prep_frame(nghttp2_session *session,
       }
       framebuflen = nghttp2_frame_pack_priority(&session->aob.framebuf,
                                                 &session->aob.framebufmax,
-                                                &frame->priority);
+                                                &frame->priority,
+                                                &session->mem);
       if(framebuflen < 0) {
         return framebuflen;
       }
@@ -1025,7 +1380,8 @@ static ssize_t nghttp2_session_prep_frame(nghttp2_session *session,
     case NGHTTP2_RST_STREAM:
       framebuflen = nghttp2_frame_pack_rst_stream(&session->aob.framebuf,
                                                   &session->aob.framebufmax,
-                                                  &frame->rst_stream);
+                                                  &frame->rst_stream,
+                                                  &session->mem);
       if(framebuflen < 0) {
         return framebuflen;
       }
@@ -1033,7 +1389,8 @@ static ssize_t nghttp2_session_prep_frame(nghttp2_session *session,
     case NGHTTP2_SETTINGS:
       framebuflen = nghttp2_frame_pack_settings(&session->aob.framebuf,
                                                 &session->aob.framebufmax,
-                                                &frame->settings);
+                                                &frame->settings,
+                                                &session->mem);
       if(framebuflen < 0) {
         return framebuflen;
       }
@@ -1071,7 +1428,8 @@ static ssize_t nghttp2_session_prep_frame(nghttp2_session *session,
     case NGHTTP2_PING:
       framebuflen = nghttp2_frame_pack_ping(&session->aob.framebuf,
                                             &session->aob.framebufmax,
-                                            &frame->ping);
+                                            &frame->ping,
+                                            &session->mem);
       if(framebuflen < 0) {
         return framebuflen;
       }
@@ -1085,7 +1443,8 @@ static ssize_t nghttp2_session_prep_frame(nghttp2_session *session,
       }
       framebuflen = nghttp2_frame_pack_window_update(&session->aob.framebuf,
                                                      &session->aob.framebufmax,
-                                                     &frame->window_update);
+                                                     &frame->window_update,
+                                                     &session->mem);
       if(framebuflen < 0) {
         return framebuflen;
       }
@@ -1101,7 +1460,8 @@ static ssize_t nghttp2_session_prep_frame(nghttp2_session *session,
       }
       framebuflen = nghttp2_frame_pack_goaway(&session->aob.framebuf,
                                               &session->aob.framebufmax,
-                                              &frame->goaway);
+                                              &frame->goaway,
+                                              &session->mem);
       if(framebuflen < 0) {
         return framebuflen;
       }
@@ -1124,7 +1484,8 @@ static ssize_t nghttp2_session_prep_frame(nghttp2_session *session,
     assert(stream);
     next_readmax = nghttp2_session_next_data_read(session, stream);
     if(next_readmax == 0) {
-      nghttp2_stream_defer_data(stream, item, NGHTTP2_DEFERRED_FLOW_CONTROL);
+      nghttp2_session_defer_data(session, stream, item,
+                                 NGHTTP2_DEFERRED_FLOW_CONTROL);
       return NGHTTP2_ERR_DEFERRED;
     }
     framebuflen = nghttp2_session_pack_data(session,
@@ -1133,7 +1494,7 @@ static ssize_t nghttp2_session_prep_frame(nghttp2_session *session,
                                             next_readmax,
                                             data_frame);
     if(framebuflen == NGHTTP2_ERR_DEFERRED) {
-      nghttp2_stream_defer_data(stream, item, NGHTTP2_DEFERRED_NONE);
+      nghttp2_session_defer_data(session, stream, item, NGHTTP2_DEFERRED_NONE);
       return NGHTTP2_ERR_DEFERRED;
     } else if(framebuflen == NGHTTP2_ERR_TEMPORAL_CALLBACK_FAILURE) {
       r = nghttp2_session_add_rst_stream(session, data_frame->hd.stream_id,
@@ -1156,12 +1517,20 @@ static ssize_t nghttp2_session_prep_frame(nghttp2_session *session,
 nghttp2_outbound_item* nghttp2_session_get_ob_pq_top
 (nghttp2_session *session)
 {
+  nghttp2_outbound_item *item = ob_ctrl_top(session);
+  if(item) {
+    return item;
+  }
   return (nghttp2_outbound_item*)nghttp2_pq_top(&session->ob_pq);
 }
 
 nghttp2_outbound_item* nghttp2_session_get_next_ob_item
 (nghttp2_session *session)
 {
+  nghttp2_outbound_item *ctrl_item = ob_ctrl_top(session);
+  if(ctrl_item) {
+    return ctrl_item;
+  }
   if(nghttp2_pq_empty(&session->ob_pq)) {
     if(nghttp2_pq_empty(&session->ob_ss_pq)) {
       return NULL;
@@ -1171,16 +1540,17 @@ nghttp2_outbound_item* nghttp2_session_get_next_ob_item
       if(nghttp2_session_is_outgoing_concurrent_streams_max(session)) {
         return NULL;
       } else {
-        return nghttp2_pq_top(&session->ob_ss_pq);
+        return (nghttp2_outbound_item*)nghttp2_pq_top(&session->ob_ss_pq);
       }
     }
   } else {
     if(nghttp2_pq_empty(&session->ob_ss_pq)) {
-      return nghttp2_pq_top(&session->ob_pq);
+      return (nghttp2_outbound_item*)nghttp2_pq_top(&session->ob_pq);
     } else {
       nghttp2_outbound_item *item, *headers_item;
-      item = nghttp2_pq_top(&session->ob_pq);
-      headers_item = nghttp2_pq_top(&session->ob_ss_pq);
+      item = (nghttp2_outbound_item*)nghttp2_pq_top(&session->ob_pq);
+      headers_item =
+        (nghttp2_outbound_item*)nghttp2_pq_top(&session->ob_ss_pq);
       if(nghttp2_session_is_outgoing_concurrent_streams_max(session) ||
          item->pri < headers_item->pri ||
          (item->pri == headers_item->pri &&
@@ -1196,6 +1566,17 @@ nghttp2_outbound_item* nghttp2_session_get_next_ob_item
 nghttp2_outbound_item* nghttp2_session_pop_next_ob_item
 (nghttp2_session *session)
 {
+  size_t i;
+  nghttp2_outbound_item *item;
+  for(i = 0; i < NGHTTP2_OB_CTRL_NQUEUE; ++i) {
+    item = nghttp2_outbound_queue_pop(&session->ob_ctrl[i]);
+    if(item) {
+      if(item->reply) {
+        --session->num_ob_ctrl_replies;
+      }
+      return item;
+    }
+  }
   if(nghttp2_pq_empty(&session->ob_pq)) {
     if(nghttp2_pq_empty(&session->ob_ss_pq)) {
       return NULL;
@@ -1205,36 +1586,39 @@ nghttp2_outbound_item* nghttp2_session_pop_next_ob_item
       if(nghttp2_session_is_outgoing_concurrent_streams_max(session)) {
         return NULL;
       } else {
-        nghttp2_outbound_item *item;
-        item = nghttp2_pq_top(&session->ob_ss_pq);
-        nghttp2_pq_pop(&session->ob_ss_pq);
-        return item;
+        return ob_item_pop(&session->ob_ss_pq);
       }
     }
   } else {
     if(nghttp2_pq_empty(&session->ob_ss_pq)) {
-      nghttp2_outbound_item *item;
-      item = nghttp2_pq_top(&session->ob_pq);
-      nghttp2_pq_pop(&session->ob_pq);
-      return item;
+      return ob_item_pop(&session->ob_pq);
     } else {
       nghttp2_outbound_item *item, *headers_item;
-      item = nghttp2_pq_top(&session->ob_pq);
-      headers_item = nghttp2_pq_top(&session->ob_ss_pq);
+      item = (nghttp2_outbound_item*)nghttp2_pq_top(&session->ob_pq);
+      headers_item =
+        (nghttp2_outbound_item*)nghttp2_pq_top(&session->ob_ss_pq);
       if(nghttp2_session_is_outgoing_concurrent_streams_max(session) ||
          item->pri < headers_item->pri ||
          (item->pri == headers_item->pri &&
           item->seq < headers_item->seq)) {
-        nghttp2_pq_pop(&session->ob_pq);
-        return item;
+        return ob_item_pop(&session->ob_pq);
       } else {
-        nghttp2_pq_pop(&session->ob_ss_pq);
-        return headers_item;
+        return ob_item_pop(&session->ob_ss_pq);
       }
     }
   }
 }
 
+/* Adds the frame of |type| with |len| bytes to |frames| and |bytes|. */
+static void nghttp2_stats_count_frame(uint64_t *frames, uint64_t *bytes,
+                                      uint8_t type, size_t len)
+{
+  if(type < NGHTTP2_STATS_FRAME_TYPE_MAX) {
+    ++frames[type];
+    bytes[type] += len;
+  }
+}
+
 /*
  * Called after a frame is sent.
  *
@@ -1252,6 +1636,9 @@ static int nghttp2_session_after_frame_sent(nghttp2_session *session)
   if(item->frame_cat == NGHTTP2_CAT_CTRL) {
     nghttp2_frame *frame;
     frame = nghttp2_outbound_item_get_ctrl_frame(session->aob.item);
+    nghttp2_stats_count_frame(session->stats.frames_sent,
+                              session->stats.bytes_sent,
+                              frame->hd.type, session->aob.framebuflen);
     if(session->callbacks.on_frame_send_callback) {
       session->callbacks.on_frame_send_callback(session, frame,
                                                 session->user_data);
@@ -1271,11 +1658,11 @@ static int nghttp2_session_after_frame_sent(nghttp2_session *session)
           nghttp2_session_close_stream_if_shut_rdwr(session, stream);
           /* We assume aux_data is a pointer to nghttp2_headers_aux_data */
           aux_data = (nghttp2_headers_aux_data*)item->aux_data;
-          if(aux_data && aux_data->data_prd) {
+          if(aux_data && aux_data->data_prd.read_callback) {
             int r;
             /* nghttp2_submit_data() makes a copy of aux_data->data_prd */
             r = nghttp2_submit_data(session, NGHTTP2_FLAG_END_STREAM,
-                                    frame->hd.stream_id, aux_data->data_prd);
+                                    frame->hd.stream_id, &aux_data->data_prd);
             if(r != 0) {
               if(nghttp2_is_fatal(r)) {
                 return r;
@@ -1295,10 +1682,10 @@ static int nghttp2_session_after_frame_sent(nghttp2_session *session)
           nghttp2_session_close_stream_if_shut_rdwr(session, stream);
           /* We assume aux_data is a pointer to nghttp2_headers_aux_data */
           aux_data = (nghttp2_headers_aux_data*)item->aux_data;
-          if(aux_data && aux_data->data_prd) {
+          if(aux_data && aux_data->data_prd.read_callback) {
             int r;
             r = nghttp2_submit_data(session, NGHTTP2_FLAG_END_STREAM,
-                                    frame->hd.stream_id, aux_data->data_prd);
+                                    frame->hd.stream_id, &aux_data->data_prd);
             if(r != 0) {
               if(nghttp2_is_fatal(r)) {
                 return r;
@@ -1341,11 +1728,14 @@ static int nghttp2_session_after_frame_sent(nghttp2_session *session)
       /* nothing to do */
       break;
     }
-    nghttp2_active_outbound_item_reset(&session->aob);
+    nghttp2_active_outbound_item_reset(session, &session->aob);
   } else if(item->frame_cat == NGHTTP2_CAT_DATA) {
     int r;
     nghttp2_data *data_frame;
     data_frame = nghttp2_outbound_item_get_data_frame(session->aob.item);
+    nghttp2_stats_count_frame(session->stats.frames_sent,
+                              session->stats.bytes_sent,
+                              NGHTTP2_DATA, session->aob.framebuflen);
     if(session->callbacks.on_data_send_callback) {
       session->callbacks.on_data_send_callback
         (session,
@@ -1368,25 +1758,41 @@ static int nghttp2_session_after_frame_sent(nghttp2_session *session)
     if(data_frame->eof ||
        nghttp2_session_predicate_data_send(session,
                                            data_frame->hd.stream_id) != 0) {
-      nghttp2_active_outbound_item_reset(&session->aob);
+      nghttp2_active_outbound_item_reset(session, &session->aob);
     } else {
       nghttp2_outbound_item* next_item;
+      nghttp2_stream *stream;
+      stream = nghttp2_session_get_stream(session, data_frame->hd.stream_id);
+      /* Assuming stream is not NULL */
+      assert(stream);
+      stream->data_credit -= session->aob.framebuflen -
+        NGHTTP2_FRAME_HEAD_LENGTH;
       next_item = nghttp2_session_get_next_ob_item(session);
-      /* If priority of this stream is higher or equal to other stream
-         waiting at the top of the queue, we continue to send this
-         data. */
-      if(next_item == NULL || session->aob.item->pri <= next_item->pri) {
+      /* If priority of this stream is higher than other stream waiting
+         at the top of the queue, we continue to send this data. If
+         they are equal, we continue until this stream uses up its
+         credit for this turn, and then let the others take their
+         turns. */
+      if(next_item == NULL || session->aob.item->pri < next_item->pri ||
+         (session->aob.item->pri == next_item->pri &&
+          stream->data_credit > 0)) {
         size_t next_readmax;
-        nghttp2_stream *stream;
-        stream = nghttp2_session_get_stream(session, data_frame->hd.stream_id);
-        /* Assuming stream is not NULL */
-        assert(stream);
+        if(stream->data_credit <= 0) {
+          /* Nobody else is waiting. Start a new turn. */
+          stream->data_credit = nghttp2_stream_quantum(stream);
+        }
+        /* The stream is doing bulk transfer. Use larger frames. */
+        if(session->aob.framebuflen - NGHTTP2_FRAME_HEAD_LENGTH >=
+           stream->data_payloadlen) {
+          stream->data_payloadlen = nghttp2_min(stream->data_payloadlen * 2,
+                                                session->max_data_payloadlen);
+        }
         next_readmax = nghttp2_session_next_data_read(session, stream);
         if(next_readmax == 0) {
-          nghttp2_stream_defer_data(stream, session->aob.item,
-                                    NGHTTP2_DEFERRED_FLOW_CONTROL);
+          nghttp2_session_defer_data(session, stream, session->aob.item,
+                                     NGHTTP2_DEFERRED_FLOW_CONTROL);
           session->aob.item = NULL;
-          nghttp2_active_outbound_item_reset(&session->aob);
+          nghttp2_active_outbound_item_reset(session, &session->aob);
           return 0;
         }
         r = nghttp2_session_pack_data(session,
@@ -1395,38 +1801,52 @@ static int nghttp2_session_after_frame_sent(nghttp2_session *session)
                                       next_readmax,
                                       data_frame);
         if(r == NGHTTP2_ERR_DEFERRED) {
-          nghttp2_stream_defer_data(stream, session->aob.item,
-                                    NGHTTP2_DEFERRED_NONE);
+          nghttp2_session_defer_data(session, stream, session->aob.item,
+                                     NGHTTP2_DEFERRED_NONE);
           session->aob.item = NULL;
-          nghttp2_active_outbound_item_reset(&session->aob);
+          nghttp2_active_outbound_item_reset(session, &session->aob);
         } else if(r == NGHTTP2_ERR_TEMPORAL_CALLBACK_FAILURE) {
           /* Stop DATA frame chain and issue RST_STREAM to close the
              stream.  We don't return
              NGHTTP2_ERR_TEMPORAL_CALLBACK_FAILURE intentionally. */
           r = nghttp2_session_add_rst_stream(session, data_frame->hd.stream_id,
                                              NGHTTP2_INTERNAL_ERROR);
-          nghttp2_active_outbound_item_reset(&session->aob);
+          nghttp2_active_outbound_item_reset(session, &session->aob);
           if(r != 0) {
             return r;
           }
         } else if(r < 0) {
           /* In this context, r is either NGHTTP2_ERR_NOMEM or
              NGHTTP2_ERR_CALLBACK_FAILURE */
-          nghttp2_active_outbound_item_reset(&session->aob);
+          nghttp2_active_outbound_item_reset(session, &session->aob);
           return r;
         } else {
           session->aob.framebuflen = r;
           session->aob.framebufoff = 0;
         }
       } else {
-        r = nghttp2_pq_push(&session->ob_pq, session->aob.item);
+        if(session->aob.item->pri > next_item->pri) {
+          /* Higher priority frames are waiting. Use smaller frames to
+             keep their latency low. */
+          stream->data_payloadlen = NGHTTP2_DATA_PAYLOAD_LENGTH;
+        }
+        if(stream->data_credit <= 0) {
+          /* Go behind the frames of the same priority, and start a
+             new turn when we get back to the top of the queue. */
+          stream->data_credit = nghttp2_stream_quantum(stream);
+          session->aob.item->seq = session->next_seq++;
+        }
+        /* Otherwise higher priority frames preempted this turn. Keep
+           the seq and the remaining credit, so that the turn resumes
+           after them. */
+        r = ob_item_push(&session->ob_pq, session->aob.item, stream);
         if(r == 0) {
           session->aob.item = NULL;
-          nghttp2_active_outbound_item_reset(&session->aob);
+          nghttp2_active_outbound_item_reset(session, &session->aob);
         } else {
           /* FATAL error */
           assert(r < NGHTTP2_ERR_FATAL);
-          nghttp2_active_outbound_item_reset(&session->aob);
+          nghttp2_active_outbound_item_reset(session, &session->aob);
           return r;
         }
       }
@@ -1438,63 +1858,383 @@ static int nghttp2_session_after_frame_sent(nghttp2_session *session)
   return 0;
 }
 
-int nghttp2_session_send(nghttp2_session *session)
+/*
+ * Makes the next frame to send active in session->aob, unless there
+ * is already an active one. If the active frame was completely
+ * handed over by nghttp2_session_mem_send(), it is finished first. If
+ * there is no frame to send, session->aob.item is left NULL.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory.
+ * NGHTTP2_ERR_CALLBACK_FAILURE
+ *     The callback function failed.
+ */
+static int nghttp2_session_prep_next_frame(nghttp2_session *session)
 {
+  int r;
+  if(session->aob.item &&
+     session->aob.framebufoff == session->aob.framebuflen) {
+    r = nghttp2_session_after_frame_sent(session);
+    if(r < 0) {
+      /* FATAL */
+      assert(r < NGHTTP2_ERR_FATAL);
+      return r;
+    }
+  }
+  while(session->aob.item == NULL) {
+    nghttp2_outbound_item *item;
+    ssize_t framebuflen;
+    item = nghttp2_session_pop_next_ob_item(session);
+    if(item == NULL) {
+      break;
+    }
+    framebuflen = nghttp2_session_prep_frame(session, item);
+    if(framebuflen == NGHTTP2_ERR_DEFERRED) {
+      continue;
+    } else if(framebuflen < 0) {
+      /* TODO If the error comes from compressor, the connection
+         must be closed. */
+      if(item->frame_cat == NGHTTP2_CAT_CTRL &&
+         session->callbacks.on_frame_not_send_callback &&
+         nghttp2_is_non_fatal(framebuflen)) {
+        /* The library is responsible for the transmission of
+           WINDOW_UPDATE frame, so we don't call error callback for
+           it. */
+        nghttp2_frame *frame = nghttp2_outbound_item_get_ctrl_frame(item);
+        if(frame->hd.type != NGHTTP2_WINDOW_UPDATE) {
+          session->callbacks.on_frame_not_send_callback
+            (session, frame, framebuflen, session->user_data);
+        }
+      }
+      nghttp2_session_free_outbound_item(session, item);
+
+      if(framebuflen == NGHTTP2_ERR_HEADER_COMP) {
+        // If header compression error occurred, should terminiate
+        // connection.
+        framebuflen = nghttp2_session_fail_session(session,
+                                                   NGHTTP2_INTERNAL_ERROR);
+      }
+      if(nghttp2_is_fatal(framebuflen)) {
+        return framebuflen;
+      } else {
+        continue;
+      }
+    }
+    session->aob.item = item;
+    session->aob.framebuflen = framebuflen;
+    /* Call before_send callback */
+    if(item->frame_cat == NGHTTP2_CAT_CTRL &&
+       session->callbacks.before_frame_send_callback) {
+      session->callbacks.before_frame_send_callback
+        (session,
+         nghttp2_outbound_item_get_ctrl_frame(item),
+         session->user_data);
+    }
+  }
+  return 0;
+}
+
+/*
+ * Consumes the remote window sizes by the length of DATA frame
+ * |framebuf|, which is sent as a part of the active outbound item.
+ */
+static void nghttp2_session_consume_remote_window
+(nghttp2_session *session, const uint8_t *framebuf)
+{
+  nghttp2_data *frame;
+  nghttp2_stream *stream;
+  uint16_t len = nghttp2_get_uint16(&framebuf[0]);
+  frame = nghttp2_outbound_item_get_data_frame(session->aob.item);
+  stream = nghttp2_session_get_stream(session, frame->hd.stream_id);
+  if(stream && stream->remote_flow_control) {
+    stream->remote_window_size -= len;
+  }
+  if(session->remote_flow_control) {
+    session->remote_window_size -= len;
+  }
+}
+
+/*
+ * Returns nonzero if the active outbound item is a DATA frame whose
+ * payload is sent by send_data_callback.
+ */
+static int nghttp2_session_aob_no_copy(nghttp2_session *session)
+{
+  return session->aob.item->frame_cat == NGHTTP2_CAT_DATA &&
+    nghttp2_outbound_item_get_data_frame(session->aob.item)->no_copy;
+}
+
+/*
+ * Reports |length| bytes |data| to capture_callback if it is set.
+ */
+static void nghttp2_session_capture(nghttp2_session *session, uint8_t flags,
+                                    const uint8_t *data, size_t length)
+{
+  if(session->callbacks.capture_callback && length > 0) {
+    session->callbacks.capture_callback(session, flags, data, length,
+                                        session->user_data);
+  }
+}
+
+/*
+ * Sends the active DATA frame whose payload was not copied using
+ * send_data_callback.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_WOULDBLOCK
+ *     The callback could not send the frame. It is retried later.
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory.
+ * NGHTTP2_ERR_CALLBACK_FAILURE
+ *     The callback function failed.
+ */
+static int nghttp2_session_send_data_no_copy(nghttp2_session *session)
+{
+  nghttp2_data *data_frame;
+  int r;
+  data_frame = nghttp2_outbound_item_get_data_frame(session->aob.item);
+  r = session->callbacks.send_data_callback
+    (session, data_frame->hd.stream_id, session->aob.framebuf,
+     session->aob.framebuflen - NGHTTP2_FRAME_HEAD_LENGTH,
+     &data_frame->data_prd.source, session->user_data);
+  if(r == NGHTTP2_ERR_WOULDBLOCK) {
+    return r;
+  } else if(r == NGHTTP2_ERR_TEMPORAL_CALLBACK_FAILURE) {
+    r = nghttp2_session_add_rst_stream(session, data_frame->hd.stream_id,
+                                       NGHTTP2_INTERNAL_ERROR);
+    nghttp2_active_outbound_item_reset(session, &session->aob);
+    return r;
+  } else if(r != 0) {
+    return NGHTTP2_ERR_CALLBACK_FAILURE;
+  }
+  nghttp2_session_capture(session, NGHTTP2_CAPTURE_SEND,
+                          session->aob.framebuf, NGHTTP2_FRAME_HEAD_LENGTH);
+  nghttp2_session_capture(session, NGHTTP2_CAPTURE_SEND, NULL,
+                          session->aob.framebuflen -
+                          NGHTTP2_FRAME_HEAD_LENGTH);
+  session->aob.framebufoff = session->aob.framebuflen;
+  nghttp2_session_consume_remote_window(session, session->aob.framebuf);
+  r = nghttp2_session_after_frame_sent(session);
+  if(r < 0) {
+    /* FATAL */
+    assert(r < NGHTTP2_ERR_FATAL);
+    return r;
+  }
+  return 0;
+}
+
+/*
+ * Packs frames into session->sendv until session->sendv_max_bytes
+ * bytes or NGHTTP2_SENDV_MAX_IOVCNT frames are packed, or there is no
+ * frame to send. Each packed frame is treated as sent. A DATA frame
+ * whose payload was not copied is left active in session->aob.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory.
+ * NGHTTP2_ERR_CALLBACK_FAILURE
+ *     The callback function failed.
+ */
+static int nghttp2_session_pack_sendv(nghttp2_session *session)
+{
+  nghttp2_sendv_batch *batch = &session->sendv;
+  int r;
+  while(batch->iovcnt < NGHTTP2_SENDV_MAX_IOVCNT &&
+        batch->len < session->sendv_max_bytes) {
+    size_t i = batch->iovcnt;
+    uint8_t *buf;
+    size_t bufmax;
+    r = nghttp2_session_prep_next_frame(session);
+    if(r != 0) {
+      return r;
+    }
+    if(session->aob.item == NULL || nghttp2_session_aob_no_copy(session)) {
+      break;
+    }
+    if(batch->bufs[i] == NULL) {
+      batch->bufs[i] = nghttp2_mem_malloc
+        (&session->mem, NGHTTP2_INITIAL_OUTBOUND_FRAMEBUF_LENGTH);
+      if(batch->bufs[i] == NULL) {
+        return NGHTTP2_ERR_NOMEM;
+      }
+      batch->bufmaxs[i] = NGHTTP2_INITIAL_OUTBOUND_FRAMEBUF_LENGTH;
+    }
+    /* Take the packed frame and give aob a spare buffer */
+    buf = batch->bufs[i];
+    bufmax = batch->bufmaxs[i];
+    batch->bufs[i] = session->aob.framebuf;
+    batch->bufmaxs[i] = session->aob.framebufmax;
+    session->aob.framebuf = buf;
+    session->aob.framebufmax = bufmax;
+
+    batch->iov[i].base = batch->bufs[i];
+    batch->iov[i].len = session->aob.framebuflen;
+    batch->len += session->aob.framebuflen;
+    ++batch->iovcnt;
+    session->aob.framebufoff = session->aob.framebuflen;
+    if(session->aob.item->frame_cat == NGHTTP2_CAT_DATA) {
+      nghttp2_session_consume_remote_window(session, batch->bufs[i]);
+    }
+    r = nghttp2_session_after_frame_sent(session);
+    if(r < 0) {
+      /* FATAL */
+      assert(r < NGHTTP2_ERR_FATAL);
+      return r;
+    }
+  }
+  return 0;
+}
+
+/*
+ * nghttp2_session_send() for the session with sendv_callback.
+ */
+static int nghttp2_session_sendv(nghttp2_session *session)
+{
+  nghttp2_sendv_batch *batch = &session->sendv;
   int r;
   while(1) {
-    const uint8_t *data;
-    size_t datalen;
     ssize_t sentlen;
-    if(session->aob.item == NULL) {
-      nghttp2_outbound_item *item;
-      ssize_t framebuflen;
-      item = nghttp2_session_pop_next_ob_item(session);
-      if(item == NULL) {
-        break;
+    size_t left;
+    if(batch->len == 0) {
+      batch->iovcnt = batch->iovoff = 0;
+      r = nghttp2_session_pack_sendv(session);
+      if(r != 0) {
+        return r;
       }
-      framebuflen = nghttp2_session_prep_frame(session, item);
-      if(framebuflen == NGHTTP2_ERR_DEFERRED) {
-        continue;
-      } else if(framebuflen < 0) {
-        /* TODO If the error comes from compressor, the connection
-           must be closed. */
-        if(item->frame_cat == NGHTTP2_CAT_CTRL &&
-           session->callbacks.on_frame_not_send_callback &&
-           nghttp2_is_non_fatal(framebuflen)) {
-          /* The library is responsible for the transmission of
-             WINDOW_UPDATE frame, so we don't call error callback for
-             it. */
-          nghttp2_frame *frame = nghttp2_outbound_item_get_ctrl_frame(item);
-          if(frame->hd.type != NGHTTP2_WINDOW_UPDATE) {
-            session->callbacks.on_frame_not_send_callback
-              (session, frame, framebuflen, session->user_data);
-          }
+      if(batch->len == 0) {
+        if(session->aob.item == NULL) {
+          break;
         }
-        nghttp2_outbound_item_free(item);
-        free(item);
-
-        if(framebuflen == NGHTTP2_ERR_HEADER_COMP) {
-          // If header compression error occurred, should terminiate
-          // connection.
-          framebuflen = nghttp2_session_fail_session(session,
-                                                     NGHTTP2_INTERNAL_ERROR);
+        /* The frames before this one were all sent */
+        r = nghttp2_session_send_data_no_copy(session);
+        if(r == NGHTTP2_ERR_WOULDBLOCK) {
+          return 0;
+        } else if(r != 0) {
+          return r;
         }
-        if(nghttp2_is_fatal(framebuflen)) {
-          return framebuflen;
-        } else {
-          continue;
+        continue;
+      }
+    }
+    sentlen = session->callbacks.sendv_callback
+      (session, batch->iov + batch->iovoff, batch->iovcnt - batch->iovoff, 0,
+       session->user_data);
+    if(sentlen < 0) {
+      if(sentlen == NGHTTP2_ERR_WOULDBLOCK) {
+        return 0;
+      } else {
+        return NGHTTP2_ERR_CALLBACK_FAILURE;
+      }
+    }
+    if((size_t)sentlen > batch->len) {
+      return NGHTTP2_ERR_CALLBACK_FAILURE;
+    }
+    batch->len -= sentlen;
+    for(left = sentlen; left > 0;) {
+      nghttp2_vec *vec = &batch->iov[batch->iovoff];
+      nghttp2_session_capture(session, NGHTTP2_CAPTURE_SEND, vec->base,
+                              nghttp2_min(vec->len, left));
+      if(vec->len <= left) {
+        left -= vec->len;
+        ++batch->iovoff;
+      } else {
+        vec->base += left;
+        vec->len -= left;
+        left = 0;
+      }
+    }
+  }
+  return 0;
+}
+
+/*
+ * Submits the operations queued by the other threads so far. The
+ * operation which fails with a non-fatal error is dropped, and the
+ * others are still submitted.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory.
+ */
+static int nghttp2_session_drain_async_q(nghttp2_session *session)
+{
+  int r;
+  nghttp2_mpscq_entry *ent;
+  while((ent = nghttp2_mpscq_pop(&session->async_q))) {
+    nghttp2_async_op *op = (nghttp2_async_op*)ent;
+    switch(op->type) {
+    case NGHTTP2_ASYNC_OP_REQUEST:
+      /* nghttp2_submit_request_nva takes ownership of op->nva */
+      r = nghttp2_submit_request_nva(session, op->pri, op->nva, op->nvlen,
+                                     op->has_data_prd ? &op->data_prd : NULL,
+                                     op->stream_user_data);
+      if(nghttp2_is_non_fatal(r)) {
+        /* Only this request fails. The submitting thread is not
+           around to see the error, so tell the application here. */
+        if(session->callbacks.on_request_async_fail_callback) {
+          session->callbacks.on_request_async_fail_callback
+            (session, op->stream_user_data, r, session->user_data);
         }
+        r = 0;
       }
-      session->aob.item = item;
-      session->aob.framebuflen = framebuflen;
-      /* Call before_send callback */
-      if(item->frame_cat == NGHTTP2_CAT_CTRL &&
-         session->callbacks.before_frame_send_callback) {
-        session->callbacks.before_frame_send_callback
-          (session,
-           nghttp2_outbound_item_get_ctrl_frame(item),
-           session->user_data);
+      nghttp2_mem_free(&session->mem, op);
+      break;
+    case NGHTTP2_ASYNC_OP_RESUME_DATA:
+      r = nghttp2_session_resume_data(session, op->stream_id);
+      nghttp2_mem_free(&session->mem, op);
+      /* The stream may have been closed or resumed since then */
+      if(nghttp2_is_non_fatal(r)) {
+        r = 0;
+      }
+      break;
+    default:
+      assert(0);
+      r = 0;
+    }
+    if(r != 0) {
+      return r;
+    }
+  }
+  return 0;
+}
+
+int nghttp2_session_send(nghttp2_session *session)
+{
+  int r;
+  r = nghttp2_session_drain_async_q(session);
+  if(r != 0) {
+    return r;
+  }
+  if(session->callbacks.sendv_callback) {
+    return nghttp2_session_sendv(session);
+  }
+  while(1) {
+    const uint8_t *data;
+    size_t datalen;
+    ssize_t sentlen;
+    r = nghttp2_session_prep_next_frame(session);
+    if(r != 0) {
+      return r;
+    }
+    if(session->aob.item == NULL) {
+      break;
+    }
+    if(nghttp2_session_aob_no_copy(session)) {
+      r = nghttp2_session_send_data_no_copy(session);
+      if(r == NGHTTP2_ERR_WOULDBLOCK) {
+        return 0;
+      } else if(r != 0) {
+        return r;
       }
+      continue;
     }
     data = session->aob.framebuf + session->aob.framebufoff;
     datalen = session->aob.framebuflen - session->aob.framebufoff;
@@ -1507,19 +2247,10 @@ int nghttp2_session_send(nghttp2_session *session)
         return NGHTTP2_ERR_CALLBACK_FAILURE;
       }
     } else {
+      nghttp2_session_capture(session, NGHTTP2_CAPTURE_SEND, data, sentlen);
       session->aob.framebufoff += sentlen;
       if(session->aob.item->frame_cat == NGHTTP2_CAT_DATA) {
-        nghttp2_data *frame;
-        nghttp2_stream *stream;
-        uint16_t len = nghttp2_get_uint16(&session->aob.framebuf[0]);
-        frame = nghttp2_outbound_item_get_data_frame(session->aob.item);
-        stream = nghttp2_session_get_stream(session, frame->hd.stream_id);
-        if(stream && stream->remote_flow_control) {
-          stream->remote_window_size -= len;
-        }
-        if(session->remote_flow_control) {
-          session->remote_window_size -= len;
-        }
+        nghttp2_session_consume_remote_window(session, session->aob.framebuf);
       }
       if(session->aob.framebufoff == session->aob.framebuflen) {
         /* Frame has completely sent */
@@ -1532,7 +2263,49 @@ int nghttp2_session_send(nghttp2_session *session)
       }
     }
   }
-  return 0;
+  return 0;
+}
+
+ssize_t nghttp2_session_mem_send(nghttp2_session *session,
+                                 const uint8_t **data_ptr)
+{
+  int r;
+  size_t datalen;
+  *data_ptr = NULL;
+  r = nghttp2_session_drain_async_q(session);
+  if(r != 0) {
+    return r;
+  }
+  while(1) {
+    r = nghttp2_session_prep_next_frame(session);
+    if(r != 0) {
+      return r;
+    }
+    if(session->aob.item == NULL) {
+      return 0;
+    }
+    if(nghttp2_session_aob_no_copy(session)) {
+      r = nghttp2_session_send_data_no_copy(session);
+      if(r == NGHTTP2_ERR_WOULDBLOCK) {
+        return 0;
+      } else if(r != 0) {
+        return r;
+      }
+      continue;
+    }
+    if(session->aob.item->frame_cat == NGHTTP2_CAT_DATA &&
+       session->aob.framebufoff == 0) {
+      nghttp2_session_consume_remote_window(session, session->aob.framebuf);
+    }
+    *data_ptr = session->aob.framebuf + session->aob.framebufoff;
+    datalen = session->aob.framebuflen - session->aob.framebufoff;
+    /* The frame is finished in the next call, so that *data_ptr stays
+       valid until then. */
+    session->aob.framebufoff = session->aob.framebuflen;
+    nghttp2_session_capture(session, NGHTTP2_CAPTURE_SEND, *data_ptr,
+                            datalen);
+    return datalen;
+  }
 }
 
 static ssize_t nghttp2_recv(nghttp2_session *session, uint8_t *buf, size_t len)
@@ -1637,6 +2410,7 @@ static int nghttp2_session_handle_invalid_stream
   if(r != 0) {
     return r;
   }
+  ob_ctrl_mark_reply(session, -1);
   if(session->callbacks.on_invalid_frame_recv_callback) {
     session->callbacks.on_invalid_frame_recv_callback
       (session, frame, error_code, session->user_data);
@@ -1868,8 +2642,12 @@ static int nghttp2_update_remote_initial_window_size_func
                                                         arg->new_window_size,
                                                         arg->old_window_size);
   if(rv != 0) {
-    return nghttp2_session_add_rst_stream(arg->session, stream->stream_id,
-                                          NGHTTP2_FLOW_CONTROL_ERROR);
+    rv = nghttp2_session_add_rst_stream(arg->session, stream->stream_id,
+                                        NGHTTP2_FLOW_CONTROL_ERROR);
+    if(rv == 0) {
+      ob_ctrl_mark_reply(arg->session, -1);
+    }
+    return rv;
   }
   /* If window size gets positive, push deferred DATA frame to
      outbound queue. */
@@ -1878,10 +2656,8 @@ static int nghttp2_update_remote_initial_window_size_func
      stream->remote_window_size > 0 &&
      (arg->session->remote_flow_control == 0 ||
       arg->session->remote_window_size > 0)) {
-    rv = nghttp2_pq_push(&arg->session->ob_pq, stream->deferred_data);
-    if(rv == 0) {
-      nghttp2_stream_detach_deferred_data(stream);
-    } else {
+    rv = nghttp2_session_resume_deferred_data(arg->session, stream);
+    if(rv != 0) {
       /* FATAL */
       assert(rv < NGHTTP2_ERR_FATAL);
       return rv;
@@ -1914,6 +2690,11 @@ static int nghttp2_session_update_remote_initial_window_size
                           &arg);
 }
 
+/*
+ * The RST_STREAM and WINDOW_UPDATE frames queued here are not marked
+ * by ob_ctrl_mark_reply(), because they follow the SETTINGS the
+ * application submits, not the frames the remote endpoint sends.
+ */
 static int nghttp2_update_local_initial_window_size_func
 (nghttp2_map_entry *entry,
  void *ptr)
@@ -1987,10 +2768,8 @@ static int nghttp2_disable_remote_flow_control_func(nghttp2_map_entry *entry,
   if(stream->deferred_data &&
      (stream->deferred_flags & NGHTTP2_DEFERRED_FLOW_CONTROL)) {
     int rv;
-    rv = nghttp2_pq_push(&session->ob_pq, stream->deferred_data);
-    if(rv == 0) {
-      nghttp2_stream_detach_deferred_data(stream);
-    } else {
+    rv = nghttp2_session_resume_deferred_data(session, stream);
+    if(rv != 0) {
       /* FATAL */
       assert(rv < NGHTTP2_ERR_FATAL);
       return rv;
@@ -2197,6 +2976,35 @@ int nghttp2_session_on_push_promise_received(nghttp2_session *session,
   return 0;
 }
 
+/*
+ * Updates the target of the local window sizes from the number of
+ * bytes received during the round trip of the PING for the window
+ * auto tuning. The connection and stream windows are moved to the
+ * new target when DATA is received on them next time.
+ */
+static void nghttp2_session_auto_window_on_ping_ack
+(nghttp2_session *session)
+{
+  int32_t bdp = session->auto_window_bytes;
+  int32_t window_size = session->auto_window_size;
+  session->auto_window_ping_inflight = 0;
+  session->auto_window_bytes = 0;
+  if(bdp > window_size / 3 * 2) {
+    /* The transfer is limited by the window */
+    if(bdp > session->auto_window_max / 2) {
+      window_size = session->auto_window_max;
+    } else {
+      window_size = bdp * 2;
+    }
+  } else if(bdp < window_size / 4) {
+    window_size /= 2;
+  }
+  session->auto_window_size =
+    nghttp2_max(window_size,
+                (int32_t)session->local_settings
+                [NGHTTP2_SETTINGS_INITIAL_WINDOW_SIZE]);
+}
+
 int nghttp2_session_on_ping_received(nghttp2_session *session,
                                      nghttp2_frame *frame)
 {
@@ -2209,6 +3017,14 @@ int nghttp2_session_on_ping_received(nghttp2_session *session,
     /* Peer sent ping, so ping it back */
     r = nghttp2_session_add_ping(session, NGHTTP2_FLAG_PONG,
                                  frame->ping.opaque_data);
+    if(r == 0) {
+      ob_ctrl_mark_reply(session, NGHTTP2_OB_PRI_PING);
+    }
+  } else if(session->auto_window_ping_inflight &&
+            memcmp(frame->ping.opaque_data,
+                   NGHTTP2_WINDOW_AUTO_TUNING_PING_DATA,
+                   sizeof(frame->ping.opaque_data)) == 0) {
+    nghttp2_session_auto_window_on_ping_ack(session);
   }
   nghttp2_session_call_on_frame_received(session, frame);
   return r;
@@ -2223,39 +3039,27 @@ int nghttp2_session_on_goaway_received(nghttp2_session *session,
   return 0;
 }
 
-static int nghttp2_push_back_deferred_data_func(nghttp2_map_entry *entry,
-                                                void *ptr)
-{
-  nghttp2_session *session;
-  nghttp2_stream *stream;
-  session = (nghttp2_session*)ptr;
-  stream = (nghttp2_stream*)entry;
-  /* If DATA frame is deferred due to flow control, push it back to
-     outbound queue. */
-  if(stream->deferred_data &&
-     (stream->deferred_flags & NGHTTP2_DEFERRED_FLOW_CONTROL) &&
-     (stream->remote_flow_control == 0 || stream->remote_window_size > 0)) {
-    int rv;
-    rv = nghttp2_pq_push(&session->ob_pq, stream->deferred_data);
-    if(rv == 0) {
-      nghttp2_stream_detach_deferred_data(stream);
-    } else {
-      /* FATAL */
-      assert(rv < NGHTTP2_ERR_FATAL);
-      return rv;
-    }
-  }
-  return 0;
-}
-
 /*
  * Push back deferred DATA frames to queue if they are deferred due to
- * connection-level flow control.
+ * connection-level flow control. Only the streams in
+ * session->fc_blocked_streams are visited.
  */
 static int nghttp2_session_push_back_deferred_data(nghttp2_session *session)
 {
-  return nghttp2_map_each(&session->streams,
-                          nghttp2_push_back_deferred_data_func, session);
+  nghttp2_stream *stream, *next;
+  for(stream = session->fc_blocked_streams; stream; stream = next) {
+    next = stream->fc_next;
+    if(stream->remote_flow_control == 0 || stream->remote_window_size > 0) {
+      int rv;
+      rv = nghttp2_session_resume_deferred_data(session, stream);
+      if(rv != 0) {
+        /* FATAL */
+        assert(rv < NGHTTP2_ERR_FATAL);
+        return rv;
+      }
+    }
+  }
+  return 0;
 }
 
 int nghttp2_session_on_window_update_received(nghttp2_session *session,
@@ -2289,8 +3093,7 @@ int nghttp2_session_on_window_update_received(nghttp2_session *session,
     }
     session->remote_window_size += frame->window_update.window_size_increment;
     nghttp2_session_call_on_frame_received(session, frame);
-    /* To queue the DATA deferred by connection-level flow-control, we
-       have to check all streams. Bad. */
+    /* Queue the DATA deferred by connection-level flow-control */
     if(session->remote_window_size > 0) {
       return nghttp2_session_push_back_deferred_data(session);
     } else {
@@ -2311,10 +3114,8 @@ int nghttp2_session_on_window_update_received(nghttp2_session *session,
            stream->deferred_data != NULL &&
            (stream->deferred_flags & NGHTTP2_DEFERRED_FLOW_CONTROL)) {
           int r;
-          r = nghttp2_pq_push(&session->ob_pq, stream->deferred_data);
-          if(r == 0) {
-            nghttp2_stream_detach_deferred_data(stream);
-          } else if(r < 0) {
+          r = nghttp2_session_resume_deferred_data(session, stream);
+          if(r != 0) {
             /* FATAL */
             assert(r < NGHTTP2_ERR_FATAL);
             return r;
@@ -2338,10 +3139,8 @@ int nghttp2_session_on_window_update_received(nghttp2_session *session,
            stream->deferred_data != NULL &&
            (stream->deferred_flags & NGHTTP2_DEFERRED_FLOW_CONTROL)) {
           int r;
-          r = nghttp2_pq_push(&session->ob_pq, stream->deferred_data);
-          if(r == 0) {
-            nghttp2_stream_detach_deferred_data(stream);
-          } else if(r < 0) {
+          r = nghttp2_session_resume_deferred_data(session, stream);
+          if(r != 0) {
             /* FATAL */
             assert(r < NGHTTP2_ERR_FATAL);
             return r;
@@ -2364,8 +3163,56 @@ static int nghttp2_get_status_code_from_error_code(int lib_error_code)
   }
 }
 
-/* For errors, this function only returns FATAL error. */
-static int nghttp2_session_process_ctrl_frame(nghttp2_session *session)
+/*
+ * Returns the number of bytes which come before the header block in
+ * the payload of the frame being received, or -1 if the frame does
+ * not have the header block.
+ */
+static ssize_t nghttp2_inbound_frame_header_block_offset
+(nghttp2_inbound_frame *iframe)
+{
+  switch(iframe->headbuf[2]) {
+  case NGHTTP2_HEADERS:
+    return (iframe->headbuf[3] & NGHTTP2_FLAG_PRIORITY) ? 4 : 0;
+  case NGHTTP2_PUSH_PROMISE:
+    return 4;
+  default:
+    return -1;
+  }
+}
+
+/*
+ * Finishes inflating the header block received in
+ * NGHTTP2_RECV_HEADER_BLOCK state, and stores the result in
+ * |*nva_ptr| and |*nvlen_ptr|.
+ *
+ * This function returns 0 if it succeeds, or one of the error codes
+ * nghttp2_hd_inflate_finish() returns.
+ */
+static int nghttp2_session_finish_header_block(nghttp2_session *session,
+                                               nghttp2_nv **nva_ptr,
+                                               size_t *nvlen_ptr)
+{
+  ssize_t rv;
+  rv = nghttp2_hd_inflate_finish(&session->hd_inflater, nva_ptr);
+  if(rv < 0) {
+    return rv;
+  }
+  *nvlen_ptr = rv;
+  return 0;
+}
+
+/*
+ * Processes the non-DATA frame whose payload is |payload| of length
+ * |payloadlen|. If session->iframe.state is
+ * NGHTTP2_RECV_HEADER_BLOCK, the header block has already been
+ * inflated, and the |payload| only contains the bytes before it.
+ *
+ * For errors, this function only returns FATAL error.
+ */
+static int nghttp2_session_process_ctrl_frame(nghttp2_session *session,
+                                              const uint8_t *payload,
+                                              size_t payloadlen)
 {
   int r = 0;
   uint16_t type;
@@ -2373,18 +3220,28 @@ static int nghttp2_session_process_ctrl_frame(nghttp2_session *session)
   type = session->iframe.headbuf[2];
   switch(type) {
   case NGHTTP2_HEADERS:
-    if(session->iframe.error_code == 0) {
+    if(session->iframe.error_code == 0 &&
+       session->iframe.state == NGHTTP2_RECV_HEADER_BLOCK) {
+      r = nghttp2_frame_unpack_headers_without_nv
+        (&frame.headers,
+         session->iframe.headbuf, sizeof(session->iframe.headbuf),
+         payload, payloadlen);
+      if(r == 0) {
+        r = nghttp2_session_finish_header_block(session, &frame.headers.nva,
+                                                &frame.headers.nvlen);
+      }
+    } else if(session->iframe.error_code == 0) {
       r = nghttp2_frame_unpack_headers(&frame.headers,
                                        session->iframe.headbuf,
                                        sizeof(session->iframe.headbuf),
-                                       session->iframe.buf,
-                                       session->iframe.buflen,
+                                       payload,
+                                       payloadlen,
                                        &session->hd_inflater);
     } else if(session->iframe.error_code == NGHTTP2_ERR_FRAME_TOO_LARGE) {
       r = nghttp2_frame_unpack_headers_without_nv
         (&frame.headers,
          session->iframe.headbuf, sizeof(session->iframe.headbuf),
-         session->iframe.buf, session->iframe.buflen);
+         payload, payloadlen);
       if(r == 0) {
         r = session->iframe.error_code;
       }
@@ -2417,14 +3274,14 @@ static int nghttp2_session_process_ctrl_frame(nghttp2_session *session)
         frame.headers.cat = NGHTTP2_HCAT_REQUEST;
         r = nghttp2_session_on_request_headers_received(session, &frame);
       }
-      nghttp2_frame_headers_free(&frame.headers);
+      /* frame.headers.nva is owned by session->hd_inflater and
+         released by nghttp2_hd_end_headers() */
       nghttp2_hd_end_headers(&session->hd_inflater);
     } else if(r == NGHTTP2_ERR_INVALID_HEADER_BLOCK) {
       r = nghttp2_session_handle_invalid_stream
         (session, &frame, nghttp2_get_status_code_from_error_code(r));
       /* TODO test this. It seems NGHTTP2_ERR_INVALID_HEADER_BLOCK is
          not used in framing anymore. */
-      nghttp2_frame_headers_free(&frame.headers);
       nghttp2_hd_end_headers(&session->hd_inflater);
     } else if(nghttp2_is_non_fatal(r)) {
       r = nghttp2_session_handle_parse_error(session, type, r,
@@ -2435,8 +3292,8 @@ static int nghttp2_session_process_ctrl_frame(nghttp2_session *session)
     r = nghttp2_frame_unpack_priority(&frame.priority,
                                       session->iframe.headbuf,
                                       sizeof(session->iframe.headbuf),
-                                      session->iframe.buf,
-                                      session->iframe.buflen);
+                                      payload,
+                                      payloadlen);
     if(r == 0) {
       r = nghttp2_session_on_priority_received(session, &frame);
       nghttp2_frame_priority_free(&frame.priority);
@@ -2449,8 +3306,8 @@ static int nghttp2_session_process_ctrl_frame(nghttp2_session *session)
     r = nghttp2_frame_unpack_rst_stream(&frame.rst_stream,
                                         session->iframe.headbuf,
                                         sizeof(session->iframe.headbuf),
-                                        session->iframe.buf,
-                                        session->iframe.buflen);
+                                        payload,
+                                        payloadlen);
     if(r == 0) {
       r = nghttp2_session_on_rst_stream_received(session, &frame);
       nghttp2_frame_rst_stream_free(&frame.rst_stream);
@@ -2463,30 +3320,40 @@ static int nghttp2_session_process_ctrl_frame(nghttp2_session *session)
     r = nghttp2_frame_unpack_settings(&frame.settings,
                                       session->iframe.headbuf,
                                       sizeof(session->iframe.headbuf),
-                                      session->iframe.buf,
-                                      session->iframe.buflen);
+                                      payload,
+                                      payloadlen,
+                                      &session->mem);
     if(r == 0) {
       r = nghttp2_session_on_settings_received(session, &frame);
-      nghttp2_frame_settings_free(&frame.settings);
+      nghttp2_frame_settings_free(&frame.settings, &session->mem);
     } else if(nghttp2_is_non_fatal(r)) {
       r = nghttp2_session_handle_parse_error(session, type, r,
                                              NGHTTP2_PROTOCOL_ERROR);
     }
     break;
   case NGHTTP2_PUSH_PROMISE:
-    if(session->iframe.error_code == 0) {
+    if(session->iframe.error_code == 0 &&
+       session->iframe.state == NGHTTP2_RECV_HEADER_BLOCK) {
+      r = nghttp2_frame_unpack_push_promise_without_nv
+        (&frame.push_promise,
+         session->iframe.headbuf, sizeof(session->iframe.headbuf),
+         payload, payloadlen);
+      if(r == 0) {
+        r = nghttp2_session_finish_header_block
+          (session, &frame.push_promise.nva, &frame.push_promise.nvlen);
+      }
+    } else if(session->iframe.error_code == 0) {
       r = nghttp2_frame_unpack_push_promise(&frame.push_promise,
                                             session->iframe.headbuf,
                                             sizeof(session->iframe.headbuf),
-                                            session->iframe.buf,
-                                            session->iframe.buflen,
+                                            payload,
+                                            payloadlen,
                                             &session->hd_inflater);
     } else {
       r = session->iframe.error_code;
     }
     if(r == 0) {
       r = nghttp2_session_on_push_promise_received(session, &frame);
-      nghttp2_frame_push_promise_free(&frame.push_promise);
       nghttp2_hd_end_headers(&session->hd_inflater);
     } else if(nghttp2_is_non_fatal(r)) {
       r = nghttp2_session_handle_parse_error(session, type, r,
@@ -2497,8 +3364,8 @@ static int nghttp2_session_process_ctrl_frame(nghttp2_session *session)
     r = nghttp2_frame_unpack_ping(&frame.ping,
                                   session->iframe.headbuf,
                                   sizeof(session->iframe.headbuf),
-                                  session->iframe.buf,
-                                  session->iframe.buflen);
+                                  payload,
+                                  payloadlen);
     if(r == 0) {
       r = nghttp2_session_on_ping_received(session, &frame);
       nghttp2_frame_ping_free(&frame.ping);
@@ -2511,11 +3378,12 @@ static int nghttp2_session_process_ctrl_frame(nghttp2_session *session)
     r = nghttp2_frame_unpack_goaway(&frame.goaway,
                                     session->iframe.headbuf,
                                     sizeof(session->iframe.headbuf),
-                                    session->iframe.buf,
-                                    session->iframe.buflen);
+                                    payload,
+                                    payloadlen,
+                                    &session->mem);
     if(r == 0) {
       r = nghttp2_session_on_goaway_received(session, &frame);
-      nghttp2_frame_goaway_free(&frame.goaway);
+      nghttp2_frame_goaway_free(&frame.goaway, &session->mem);
     } else if(nghttp2_is_non_fatal(r)) {
       r = nghttp2_session_handle_parse_error(session, type, r,
                                              NGHTTP2_PROTOCOL_ERROR);
@@ -2525,8 +3393,8 @@ static int nghttp2_session_process_ctrl_frame(nghttp2_session *session)
     r = nghttp2_frame_unpack_window_update(&frame.window_update,
                                            session->iframe.headbuf,
                                            sizeof(session->iframe.headbuf),
-                                           session->iframe.buf,
-                                           session->iframe.buflen);
+                                           payload,
+                                           payloadlen);
     if(r == 0) {
       r = nghttp2_session_on_window_update_received(session, &frame);
       nghttp2_frame_window_update_free(&frame.window_update);
@@ -2542,8 +3410,8 @@ static int nghttp2_session_process_ctrl_frame(nghttp2_session *session)
         (session,
          session->iframe.headbuf,
          sizeof(session->iframe.headbuf),
-         session->iframe.buf,
-         session->iframe.buflen,
+         payload,
+         payloadlen,
          session->user_data);
     }
   }
@@ -2619,6 +3487,9 @@ int nghttp2_session_on_data_received(nghttp2_session *session,
   }
   if(error_code != 0) {
     r = nghttp2_session_add_rst_stream(session, stream_id, error_code);
+    if(r == 0) {
+      ob_ctrl_mark_reply(session, -1);
+    }
   }
   return r;
 }
@@ -2638,6 +3509,38 @@ static int nghttp2_session_process_data_frame(nghttp2_session *session)
   }
 }
 
+/*
+ * Counts |readlen| bytes of DATA payload for the window auto tuning,
+ * and sends the PING to measure the round trip if it is not in
+ * flight.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory.
+ */
+static int nghttp2_session_auto_window_on_data(nghttp2_session *session,
+                                               size_t readlen)
+{
+  int rv;
+  if(session->auto_window_ping_inflight) {
+    if(session->auto_window_bytes < NGHTTP2_MAX_WINDOW_SIZE -
+       (int32_t)readlen) {
+      session->auto_window_bytes += readlen;
+    }
+    return 0;
+  }
+  rv = nghttp2_session_add_ping(session, NGHTTP2_FLAG_NONE,
+                                (uint8_t*)NGHTTP2_WINDOW_AUTO_TUNING_PING_DATA);
+  if(rv != 0) {
+    return rv;
+  }
+  session->auto_window_ping_inflight = 1;
+  session->auto_window_bytes = 0;
+  return 0;
+}
+
 /*
  * If the resulting recv_window_size is strictly larger than
  * NGHTTP2_MAX_WINDOW_SIZE, return NGHTTP2_ERR_FLOW_CONTROL.
@@ -2652,11 +3555,28 @@ static int adjust_recv_window_size(int32_t *recv_window_size_ptr,
   return 0;
 }
 
+/*
+ * Sets |*local_window_size_ptr| to |target|. |*recv_window_size_ptr|
+ * is adjusted by the same amount, so that the window the remote
+ * endpoint currently has does not change. The grown window is
+ * advertised by the next WINDOW_UPDATE, and the shrunk window is
+ * withheld from the subsequent WINDOW_UPDATE.
+ */
+static void nghttp2_retarget_window_size(int32_t *local_window_size_ptr,
+                                         int32_t *recv_window_size_ptr,
+                                         int32_t target)
+{
+  *recv_window_size_ptr += target - *local_window_size_ptr;
+  *local_window_size_ptr = target;
+}
+
 /*
  * Accumulates received bytes |delta_size| for stream-level flow
  * control and decides whether to send WINDOW_UPDATE to that
  * stream. If NGHTTP2_OPT_NO_AUTO_STREAM_WINDOW_UPDATE is set,
- * WINDOW_UPDATE will not be sent.
+ * WINDOW_UPDATE will not be sent. If the window auto tuning is
+ * enabled, the local window size of the stream is moved to the
+ * current target first.
  *
  * This function returns 0 if it succeeds, or one of the following
  * negative error codes:
@@ -2672,10 +3592,21 @@ static int nghttp2_session_update_recv_stream_window_size
   int rv;
   rv = adjust_recv_window_size(&stream->recv_window_size, delta_size);
   if(rv != 0) {
-    return nghttp2_session_add_rst_stream(session, stream->stream_id,
-                                          NGHTTP2_ERR_FLOW_CONTROL);
+    rv = nghttp2_session_add_rst_stream(session, stream->stream_id,
+                                        NGHTTP2_ERR_FLOW_CONTROL);
+    if(rv == 0) {
+      ob_ctrl_mark_reply(session, -1);
+    }
+    return rv;
   }
   if(!(session->opt_flags & NGHTTP2_OPTMASK_NO_AUTO_STREAM_WINDOW_UPDATE)) {
+    if(session->auto_window_max) {
+      nghttp2_retarget_window_size
+        (&stream->local_window_size, &stream->recv_window_size,
+         nghttp2_max(session->auto_window_size,
+                     (int32_t)session->local_settings
+                     [NGHTTP2_SETTINGS_INITIAL_WINDOW_SIZE]));
+    }
     /* We have to use local_settings here because it is the constraint
        the remote endpoint should honor. */
     if(nghttp2_should_send_window_update(stream->local_window_size,
@@ -2685,6 +3616,7 @@ static int nghttp2_session_update_recv_stream_window_size
                                             stream->stream_id,
                                             stream->recv_window_size);
       if(rv == 0) {
+        ob_ctrl_mark_reply(session, -1);
         stream->recv_window_size = 0;
       } else {
         return rv;
@@ -2698,7 +3630,9 @@ static int nghttp2_session_update_recv_stream_window_size
  * Accumulates received bytes |delta_size| for connection-level flow
  * control and decides whether to send WINDOW_UPDATE to the
  * connection.  If NGHTTP2_OPT_NO_AUTO_CONNECTION_WINDOW_UPDATE is
- * set, WINDOW_UPDATE will not be sent.
+ * set, WINDOW_UPDATE will not be sent. If the window auto tuning is
+ * enabled, the local window size of the connection is moved to the
+ * current target first.
  *
  * This function returns 0 if it succeeds, or one of the following
  * negative error codes:
@@ -2717,6 +3651,12 @@ static int nghttp2_session_update_recv_connection_window_size
   }
   if(!(session->opt_flags &
        NGHTTP2_OPTMASK_NO_AUTO_CONNECTION_WINDOW_UPDATE)) {
+    if(session->auto_window_max) {
+      nghttp2_retarget_window_size
+        (&session->local_window_size, &session->recv_window_size,
+         nghttp2_max(session->auto_window_size,
+                     NGHTTP2_INITIAL_CONNECTION_WINDOW_SIZE));
+    }
     if(nghttp2_should_send_window_update(session->local_window_size,
                                          session->recv_window_size)) {
       /* Use stream ID 0 to update connection-level flow control
@@ -2726,6 +3666,7 @@ static int nghttp2_session_update_recv_connection_window_size
                                             0,
                                             session->recv_window_size);
       if(rv == 0) {
+        ob_ctrl_mark_reply(session, -1);
         session->recv_window_size = 0;
       } else {
         return rv;
@@ -2761,12 +3702,128 @@ static int nghttp2_session_check_data_recv_allowed(nghttp2_session *session,
   return 0;
 }
 
+/*
+ * Receives |in| of length |inlen|, which is the part of the payload
+ * of the non-DATA frame that cannot be processed in place. The header
+ * block of HEADERS and PUSH_PROMISE frames is inflated as it arrives,
+ * and only the bytes before it and the incomplete header
+ * representation at the end of |in| are buffered. The other frames
+ * are buffered as a whole. The session->iframe.off must not include
+ * |inlen| yet.
+ *
+ * The inflation error is stored in session->iframe.error_code and
+ * reported when the whole frame is received.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory.
+ */
+static int nghttp2_session_buffer_ctrl_payload(nghttp2_session *session,
+                                               const uint8_t *in,
+                                               size_t inlen)
+{
+  nghttp2_inbound_frame *iframe = &session->iframe;
+  size_t off = iframe->off;
+  ssize_t hdoff;
+  int rv;
+  hdoff = nghttp2_inbound_frame_header_block_offset(iframe);
+  if(iframe->state == NGHTTP2_RECV_PAYLOAD) {
+    size_t n;
+    if(hdoff == -1 || iframe->payloadlen < (size_t)hdoff) {
+      rv = nghttp2_reserve_buffer(&iframe->buf, &iframe->bufmax,
+                                  iframe->payloadlen, &session->mem);
+      if(rv != 0) {
+        return rv;
+      }
+      memcpy(iframe->buf + iframe->buflen, in, inlen);
+      iframe->buflen += inlen;
+      return 0;
+    }
+    n = nghttp2_min(inlen, hdoff - iframe->buflen);
+    if(n > 0) {
+      rv = nghttp2_reserve_buffer(&iframe->buf, &iframe->bufmax, hdoff,
+                                  &session->mem);
+      if(rv != 0) {
+        return rv;
+      }
+      memcpy(iframe->buf + iframe->buflen, in, n);
+      iframe->buflen += n;
+      in += n;
+      inlen -= n;
+      off += n;
+    }
+    if(iframe->buflen < (size_t)hdoff) {
+      return 0;
+    }
+    iframe->state = NGHTTP2_RECV_HEADER_BLOCK;
+    rv = nghttp2_hd_inflate_begin(&session->hd_inflater,
+                                  iframe->payloadlen - hdoff, 1);
+    if(nghttp2_is_fatal(rv)) {
+      return rv;
+    }
+    iframe->error_code = rv;
+  }
+  while(inlen > 0 && iframe->error_code == 0) {
+    const uint8_t *p;
+    size_t plen, n;
+    ssize_t consumed;
+    if(iframe->buflen > (size_t)hdoff) {
+      /* Appends the following bytes to the incomplete header
+         representation, doubling its length each time, so that the
+         bytes after the representation are hardly copied. */
+      n = nghttp2_min(inlen,
+                      nghttp2_max(iframe->buflen - hdoff,
+                                  NGHTTP2_INBOUND_HD_APPEND_LENGTH));
+      rv = nghttp2_reserve_buffer(&iframe->buf, &iframe->bufmax,
+                                  iframe->buflen + n, &session->mem);
+      if(rv != 0) {
+        return rv;
+      }
+      memcpy(iframe->buf + iframe->buflen, in, n);
+      iframe->buflen += n;
+      p = iframe->buf + hdoff;
+      plen = iframe->buflen - hdoff;
+    } else {
+      n = inlen;
+      p = in;
+      plen = inlen;
+    }
+    in += n;
+    inlen -= n;
+    off += n;
+    consumed = nghttp2_hd_inflate_partial(&session->hd_inflater, p, plen,
+                                          off == iframe->payloadlen);
+    if(consumed < 0) {
+      if(nghttp2_is_fatal(consumed)) {
+        return consumed;
+      }
+      iframe->error_code = consumed;
+      iframe->buflen = hdoff;
+      break;
+    }
+    /* Keeps the incomplete header representation. If |p| points to
+       iframe->buf, the buffer is large enough and is not
+       reallocated. */
+    rv = nghttp2_reserve_buffer(&iframe->buf, &iframe->bufmax,
+                                hdoff + plen - consumed, &session->mem);
+    if(rv != 0) {
+      return rv;
+    }
+    memmove(iframe->buf + hdoff, p + consumed, plen - consumed);
+    iframe->buflen = hdoff + plen - consumed;
+  }
+  return 0;
+}
+
 ssize_t nghttp2_session_mem_recv(nghttp2_session *session,
                                  const uint8_t *in, size_t inlen)
 {
   const uint8_t *inmark, *inlimit;
   inmark = in;
   inlimit = in+inlen;
+  nghttp2_session_capture(session, NGHTTP2_CAPTURE_RECV, in, inlen);
   while(1) {
     ssize_t r;
     if(session->iframe.state == NGHTTP2_RECV_HEAD) {
@@ -2776,6 +3833,13 @@ ssize_t nghttp2_session_mem_recv(nghttp2_session *session,
       if(bufavail == 0) {
         break;
       }
+      /* Each frame received may queue a reply. If the remote
+         endpoint does not read them, refuse further frames instead
+         of growing the queue without bound. */
+      if(session->iframe.headbufoff == 0 &&
+         session->num_ob_ctrl_replies >= session->max_ob_ctrl) {
+        return NGHTTP2_ERR_FLOODED;
+      }
       remheadbytes = NGHTTP2_FRAME_HEAD_LENGTH - session->iframe.headbufoff;
       readlen = nghttp2_min(remheadbytes, bufavail);
       memcpy(session->iframe.headbuf+session->iframe.headbufoff,
@@ -2786,19 +3850,14 @@ ssize_t nghttp2_session_mem_recv(nghttp2_session *session,
         session->iframe.state = NGHTTP2_RECV_PAYLOAD;
         session->iframe.payloadlen =
           nghttp2_get_uint16(&session->iframe.headbuf[0]);
-        if(!nghttp2_frame_is_data_frame(session->iframe.headbuf)) {
-          /* control frame */
-          ssize_t buflen = session->iframe.payloadlen;
-          session->iframe.buflen = buflen;
-          r = nghttp2_reserve_buffer(&session->iframe.buf,
-                                     &session->iframe.bufmax,
-                                     buflen);
-          if(r != 0) {
-            /* FATAL */
-            assert(r < NGHTTP2_ERR_FATAL);
-            return r;
-          }
-        } else {
+        nghttp2_stats_count_frame(session->stats.frames_recv,
+                                  session->stats.bytes_recv,
+                                  session->iframe.headbuf[2],
+                                  NGHTTP2_FRAME_HEAD_LENGTH +
+                                  session->iframe.payloadlen);
+        /* The payload of control frame is buffered only when it is
+           not contained in one input. */
+        if(nghttp2_frame_is_data_frame(session->iframe.headbuf)) {
           /* Check stream is open. If it is not open or closing,
              ignore payload. */
           int32_t stream_id;
@@ -2813,11 +3872,14 @@ ssize_t nghttp2_session_mem_recv(nghttp2_session *session,
       }
     }
     if(session->iframe.state == NGHTTP2_RECV_PAYLOAD ||
-       session->iframe.state == NGHTTP2_RECV_PAYLOAD_IGN) {
+       session->iframe.state == NGHTTP2_RECV_PAYLOAD_IGN ||
+       session->iframe.state == NGHTTP2_RECV_HEADER_BLOCK) {
       size_t rempayloadlen;
       size_t bufavail, readlen;
       int32_t data_stream_id = 0;
       uint8_t data_flags = NGHTTP2_FLAG_NONE;
+      /* The payload of non-DATA frame processed in place, or NULL */
+      const uint8_t *ctrl_payload = NULL;
 
       rempayloadlen = session->iframe.payloadlen - session->iframe.off;
       bufavail = inlimit - inmark;
@@ -2826,8 +3888,17 @@ ssize_t nghttp2_session_mem_recv(nghttp2_session *session,
       }
       readlen =  nghttp2_min(bufavail, rempayloadlen);
       if(!nghttp2_frame_is_data_frame(session->iframe.headbuf)) {
-        if(session->iframe.state != NGHTTP2_RECV_PAYLOAD_IGN) {
-          memcpy(session->iframe.buf+session->iframe.off, inmark, readlen);
+        if(session->iframe.off == 0 &&
+           readlen == session->iframe.payloadlen) {
+          /* The whole payload is in |in|. Process it in place. */
+          ctrl_payload = inmark;
+        } else if(session->iframe.state != NGHTTP2_RECV_PAYLOAD_IGN) {
+          r = nghttp2_session_buffer_ctrl_payload(session, inmark, readlen);
+          if(r < 0) {
+            /* FATAL */
+            assert(r < NGHTTP2_ERR_FATAL);
+            return r;
+          }
         }
       } else {
         /* For data frame, We don't buffer data. Instead, just pass
@@ -2854,6 +3925,14 @@ ssize_t nghttp2_session_mem_recv(nghttp2_session *session,
 
       if(nghttp2_frame_is_data_frame(session->iframe.headbuf) && readlen > 0) {
         if(session->local_flow_control) {
+          if(session->auto_window_max) {
+            r = nghttp2_session_auto_window_on_data(session, readlen);
+            if(r < 0) {
+              /* FATAL */
+              assert(r < NGHTTP2_ERR_FATAL);
+              return r;
+            }
+          }
           /* Update connection-level flow control window for ignored
              DATA frame too */
           r = nghttp2_session_update_recv_connection_window_size
@@ -2881,8 +3960,13 @@ ssize_t nghttp2_session_mem_recv(nghttp2_session *session,
         }
       }
       if(session->iframe.payloadlen == session->iframe.off) {
-        if(!nghttp2_frame_is_data_frame(session->iframe.headbuf)) {
-          r = nghttp2_session_process_ctrl_frame(session);
+        if(ctrl_payload) {
+          r = nghttp2_session_process_ctrl_frame(session, ctrl_payload,
+                                                 session->iframe.payloadlen);
+        } else if(!nghttp2_frame_is_data_frame(session->iframe.headbuf)) {
+          r = nghttp2_session_process_ctrl_frame(session,
+                                                 session->iframe.buf,
+                                                 session->iframe.buflen);
         } else {
           r = nghttp2_session_process_data_frame(session);
         }
@@ -2936,6 +4020,11 @@ int nghttp2_session_want_read(nghttp2_session *session)
 
 int nghttp2_session_want_write(nghttp2_session *session)
 {
+  /* The frames already packed for sendv_callback must be sent, even
+     if they include GOAWAY which fails the session. */
+  if(session->sendv.len > 0) {
+    return 1;
+  }
   /* If these flags are set, we don't want to write any data. The
      application should drop the connection. */
   if((session->goaway_flags & NGHTTP2_GOAWAY_FAIL_ON_SEND) &&
@@ -2949,7 +4038,9 @@ int nghttp2_session_want_write(nghttp2_session *session)
    * write them.  After GOAWAY is sent or received, we want to write
    * frames if there is pending ones AND there are active frames.
    */
-  return (session->aob.item != NULL || !nghttp2_pq_empty(&session->ob_pq) ||
+  return (session->aob.item != NULL || ob_ctrl_top(session) ||
+          !nghttp2_mpscq_empty(&session->async_q) ||
+          !nghttp2_pq_empty(&session->ob_pq) ||
           (!nghttp2_pq_empty(&session->ob_ss_pq) &&
            !nghttp2_session_is_outgoing_concurrent_streams_max(session))) &&
     (!session->goaway_flags || nghttp2_map_size(&session->streams) > 0);
@@ -2960,7 +4051,7 @@ int nghttp2_session_add_ping(nghttp2_session *session, uint8_t flags,
 {
   int r;
   nghttp2_frame *frame;
-  frame = malloc(sizeof(nghttp2_frame));
+  frame = nghttp2_mem_malloc(&session->mem, sizeof(nghttp2_frame));
   if(frame == NULL) {
     return NGHTTP2_ERR_NOMEM;
   }
@@ -2968,7 +4059,7 @@ int nghttp2_session_add_ping(nghttp2_session *session, uint8_t flags,
   r = nghttp2_session_add_frame(session, NGHTTP2_CAT_CTRL, frame, NULL);
   if(r != 0) {
     nghttp2_frame_ping_free(&frame->ping);
-    free(frame);
+    nghttp2_mem_free(&session->mem, frame);
   }
   return r;
 }
@@ -2985,23 +4076,23 @@ int nghttp2_session_add_goaway(nghttp2_session *session,
     if(opaque_data_len > UINT16_MAX - 8) {
       return NGHTTP2_ERR_INVALID_ARGUMENT;
     }
-    opaque_data_copy = malloc(opaque_data_len);
+    opaque_data_copy = nghttp2_mem_malloc(&session->mem, opaque_data_len);
     if(opaque_data_copy == NULL) {
       return NGHTTP2_ERR_NOMEM;
     }
     memcpy(opaque_data_copy, opaque_data, opaque_data_len);
   }
-  frame = malloc(sizeof(nghttp2_frame));
+  frame = nghttp2_mem_malloc(&session->mem, sizeof(nghttp2_frame));
   if(frame == NULL) {
-    free(opaque_data_copy);
+    nghttp2_mem_free(&session->mem, opaque_data_copy);
     return NGHTTP2_ERR_NOMEM;
   }
   nghttp2_frame_goaway_init(&frame->goaway, last_stream_id, error_code,
                             opaque_data_copy, opaque_data_len);
   r = nghttp2_session_add_frame(session, NGHTTP2_CAT_CTRL, frame, NULL);
   if(r != 0) {
-    nghttp2_frame_goaway_free(&frame->goaway);
-    free(frame);
+    nghttp2_frame_goaway_free(&frame->goaway, &session->mem);
+    nghttp2_mem_free(&session->mem, frame);
   }
   return r;
 }
@@ -3012,7 +4103,7 @@ int nghttp2_session_add_window_update(nghttp2_session *session, uint8_t flags,
 {
   int r;
   nghttp2_frame *frame;
-  frame = malloc(sizeof(nghttp2_frame));
+  frame = nghttp2_mem_malloc(&session->mem, sizeof(nghttp2_frame));
   if(frame == NULL) {
     return NGHTTP2_ERR_NOMEM;
   }
@@ -3021,7 +4112,7 @@ int nghttp2_session_add_window_update(nghttp2_session *session, uint8_t flags,
   r = nghttp2_session_add_frame(session, NGHTTP2_CAT_CTRL, frame, NULL);
   if(r != 0) {
     nghttp2_frame_window_update_free(&frame->window_update);
-    free(frame);
+    nghttp2_mem_free(&session->mem, frame);
   }
   return r;
 }
@@ -3032,26 +4123,31 @@ ssize_t nghttp2_session_pack_data(nghttp2_session *session,
                                   nghttp2_data *frame)
 {
   ssize_t framelen = datamax+8, r;
-  int eof_flags;
+  int data_flags;
   uint8_t flags;
-  r = nghttp2_reserve_buffer(buf_ptr, buflen_ptr, framelen);
+  r = nghttp2_reserve_buffer(buf_ptr, buflen_ptr, framelen, &session->mem);
   if(r != 0) {
     return r;
   }
-  eof_flags = 0;
+  data_flags = NGHTTP2_DATA_FLAG_NONE;
   r = frame->data_prd.read_callback
     (session, frame->hd.stream_id, (*buf_ptr)+8, datamax,
-     &eof_flags, &frame->data_prd.source, session->user_data);
+     &data_flags, &frame->data_prd.source, session->user_data);
   if(r == NGHTTP2_ERR_DEFERRED || r == NGHTTP2_ERR_TEMPORAL_CALLBACK_FAILURE) {
     return r;
   } else if(r < 0 || datamax < (size_t)r) {
     /* This is the error code when callback is failed. */
     return NGHTTP2_ERR_CALLBACK_FAILURE;
   }
+  if((data_flags & NGHTTP2_DATA_FLAG_NO_COPY) &&
+     session->callbacks.send_data_callback == NULL) {
+    return NGHTTP2_ERR_CALLBACK_FAILURE;
+  }
+  frame->no_copy = (data_flags & NGHTTP2_DATA_FLAG_NO_COPY) != 0;
   memset(*buf_ptr, 0, NGHTTP2_FRAME_HEAD_LENGTH);
   nghttp2_put_uint16be(&(*buf_ptr)[0], r);
   flags = 0;
-  if(eof_flags) {
+  if(data_flags & NGHTTP2_DATA_FLAG_EOF) {
     frame->eof = 1;
     if(frame->hd.flags & NGHTTP2_FLAG_END_STREAM) {
       flags |= NGHTTP2_FLAG_END_STREAM;
@@ -3074,25 +4170,129 @@ void* nghttp2_session_get_stream_user_data(nghttp2_session *session,
   }
 }
 
+int nghttp2_session_set_stream_weight(nghttp2_session *session,
+                                      int32_t stream_id, int32_t weight)
+{
+  nghttp2_stream *stream;
+  if(weight < NGHTTP2_MIN_WEIGHT || weight > NGHTTP2_MAX_WEIGHT) {
+    return NGHTTP2_ERR_INVALID_ARGUMENT;
+  }
+  stream = nghttp2_session_get_stream(session, stream_id);
+  if(stream == NULL) {
+    return NGHTTP2_ERR_STREAM_CLOSED;
+  }
+  stream->weight = weight;
+  if(stream->data_credit > nghttp2_stream_quantum(stream)) {
+    stream->data_credit = nghttp2_stream_quantum(stream);
+  }
+  return 0;
+}
+
 int nghttp2_session_resume_data(nghttp2_session *session, int32_t stream_id)
 {
-  int r;
   nghttp2_stream *stream;
   stream = nghttp2_session_get_stream(session, stream_id);
   if(stream == NULL || stream->deferred_data == NULL ||
      (stream->deferred_flags & NGHTTP2_DEFERRED_FLOW_CONTROL)) {
     return NGHTTP2_ERR_INVALID_ARGUMENT;
   }
-  r = nghttp2_pq_push(&session->ob_pq, stream->deferred_data);
-  if(r == 0) {
-    nghttp2_stream_detach_deferred_data(stream);
+  return nghttp2_session_resume_deferred_data(session, stream);
+}
+
+int nghttp2_session_resume_data_async(nghttp2_session *session,
+                                      int32_t stream_id)
+{
+  nghttp2_async_op *op;
+  op = nghttp2_mem_malloc(&session->mem, sizeof(nghttp2_async_op));
+  if(op == NULL) {
+    return NGHTTP2_ERR_NOMEM;
   }
-  return r;
+  op->type = NGHTTP2_ASYNC_OP_RESUME_DATA;
+  op->stream_id = stream_id;
+  nghttp2_session_push_async_op(session, op);
+  return 0;
+}
+
+void nghttp2_session_push_async_op(nghttp2_session *session,
+                                   nghttp2_async_op *op)
+{
+  nghttp2_mpscq_push(&session->async_q, &op->qent);
 }
 
 size_t nghttp2_session_get_outbound_queue_size(nghttp2_session *session)
 {
-  return nghttp2_pq_size(&session->ob_pq)+nghttp2_pq_size(&session->ob_ss_pq);
+  return nghttp2_pq_size(&session->ob_pq) +
+    nghttp2_pq_size(&session->ob_ss_pq) + ob_ctrl_size(session);
+}
+
+static int nghttp2_stats_count_deferred_data(nghttp2_map_entry *entry,
+                                             void *ptr)
+{
+  nghttp2_session_stats *stats = (nghttp2_session_stats*)ptr;
+  nghttp2_stream *stream = (nghttp2_stream*)entry;
+  if(stream->deferred_data) {
+    ++stats->num_deferred_data;
+  }
+  return 0;
+}
+
+void nghttp2_session_get_stats(nghttp2_session *session,
+                               nghttp2_session_stats *stats)
+{
+  nghttp2_stream *stream;
+  size_t i;
+  *stats = session->stats;
+  stats->deflate_in_bytes = session->hd_deflater.nv_bytes;
+  stats->deflate_out_bytes = session->hd_deflater.block_bytes;
+  stats->inflate_in_bytes = session->hd_inflater.block_bytes;
+  stats->inflate_out_bytes = session->hd_inflater.nv_bytes;
+  stats->ob_pq_len = nghttp2_pq_size(&session->ob_pq);
+  stats->ob_ss_pq_len = nghttp2_pq_size(&session->ob_ss_pq);
+  stats->ob_ctrl_len = ob_ctrl_size(session);
+  stats->num_deferred_data = 0;
+  nghttp2_map_each(&session->streams, nghttp2_stats_count_deferred_data,
+                   stats);
+  stats->num_fc_blocked = 0;
+  for(stream = session->fc_blocked_streams; stream;
+      stream = stream->fc_next) {
+    ++stats->num_fc_blocked;
+  }
+  stats->framebuf_bytes = session->aob.framebufmax;
+  for(i = 0; i < NGHTTP2_SENDV_MAX_IOVCNT; ++i) {
+    stats->framebuf_bytes += session->sendv.bufmaxs[i];
+  }
+  stats->iframe_buf_bytes = session->iframe.bufmax;
+  stats->deflater_bytes = nghttp2_hd_get_mem_usage(&session->hd_deflater);
+  stats->inflater_bytes = nghttp2_hd_get_mem_usage(&session->hd_inflater);
+  stats->pool_bytes = nghttp2_mempool_get_mem_usage(&session->stream_pool) +
+    nghttp2_mempool_get_mem_usage(&session->item_pool);
+}
+
+void nghttp2_session_shrink(nghttp2_session *session)
+{
+  nghttp2_sendv_batch *batch = &session->sendv;
+  size_t i;
+  if(session->aob.item == NULL) {
+    nghttp2_mem_free(&session->mem, session->aob.framebuf);
+    session->aob.framebuf = NULL;
+    session->aob.framebufmax = 0;
+  }
+  if(batch->len == 0) {
+    for(i = 0; i < NGHTTP2_SENDV_MAX_IOVCNT; ++i) {
+      nghttp2_mem_free(&session->mem, batch->bufs[i]);
+      batch->bufs[i] = NULL;
+      batch->bufmaxs[i] = 0;
+    }
+  }
+  if(session->iframe.state == NGHTTP2_RECV_HEAD) {
+    nghttp2_mem_free(&session->mem, session->iframe.buf);
+    session->iframe.buf = NULL;
+    session->iframe.bufmax = 0;
+  }
+  nghttp2_hd_shrink(&session->hd_deflater);
+  nghttp2_hd_shrink(&session->hd_inflater);
+  nghttp2_mempool_shrink(&session->stream_pool);
+  nghttp2_mempool_shrink(&session->item_pool);
 }
 
 int nghttp2_session_set_option(nghttp2_session *session,
@@ -3119,6 +4319,74 @@ int nghttp2_session_set_option(nghttp2_session *session,
     }
     break;
   }
+  case NGHTTP2_OPT_SENDV_MAX_BYTES:
+    if(optlen == sizeof(size_t) && *(size_t*)optval > 0) {
+      session->sendv_max_bytes = *(size_t*)optval;
+    } else {
+      return NGHTTP2_ERR_INVALID_ARGUMENT;
+    }
+    break;
+  case NGHTTP2_OPT_WINDOW_AUTO_TUNING_MAX:
+    if(optlen == sizeof(int32_t) && *(int32_t*)optval >= 0) {
+      session->auto_window_max = *(int32_t*)optval;
+    } else {
+      return NGHTTP2_ERR_INVALID_ARGUMENT;
+    }
+    break;
+  case NGHTTP2_OPT_MAX_DATA_PAYLOAD_LENGTH:
+    if(optlen == sizeof(size_t) && *(size_t*)optval > 0 &&
+       *(size_t*)optval <= NGHTTP2_MAX_FRAME_LENGTH) {
+      session->max_data_payloadlen = *(size_t*)optval;
+    } else {
+      return NGHTTP2_ERR_INVALID_ARGUMENT;
+    }
+    break;
+  case NGHTTP2_OPT_MAX_OUTBOUND_CTRL:
+    if(optlen == sizeof(size_t) && *(size_t*)optval > 0) {
+      session->max_ob_ctrl = *(size_t*)optval;
+    } else {
+      return NGHTTP2_ERR_INVALID_ARGUMENT;
+    }
+    break;
+  case NGHTTP2_OPT_HD_TABLE_SIZE:
+    if(optlen == sizeof(size_t) && *(size_t*)optval <= NGHTTP2_HD_TABLE_SIZE) {
+      nghttp2_hd_deflate_set_table_size(&session->hd_deflater,
+                                        *(size_t*)optval);
+    } else {
+      return NGHTTP2_ERR_INVALID_ARGUMENT;
+    }
+    break;
+  case NGHTTP2_OPT_MAX_HEADER_FIELDS: {
+    int rv;
+    size_t n;
+    if(optlen != sizeof(size_t)) {
+      return NGHTTP2_ERR_INVALID_ARGUMENT;
+    }
+    n = *(size_t*)optval;
+    if(n == 0 || n > NGHTTP2_DEFAULT_MAX_HEADER_FIELDS ||
+       session->hd_deflater.refsetlen > n ||
+       session->hd_inflater.refsetlen > n) {
+      return NGHTTP2_ERR_INVALID_ARGUMENT;
+    }
+    rv = nghttp2_hd_set_max_header_fields(&session->hd_deflater, n);
+    if(rv != 0) {
+      return rv;
+    }
+    rv = nghttp2_hd_set_max_header_fields(&session->hd_inflater, n);
+    if(rv != 0) {
+      return rv;
+    }
+    break;
+  }
+  case NGHTTP2_OPT_HD_HUFFMAN:
+    if(optlen != sizeof(int) ||
+       session->hd_deflater.block_bytes > 0 ||
+       session->hd_inflater.block_bytes > 0) {
+      return NGHTTP2_ERR_INVALID_ARGUMENT;
+    }
+    nghttp2_hd_set_huffman(&session->hd_deflater, *(int*)optval);
+    nghttp2_hd_set_huffman(&session->hd_inflater, *(int*)optval);
+    break;
   default:
     return NGHTTP2_ERR_INVALID_ARGUMENT;
   }
@@ -3147,7 +4415,8 @@ int nghttp2_session_upgrade(nghttp2_session *session,
     return NGHTTP2_ERR_INVALID_ARGUMENT;
   }
   rv = nghttp2_frame_unpack_settings_payload(&iv, &niv, settings_payload,
-                                             settings_payloadlen);
+                                             settings_payloadlen,
+                                             &session->mem);
   if(rv != 0) {
     return rv;
   }
@@ -3159,7 +4428,7 @@ int nghttp2_session_upgrade(nghttp2_session *session,
     }
   }
   if(!max_conn_val_seen || !ini_win_size_seen) {
-    free(iv);
+    nghttp2_mem_free(&session->mem, iv);
     return NGHTTP2_ERR_PROTO;
   }
   if(session->server) {
@@ -3170,7 +4439,7 @@ int nghttp2_session_upgrade(nghttp2_session *session,
   } else {
     rv = nghttp2_submit_settings(session, iv, niv);
   }
-  free(iv);
+  nghttp2_mem_free(&session->mem, iv);
   if(rv != 0) {
     return rv;
   }
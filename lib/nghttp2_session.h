@@ -37,6 +37,9 @@
 #include "nghttp2_stream.h"
 #include "nghttp2_buffer.h"
 #include "nghttp2_outbound_item.h"
+#include "nghttp2_mem.h"
+#include "nghttp2_mempool.h"
+#include "nghttp2_mpscq.h"
 
 /*
  * Option flags.
@@ -61,13 +64,68 @@ typedef struct {
   size_t framebufoff;
 } nghttp2_active_outbound_item;
 
+/* The maximum number of frames packed for one sendv_callback call */
+#define NGHTTP2_SENDV_MAX_IOVCNT 16
+/* The default value of NGHTTP2_OPT_SENDV_MAX_BYTES */
+#define NGHTTP2_SENDV_DEFAULT_MAX_BYTES 65536
+
+/* Frames packed for sendv_callback. Each frame is packed in
+   aob.framebuf as usual, and then the buffer is swapped with bufs[i]
+   so that no copy is made. */
+typedef struct {
+  /* Buffers holding packed frames. They are allocated lazily and
+     reused. */
+  uint8_t *bufs[NGHTTP2_SENDV_MAX_IOVCNT];
+  /* The capacity of each buffer in bufs */
+  size_t bufmaxs[NGHTTP2_SENDV_MAX_IOVCNT];
+  /* The unsent part of each frame */
+  nghttp2_vec iov[NGHTTP2_SENDV_MAX_IOVCNT];
+  /* The number of frames packed */
+  size_t iovcnt;
+  /* The index of the first frame which is not completely sent */
+  size_t iovoff;
+  /* The number of bytes not sent yet */
+  size_t len;
+} nghttp2_sendv_batch;
+
+typedef enum {
+  NGHTTP2_ASYNC_OP_REQUEST,
+  NGHTTP2_ASYNC_OP_RESUME_DATA
+} nghttp2_async_op_type;
+
+/* Operation queued by a thread other than the owner of the session.
+   See nghttp2_submit_request_async() and
+   nghttp2_session_resume_data_async(). */
+typedef struct {
+  /* This must be the first member */
+  nghttp2_mpscq_entry qent;
+  nghttp2_async_op_type type;
+  /* The stream to resume for NGHTTP2_ASYNC_OP_RESUME_DATA */
+  int32_t stream_id;
+  /* The rest are the arguments of the request for
+     NGHTTP2_ASYNC_OP_REQUEST. The nva is already copied. */
+  int32_t pri;
+  nghttp2_nv *nva;
+  size_t nvlen;
+  nghttp2_data_provider data_prd;
+  uint8_t has_data_prd;
+  void *stream_user_data;
+} nghttp2_async_op;
+
 /* Buffer length for inbound raw byte stream. */
 #define NGHTTP2_INBOUND_BUFFER_LENGTH 16384
 
+/* The minimum number of bytes appended at once to the incomplete
+   header representation buffered in the inbound frame. */
+#define NGHTTP2_INBOUND_HD_APPEND_LENGTH 64
+
 #define NGHTTP2_INITIAL_OUTBOUND_FRAMEBUF_LENGTH (NGHTTP2_DATA_PAYLOAD_LENGTH+8)
-#define NGHTTP2_INITIAL_INBOUND_FRAMEBUF_LENGTH \
-  NGHTTP2_INITIAL_OUTBOUND_FRAMEBUF_LENGTH
-#define NGHTTP2_INITIAL_NV_BUFFER_LENGTH 4096
+
+/* The number of queues in nghttp2_session.ob_ctrl */
+#define NGHTTP2_OB_CTRL_NQUEUE 3
+
+/* The number of objects in one block of stream_pool and item_pool */
+#define NGHTTP2_SESSION_POOL_BLOCK_NOBJ 32
 
 /* Internal state when receiving incoming frame */
 typedef enum {
@@ -76,7 +134,10 @@ typedef enum {
   /* Receiving frame payload (comes after length field) */
   NGHTTP2_RECV_PAYLOAD,
   /* Receiving frame payload, but the received bytes are discarded. */
-  NGHTTP2_RECV_PAYLOAD_IGN
+  NGHTTP2_RECV_PAYLOAD_IGN,
+  /* Receiving the header block of HEADERS or PUSH_PROMISE frame,
+     which is inflated as it arrives */
+  NGHTTP2_RECV_HEADER_BLOCK
 } nghttp2_inbound_state;
 
 typedef struct {
@@ -84,15 +145,16 @@ typedef struct {
   uint8_t headbuf[NGHTTP2_FRAME_HEAD_LENGTH];
   /* How many bytes are filled in headbuf */
   size_t headbufoff;
-  /* Payload for non-DATA frames. */
+  /* Payload for non-DATA frames which is not contained in one input
+     and cannot be processed in place. */
   uint8_t *buf;
   /* Capacity of buf */
   size_t bufmax;
-  /* For frames without name/value header block, this is how many
-     bytes are going to filled in buf. For frames with the block, buf
-     only contains bytes that come before ther block, but this value
-     includes the length of the block. buflen <= bufmax must be
-     fulfilled. */
+  /* How many bytes are filled in buf. For frames without name/value
+     header block, this is the received part of the payload. For
+     frames with the block, buf contains the bytes that come before
+     the block, followed by the incomplete header representation not
+     inflated yet. buflen <= bufmax must be fulfilled. */
   size_t buflen;
   /* length in Length field */
   size_t payloadlen;
@@ -130,6 +192,10 @@ struct nghttp2_session {
   int64_t next_seq;
 
   nghttp2_map /* <nghttp2_stream*> */ streams;
+  /* Head of the list of streams whose DATA is deferred due to flow
+     control, linked by nghttp2_stream.fc_next. Only these streams are
+     visited when the connection-level window opens. */
+  nghttp2_stream *fc_blocked_streams;
   /* The number of outgoing streams. This will be capped by
      remote_settings[NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS]. */
   size_t num_outgoing_streams;
@@ -141,16 +207,31 @@ struct nghttp2_session {
   nghttp2_pq /* <nghttp2_outbound_item*> */ ob_pq;
   /* Queue for outbound stream-creating HEADERS frame */
   nghttp2_pq /* <nghttp2_outbound_item*> */ ob_ss_pq;
+  /* Queues for outbound control frames which do not follow stream
+     priority: PING, SETTINGS, and the others (RST_STREAM, PRIORITY
+     and WINDOW_UPDATE), in the order they are sent. They are all
+     sent before the frames in ob_pq and ob_ss_pq, which is the order
+     their priority values used to give in ob_pq. */
+  nghttp2_outbound_queue ob_ctrl[NGHTTP2_OB_CTRL_NQUEUE];
+  /* The number of frames in ob_ctrl which reply to received frames:
+     PING replies, RST_STREAM for invalid frames and WINDOW_UPDATE for
+     received DATA. */
+  size_t num_ob_ctrl_replies;
+  /* The maximum number of num_ob_ctrl_replies while receiving
+     frames. See NGHTTP2_OPT_MAX_OUTBOUND_CTRL. */
+  size_t max_ob_ctrl;
 
   nghttp2_active_outbound_item aob;
 
-  nghttp2_inbound_frame iframe;
+  /* Frames pending in sendv_callback */
+  nghttp2_sendv_batch sendv;
+  /* The number of bytes packed for one sendv_callback call */
+  size_t sendv_max_bytes;
+  /* The maximum DATA payload length. See
+     nghttp2_stream.data_payloadlen. */
+  size_t max_data_payloadlen;
 
-  /* Buffer used to store inflated name/value pairs in wire format
-     temporarily on pack/unpack. */
-  uint8_t *nvbuf;
-  /* The number of bytes allocated for nvbuf */
-  size_t nvbuflen;
+  nghttp2_inbound_frame iframe;
 
   nghttp2_hd_context hd_deflater;
   nghttp2_hd_context hd_inflater;
@@ -180,6 +261,18 @@ struct nghttp2_session {
      increased/decreased by submitting WINDOW_UPDATE. See
      nghttp2_submit_window_update(). */
   int32_t local_window_size;
+  /* The upper limit of the local window sizes when the window auto
+     tuning is enabled, or 0 if it is disabled. */
+  int32_t auto_window_max;
+  /* The current target of the local window sizes computed by the
+     window auto tuning. The actual target of the connection and the
+     streams is not smaller than their initial window size. */
+  int32_t auto_window_size;
+  /* The number of DATA payload bytes received since the PING for
+     the window auto tuning was sent */
+  int32_t auto_window_bytes;
+  /* Nonzero if the PING for the window auto tuning is in flight */
+  uint8_t auto_window_ping_inflight;
 
   /* Settings value received from the remote endpoint. We just use ID
      as index. The index = 0 is unused. */
@@ -190,8 +283,24 @@ struct nghttp2_session {
   /* Option flags. This is bitwise-OR of 0 or more of nghttp2_optmask. */
   uint32_t opt_flags;
 
+  /* Statistics. Only the counters are updated as frames are sent and
+     received. The other fields are filled in by
+     nghttp2_session_get_stats(). */
+  nghttp2_session_stats stats;
+
   nghttp2_session_callbacks callbacks;
   void *user_data;
+
+  /* Memory allocator used for all allocations of this session */
+  nghttp2_mem mem;
+  /* Pool of nghttp2_stream objects */
+  nghttp2_mempool stream_pool;
+  /* Pool of nghttp2_outbound_item objects */
+  nghttp2_mempool item_pool;
+
+  /* Operations queued by the other threads. This is the only member
+     the other threads touch. */
+  nghttp2_mpscq async_q;
 };
 
 /* Struct used when updating initial window size of each active
@@ -230,6 +339,23 @@ int nghttp2_session_add_frame(nghttp2_session *session,
                               nghttp2_frame_category frame_cat,
                               void *abs_frame, void *aux_data);
 
+/*
+ * Appends |op| to the queue of the operations submitted from the
+ * other threads. This function takes ownership of |op|, which must
+ * be allocated by the memory allocator of |session|. This function
+ * may be called from any thread.
+ */
+void nghttp2_session_push_async_op(nghttp2_session *session,
+                                   nghttp2_async_op *op);
+
+/*
+ * Deallocates |item| including the frame it holds and returns it to
+ * the item pool of |session|. If |item| is NULL, this function does
+ * nothing.
+ */
+void nghttp2_session_free_outbound_item(nghttp2_session *session,
+                                        nghttp2_outbound_item *item);
+
 /*
  * Adds RST_STREAM frame for the stream |stream_id| with the error
  * code |error_code|. This is a convenient function built on top of
@@ -473,7 +599,10 @@ nghttp2_stream* nghttp2_session_get_stream(nghttp2_session *session,
  * length. This function expands |*buf_ptr| as necessary to store
  * given |frame|. It packs header in first 8 bytes. Remaining bytes
  * are the DATA apyload and are filled using |frame->data_prd|. The
- * length of payload is at most |datamax| bytes.
+ * length of payload is at most |datamax| bytes. If the read callback
+ * sets NGHTTP2_DATA_FLAG_NO_COPY, the payload is not filled and
+ * |frame->no_copy| is set to 1; the returned size still includes the
+ * payload.
  *
  * This function returns the size of packed frame if it succeeds, or
  * one of the following negative error codes:
@@ -485,7 +614,8 @@ nghttp2_stream* nghttp2_session_get_stream(nghttp2_session *session,
  * NGHTTP2_ERR_NOMEM
  *     Out of memory.
  * NGHTTP2_ERR_CALLBACK_FAILURE
- *     The read_callback failed (session error).
+ *     The read_callback failed (session error); or
+ *     NGHTTP2_DATA_FLAG_NO_COPY is used without send_data_callback.
  */
 ssize_t nghttp2_session_pack_data(nghttp2_session *session,
                                   uint8_t **buf_ptr, size_t *buflen_ptr,
@@ -493,8 +623,8 @@ ssize_t nghttp2_session_pack_data(nghttp2_session *session,
                                   nghttp2_data *frame);
 
 /*
- * Returns top of outbound frame queue. This function returns NULL if
- * queue is empty.
+ * Returns top of outbound frame queue, not counting stream-creating
+ * HEADERS. This function returns NULL if queue is empty.
  */
 nghttp2_outbound_item* nghttp2_session_get_ob_pq_top(nghttp2_session *session);
 
@@ -44,6 +44,11 @@ void nghttp2_stream_init(nghttp2_stream *stream, int32_t stream_id,
   stream->stream_user_data = stream_user_data;
   stream->deferred_data = NULL;
   stream->deferred_flags = NGHTTP2_DEFERRED_NONE;
+  stream->fc_prev = stream->fc_next = NULL;
+  stream->queued_items = NULL;
+  stream->data_payloadlen = NGHTTP2_DATA_PAYLOAD_LENGTH;
+  stream->weight = NGHTTP2_DEFAULT_WEIGHT;
+  stream->data_credit = nghttp2_stream_quantum(stream);
   stream->remote_flow_control = remote_flow_control;
   stream->local_flow_control = local_flow_control;
   stream->remote_window_size = remote_initial_window_size;
@@ -53,8 +58,9 @@ void nghttp2_stream_init(nghttp2_stream *stream, int32_t stream_id,
 
 void nghttp2_stream_free(nghttp2_stream *stream)
 {
-  nghttp2_outbound_item_free(stream->deferred_data);
-  free(stream->deferred_data);
+  /* The deferred DATA is owned by the session and released to its
+     item pool there. */
+  assert(stream->deferred_data == NULL);
 }
 
 void nghttp2_stream_shutdown(nghttp2_stream *stream, nghttp2_shut_flag flag)
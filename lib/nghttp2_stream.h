@@ -78,7 +78,7 @@ typedef enum {
   NGHTTP2_DEFERRED_FLOW_CONTROL = 0x01
 } nghttp2_deferred_flag;
 
-typedef struct {
+typedef struct nghttp2_stream {
   /* Intrusive Map */
   nghttp2_map_entry map_entry;
   /* stream ID */
@@ -97,6 +97,28 @@ typedef struct {
   /* The flags for defered DATA. Bitwise OR of zero or more
      nghttp2_deferred_flag values */
   uint8_t deferred_flags;
+  /* Intrusive doubly linked list of the streams whose DATA is
+     deferred due to flow control. The stream is in the list if and
+     only if deferred_flags has NGHTTP2_DEFERRED_FLOW_CONTROL. The
+     list is owned by nghttp2_session. */
+  struct nghttp2_stream *fc_prev, *fc_next;
+  /* Intrusive doubly linked list of the queued HEADERS, PUSH_PROMISE
+     and DATA frames whose priority follows this stream. The list is
+     owned by nghttp2_session. */
+  nghttp2_outbound_item *queued_items;
+  /* The current maximum DATA payload length for this stream. This
+     starts at NGHTTP2_DATA_PAYLOAD_LENGTH and doubles, up to
+     session->max_data_payloadlen, while the stream keeps sending
+     full-size DATA frames. */
+  size_t data_payloadlen;
+  /* The weight in the round-robin among the streams of the same
+     priority. See nghttp2_session_set_stream_weight(). */
+  int32_t weight;
+  /* The number of DATA payload bytes this stream may still send in
+     the current round-robin turn. This is reset to
+     nghttp2_stream_quantum() when a turn starts, and the turn ends
+     when it drops to 0 or below. */
+  int32_t data_credit;
   /* Flag to indicate whether the remote side has flow control
      enabled. If it is enabled, we have to enforces flow control to
      send data to the other side. This could be disabled when
@@ -121,6 +143,15 @@ typedef struct {
   int32_t local_window_size;
 } nghttp2_stream;
 
+/* The number of DATA payload bytes per weight sent in one round-robin
+   turn */
+#define NGHTTP2_STREAM_WEIGHT_QUANTUM 1024
+
+/* Returns the number of DATA payload bytes |stream| sends in one
+   round-robin turn. */
+#define nghttp2_stream_quantum(STREAM) \
+  ((STREAM)->weight * NGHTTP2_STREAM_WEIGHT_QUANTUM)
+
 void nghttp2_stream_init(nghttp2_stream *stream, int32_t stream_id,
                          uint8_t flags, int32_t pri,
                          nghttp2_stream_state initial_state,
@@ -130,6 +161,10 @@ void nghttp2_stream_init(nghttp2_stream *stream, int32_t stream_id,
                          int32_t local_initial_window_size,
                          void *stream_user_data);
 
+/*
+ * Deallocates resources for |stream|. The deferred DATA must have
+ * been freed and detached by the owning session beforehand.
+ */
 void nghttp2_stream_free(nghttp2_stream *stream);
 
 /*
@@ -31,57 +31,45 @@
 #include "nghttp2_frame.h"
 #include "nghttp2_helper.h"
 
-static int nghttp2_submit_headers_shared
+/*
+ * Submits HEADERS frame with the name/value pairs |nva_copy|, which
+ * has |nvlen| entries. This function takes ownership of |nva_copy|
+ * and frees it if it fails.
+ */
+static int nghttp2_submit_headers_nva
 (nghttp2_session *session,
  uint8_t flags,
  int32_t stream_id,
  int32_t pri,
- const char **nv,
+ nghttp2_nv *nva_copy,
+ ssize_t nvlen,
  const nghttp2_data_provider *data_prd,
  void *stream_user_data)
 {
   int r;
   nghttp2_frame *frame;
-  nghttp2_nv *nva_copy;
-  ssize_t nvlen;
   uint8_t flags_copy;
-  nghttp2_data_provider *data_prd_copy = NULL;
   nghttp2_headers_aux_data *aux_data = NULL;
-  if(pri < 0) {
-    return NGHTTP2_ERR_INVALID_ARGUMENT;
-  }
-  if(!nghttp2_frame_nv_check_null(nv)) {
-    return NGHTTP2_ERR_INVALID_ARGUMENT;
-  }
-  if(data_prd != NULL && data_prd->read_callback != NULL) {
-    data_prd_copy = malloc(sizeof(nghttp2_data_provider));
-    if(data_prd_copy == NULL) {
-      return NGHTTP2_ERR_NOMEM;
-    }
-    *data_prd_copy = *data_prd;
-  }
   if(data_prd || stream_user_data) {
-    aux_data = malloc(sizeof(nghttp2_headers_aux_data));
+    aux_data = nghttp2_mem_malloc(&session->mem,
+                                  sizeof(nghttp2_headers_aux_data));
     if(aux_data == NULL) {
-      free(data_prd_copy);
+      nghttp2_nv_array_del(nva_copy, &session->mem);
       return NGHTTP2_ERR_NOMEM;
     }
-    aux_data->data_prd = data_prd_copy;
+    if(data_prd) {
+      aux_data->data_prd = *data_prd;
+    } else {
+      memset(&aux_data->data_prd, 0, sizeof(aux_data->data_prd));
+    }
     aux_data->stream_user_data = stream_user_data;
   }
-  frame = malloc(sizeof(nghttp2_frame));
+  frame = nghttp2_mem_malloc(&session->mem, sizeof(nghttp2_frame));
   if(frame == NULL) {
-    free(aux_data);
-    free(data_prd_copy);
+    nghttp2_mem_free(&session->mem, aux_data);
+    nghttp2_nv_array_del(nva_copy, &session->mem);
     return NGHTTP2_ERR_NOMEM;
   }
-  nvlen = nghttp2_nv_array_from_cstr(&nva_copy, nv);
-  if(nvlen < 0) {
-    free(frame);
-    free(aux_data);
-    free(data_prd_copy);
-    return nvlen;
-  }
   /* TODO Implement header continuation */
   flags_copy = (flags & (NGHTTP2_FLAG_END_STREAM | NGHTTP2_FLAG_PRIORITY)) |
     NGHTTP2_FLAG_END_HEADERS;
@@ -91,14 +79,66 @@ static int nghttp2_submit_headers_shared
   r = nghttp2_session_add_frame(session, NGHTTP2_CAT_CTRL, frame,
                                 aux_data);
   if(r != 0) {
-    nghttp2_frame_headers_free(&frame->headers);
-    free(frame);
-    free(aux_data);
-    free(data_prd_copy);
+    nghttp2_frame_headers_free(&frame->headers, &session->mem);
+    nghttp2_mem_free(&session->mem, frame);
+    nghttp2_mem_free(&session->mem, aux_data);
   }
   return r;
 }
 
+static int nghttp2_submit_headers_shared
+(nghttp2_session *session,
+ uint8_t flags,
+ int32_t stream_id,
+ int32_t pri,
+ const char **nv,
+ const nghttp2_data_provider *data_prd,
+ void *stream_user_data)
+{
+  nghttp2_nv *nva_copy;
+  ssize_t nvlen;
+  if(pri < 0) {
+    return NGHTTP2_ERR_INVALID_ARGUMENT;
+  }
+  if(!nghttp2_frame_nv_check_null(nv)) {
+    return NGHTTP2_ERR_INVALID_ARGUMENT;
+  }
+  nvlen = nghttp2_nv_array_from_cstr(&nva_copy, nv, &session->mem);
+  if(nvlen < 0) {
+    return nvlen;
+  }
+  return nghttp2_submit_headers_nva(session, flags, stream_id, pri,
+                                    nva_copy, nvlen, data_prd,
+                                    stream_user_data);
+}
+
+static int nghttp2_submit_headers_shared2
+(nghttp2_session *session,
+ uint8_t flags,
+ int32_t stream_id,
+ int32_t pri,
+ const nghttp2_nv *nva,
+ size_t nvlen,
+ const nghttp2_data_provider *data_prd,
+ void *stream_user_data)
+{
+  nghttp2_nv *nva_copy;
+  ssize_t rv;
+  if(pri < 0) {
+    return NGHTTP2_ERR_INVALID_ARGUMENT;
+  }
+  if(!nghttp2_nv_array_check_null(nva, nvlen)) {
+    return NGHTTP2_ERR_INVALID_ARGUMENT;
+  }
+  rv = nghttp2_nv_array_copy(&nva_copy, nva, nvlen, &session->mem);
+  if(rv < 0) {
+    return rv;
+  }
+  return nghttp2_submit_headers_nva(session, flags, stream_id, pri,
+                                    nva_copy, rv, data_prd,
+                                    stream_user_data);
+}
+
 int nghttp2_submit_headers(nghttp2_session *session, uint8_t flags,
                            int32_t stream_id, int32_t pri,
                            const char **nv, void *stream_user_data)
@@ -126,7 +166,7 @@ int nghttp2_submit_priority(nghttp2_session *session, int32_t stream_id,
   if(stream == NULL) {
     return NGHTTP2_ERR_STREAM_CLOSED;
   }
-  frame = malloc(sizeof(nghttp2_frame));
+  frame = nghttp2_mem_malloc(&session->mem, sizeof(nghttp2_frame));
   if(frame == NULL) {
     return NGHTTP2_ERR_NOMEM;
   }
@@ -134,7 +174,7 @@ int nghttp2_submit_priority(nghttp2_session *session, int32_t stream_id,
   r = nghttp2_session_add_frame(session, NGHTTP2_CAT_CTRL, frame, NULL);
   if(r != 0) {
     nghttp2_frame_priority_free(&frame->priority);
-    free(frame);
+    nghttp2_mem_free(&session->mem, frame);
     return r;
   }
   /* Only update priority if the sender is client for now */
@@ -167,13 +207,13 @@ int nghttp2_submit_settings(nghttp2_session *session,
   if(!nghttp2_settings_check_duplicate(iv, niv)) {
     return NGHTTP2_ERR_INVALID_ARGUMENT;
   }
-  frame = malloc(sizeof(nghttp2_frame));
+  frame = nghttp2_mem_malloc(&session->mem, sizeof(nghttp2_frame));
   if(frame == NULL) {
     return NGHTTP2_ERR_NOMEM;
   }
-  iv_copy = nghttp2_frame_iv_copy(iv, niv);
+  iv_copy = nghttp2_frame_iv_copy(iv, niv, &session->mem);
   if(iv_copy == NULL) {
-    free(frame);
+    nghttp2_mem_free(&session->mem, frame);
     return NGHTTP2_ERR_NOMEM;
   }
   nghttp2_frame_iv_sort(iv_copy, niv);
@@ -181,16 +221,16 @@ int nghttp2_submit_settings(nghttp2_session *session,
 
   r = nghttp2_session_update_local_settings(session, iv_copy, niv);
   if(r != 0) {
-    nghttp2_frame_settings_free(&frame->settings);
-    free(frame);
+    nghttp2_frame_settings_free(&frame->settings, &session->mem);
+    nghttp2_mem_free(&session->mem, frame);
     return r;
   }
   r = nghttp2_session_add_frame(session, NGHTTP2_CAT_CTRL, frame, NULL);
   if(r != 0) {
     /* The only expected error is fatal one */
     assert(r < NGHTTP2_ERR_FATAL);
-    nghttp2_frame_settings_free(&frame->settings);
-    free(frame);
+    nghttp2_frame_settings_free(&frame->settings, &session->mem);
+    nghttp2_mem_free(&session->mem, frame);
   }
   return r;
 }
@@ -210,13 +250,13 @@ int nghttp2_submit_push_promise(nghttp2_session *session, uint8_t flags,
   if(!nghttp2_frame_nv_check_null(nv)) {
     return NGHTTP2_ERR_INVALID_ARGUMENT;
   }
-  frame = malloc(sizeof(nghttp2_frame));
+  frame = nghttp2_mem_malloc(&session->mem, sizeof(nghttp2_frame));
   if(frame == NULL) {
     return NGHTTP2_ERR_NOMEM;
   }
-  nvlen = nghttp2_nv_array_from_cstr(&nva, nv);
+  nvlen = nghttp2_nv_array_from_cstr(&nva, nv, &session->mem);
   if(nvlen < 0) {
-    free(frame);
+    nghttp2_mem_free(&session->mem, frame);
     return nvlen;
   }
   /* TODO Implement header continuation */
@@ -225,8 +265,8 @@ int nghttp2_submit_push_promise(nghttp2_session *session, uint8_t flags,
                                   stream_id, -1, nva, nvlen);
   r = nghttp2_session_add_frame(session, NGHTTP2_CAT_CTRL, frame, NULL);
   if(r != 0) {
-    nghttp2_frame_push_promise_free(&frame->push_promise);
-    free(frame);
+    nghttp2_frame_push_promise_free(&frame->push_promise, &session->mem);
+    nghttp2_mem_free(&session->mem, frame);
   }
   return 0;
 }
@@ -302,10 +342,8 @@ int nghttp2_submit_window_update(nghttp2_session *session, uint8_t flags,
   return 0;
 }
 
-int nghttp2_submit_request(nghttp2_session *session, int32_t pri,
-                           const char **nv,
-                           const nghttp2_data_provider *data_prd,
-                           void *stream_user_data)
+static uint8_t set_request_flags(int32_t pri,
+                                 const nghttp2_data_provider *data_prd)
 {
   uint8_t flags = NGHTTP2_FLAG_NONE;
   if(data_prd == NULL || data_prd->read_callback == NULL) {
@@ -314,23 +352,106 @@ int nghttp2_submit_request(nghttp2_session *session, int32_t pri,
   if(pri != NGHTTP2_PRI_DEFAULT) {
     flags |= NGHTTP2_FLAG_PRIORITY;
   }
+  return flags;
+}
+
+static uint8_t set_response_flags(const nghttp2_data_provider *data_prd)
+{
+  uint8_t flags = NGHTTP2_FLAG_NONE;
+  if(data_prd == NULL || data_prd->read_callback == NULL) {
+    flags |= NGHTTP2_FLAG_END_STREAM;
+  }
+  return flags;
+}
+
+int nghttp2_submit_request(nghttp2_session *session, int32_t pri,
+                           const char **nv,
+                           const nghttp2_data_provider *data_prd,
+                           void *stream_user_data)
+{
+  uint8_t flags = set_request_flags(pri, data_prd);
   return nghttp2_submit_headers_shared(session, flags, -1, pri, nv,
                                        data_prd, stream_user_data);
 }
 
+int nghttp2_submit_request2(nghttp2_session *session, int32_t pri,
+                            const nghttp2_nv *nva, size_t nvlen,
+                            const nghttp2_data_provider *data_prd,
+                            void *stream_user_data)
+{
+  uint8_t flags = set_request_flags(pri, data_prd);
+  return nghttp2_submit_headers_shared2(session, flags, -1, pri, nva, nvlen,
+                                        data_prd, stream_user_data);
+}
+
+int nghttp2_submit_request_nva(nghttp2_session *session, int32_t pri,
+                               nghttp2_nv *nva_copy, size_t nvlen,
+                               const nghttp2_data_provider *data_prd,
+                               void *stream_user_data)
+{
+  uint8_t flags = set_request_flags(pri, data_prd);
+  return nghttp2_submit_headers_nva(session, flags, -1, pri, nva_copy, nvlen,
+                                    data_prd, stream_user_data);
+}
+
+int nghttp2_submit_request_async(nghttp2_session *session, int32_t pri,
+                                 const nghttp2_nv *nva, size_t nvlen,
+                                 const nghttp2_data_provider *data_prd,
+                                 void *stream_user_data)
+{
+  nghttp2_async_op *op;
+  ssize_t rv;
+  if(pri < 0) {
+    return NGHTTP2_ERR_INVALID_ARGUMENT;
+  }
+  if(!nghttp2_nv_array_check_null(nva, nvlen)) {
+    return NGHTTP2_ERR_INVALID_ARGUMENT;
+  }
+  op = nghttp2_mem_malloc(&session->mem, sizeof(nghttp2_async_op));
+  if(op == NULL) {
+    return NGHTTP2_ERR_NOMEM;
+  }
+  rv = nghttp2_nv_array_copy(&op->nva, nva, nvlen, &session->mem);
+  if(rv < 0) {
+    nghttp2_mem_free(&session->mem, op);
+    return rv;
+  }
+  op->type = NGHTTP2_ASYNC_OP_REQUEST;
+  op->stream_id = -1;
+  op->pri = pri;
+  op->nvlen = rv;
+  if(data_prd) {
+    op->data_prd = *data_prd;
+    op->has_data_prd = 1;
+  } else {
+    op->has_data_prd = 0;
+  }
+  op->stream_user_data = stream_user_data;
+  nghttp2_session_push_async_op(session, op);
+  return 0;
+}
+
 int nghttp2_submit_response(nghttp2_session *session,
                             int32_t stream_id, const char **nv,
                             const nghttp2_data_provider *data_prd)
 {
-  uint8_t flags = NGHTTP2_FLAG_NONE;
-  if(data_prd == NULL || data_prd->read_callback == NULL) {
-    flags |= NGHTTP2_FLAG_END_STREAM;
-  }
+  uint8_t flags = set_response_flags(data_prd);
   return nghttp2_submit_headers_shared(session, flags, stream_id,
                                        NGHTTP2_PRI_DEFAULT, nv, data_prd,
                                        NULL);
 }
 
+int nghttp2_submit_response2(nghttp2_session *session,
+                             int32_t stream_id,
+                             const nghttp2_nv *nva, size_t nvlen,
+                             const nghttp2_data_provider *data_prd)
+{
+  uint8_t flags = set_response_flags(data_prd);
+  return nghttp2_submit_headers_shared2(session, flags, stream_id,
+                                        NGHTTP2_PRI_DEFAULT, nva, nvlen,
+                                        data_prd, NULL);
+}
+
 int nghttp2_submit_data(nghttp2_session *session, uint8_t flags,
                         int32_t stream_id,
                         const nghttp2_data_provider *data_prd)
@@ -342,7 +463,7 @@ int nghttp2_submit_data(nghttp2_session *session, uint8_t flags,
   if(nghttp2_session_get_stream(session, stream_id) == NULL) {
     return NGHTTP2_ERR_STREAM_CLOSED;
   }
-  data_frame = malloc(sizeof(nghttp2_frame));
+  data_frame = nghttp2_mem_malloc(&session->mem, sizeof(nghttp2_frame));
   if(data_frame == NULL) {
     return NGHTTP2_ERR_NOMEM;
   }
@@ -353,7 +474,7 @@ int nghttp2_submit_data(nghttp2_session *session, uint8_t flags,
   r = nghttp2_session_add_frame(session, NGHTTP2_CAT_DATA, data_frame, NULL);
   if(r != 0) {
     nghttp2_frame_data_free(data_frame);
-    free(data_frame);
+    nghttp2_mem_free(&session->mem, data_frame);
   }
   return r;
 }
@@ -31,4 +31,21 @@
 
 #include <nghttp2/nghttp2.h>
 
+/*
+ * Submits request HEADERS with the name/value pairs |nva_copy|, which
+ * has |nvlen| entries and is allocated by the memory allocator of
+ * |session|. This function takes ownership of |nva_copy| and frees
+ * it if it fails.
+ *
+ * This function returns 0 if it succeeds, or one of the following
+ * negative error codes:
+ *
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory.
+ */
+int nghttp2_submit_request_nva(nghttp2_session *session, int32_t pri,
+                               nghttp2_nv *nva_copy, size_t nvlen,
+                               const nghttp2_data_provider *data_prd,
+                               void *stream_user_data);
+
 #endif /* NGHTTP2_SUBMIT_H */
@@ -0,0 +1,294 @@
+#!/usr/bin/env python
+#
+# nghttp2 - HTTP/2.0 C Library
+#
+# Copyright (c) 2014 Tatsuhiro Tsujikawa
+#
+# Permission is hereby granted, free of charge, to any person obtaining
+# a copy of this software and associated documentation files (the
+# "Software"), to deal in the Software without restriction, including
+# without limitation the rights to use, copy, modify, merge, publish,
+# distribute, sublicense, and/or sell copies of the Software, and to
+# permit persons to whom the Software is furnished to do so, subject to
+# the following conditions:
+#
+# The above copyright notice and this permission notice shall be
+# included in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+# EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+# MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+# NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+# LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+# OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+# WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+# This script generates lib/nghttp2_hd_huffman_data.c, the static
+# Huffman code for header literals and its decoding table.
+#
+# The code is a canonical Huffman code built from the symbol
+# frequencies of the sample header values below. Every octet gets a
+# code, and the extra symbol 256 (EOS) gets the longest code, which
+# is all ones. Encoded strings are padded with the most significant
+# bits of EOS.
+#
+# The decoder consumes 4 bits per lookup. Each state is an internal
+# node of the Huffman tree, and each transition emits at most one
+# symbol, so the shortest code must be at least 4 bits long.
+#
+# Usage: python mkhufftbl.py > lib/nghttp2_hd_huffman_data.c
+
+import heapq
+import sys
+
+SAMPLES = [
+    'GET', 'POST', 'HEAD', 'https', 'http', '200', '204', '301', '302',
+    '304', '404', '500',
+    '/', '/index.html', '/favicon.ico', '/robots.txt',
+    '/static/js/jquery-1.10.2.min.js', '/static/css/style.css',
+    '/images/logo.png', '/img/sprite-2x.png', '/api/v1/users/12345',
+    '/search?q=http2+header+compression&ie=utf-8&oe=utf-8',
+    '/wiki/Hypertext_Transfer_Protocol', '/assets/app-8f3a9c1d.js',
+    '/ajax/libs/angularjs/1.2.6/angular.min.js',
+    'www.example.com', 'www.example.org', 'example.net',
+    'static.example.com', 'api.example.com', 'en.wikipedia.org',
+    'Mozilla/5.0 (Windows NT 6.1; WOW64) AppleWebKit/537.36 '
+    '(KHTML, like Gecko) Chrome/31.0.1650.63 Safari/537.36',
+    'Mozilla/5.0 (Macintosh; Intel Mac OS X 10_9_1) AppleWebKit/537.73.11 '
+    '(KHTML, like Gecko) Version/7.0.1 Safari/537.73.11',
+    'Mozilla/5.0 (X11; Ubuntu; Linux x86_64; rv:26.0) Gecko/20100101 '
+    'Firefox/26.0',
+    'Mozilla/5.0 (iPhone; CPU iPhone OS 7_0_4 like Mac OS X) '
+    'AppleWebKit/537.51.1 (KHTML, like Gecko) Version/7.0 Mobile/11B554a '
+    'Safari/9537.53',
+    'Mozilla/5.0 (Linux; Android 4.4.2; Nexus 5 Build/KOT49H) '
+    'AppleWebKit/537.36 (KHTML, like Gecko) Chrome/31.0.1650.59 Mobile '
+    'Safari/537.36',
+    'text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8',
+    'image/webp,*/*;q=0.8', 'text/css,*/*;q=0.1', '*/*',
+    'application/json', 'application/javascript', 'text/plain',
+    'text/html; charset=utf-8', 'text/html; charset=UTF-8',
+    'image/png', 'image/jpeg', 'image/gif',
+    'application/x-www-form-urlencoded',
+    'gzip,deflate,sdch', 'gzip, deflate', 'gzip',
+    'en-US,en;q=0.8', 'en-us', 'ja,en-US;q=0.8,en;q=0.6',
+    'max-age=0', 'no-cache', 'private, max-age=0, must-revalidate',
+    'public, max-age=31536000', 'no-store, no-cache, must-revalidate',
+    'keep-alive', 'close', 'chunked', 'bytes', 'Accept-Encoding',
+    'nginx/1.4.4', 'Apache/2.2.22 (Ubuntu)', 'gws', 'cloudflare-nginx',
+    'Mon, 13 Jan 2014 08:29:41 GMT', 'Tue, 14 Jan 2014 17:02:13 GMT',
+    'Wed, 01 Jan 2014 00:00:00 GMT', 'Thu, 19 Nov 1981 08:52:00 GMT',
+    'Fri, 10 Jan 2014 23:59:59 GMT', 'Sat, 11 Jan 2014 12:00:00 GMT',
+    'Sun, 12 Jan 2014 06:30:15 GMT',
+    '"5d8e1a7c-3f2"', 'W/"1b2c3d4e5f60718293a4b5c6d7e8f901"',
+    'https://www.example.com/', 'https://www.google.com/',
+    'http://www.example.org/index.html?utm_source=feed&utm_medium=rss',
+    'SID=31d4d96e407aad42; lang=en-US',
+    '_ga=GA1.2.1234567890.1389600000; __utma=1.1234567890.1389600000.'
+    '1389600000.1389600000.1; __utmz=1.1389600000.1.1.utmcsr=(direct)|'
+    'utmccn=(direct)|utmcmd=(none)',
+    'PHPSESSID=r2t5uvjq435r4q7ib3vtdjq120; path=/',
+    'JSESSIONID=8A7F5C2E1B9D3E4F6A0B1C2D3E4F5A6B; Path=/; HttpOnly',
+    'id=a3fWa; Expires=Wed, 09 Jun 2021 10:18:14 GMT; Secure; HttpOnly',
+    'NID=67=XxLUoVHmTz8bL4qQ_5Ns9E0c3FzWwD2kRuPq7jY1vAh6MgKeTiOnBaCdSfG',
+    'dGhlIHNhbXBsZSBub25jZQ==', 'Basic QWxhZGRpbjpvcGVuIHNlc2FtZQ==',
+    'bytes=0-1023', '1024', '4096', '65535', '0', '1', '11428',
+    'SAMEORIGIN', 'nosniff', '1; mode=block', 'max-age=15552000',
+    'Origin', 'Accept-Encoding, User-Agent', 'XMLHttpRequest',
+    'attachment; filename="report-2014-01.pdf"',
+    '</style.css>; rel=preload; as=style',
+    'HIT', 'MISS', '1.1 varnish', 'v=spf1 include:_spf.example.com ~all',
+    ':method', ':path', ':scheme', ':host', ':status',
+    'accept', 'accept-charset', 'accept-encoding', 'accept-language',
+    'accept-ranges', 'age', 'allow', 'authorization', 'cache-control',
+    'content-disposition', 'content-encoding', 'content-language',
+    'content-length', 'content-location', 'content-range',
+    'content-type', 'cookie', 'date', 'etag', 'expect', 'expires',
+    'from', 'if-match', 'if-modified-since', 'if-none-match',
+    'if-range', 'if-unmodified-since', 'last-modified', 'link',
+    'location', 'max-forwards', 'proxy-authenticate',
+    'proxy-authorization', 'range', 'referer', 'refresh',
+    'retry-after', 'server', 'set-cookie', 'strict-transport-security',
+    'transfer-encoding', 'user-agent', 'vary', 'via',
+    'www-authenticate', 'x-forwarded-for', 'x-frame-options',
+    'x-content-type-options', 'x-xss-protection', 'x-requested-with',
+    'x-cache', 'x-powered-by', 'dnt',
+]
+
+# Weight of the sample symbols against the baseline count 1 given to
+# every symbol
+SAMPLE_WEIGHT = 4
+
+EOS = 256
+MIN_CODE_LENGTH = 4
+MAX_CODE_LENGTH = 30
+
+def symbol_counts():
+    counts = [1] * 257
+    for s in SAMPLES:
+        for c in s:
+            counts[ord(c)] += SAMPLE_WEIGHT
+    # EOS is never encoded.  Giving it the smallest count puts it at
+    # the bottom of the tree.
+    counts[EOS] = 0
+    return counts
+
+def code_lengths(counts):
+    heap = [(count, sym, None) for sym, count in enumerate(counts)]
+    heapq.heapify(heap)
+    seq = 257
+    while len(heap) > 1:
+        a = heapq.heappop(heap)
+        b = heapq.heappop(heap)
+        heapq.heappush(heap, (a[0] + b[0], seq, (a, b)))
+        seq += 1
+    lengths = [0] * 257
+    stack = [(heap[0], 0)]
+    while stack:
+        node, depth = stack.pop()
+        if node[2] is None:
+            lengths[node[1]] = depth
+        else:
+            stack.append((node[2][0], depth + 1))
+            stack.append((node[2][1], depth + 1))
+    return lengths
+
+def make_lengths():
+    counts = symbol_counts()
+    while True:
+        lengths = code_lengths(counts)
+        if min(lengths) >= MIN_CODE_LENGTH:
+            break
+        # Flatten the most frequent symbols until the shortest code
+        # is long enough for the 4 bits decoder.
+        top = max(counts)
+        counts = [min(c, top * 3 // 4) for c in counts]
+    assert max(lengths) <= MAX_CODE_LENGTH
+    # EOS must have the longest code so that it is all ones
+    assert lengths[EOS] == max(lengths)
+    return lengths
+
+def canonical_codes(lengths):
+    order = sorted(range(257), key=lambda sym: (lengths[sym], sym))
+    codes = [0] * 257
+    code = 0
+    prevlen = lengths[order[0]]
+    for sym in order:
+        code <<= lengths[sym] - prevlen
+        prevlen = lengths[sym]
+        codes[sym] = code
+        code += 1
+    assert codes[EOS] == (1 << lengths[EOS]) - 1
+    return codes
+
+class Node:
+    def __init__(self, depth, all_ones):
+        self.children = [None, None]
+        self.sym = None
+        self.id = None
+        self.depth = depth
+        # True if the path from the root is all ones
+        self.all_ones = all_ones
+
+def build_tree(lengths, codes):
+    root = Node(0, True)
+    for sym in range(257):
+        node = root
+        for i in range(lengths[sym] - 1, -1, -1):
+            bit = (codes[sym] >> i) & 1
+            if node.children[bit] is None:
+                node.children[bit] = Node(node.depth + 1,
+                                          node.all_ones and bit == 1)
+            node = node.children[bit]
+        node.sym = sym
+    # Number the internal nodes in breadth first order, root is 0
+    internal = []
+    queue = [root]
+    while queue:
+        node = queue.pop(0)
+        if node.sym is not None:
+            continue
+        node.id = len(internal)
+        internal.append(node)
+        queue.extend(node.children)
+    assert len(internal) <= 256
+    return root, internal
+
+FLAG_ACCEPTED = 1
+FLAG_SYM = 2
+FLAG_FAIL = 4
+
+def transition(root, node, nibble):
+    flags = 0
+    sym = 0
+    for i in range(3, -1, -1):
+        node = node.children[(nibble >> i) & 1]
+        if node.sym is not None:
+            if node.sym == EOS:
+                return (0, FLAG_FAIL, 0)
+            assert flags & FLAG_SYM == 0
+            flags |= FLAG_SYM
+            sym = node.sym
+            node = root
+    # Padding is the prefix of EOS, which is at most 7 bits
+    if node.all_ones and node.depth <= 7:
+        flags |= FLAG_ACCEPTED
+    return (node.id, flags, sym)
+
+def main():
+    lengths = make_lengths()
+    codes = canonical_codes(lengths)
+    root, internal = build_tree(lengths, codes)
+    out = sys.stdout
+    out.write('''\
+/*
+ * nghttp2 - HTTP/2.0 C Library
+ *
+ * Copyright (c) 2014 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* This file is generated by mkhufftbl.py. Do not edit. */
+#include "nghttp2_hd_huffman.h"
+
+/* The shortest code is %d bits, and the longest code is %d bits. */
+
+const nghttp2_huff_sym nghttp2_huff_sym_table[] = {
+''' % (min(lengths), max(lengths)))
+    for sym in range(257):
+        out.write('  {{ {0}, 0x{1:x}u }}{2}\n'.format(
+            lengths[sym], codes[sym], ',' if sym < 256 else ''))
+    out.write('''\
+};
+
+const nghttp2_huff_decode nghttp2_huff_decode_table[][16] = {
+''')
+    for node in internal:
+        out.write('  /* {0} */\n  {{\n'.format(node.id))
+        for nibble in range(16):
+            state, flags, sym = transition(root, node, nibble)
+            out.write('    {{ {0}, 0x{1:02x}, {2} }}{3}\n'.format(
+                state, flags, sym, ',' if nibble < 15 else ''))
+        out.write('  }}{0}\n'.format(',' if node.id < len(internal) - 1
+                                     else ''))
+    out.write('};\n')
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,160 @@
+/*
+ * nghttp2 - HTTP/2.0 C Library
+ *
+ * Copyright (c) 2014 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "Capture.h"
+
+#include <cstring>
+
+#include "app_helper.h"
+
+namespace nghttp2 {
+
+namespace {
+const char CAPTURE_MAGIC[] = "NGH2CAP\x01";
+} // namespace
+
+namespace {
+void put_uint32(uint8_t *buf, uint32_t n)
+{
+  buf[0] = n >> 24;
+  buf[1] = n >> 16;
+  buf[2] = n >> 8;
+  buf[3] = n;
+}
+} // namespace
+
+namespace {
+uint32_t get_uint32(const uint8_t *buf)
+{
+  return (static_cast<uint32_t>(buf[0]) << 24) | (buf[1] << 16) |
+    (buf[2] << 8) | buf[3];
+}
+} // namespace
+
+CaptureWriter::CaptureWriter()
+  : fp_(nullptr)
+{}
+
+CaptureWriter::~CaptureWriter()
+{
+  if(fp_) {
+    fclose(fp_);
+  }
+}
+
+int CaptureWriter::open(const std::string& path, int side)
+{
+  uint8_t hd[CAPTURE_HEADER_LENGTH];
+  fp_ = fopen(path.c_str(), "wb");
+  if(!fp_) {
+    return -1;
+  }
+  memcpy(hd, CAPTURE_MAGIC, 8);
+  hd[8] = side;
+  memset(hd + 9, 0, 3);
+  if(fwrite(hd, sizeof(hd), 1, fp_) != 1) {
+    return -1;
+  }
+  get_time(&last_);
+  return 0;
+}
+
+int CaptureWriter::write(uint8_t flags, const uint8_t *data, size_t len)
+{
+  uint8_t hd[CAPTURE_RECORD_HEADER_LENGTH];
+  timeval now;
+  if(!fp_) {
+    return -1;
+  }
+  get_time(&now);
+  int64_t delta = (now.tv_sec - last_.tv_sec) * 1000000LL +
+    (now.tv_usec - last_.tv_usec);
+  last_ = now;
+  hd[0] = flags;
+  put_uint32(hd + 1, delta > UINT32_MAX ? UINT32_MAX :
+             delta < 0 ? 0 : delta);
+  put_uint32(hd + 5, len);
+  if(fwrite(hd, sizeof(hd), 1, fp_) != 1) {
+    return -1;
+  }
+  if(data) {
+    if(fwrite(data, len, 1, fp_) != 1) {
+      return -1;
+    }
+  } else {
+    for(; len > 0; --len) {
+      if(fputc(0, fp_) == EOF) {
+        return -1;
+      }
+    }
+  }
+  return 0;
+}
+
+int read_capture(Capture& cap, const std::string& path)
+{
+  uint8_t hd[CAPTURE_HEADER_LENGTH];
+  auto fp = fopen(path.c_str(), "rb");
+  if(!fp) {
+    return -1;
+  }
+  cap.records.clear();
+  if(fread(hd, sizeof(hd), 1, fp) != 1 ||
+     memcmp(hd, CAPTURE_MAGIC, 8) != 0 ||
+     hd[8] > CAPTURE_SIDE_SERVER) {
+    fclose(fp);
+    return -1;
+  }
+  cap.side = hd[8];
+  for(;;) {
+    uint8_t rhd[CAPTURE_RECORD_HEADER_LENGTH];
+    size_t n = fread(rhd, 1, sizeof(rhd), fp);
+    if(n == 0 && feof(fp)) {
+      break;
+    }
+    if(n != sizeof(rhd)) {
+      fclose(fp);
+      return -1;
+    }
+    CaptureRecord rec;
+    rec.flags = rhd[0];
+    if(rec.flags != NGHTTP2_CAPTURE_SEND &&
+       rec.flags != NGHTTP2_CAPTURE_RECV) {
+      fclose(fp);
+      return -1;
+    }
+    rec.delta = get_uint32(rhd + 1);
+    rec.data.resize(get_uint32(rhd + 5));
+    if(!rec.data.empty() &&
+       fread(&rec.data[0], rec.data.size(), 1, fp) != 1) {
+      fclose(fp);
+      return -1;
+    }
+    cap.records.push_back(std::move(rec));
+  }
+  fclose(fp);
+  return 0;
+}
+
+} // namespace nghttp2
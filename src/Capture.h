@@ -0,0 +1,106 @@
+/*
+ * nghttp2 - HTTP/2.0 C Library
+ *
+ * Copyright (c) 2014 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include "nghttp2_config.h"
+
+#include <stdint.h>
+#include <sys/time.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <nghttp2/nghttp2.h>
+
+namespace nghttp2 {
+
+// Capture file format
+//
+// A capture file records the bytes reported by
+// nghttp2_capture_callback for one session. All integers are in
+// network byte order. The file starts with the 12 bytes header:
+//
+//   magic   8 bytes  "NGH2CAP" followed by the version, currently 1
+//   side    1 byte   0 if the captured session is a client, 1 if it
+//                    is a server
+//   unused  3 bytes  zero
+//
+// Then the records follow, one for each callback invocation:
+//
+//   flags   1 byte   NGHTTP2_CAPTURE_SEND or NGHTTP2_CAPTURE_RECV
+//   delta   4 bytes  microseconds since the previous record, or since
+//                    the capture started for the first record,
+//                    saturated at 2**32-1
+//   length  4 bytes  the number of bytes of data
+//   data    length bytes
+//
+// The DATA payload sent by send_data_callback is not available to
+// the library. It is recorded as zeros.
+
+enum {
+  CAPTURE_HEADER_LENGTH = 12,
+  CAPTURE_RECORD_HEADER_LENGTH = 9
+};
+
+enum {
+  CAPTURE_SIDE_CLIENT = 0,
+  CAPTURE_SIDE_SERVER = 1
+};
+
+class CaptureWriter {
+public:
+  CaptureWriter();
+  ~CaptureWriter();
+  // Creates the capture file |path| for the session of the |side|.
+  // Returns 0 if it succeeds, or -1.
+  int open(const std::string& path, int side);
+  // Appends the record. The |data| may be nullptr, in which case
+  // |len| zeros are written. Returns 0 if it succeeds, or -1.
+  int write(uint8_t flags, const uint8_t *data, size_t len);
+private:
+  FILE *fp_;
+  timeval last_;
+};
+
+struct CaptureRecord {
+  std::string data;
+  uint32_t delta;
+  uint8_t flags;
+};
+
+struct Capture {
+  std::vector<CaptureRecord> records;
+  int side;
+};
+
+// Reads the capture file |path| into |cap|. Returns 0 if it
+// succeeds, or -1 if the file cannot be read or is malformed.
+int read_capture(Capture& cap, const std::string& path);
+
+} // namespace nghttp2
+
+#endif // CAPTURE_H
@@ -45,6 +45,7 @@
 #include <event2/listener.h>
 
 #include "app_helper.h"
+#include "Capture.h"
 #include "util.h"
 
 #ifndef O_BINARY
@@ -344,6 +345,15 @@ int Http2Handler::on_connect()
 {
   int r;
   nghttp2_session_callbacks callbacks;
+  auto& capture_prefix = sessions_->get_config()->capture_prefix;
+  if(!capture_prefix.empty()) {
+    auto path = capture_prefix + "." + util::utos(session_id_);
+    capture_ = util::make_unique<CaptureWriter>();
+    if(capture_->open(path, CAPTURE_SIDE_SERVER) != 0) {
+      std::cerr << "Could not open capture file " << path << std::endl;
+      return -1;
+    }
+  }
   fill_callback(callbacks, sessions_->get_config());
   r = nghttp2_session_server_new(&session_, &callbacks, this);
   if(r != 0) {
@@ -551,6 +561,20 @@ ssize_t hd_recv_callback(nghttp2_session *session,
 }
 } // namespace
 
+void Http2Handler::capture(uint8_t flags, const uint8_t *data, size_t len)
+{
+  capture_->write(flags, data, len);
+}
+
+namespace {
+void hd_capture_callback(nghttp2_session *session, uint8_t flags,
+                         const uint8_t *data, size_t len, void *user_data)
+{
+  auto hd = reinterpret_cast<Http2Handler*>(user_data);
+  hd->capture(flags, data, len);
+}
+} // namespace
+
 ssize_t file_read_callback
 (nghttp2_session *session, int32_t stream_id,
  uint8_t *buf, size_t length, int *eof,
@@ -829,6 +853,9 @@ void fill_callback(nghttp2_session_callbacks& callbacks, const Config *config)
   }
   callbacks.on_data_chunk_recv_callback = on_data_chunk_recv_callback;
   callbacks.on_request_recv_callback = config->on_request_recv_callback;
+  if(!config->capture_prefix.empty()) {
+    callbacks.capture_callback = hd_capture_callback;
+  }
 }
 } // namespace
 
@@ -45,8 +45,13 @@
 
 namespace nghttp2 {
 
+class CaptureWriter;
+
 struct Config {
   std::string htdocs;
+  // If not empty, each session is recorded in the file named this
+  // followed by "." and the session ID.
+  std::string capture_prefix;
   bool verbose;
   bool daemon;
   std::string host;
@@ -89,6 +94,7 @@ public:
   int verify_npn_result();
   int sendcb(const uint8_t *data, size_t len);
   int recvcb(uint8_t *buf, size_t len);
+  void capture(uint8_t flags, const uint8_t *data, size_t len);
 
   int submit_file_response(const std::string& status,
                            int32_t stream_id,
@@ -123,6 +129,7 @@ private:
   int64_t session_id_;
   uint8_t io_flags_;
   std::map<int32_t, std::unique_ptr<Request>> id2req_;
+  std::unique_ptr<CaptureWriter> capture_;
   size_t left_connhd_len_;
 };
 
@@ -0,0 +1,354 @@
+/*
+ * nghttp2 - HTTP/2.0 C Library
+ *
+ * Copyright (c) 2014 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "nghttp2_config.h"
+
+#include <getopt.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <iostream>
+#include <iomanip>
+
+#include <nghttp2/nghttp2.h>
+
+#include "app_helper.h"
+#include "Capture.h"
+#include "util.h"
+
+namespace nghttp2 {
+
+namespace {
+struct Config {
+  size_t repeat;
+  Config()
+    : repeat(1)
+  {}
+} config;
+} // namespace
+
+namespace {
+// The peer sessions a capture is replayed through. The server session
+// receives the bytes the client sent and the client session receives
+// the bytes the server sent, whichever side was captured.
+struct Replay {
+  nghttp2_session *server;
+  nghttp2_session *client;
+  nghttp2_mem mem;
+  uint64_t frames;
+  uint64_t nalloc;
+  Replay();
+  ~Replay();
+};
+} // namespace
+
+namespace {
+void* replay_malloc(size_t size, void *mem_user_data)
+{
+  ++reinterpret_cast<Replay*>(mem_user_data)->nalloc;
+  return malloc(size);
+}
+} // namespace
+
+namespace {
+void replay_free(void *ptr, void *mem_user_data)
+{
+  free(ptr);
+}
+} // namespace
+
+namespace {
+void* replay_calloc(size_t nmemb, size_t size, void *mem_user_data)
+{
+  ++reinterpret_cast<Replay*>(mem_user_data)->nalloc;
+  return calloc(nmemb, size);
+}
+} // namespace
+
+namespace {
+void* replay_realloc(void *ptr, size_t size, void *mem_user_data)
+{
+  ++reinterpret_cast<Replay*>(mem_user_data)->nalloc;
+  return realloc(ptr, size);
+}
+} // namespace
+
+Replay::Replay()
+  : server(nullptr),
+    client(nullptr),
+    frames(0),
+    nalloc(0)
+{
+  mem.mem_user_data = this;
+  mem.malloc = replay_malloc;
+  mem.free = replay_free;
+  mem.calloc = replay_calloc;
+  mem.realloc = replay_realloc;
+}
+
+Replay::~Replay()
+{
+  nghttp2_session_del(server);
+  nghttp2_session_del(client);
+}
+
+namespace {
+ssize_t null_send_callback(nghttp2_session *session,
+                           const uint8_t *data, size_t len, int flags,
+                           void *user_data)
+{
+  return len;
+}
+} // namespace
+
+namespace {
+void replay_on_frame_recv_callback
+(nghttp2_session *session, nghttp2_frame *frame, void *user_data)
+{
+  auto replay = reinterpret_cast<Replay*>(user_data);
+  ++replay->frames;
+  if(session != replay->server) {
+    return;
+  }
+  // The client session has to know what the client did, so that the
+  // frames from the server make sense to it. Submit the same request
+  // and send it right away, so that it gets the same stream ID.
+  switch(frame->hd.type) {
+  case NGHTTP2_HEADERS:
+    if(frame->headers.cat == NGHTTP2_HCAT_REQUEST) {
+      nghttp2_submit_request2(replay->client, frame->headers.pri,
+                              frame->headers.nva, frame->headers.nvlen,
+                              nullptr, nullptr);
+      nghttp2_session_send(replay->client);
+    }
+    break;
+  case NGHTTP2_SETTINGS:
+    nghttp2_submit_settings(replay->client, frame->settings.iv,
+                            frame->settings.niv);
+    break;
+  case NGHTTP2_WINDOW_UPDATE:
+    nghttp2_submit_window_update(replay->client, frame->hd.flags,
+                                 frame->hd.stream_id,
+                                 frame->window_update.window_size_increment);
+    break;
+  default:
+    break;
+  }
+}
+} // namespace
+
+namespace {
+void replay_on_data_recv_callback
+(nghttp2_session *session, uint16_t length, uint8_t flags, int32_t stream_id,
+ void *user_data)
+{
+  ++reinterpret_cast<Replay*>(user_data)->frames;
+}
+} // namespace
+
+namespace {
+struct Result {
+  uint64_t frames;
+  uint64_t inflate_in_bytes;
+  uint64_t inflate_out_bytes;
+  uint64_t nalloc;
+};
+} // namespace
+
+namespace {
+// Replays |cap| once. Returns 0 if it succeeds, or -1.
+int replay_capture(Result& res, const Capture& cap)
+{
+  nghttp2_session_callbacks callbacks;
+  Replay replay;
+  int rv;
+  memset(&callbacks, 0, sizeof(callbacks));
+  callbacks.send_callback = null_send_callback;
+  callbacks.on_frame_recv_callback = replay_on_frame_recv_callback;
+  callbacks.on_data_recv_callback = replay_on_data_recv_callback;
+  if(nghttp2_session_server_new2(&replay.server, &callbacks, &replay,
+                                 &replay.mem) != 0 ||
+     nghttp2_session_client_new2(&replay.client, &callbacks, &replay,
+                                 &replay.mem) != 0) {
+    std::cerr << "Could not create sessions" << std::endl;
+    return -1;
+  }
+  for(size_t i = 0; i < cap.records.size(); ++i) {
+    auto& rec = cap.records[i];
+    bool from_client = (cap.side == CAPTURE_SIDE_CLIENT) ==
+      ((rec.flags & NGHTTP2_CAPTURE_SEND) != 0);
+    auto session = from_client ? replay.server : replay.client;
+    auto data = reinterpret_cast<const uint8_t*>(rec.data.c_str());
+    auto nread = nghttp2_session_mem_recv(session, data, rec.data.size());
+    if(nread < 0) {
+      std::cerr << "Record " << i << ": nghttp2_session_mem_recv() returned "
+                << "error: " << nghttp2_strerror(nread) << std::endl;
+      return -1;
+    }
+    // Discard the replies, so that they do not pile up
+    if((rv = nghttp2_session_send(session)) != 0) {
+      std::cerr << "Record " << i << ": nghttp2_session_send() returned "
+                << "error: " << nghttp2_strerror(rv) << std::endl;
+      return -1;
+    }
+  }
+  nghttp2_session_stats server_stats, client_stats;
+  nghttp2_session_get_stats(replay.server, &server_stats);
+  nghttp2_session_get_stats(replay.client, &client_stats);
+  res.frames += replay.frames;
+  res.inflate_in_bytes += server_stats.inflate_in_bytes +
+    client_stats.inflate_in_bytes;
+  res.inflate_out_bytes += server_stats.inflate_out_bytes +
+    client_stats.inflate_out_bytes;
+  res.nalloc += replay.nalloc;
+  return 0;
+}
+} // namespace
+
+namespace {
+int run(const std::string& path)
+{
+  Capture cap;
+  if(read_capture(cap, path) != 0) {
+    std::cerr << path << ": Could not read capture file" << std::endl;
+    return -1;
+  }
+  uint64_t bytes = 0, duration = 0;
+  for(auto& rec : cap.records) {
+    bytes += rec.data.size();
+    duration += rec.delta;
+  }
+  Result res;
+  memset(&res, 0, sizeof(res));
+  timeval start, end;
+  get_time(&start);
+  for(size_t i = 0; i < config.repeat; ++i) {
+    if(replay_capture(res, cap) != 0) {
+      std::cerr << path << ": Replay failed" << std::endl;
+      return -1;
+    }
+  }
+  get_time(&end);
+  double elapsed = (end.tv_sec - start.tv_sec) +
+    (end.tv_usec - start.tv_usec) / 1000000.0;
+  if(elapsed <= 0) {
+    elapsed = 1e-6;
+  }
+  std::cout << path << ": "
+            << (cap.side == CAPTURE_SIDE_CLIENT ? "client" : "server")
+            << " capture, " << cap.records.size() << " records, "
+            << bytes << " bytes, " << duration / 1000 << " ms\n"
+            << std::fixed << std::setprecision(3)
+            << "  replayed " << config.repeat << " times in "
+            << elapsed * 1000 << " ms\n"
+            << std::setprecision(0)
+            << "  frames:        " << res.frames / config.repeat << " ("
+            << res.frames / elapsed << " frames/s)\n"
+            << "  header bytes:  " << res.inflate_in_bytes / config.repeat
+            << " in, " << res.inflate_out_bytes / config.repeat << " out ("
+            << res.inflate_in_bytes / elapsed << " in bytes/s)\n"
+            << "  allocations:   " << res.nalloc / config.repeat
+            << std::endl;
+  return 0;
+}
+} // namespace
+
+namespace {
+void print_usage(std::ostream& out)
+{
+  out << "Usage: h2replay [-h] [-n <N>] <CAPTURE>..."
+      << std::endl;
+}
+} // namespace
+
+namespace {
+void print_help(std::ostream& out)
+{
+  print_usage(out);
+  out << "\n"
+      << "Replays the capture files recorded by nghttp --capture or\n"
+      << "nghttpd --capture through fresh client and server sessions as\n"
+      << "fast as possible, and prints the number of frames, header bytes\n"
+      << "and allocations per replay, and their rates.\n"
+      << "\n"
+      << "OPTIONS:\n"
+      << "    -n, --repeat=<N>   Replay each capture <N> times. Default: 1\n"
+      << "    -h, --help         Print this help.\n"
+      << std::endl;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+  while(1) {
+    static option long_options[] = {
+      {"repeat", required_argument, 0, 'n' },
+      {"help", no_argument, 0, 'h' },
+      {0, 0, 0, 0 }
+    };
+    int option_index = 0;
+    int c = getopt_long(argc, argv, "hn:", long_options, &option_index);
+    if(c == -1) {
+      break;
+    }
+    switch(c) {
+    case 'n': {
+      auto n = strtoul(optarg, nullptr, 10);
+      if(n == 0) {
+        std::cerr << "-n: specify the positive integer" << std::endl;
+        exit(EXIT_FAILURE);
+      }
+      config.repeat = n;
+      break;
+    }
+    case 'h':
+      print_help(std::cout);
+      exit(EXIT_SUCCESS);
+    case '?':
+      exit(EXIT_FAILURE);
+    default:
+      break;
+    }
+  }
+  if(optind == argc) {
+    print_usage(std::cerr);
+    std::cerr << "Too few arguments" << std::endl;
+    exit(EXIT_FAILURE);
+  }
+  int failures = 0;
+  for(int i = optind; i < argc; ++i) {
+    if(run(argv[i]) != 0) {
+      ++failures;
+    }
+  }
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+} // namespace nghttp2
+
+int main(int argc, char **argv)
+{
+  return nghttp2::main(argc, argv);
+}
@@ -63,6 +63,7 @@
 #include "http-parser/http_parser.h"
 
 #include "app_helper.h"
+#include "Capture.h"
 #include "HtmlParser.h"
 #include "util.h"
 #include "base64.h"
@@ -92,6 +93,7 @@ struct Config {
   int window_bits;
   std::map<std::string, std::string> headers;
   std::string datafile;
+  std::string capture_file;
   size_t output_upper_thres;
   Config()
     : null_out(false),
@@ -413,6 +415,8 @@ struct HttpClient {
   uint8_t settings_payload[16];
   // The length of settings_payload
   size_t settings_payloadlen;
+  // Records the bytes of the session if --capture is given
+  std::unique_ptr<CaptureWriter> capture;
 
   HttpClient(const nghttp2_session_callbacks* callbacks,
              event_base *evbase, SSL_CTX *ssl_ctx)
@@ -613,6 +617,14 @@ struct HttpClient {
     if(!config.upgrade) {
       record_handshake_time();
     }
+    if(!config.capture_file.empty()) {
+      capture = util::make_unique<CaptureWriter>();
+      if(capture->open(config.capture_file, CAPTURE_SIDE_CLIENT) != 0) {
+        std::cerr << "Could not open capture file " << config.capture_file
+                  << std::endl;
+        return -1;
+      }
+    }
     rv = nghttp2_session_client_new(&session, callbacks, this);
     if(rv != 0) {
       return -1;
@@ -1239,6 +1251,16 @@ ssize_t client_recv_callback(nghttp2_session *session,
 }
 } // namespace
 
+namespace {
+void client_capture_callback(nghttp2_session *session, uint8_t flags,
+                             const uint8_t *data, size_t len,
+                             void *user_data)
+{
+  auto client = reinterpret_cast<HttpClient*>(user_data);
+  client->capture->write(flags, data, len);
+}
+} // namespace
+
 int communicate(const std::string& host, uint16_t port,
                 std::vector<std::tuple<std::string,
                                        nghttp2_data_provider*,
@@ -1355,6 +1377,9 @@ int run(char **uris, int n)
     callbacks.on_unknown_frame_recv_callback = on_unknown_frame_recv_callback;
   }
   callbacks.on_data_chunk_recv_callback = on_data_chunk_recv_callback;
+  if(!config.capture_file.empty()) {
+    callbacks.capture_callback = client_capture_callback;
+  }
   std::string prev_host;
   uint16_t prev_port = 0;
   int failures = 0;
@@ -1414,6 +1439,7 @@ void print_usage(std::ostream& out)
 {
   out << "Usage: nghttp [-FOafnsuv] [-t <SECONDS>] [-w <WINDOW_BITS>] [--cert=<CERT>]\n"
       << "              [--key=<KEY>] [--no-tls] [-d <FILE>] [-m <N>] [-p <PRIORITY>]\n"
+      << "              [--capture=<FILE>]\n"
       << "              <URI>..."
       << std::endl;
 }
@@ -1461,6 +1487,11 @@ void print_help(std::ostream& out)
       << "    -p, --pri=<PRIORITY>\n"
       << "                       Sets stream priority. Default: "
       << NGHTTP2_PRI_DEFAULT << "\n"
+      << "    --capture=<FILE>   Record the bytes sent and received by the\n"
+      << "                       HTTP/2.0 session in <FILE>, which can be\n"
+      << "                       replayed by h2replay. If URIs of more than\n"
+      << "                       one host are given, the last connection is\n"
+      << "                       recorded.\n"
       << std::endl;
 }
 
@@ -1487,6 +1518,7 @@ int main(int argc, char **argv)
       {"no-stream-flow-control", no_argument, 0, 'f'},
       {"upgrade", no_argument, 0, 'u'},
       {"pri", required_argument, 0, 'p'},
+      {"capture", required_argument, &flag, 4 },
       {0, 0, 0, 0 }
     };
     int option_index = 0;
@@ -1601,6 +1633,10 @@ int main(int argc, char **argv)
         // no-tls option
         config.no_tls = true;
         break;
+      case 4:
+        // capture option
+        config.capture_file = optarg;
+        break;
       }
       break;
     default:
@@ -45,7 +45,8 @@ namespace nghttp2 {
 namespace {
 void print_usage(std::ostream& out)
 {
-  out << "Usage: nghttpd [-FDVfhv] [-d <PATH>] [--no-tls] <PORT> [<PRIVATE_KEY> <CERT>]"
+  out << "Usage: nghttpd [-FDVfhv] [-d <PATH>] [--no-tls] [--capture=<PREFIX>]\n"
+      << "               <PORT> [<PRIVATE_KEY> <CERT>]"
       << std::endl;
 }
 } // namespace
@@ -77,6 +78,10 @@ void print_help(std::ostream& out)
       << "                       Disables connection level flow control.\n"
       << "    -f, --no-stream-flow-control\n"
       << "                       Disables stream level flow control.\n"
+      << "    --capture=<PREFIX> Record the bytes sent and received by each\n"
+      << "                       HTTP/2.0 session in <PREFIX>.<ID>, where\n"
+      << "                       <ID> is the session ID. The files can be\n"
+      << "                       replayed by h2replay.\n"
       << "    -h, --help         Print this help.\n"
       << std::endl;
 }
@@ -96,6 +101,7 @@ int main(int argc, char **argv)
       {"no-tls", no_argument, &flag, 1 },
       {"no-connection-flow-control", no_argument, 0, 'F'},
       {"no-stream-flow-control", no_argument, 0, 'f'},
+      {"capture", required_argument, &flag, 2 },
       {0, 0, 0, 0 }
     };
     int option_index = 0;
@@ -133,6 +139,10 @@ int main(int argc, char **argv)
         // no-tls option
         config.no_tls = true;
         break;
+      case 2:
+        // capture option
+        config.capture_prefix = optarg;
+        break;
       }
       break;
     default:
@@ -27,7 +27,9 @@
 #include <netinet/tcp.h>
 #include <assert.h>
 #include <cerrno>
+#include <cstring>
 #include <sstream>
+#include <vector>
 
 #include "shrpx_client_handler.h"
 #include "shrpx_https_upstream.h"
@@ -47,6 +49,33 @@ namespace {
 const size_t SHRPX_SPDY_UPSTREAM_OUTPUT_UPPER_THRES = 64*1024;
 } // namespace
 
+namespace {
+nghttp2_nv make_nv(const char *name, const char *value, uint8_t flags)
+{
+  nghttp2_nv nv;
+  nv.name = reinterpret_cast<uint8_t*>(const_cast<char*>(name));
+  nv.value = reinterpret_cast<uint8_t*>(const_cast<char*>(value));
+  nv.namelen = strlen(name);
+  nv.valuelen = strlen(value);
+  nv.flags = flags;
+  return nv;
+}
+} // namespace
+
+namespace {
+nghttp2_nv make_nv(const std::string& name, const std::string& value,
+                   uint8_t flags)
+{
+  nghttp2_nv nv;
+  nv.name = reinterpret_cast<uint8_t*>(const_cast<char*>(name.c_str()));
+  nv.value = reinterpret_cast<uint8_t*>(const_cast<char*>(value.c_str()));
+  nv.namelen = name.size();
+  nv.valuelen = value.size();
+  nv.flags = flags;
+  return nv;
+}
+} // namespace
+
 namespace {
 ssize_t send_callback(nghttp2_session *session,
                       const uint8_t *data, size_t len, int flags,
@@ -828,12 +857,17 @@ int Http2Upstream::on_downstream_header_complete(Downstream *downstream)
     DLOG(INFO, downstream) << "HTTP response header completed";
   }
   size_t nheader = downstream->get_response_headers().size();
-  // 4 means :status and possible via header field.
-  const char **nv = new const char*[nheader * 2 + 4 + 1];
-  size_t hdidx = 0;
+  // 2 means :status and possible via header field.
+  std::vector<nghttp2_nv> nva;
+  nva.reserve(nheader + 2);
   std::string via_value;
-  nv[hdidx++] = ":status";
-  nv[hdidx++] = http::get_status_string(downstream->get_response_http_status());
+  // The status string is static and the response header fields live
+  // as long as |downstream|, which is deleted only after the stream
+  // is closed, so the library does not have to copy them.
+  nva.push_back(make_nv(":status", http::get_status_string
+                        (downstream->get_response_http_status()),
+                        NGHTTP2_NV_FLAG_NO_COPY |
+                        NGHTTP2_NV_FLAG_LOWERCASE));
   for(Headers::const_iterator i = downstream->get_response_headers().begin();
       i != downstream->get_response_headers().end(); ++i) {
     if(util::strieq((*i).first.c_str(), "transfer-encoding") ||
@@ -845,8 +879,8 @@ int Http2Upstream::on_downstream_header_complete(Downstream *downstream)
               util::strieq((*i).first.c_str(), "via")) {
       via_value = (*i).second;
     } else {
-      nv[hdidx++] = (*i).first.c_str();
-      nv[hdidx++] = (*i).second.c_str();
+      nva.push_back(make_nv((*i).first, (*i).second,
+                            NGHTTP2_NV_FLAG_NO_COPY));
     }
   }
   if(!get_config()->no_via) {
@@ -855,14 +889,18 @@ int Http2Upstream::on_downstream_header_complete(Downstream *downstream)
     }
     via_value += http::create_via_header_value
       (downstream->get_response_major(), downstream->get_response_minor());
-    nv[hdidx++] = "via";
-    nv[hdidx++] = via_value.c_str();
+    // |via_value| is local, so it must be copied.
+    nva.push_back(make_nv("via", via_value.c_str(),
+                          NGHTTP2_NV_FLAG_LOWERCASE));
   }
-  nv[hdidx++] = 0;
   if(LOG_ENABLED(INFO)) {
     std::stringstream ss;
-    for(size_t i = 0; nv[i]; i += 2) {
-      ss << TTY_HTTP_HD << nv[i] << TTY_RST << ": " << nv[i+1] << "\n";
+    for(size_t i = 0; i < nva.size(); ++i) {
+      ss << TTY_HTTP_HD;
+      ss.write(reinterpret_cast<const char*>(nva[i].name), nva[i].namelen);
+      ss << TTY_RST << ": ";
+      ss.write(reinterpret_cast<const char*>(nva[i].value), nva[i].valuelen);
+      ss << "\n";
     }
     ULOG(INFO, this) << "HTTP response headers. stream_id="
                      << downstream->get_stream_id() << "\n"
@@ -873,11 +911,10 @@ int Http2Upstream::on_downstream_header_complete(Downstream *downstream)
   data_prd.read_callback = spdy_data_read_callback;
 
   int rv;
-  rv = nghttp2_submit_response(session_, downstream->get_stream_id(), nv,
-                               &data_prd);
-  delete [] nv;
+  rv = nghttp2_submit_response2(session_, downstream->get_stream_id(),
+                                nva.data(), nva.size(), &data_prd);
   if(rv != 0) {
-    ULOG(FATAL, this) << "nghttp2_submit_response() failed";
+    ULOG(FATAL, this) << "nghttp2_submit_response2() failed";
     return -1;
   }
   if(get_config()->accesslog) {
@@ -37,6 +37,8 @@
 #include "nghttp2_npn_test.h"
 #include "nghttp2_gzip_test.h"
 #include "nghttp2_helper_test.h"
+#include "nghttp2_mempool_test.h"
+#include "nghttp2_mpscq_test.h"
 
 static int init_suite1(void)
 {
@@ -68,6 +70,11 @@ int main(int argc, char* argv[])
    /* add the tests to the suite */
    if(!CU_add_test(pSuite, "pq", test_nghttp2_pq) ||
       !CU_add_test(pSuite, "pq_update", test_nghttp2_pq_update) ||
+      !CU_add_test(pSuite, "pq_update_entry",
+                   test_nghttp2_pq_update_entry) ||
+      !CU_add_test(pSuite, "pq_remove", test_nghttp2_pq_remove) ||
+      !CU_add_test(pSuite, "mempool", test_nghttp2_mempool) ||
+      !CU_add_test(pSuite, "mpscq", test_nghttp2_mpscq) ||
       !CU_add_test(pSuite, "map", test_nghttp2_map) ||
       !CU_add_test(pSuite, "map_functional", test_nghttp2_map_functional) ||
       !CU_add_test(pSuite, "map_each_free", test_nghttp2_map_each_free) ||
@@ -134,6 +141,11 @@ int main(int argc, char* argv[])
                    test_nghttp2_submit_request_with_data) ||
       !CU_add_test(pSuite, "submit_request_without_data",
                    test_nghttp2_submit_request_without_data) ||
+      !CU_add_test(pSuite, "submit_request2", test_nghttp2_submit_request2) ||
+      !CU_add_test(pSuite, "submit_response2",
+                   test_nghttp2_submit_response2) ||
+      !CU_add_test(pSuite, "submit_request_async",
+                   test_nghttp2_submit_request_async) ||
       !CU_add_test(pSuite, "submit_headers_start_stream",
                    test_nghttp2_submit_headers_start_stream) ||
       !CU_add_test(pSuite, "submit_headers_reply",
@@ -170,6 +182,8 @@ int main(int argc, char* argv[])
                    test_nghttp2_session_stop_data_with_rst_stream) ||
       !CU_add_test(pSuite, "session_defer_data",
                    test_nghttp2_session_defer_data) ||
+      !CU_add_test(pSuite, "session_resume_data_async",
+                   test_nghttp2_session_resume_data_async) ||
       !CU_add_test(pSuite, "session_flow_control",
                    test_nghttp2_session_flow_control) ||
       !CU_add_test(pSuite, "session_flow_control_disable_remote",
@@ -192,6 +206,38 @@ int main(int argc, char* argv[])
                    test_nghttp2_session_set_option) ||
       !CU_add_test(pSuite, "session_data_backoff_by_high_pri_frame",
                    test_nghttp2_session_data_backoff_by_high_pri_frame) ||
+      !CU_add_test(pSuite, "session_custom_allocator",
+                   test_nghttp2_session_custom_allocator) ||
+      !CU_add_test(pSuite, "session_sendv",
+                   test_nghttp2_session_sendv) ||
+      !CU_add_test(pSuite, "session_send_data_no_copy",
+                   test_nghttp2_session_send_data_no_copy) ||
+      !CU_add_test(pSuite, "session_capture",
+                   test_nghttp2_session_capture) ||
+      !CU_add_test(pSuite, "session_replay_captures",
+                   test_nghttp2_session_replay_captures) ||
+      !CU_add_test(pSuite, "session_mem_send",
+                   test_nghttp2_session_mem_send) ||
+      !CU_add_test(pSuite, "session_fc_blocked_streams",
+                   test_nghttp2_session_fc_blocked_streams) ||
+      !CU_add_test(pSuite, "session_cancel_queued_data",
+                   test_nghttp2_session_cancel_queued_data) ||
+      !CU_add_test(pSuite, "session_data_payload_length",
+                   test_nghttp2_session_data_payload_length) ||
+      !CU_add_test(pSuite, "session_data_round_robin",
+                   test_nghttp2_session_data_round_robin) ||
+      !CU_add_test(pSuite, "session_window_auto_tuning",
+                   test_nghttp2_session_window_auto_tuning) ||
+      !CU_add_test(pSuite, "session_get_stats",
+                   test_nghttp2_session_get_stats) ||
+      !CU_add_test(pSuite, "session_shrink",
+                   test_nghttp2_session_shrink) ||
+      !CU_add_test(pSuite, "session_select_header_indexing",
+                   test_nghttp2_session_select_header_indexing) ||
+      !CU_add_test(pSuite, "session_recv_header_block",
+                   test_nghttp2_session_recv_header_block) ||
+      !CU_add_test(pSuite, "session_flooding",
+                   test_nghttp2_session_flooding) ||
       !CU_add_test(pSuite, "pack_settings_payload",
                    test_nghttp2_pack_settings_payload) ||
       !CU_add_test(pSuite, "frame_nv_sort", test_nghttp2_frame_nv_sort) ||
@@ -218,6 +264,7 @@ int main(int argc, char* argv[])
                    test_nghttp2_frame_pack_window_update) ||
       !CU_add_test(pSuite, "nv_array_from_cstr",
                    test_nghttp2_nv_array_from_cstr) ||
+      !CU_add_test(pSuite, "nv_array_copy", test_nghttp2_nv_array_copy) ||
       !CU_add_test(pSuite, "settings_check_duplicate",
                    test_nghttp2_settings_check_duplicate) ||
       !CU_add_test(pSuite, "hd_deflate", test_nghttp2_hd_deflate) ||
@@ -237,6 +284,24 @@ int main(int argc, char* argv[])
                    test_nghttp2_hd_inflate_newname_subst) ||
       !CU_add_test(pSuite, "hd_deflate_inflate",
                    test_nghttp2_hd_deflate_inflate) ||
+      !CU_add_test(pSuite, "hd_deflate_index_eviction",
+                   test_nghttp2_hd_deflate_index_eviction) ||
+      !CU_add_test(pSuite, "hd_table_wrap_around",
+                   test_nghttp2_hd_table_wrap_around) ||
+      !CU_add_test(pSuite, "hd_ini_table", test_nghttp2_hd_ini_table) ||
+      !CU_add_test(pSuite, "hd_deflate_table_size",
+                   test_nghttp2_hd_deflate_table_size) ||
+      !CU_add_test(pSuite, "hd_max_header_fields",
+                   test_nghttp2_hd_max_header_fields) ||
+      !CU_add_test(pSuite, "hd_huffman", test_nghttp2_hd_huffman) ||
+      !CU_add_test(pSuite, "hd_deflate_inflate_huffman",
+                   test_nghttp2_hd_deflate_inflate_huffman) ||
+      !CU_add_test(pSuite, "hd_deflate_indexing_policy",
+                   test_nghttp2_hd_deflate_indexing_policy) ||
+      !CU_add_test(pSuite, "hd_deflate_large_refset",
+                   test_nghttp2_hd_deflate_large_refset) ||
+      !CU_add_test(pSuite, "hd_inflate_partial",
+                   test_nghttp2_hd_inflate_partial) ||
       !CU_add_test(pSuite, "gzip_inflate", test_nghttp2_gzip_inflate) ||
       !CU_add_test(pSuite, "adjust_local_window_size",
                    test_nghttp2_adjust_local_window_size)
@@ -112,10 +112,12 @@ void test_nghttp2_frame_pack_headers()
   nghttp2_nv *nva;
   ssize_t nvlen;
 
-  nghttp2_hd_deflate_init(&deflater, NGHTTP2_HD_SIDE_CLIENT);
-  nghttp2_hd_inflate_init(&inflater, NGHTTP2_HD_SIDE_SERVER);
+  nghttp2_hd_deflate_init(&deflater, NGHTTP2_HD_SIDE_CLIENT,
+                          nghttp2_mem_default());
+  nghttp2_hd_inflate_init(&inflater, NGHTTP2_HD_SIDE_SERVER,
+                          nghttp2_mem_default());
 
-  nvlen = nghttp2_nv_array_from_cstr(&nva, headers);
+  nvlen = nghttp2_nv_array_from_cstr(&nva, headers, nghttp2_mem_default());
   nghttp2_frame_headers_init(&frame, NGHTTP2_FLAG_END_STREAM, 1000000007,
                              1 << 20, nva, nvlen);
   framelen = nghttp2_frame_pack_headers(&buf, &buflen, &frame, &deflater);
@@ -133,7 +135,6 @@ void test_nghttp2_frame_pack_headers()
   CU_ASSERT(nvnameeq("method", &oframe.nva[0]));
   CU_ASSERT(nvvalueeq("GET", &oframe.nva[0]));
 
-  nghttp2_frame_headers_free(&oframe);
   nghttp2_hd_end_headers(&inflater);
 
   memset(&oframe, 0, sizeof(oframe));
@@ -153,8 +154,7 @@ void test_nghttp2_frame_pack_headers()
   CU_ASSERT(nvnameeq("method", &oframe.nva[0]));
 
   free(buf);
-  nghttp2_frame_headers_free(&oframe);
-  nghttp2_frame_headers_free(&frame);
+  nghttp2_frame_headers_free(&frame, nghttp2_mem_default());
   nghttp2_hd_inflate_free(&inflater);
   nghttp2_hd_deflate_free(&deflater);
 }
@@ -181,14 +181,16 @@ void test_nghttp2_frame_pack_headers_frame_too_large(void)
   }
   big_hds[big_hdslen - 1] = NULL;
 
-  nvlen = nghttp2_nv_array_from_cstr(&nva, (const char**)big_hds);
-  nghttp2_hd_deflate_init(&deflater, NGHTTP2_HD_SIDE_CLIENT);
+  nvlen = nghttp2_nv_array_from_cstr(&nva, (const char**)big_hds,
+                                     nghttp2_mem_default());
+  nghttp2_hd_deflate_init(&deflater, NGHTTP2_HD_SIDE_CLIENT,
+                          nghttp2_mem_default());
   nghttp2_frame_headers_init(&frame, NGHTTP2_FLAG_END_STREAM, 1000000007,
                              0, nva, nvlen);
   framelen = nghttp2_frame_pack_headers(&buf, &buflen, &frame, &deflater);
   CU_ASSERT_EQUAL(NGHTTP2_ERR_HEADER_COMP, framelen);
 
-  nghttp2_frame_headers_free(&frame);
+  nghttp2_frame_headers_free(&frame, nghttp2_mem_default());
   free(buf);
   for(i = 0; i < big_hdslen; i += 2) {
     free(big_hds[i+1]);
@@ -203,7 +205,8 @@ void test_nghttp2_frame_pack_priority(void)
   size_t buflen = 0;
   ssize_t framelen;
   nghttp2_frame_priority_init(&frame, 1000000007, 1 << 30);
-  framelen = nghttp2_frame_pack_priority(&buf, &buflen, &frame);
+  framelen = nghttp2_frame_pack_priority(&buf, &buflen, &frame,
+                                         nghttp2_mem_default());
   CU_ASSERT(0 == nghttp2_frame_unpack_priority
             (&oframe,
              &buf[0], NGHTTP2_FRAME_HEAD_LENGTH,
@@ -224,7 +227,8 @@ void test_nghttp2_frame_pack_rst_stream(void)
   size_t buflen = 0;
   ssize_t framelen;
   nghttp2_frame_rst_stream_init(&frame, 1000000007, NGHTTP2_PROTOCOL_ERROR);
-  framelen = nghttp2_frame_pack_rst_stream(&buf, &buflen, &frame);
+  framelen = nghttp2_frame_pack_rst_stream(&buf, &buflen, &frame,
+                                           nghttp2_mem_default());
   CU_ASSERT(0 == nghttp2_frame_unpack_rst_stream
             (&oframe,
              &buf[0], NGHTTP2_FRAME_HEAD_LENGTH,
@@ -253,15 +257,20 @@ void test_nghttp2_frame_pack_settings()
   iv[2].settings_id = NGHTTP2_SETTINGS_FLOW_CONTROL_OPTIONS;
   iv[2].value = 1;
 
-  nghttp2_frame_settings_init(&frame, nghttp2_frame_iv_copy(iv, 3), 3);
-  framelen = nghttp2_frame_pack_settings(&buf, &buflen, &frame);
+  nghttp2_frame_settings_init(&frame,
+                              nghttp2_frame_iv_copy(iv, 3,
+                                                    nghttp2_mem_default()),
+                              3);
+  framelen = nghttp2_frame_pack_settings(&buf, &buflen, &frame,
+                                         nghttp2_mem_default());
   CU_ASSERT(NGHTTP2_FRAME_HEAD_LENGTH+3*8 == framelen);
 
   CU_ASSERT(0 == nghttp2_frame_unpack_settings
             (&oframe,
              &buf[0], NGHTTP2_FRAME_HEAD_LENGTH,
              &buf[NGHTTP2_FRAME_HEAD_LENGTH],
-             framelen - NGHTTP2_FRAME_HEAD_LENGTH));
+             framelen - NGHTTP2_FRAME_HEAD_LENGTH,
+             nghttp2_mem_default()));
 
   check_frame_header(3*8, NGHTTP2_SETTINGS, NGHTTP2_FLAG_NONE, 0, &oframe.hd);
   CU_ASSERT(3 == oframe.niv);
@@ -271,8 +280,8 @@ void test_nghttp2_frame_pack_settings()
   }
 
   free(buf);
-  nghttp2_frame_settings_free(&frame);
-  nghttp2_frame_settings_free(&oframe);
+  nghttp2_frame_settings_free(&frame, nghttp2_mem_default());
+  nghttp2_frame_settings_free(&oframe, nghttp2_mem_default());
 }
 
 void test_nghttp2_frame_pack_push_promise()
@@ -285,10 +294,12 @@ void test_nghttp2_frame_pack_push_promise()
   nghttp2_nv *nva;
   ssize_t nvlen;
 
-  nghttp2_hd_deflate_init(&deflater, NGHTTP2_HD_SIDE_CLIENT);
-  nghttp2_hd_inflate_init(&inflater, NGHTTP2_HD_SIDE_SERVER);
+  nghttp2_hd_deflate_init(&deflater, NGHTTP2_HD_SIDE_CLIENT,
+                          nghttp2_mem_default());
+  nghttp2_hd_inflate_init(&inflater, NGHTTP2_HD_SIDE_SERVER,
+                          nghttp2_mem_default());
 
-  nvlen = nghttp2_nv_array_from_cstr(&nva, headers);
+  nvlen = nghttp2_nv_array_from_cstr(&nva, headers, nghttp2_mem_default());
   nghttp2_frame_push_promise_init(&frame, NGHTTP2_FLAG_END_PUSH_PROMISE,
                                   1000000007, (1U << 31) - 1, nva, nvlen);
   framelen = nghttp2_frame_pack_push_promise(&buf, &buflen, &frame, &deflater);
@@ -307,8 +318,7 @@ void test_nghttp2_frame_pack_push_promise()
   CU_ASSERT(nvvalueeq("GET", &oframe.nva[0]));
 
   free(buf);
-  nghttp2_frame_push_promise_free(&oframe);
-  nghttp2_frame_push_promise_free(&frame);
+  nghttp2_frame_push_promise_free(&frame, nghttp2_mem_default());
   nghttp2_hd_inflate_free(&inflater);
   nghttp2_hd_deflate_free(&deflater);
 }
@@ -321,7 +331,8 @@ void test_nghttp2_frame_pack_ping(void)
   ssize_t framelen;
   const uint8_t opaque_data[] = "01234567";
   nghttp2_frame_ping_init(&frame, NGHTTP2_FLAG_PONG, opaque_data);
-  framelen = nghttp2_frame_pack_ping(&buf, &buflen, &frame);
+  framelen = nghttp2_frame_pack_ping(&buf, &buflen, &frame,
+                                     nghttp2_mem_default());
   CU_ASSERT(0 == nghttp2_frame_unpack_ping
             (&oframe,
              &buf[0], NGHTTP2_FRAME_HEAD_LENGTH,
@@ -346,20 +357,22 @@ void test_nghttp2_frame_pack_goaway()
   memcpy(opaque_data, "0123456789abcdef", opaque_data_len);
   nghttp2_frame_goaway_init(&frame, 1000000007, NGHTTP2_PROTOCOL_ERROR,
                             opaque_data, opaque_data_len);
-  framelen = nghttp2_frame_pack_goaway(&buf, &buflen, &frame);
+  framelen = nghttp2_frame_pack_goaway(&buf, &buflen, &frame,
+                                       nghttp2_mem_default());
   CU_ASSERT(0 == nghttp2_frame_unpack_goaway
             (&oframe,
              &buf[0], NGHTTP2_FRAME_HEAD_LENGTH,
              &buf[NGHTTP2_FRAME_HEAD_LENGTH],
-             framelen-NGHTTP2_FRAME_HEAD_LENGTH));
+             framelen-NGHTTP2_FRAME_HEAD_LENGTH,
+             nghttp2_mem_default()));
   check_frame_header(24, NGHTTP2_GOAWAY, NGHTTP2_FLAG_NONE, 0, &oframe.hd);
   CU_ASSERT(1000000007 == oframe.last_stream_id);
   CU_ASSERT(NGHTTP2_PROTOCOL_ERROR == oframe.error_code);
   CU_ASSERT(opaque_data_len == oframe.opaque_data_len);
   CU_ASSERT(memcmp(opaque_data, oframe.opaque_data, opaque_data_len) == 0);
   free(buf);
-  nghttp2_frame_goaway_free(&oframe);
-  nghttp2_frame_goaway_free(&frame);
+  nghttp2_frame_goaway_free(&oframe, nghttp2_mem_default());
+  nghttp2_frame_goaway_free(&frame, nghttp2_mem_default());
 }
 
 void test_nghttp2_frame_pack_window_update(void)
@@ -371,7 +384,7 @@ void test_nghttp2_frame_pack_window_update(void)
   nghttp2_frame_window_update_init(&frame, NGHTTP2_FLAG_END_FLOW_CONTROL,
                                    1000000007, 4096);
   framelen = nghttp2_frame_pack_window_update(&buf, &buflen,
-                                              &frame);
+                                              &frame, nghttp2_mem_default());
   CU_ASSERT(0 == nghttp2_frame_unpack_window_update
             (&oframe,
              &buf[0], NGHTTP2_FRAME_HEAD_LENGTH,
@@ -400,15 +413,15 @@ void test_nghttp2_nv_array_from_cstr(void)
   bigval[bigvallen] = '\0';
   bignv[1] = bigval;
 
-  rv = nghttp2_nv_array_from_cstr(&nva, empty);
+  rv = nghttp2_nv_array_from_cstr(&nva, empty, nghttp2_mem_default());
   CU_ASSERT(0 == rv);
   CU_ASSERT(NULL == nva);
 
-  rv = nghttp2_nv_array_from_cstr(&nva, emptynv);
+  rv = nghttp2_nv_array_from_cstr(&nva, emptynv, nghttp2_mem_default());
   CU_ASSERT(0 == rv);
   CU_ASSERT(NULL == nva);
 
-  rv = nghttp2_nv_array_from_cstr(&nva, nv);
+  rv = nghttp2_nv_array_from_cstr(&nva, nv, nghttp2_mem_default());
   CU_ASSERT(2 == rv);
   CU_ASSERT(nva[0].namelen == 5);
   CU_ASSERT(0 == memcmp("alpha", nva[0].name, 5));
@@ -419,14 +432,75 @@ void test_nghttp2_nv_array_from_cstr(void)
   CU_ASSERT(nva[1].valuelen == 5);
   CU_ASSERT(0 == memcmp("delta", nva[1].value, 5));
 
-  nghttp2_nv_array_del(nva);
+  nghttp2_nv_array_del(nva, nghttp2_mem_default());
 
-  rv = nghttp2_nv_array_from_cstr(&nva, bignv);
+  rv = nghttp2_nv_array_from_cstr(&nva, bignv, nghttp2_mem_default());
   CU_ASSERT(NGHTTP2_ERR_INVALID_ARGUMENT == rv);
 
   free(bigval);
 }
 
+void test_nghttp2_nv_array_copy(void)
+{
+  uint8_t alpha[] = "Alpha", charlie[] = "charlie", echo[] = "Echo";
+  uint8_t bravo[] = "bravo", delta[] = "delta", foxtrot[] = "foxtrot";
+  nghttp2_nv src[] = {
+    { echo, foxtrot, 4, 7, NGHTTP2_NV_FLAG_NO_COPY },
+    { charlie, delta, 7, 5,
+      NGHTTP2_NV_FLAG_NO_COPY | NGHTTP2_NV_FLAG_LOWERCASE },
+    { alpha, bravo, 5, 5, NGHTTP2_NV_FLAG_NONE },
+    { (uint8_t*)"golf", NULL, 4, 0, NGHTTP2_NV_FLAG_LOWERCASE }
+  };
+  nghttp2_nv bad[] = {
+    { (uint8_t*)"hotel", NULL, 5, 1, NGHTTP2_NV_FLAG_NONE }
+  };
+  nghttp2_nv big;
+  size_t i;
+  nghttp2_nv *nva;
+  ssize_t rv;
+
+  CU_ASSERT(nghttp2_nv_array_check_null(src, 4));
+  CU_ASSERT(!nghttp2_nv_array_check_null(bad, 1));
+
+  rv = nghttp2_nv_array_copy(&nva, src, 0, nghttp2_mem_default());
+  CU_ASSERT(0 == rv);
+  CU_ASSERT(NULL == nva);
+
+  rv = nghttp2_nv_array_copy(&nva, src, 4, nghttp2_mem_default());
+  CU_ASSERT(4 == rv);
+  /* Copied and lower-cased */
+  CU_ASSERT(5 == nva[0].namelen);
+  CU_ASSERT(0 == memcmp("alpha", nva[0].name, 5));
+  CU_ASSERT(alpha != nva[0].name);
+  CU_ASSERT(0 == memcmp("bravo", nva[0].value, 5));
+  CU_ASSERT(bravo != nva[0].value);
+  /* Not copied at all */
+  CU_ASSERT(charlie == nva[1].name);
+  CU_ASSERT(delta == nva[1].value);
+  /* Only the name is copied to lower-case it */
+  CU_ASSERT(0 == memcmp("echo", nva[2].name, 4));
+  CU_ASSERT(echo != nva[2].name);
+  CU_ASSERT(foxtrot == nva[2].value);
+  CU_ASSERT(0 == memcmp("Echo", echo, 4));
+  CU_ASSERT(0 == memcmp("golf", nva[3].name, 4));
+  CU_ASSERT(0 == nva[3].valuelen);
+  for(i = 0; i < 4; ++i) {
+    CU_ASSERT(NGHTTP2_NV_FLAG_NONE == nva[i].flags);
+  }
+
+  nghttp2_nv_array_del(nva, nghttp2_mem_default());
+
+  big.name = alpha;
+  big.namelen = 5;
+  big.value = malloc(NGHTTP2_MAX_HD_VALUE_LENGTH + 1);
+  big.valuelen = NGHTTP2_MAX_HD_VALUE_LENGTH + 1;
+  big.flags = NGHTTP2_NV_FLAG_NO_COPY;
+  rv = nghttp2_nv_array_copy(&nva, &big, 1, nghttp2_mem_default());
+  CU_ASSERT(NGHTTP2_ERR_INVALID_ARGUMENT == rv);
+
+  free(big.value);
+}
+
 void test_nghttp2_settings_check_duplicate(void)
 {
   nghttp2_settings_entry set[3];
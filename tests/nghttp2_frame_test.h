@@ -38,6 +38,7 @@ void test_nghttp2_frame_pack_ping(void);
 void test_nghttp2_frame_pack_goaway(void);
 void test_nghttp2_frame_pack_window_update(void);
 void test_nghttp2_nv_array_from_cstr(void);
+void test_nghttp2_nv_array_copy(void);
 void test_nghttp2_settings_check_duplicate(void);
 
 #endif /* NGHTTP2_FRAME_TEST_H */
@@ -30,10 +30,12 @@
 #include <CUnit/CUnit.h>
 
 #include "nghttp2_hd.h"
+#include "nghttp2_hd_huffman.h"
 #include "nghttp2_frame.h"
 
-#define MAKE_NV(NAME, VALUE)                    \
-  { (uint8_t*)NAME, (uint8_t*)VALUE, strlen(NAME), strlen(VALUE) }
+#define MAKE_NV(NAME, VALUE)                                    \
+  { (uint8_t*)NAME, (uint8_t*)VALUE, strlen(NAME), strlen(VALUE), \
+      NGHTTP2_NV_FLAG_NONE }
 #define ARRLEN(ARR) (sizeof(ARR)/sizeof(ARR[0]))
 
 static void assert_nv_equal(nghttp2_nv *a, nghttp2_nv *b, size_t len)
@@ -66,8 +68,10 @@ void test_nghttp2_hd_deflate(void)
   nghttp2_nv *resnva;
   ssize_t blocklen;
 
-  CU_ASSERT(0 == nghttp2_hd_deflate_init(&deflater, NGHTTP2_HD_SIDE_CLIENT));
-  CU_ASSERT(0 == nghttp2_hd_inflate_init(&inflater, NGHTTP2_HD_SIDE_SERVER));
+  CU_ASSERT(0 == nghttp2_hd_deflate_init(&deflater, NGHTTP2_HD_SIDE_CLIENT,
+                                         nghttp2_mem_default()));
+  CU_ASSERT(0 == nghttp2_hd_inflate_init(&inflater, NGHTTP2_HD_SIDE_SERVER,
+                                         nghttp2_mem_default()));
 
   blocklen = nghttp2_hd_deflate_hd(&deflater, &buf, &buflen, nv_offset, nva1,
                                    sizeof(nva1)/sizeof(nghttp2_nv));
@@ -78,8 +82,9 @@ void test_nghttp2_hd_deflate(void)
                                        blocklen));
 
   assert_nv_equal(nva1, resnva, 3);
+  /* The result is stored in the buffer owned by inflater */
+  CU_ASSERT(inflater.nvabuf == resnva);
 
-  nghttp2_nv_array_del(resnva);
   nghttp2_hd_end_headers(&inflater);
 
   /* Second headers */
@@ -93,7 +98,6 @@ void test_nghttp2_hd_deflate(void)
 
   assert_nv_equal(nva2, resnva, 2);
 
-  nghttp2_nv_array_del(resnva);
   nghttp2_hd_end_headers(&inflater);
 
   /* Third headers, including same header field name, but value is not
@@ -108,7 +112,6 @@ void test_nghttp2_hd_deflate(void)
 
   assert_nv_equal(nva3, resnva, 3);
 
-  nghttp2_nv_array_del(resnva);
   nghttp2_hd_end_headers(&inflater);
 
   /* Fourth headers, including duplicate header fields. We don't
@@ -123,7 +126,6 @@ void test_nghttp2_hd_deflate(void)
 
   assert_nv_equal(nva4, resnva, 2);
 
-  nghttp2_nv_array_del(resnva);
   nghttp2_hd_end_headers(&inflater);
 
   /* Fifth headers includes empty value */
@@ -137,7 +139,6 @@ void test_nghttp2_hd_deflate(void)
 
   assert_nv_equal(nva5, resnva, 2);
 
-  nghttp2_nv_array_del(resnva);
   nghttp2_hd_end_headers(&inflater);
 
   /* Cleanup */
@@ -154,16 +155,19 @@ void test_nghttp2_hd_inflate_indname_inc(void)
   size_t offset = 0;
   nghttp2_nv nv = MAKE_NV("user-agent", "nghttp2");
   nghttp2_nv *resnva;
-  nghttp2_hd_inflate_init(&inflater, NGHTTP2_HD_SIDE_SERVER);
+  nghttp2_hd_inflate_init(&inflater, NGHTTP2_HD_SIDE_SERVER,
+                          nghttp2_mem_default());
 
   CU_ASSERT(0 == nghttp2_hd_emit_indname_block(&buf, &buflen, &offset, 12,
-                                               nv.value, nv.valuelen, 1));
+                                               nv.value, nv.valuelen, 1,
+                                               nghttp2_mem_default()));
   CU_ASSERT(1 == nghttp2_hd_inflate_hd(&inflater, &resnva, buf, offset));
   assert_nv_equal(&nv, resnva, 1);
   CU_ASSERT(39 == inflater.hd_tablelen);
-  assert_nv_equal(&nv, &inflater.hd_table[inflater.hd_tablelen-1]->nv, 1);
+  assert_nv_equal(&nv,
+                  &nghttp2_hd_table_get(&inflater, inflater.hd_tablelen-1)->nv,
+                  1);
 
-  nghttp2_nv_array_del(resnva);
   free(buf);
   nghttp2_hd_inflate_free(&inflater);
 }
@@ -179,20 +183,21 @@ void test_nghttp2_hd_inflate_indname_inc_eviction(void)
      use name ":host" which index 2 and value length 2510. */
   uint8_t value[2510];
   nghttp2_nv *resnva;
-  nghttp2_hd_inflate_init(&inflater, NGHTTP2_HD_SIDE_SERVER);
+  nghttp2_hd_inflate_init(&inflater, NGHTTP2_HD_SIDE_SERVER,
+                          nghttp2_mem_default());
 
   CU_ASSERT(0 == nghttp2_hd_emit_indname_block(&buf, &buflen, &offset, 2,
-                                               value, sizeof(value), 1));
+                                               value, sizeof(value), 1,
+                                               nghttp2_mem_default()));
   CU_ASSERT(1 == nghttp2_hd_inflate_hd(&inflater, &resnva, buf, offset));
   CU_ASSERT(5 == resnva[0].namelen);
   CU_ASSERT(0 == memcmp(":host", resnva[0].name, resnva[0].namelen));
   CU_ASSERT(sizeof(value) == resnva[0].valuelen);
 
-  nghttp2_nv_array_del(resnva);
   nghttp2_hd_end_headers(&inflater);
 
   CU_ASSERT(38 == inflater.hd_tablelen);
-  CU_ASSERT(37 == inflater.refset[0]->index);
+  CU_ASSERT(nghttp2_hd_table_get(&inflater, 37) == inflater.refset[0]);
 
   free(buf);
   nghttp2_hd_inflate_free(&inflater);
@@ -206,16 +211,18 @@ void test_nghttp2_hd_inflate_newname_inc(void)
   size_t offset = 0;
   nghttp2_nv nv = MAKE_NV("x-rel", "nghttp2");
   nghttp2_nv *resnva;
-  nghttp2_hd_inflate_init(&inflater, NGHTTP2_HD_SIDE_SERVER);
+  nghttp2_hd_inflate_init(&inflater, NGHTTP2_HD_SIDE_SERVER,
+                          nghttp2_mem_default());
 
   CU_ASSERT(0 == nghttp2_hd_emit_newname_block(&buf, &buflen, &offset,
-                                               &nv, 1));
+                                               &nv, 1, nghttp2_mem_default()));
   CU_ASSERT(1 == nghttp2_hd_inflate_hd(&inflater, &resnva, buf, offset));
   assert_nv_equal(&nv, resnva, 1);
   CU_ASSERT(39 == inflater.hd_tablelen);
-  assert_nv_equal(&nv, &inflater.hd_table[inflater.hd_tablelen-1]->nv, 1);
+  assert_nv_equal(&nv,
+                  &nghttp2_hd_table_get(&inflater, inflater.hd_tablelen-1)->nv,
+                  1);
 
-  nghttp2_nv_array_del(resnva);
   free(buf);
   nghttp2_hd_inflate_free(&inflater);
 }
@@ -228,18 +235,19 @@ void test_nghttp2_hd_inflate_indname_subst(void)
   size_t offset = 0;
   nghttp2_nv nv = MAKE_NV("user-agent", "nghttp2");
   nghttp2_nv *resnva;
-  nghttp2_hd_inflate_init(&inflater, NGHTTP2_HD_SIDE_SERVER);
+  nghttp2_hd_inflate_init(&inflater, NGHTTP2_HD_SIDE_SERVER,
+                          nghttp2_mem_default());
 
   CU_ASSERT(0 == nghttp2_hd_emit_subst_indname_block(&buf, &buflen, &offset,
                                                      12,
                                                      nv.value, nv.valuelen,
-                                                     12));
+                                                     12,
+                                                     nghttp2_mem_default()));
   CU_ASSERT(1 == nghttp2_hd_inflate_hd(&inflater, &resnva, buf, offset));
   assert_nv_equal(&nv, resnva, 1);
   CU_ASSERT(38 == inflater.hd_tablelen);
-  assert_nv_equal(&nv, &inflater.hd_table[12]->nv, 1);
+  assert_nv_equal(&nv, &nghttp2_hd_table_get(&inflater, 12)->nv, 1);
 
-  nghttp2_nv_array_del(resnva);
   free(buf);
   nghttp2_hd_inflate_free(&inflater);
 }
@@ -255,21 +263,22 @@ void test_nghttp2_hd_inflate_indname_subst_eviction(void)
      use name ":host" which index 2 and value length 2510. */
   uint8_t value[2510];
   nghttp2_nv *resnva;
-  nghttp2_hd_inflate_init(&inflater, NGHTTP2_HD_SIDE_SERVER);
+  nghttp2_hd_inflate_init(&inflater, NGHTTP2_HD_SIDE_SERVER,
+                          nghttp2_mem_default());
 
   CU_ASSERT(0 == nghttp2_hd_emit_subst_indname_block(&buf, &buflen, &offset,
                                                      2,
-                                                     value, sizeof(value), 2));
+                                                     value, sizeof(value), 2,
+                                                     nghttp2_mem_default()));
   CU_ASSERT(1 == nghttp2_hd_inflate_hd(&inflater, &resnva, buf, offset));
   CU_ASSERT(5 == resnva[0].namelen);
   CU_ASSERT(0 == memcmp(":host", resnva[0].name, resnva[0].namelen));
   CU_ASSERT(sizeof(value) == resnva[0].valuelen);
 
-  nghttp2_nv_array_del(resnva);
   nghttp2_hd_end_headers(&inflater);
 
   CU_ASSERT(37 == inflater.hd_tablelen);
-  CU_ASSERT(1 == inflater.refset[0]->index);
+  CU_ASSERT(nghttp2_hd_table_get(&inflater, 1) == inflater.refset[0]);
 
   free(buf);
   nghttp2_hd_inflate_free(&inflater);
@@ -286,21 +295,22 @@ void test_nghttp2_hd_inflate_indname_subst_eviction_neg(void)
      use name ":host" which index 2 and value length 2511. */
   uint8_t value[2511];
   nghttp2_nv *resnva;
-  nghttp2_hd_inflate_init(&inflater, NGHTTP2_HD_SIDE_SERVER);
+  nghttp2_hd_inflate_init(&inflater, NGHTTP2_HD_SIDE_SERVER,
+                          nghttp2_mem_default());
   /* Try to substitute index 0, but it will be evicted */
   CU_ASSERT(0 == nghttp2_hd_emit_subst_indname_block(&buf, &buflen, &offset,
                                                      2,
-                                                     value, sizeof(value), 0));
+                                                     value, sizeof(value), 0,
+                                                     nghttp2_mem_default()));
   CU_ASSERT(1 == nghttp2_hd_inflate_hd(&inflater, &resnva, buf, offset));
   CU_ASSERT(5 == resnva[0].namelen);
   CU_ASSERT(0 == memcmp(":host", resnva[0].name, resnva[0].namelen));
   CU_ASSERT(sizeof(value) == resnva[0].valuelen);
 
-  nghttp2_nv_array_del(resnva);
   nghttp2_hd_end_headers(&inflater);
 
   CU_ASSERT(37 == inflater.hd_tablelen);
-  CU_ASSERT(0 == inflater.refset[0]->index);
+  CU_ASSERT(nghttp2_hd_table_get(&inflater, 0) == inflater.refset[0]);
 
   free(buf);
   nghttp2_hd_inflate_free(&inflater);
@@ -314,23 +324,46 @@ void test_nghttp2_hd_inflate_newname_subst(void)
   size_t offset = 0;
   nghttp2_nv nv = MAKE_NV("x-rel", "nghttp2");
   nghttp2_nv *resnva;
-  nghttp2_hd_inflate_init(&inflater, NGHTTP2_HD_SIDE_SERVER);
+  nghttp2_hd_inflate_init(&inflater, NGHTTP2_HD_SIDE_SERVER,
+                          nghttp2_mem_default());
 
   CU_ASSERT(0 == nghttp2_hd_emit_subst_newname_block(&buf, &buflen, &offset,
-                                                     &nv, 1));
+                                                     &nv, 1,
+                                                     nghttp2_mem_default()));
   CU_ASSERT(1 == nghttp2_hd_inflate_hd(&inflater, &resnva, buf, offset));
   assert_nv_equal(&nv, resnva, 1);
   CU_ASSERT(38 == inflater.hd_tablelen);
-  assert_nv_equal(&nv, &inflater.hd_table[1]->nv, 1);
+  assert_nv_equal(&nv, &nghttp2_hd_table_get(&inflater, 1)->nv, 1);
 
-  nghttp2_nv_array_del(resnva);
   free(buf);
   nghttp2_hd_inflate_free(&inflater);
 }
 
-static void check_deflate_inflate(nghttp2_hd_context *deflater,
-                                  nghttp2_hd_context *inflater,
-                                  nghttp2_nv *nva, size_t nvlen)
+static int select_indexing_incremental(const nghttp2_nv *nv, void *arg)
+{
+  return NGHTTP2_HD_INDEXING_INCREMENTAL;
+}
+
+static int select_indexing_none(const nghttp2_nv *nv, void *arg)
+{
+  ++*(int*)arg;
+  return NGHTTP2_HD_INDEXING_NONE;
+}
+
+static int hd_table_has(nghttp2_hd_context *context, nghttp2_nv *nv)
+{
+  size_t i;
+  for(i = 0; i < context->hd_tablelen; ++i) {
+    if(nghttp2_nv_equal(nv, &nghttp2_hd_table_get(context, i)->nv)) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+static ssize_t check_deflate_inflate(nghttp2_hd_context *deflater,
+                                     nghttp2_hd_context *inflater,
+                                     nghttp2_nv *nva, size_t nvlen)
 {
   uint8_t *buf = NULL;
   size_t buflen = 0;
@@ -346,8 +379,9 @@ static void check_deflate_inflate(nghttp2_hd_context *deflater,
   assert_nv_equal(nva, resnva, nvlen);
   nghttp2_hd_end_headers(inflater);
 
-  free(resnva);
   free(buf);
+
+  return blocklen;
 }
 
 void test_nghttp2_hd_deflate_inflate(void)
@@ -488,8 +522,10 @@ void test_nghttp2_hd_deflate_inflate(void)
     MAKE_NV("x-cache-lookup", "HIT from alphabravo:3128"),
   };
 
-  nghttp2_hd_deflate_init(&deflater, NGHTTP2_HD_SIDE_SERVER);
-  nghttp2_hd_inflate_init(&inflater, NGHTTP2_HD_SIDE_CLIENT);
+  nghttp2_hd_deflate_init(&deflater, NGHTTP2_HD_SIDE_SERVER,
+                          nghttp2_mem_default());
+  nghttp2_hd_inflate_init(&inflater, NGHTTP2_HD_SIDE_CLIENT,
+                          nghttp2_mem_default());
 
   check_deflate_inflate(&deflater, &inflater, nv1, ARRLEN(nv1));
   check_deflate_inflate(&deflater, &inflater, nv2, ARRLEN(nv2));
@@ -505,3 +541,496 @@ void test_nghttp2_hd_deflate_inflate(void)
   nghttp2_hd_inflate_free(&inflater);
   nghttp2_hd_deflate_free(&deflater);
 }
+
+void test_nghttp2_hd_deflate_index_eviction(void)
+{
+  nghttp2_hd_context inflater, deflater;
+  nghttp2_nv nv1[] = { MAKE_NV("x-foo", "bar") };
+  nghttp2_nv nv2[] = { MAKE_NV("x-baz", "qux") };
+  uint8_t value[900];
+  nghttp2_nv bignv;
+  size_t i;
+
+  nghttp2_hd_deflate_init(&deflater, NGHTTP2_HD_SIDE_SERVER,
+                          nghttp2_mem_default());
+  nghttp2_hd_inflate_init(&inflater, NGHTTP2_HD_SIDE_CLIENT,
+                          nghttp2_mem_default());
+  /* Index everything, so that the big values evict "x-foo: bar" */
+  nghttp2_hd_deflate_set_select_indexing(&deflater,
+                                         select_indexing_incremental, NULL);
+
+  CU_ASSERT(1 < check_deflate_inflate(&deflater, &inflater,
+                                      nv1, ARRLEN(nv1)));
+  /* Toggles off "x-foo: bar" in reference set */
+  check_deflate_inflate(&deflater, &inflater, nv2, ARRLEN(nv2));
+  /* "x-foo: bar" is now in the header table and is encoded using
+     Indexed Header representation. Another 1 byte is used to toggle
+     off "x-baz: qux". */
+  CU_ASSERT(2 == check_deflate_inflate(&deflater, &inflater,
+                                       nv1, ARRLEN(nv1)));
+
+  /* Evicts all entries added so far */
+  memset(value, 'a', sizeof(value));
+  bignv.name = (uint8_t*)"x-big";
+  bignv.namelen = strlen("x-big");
+  bignv.value = value;
+  bignv.valuelen = sizeof(value);
+  for(i = 0; i < 5; ++i) {
+    value[0] = 'a' + i;
+    check_deflate_inflate(&deflater, &inflater, &bignv, 1);
+  }
+  for(i = 0; i < deflater.hd_tablelen; ++i) {
+    CU_ASSERT(!nghttp2_nv_equal(&nv1[0],
+                                &nghttp2_hd_table_get(&deflater, i)->nv));
+  }
+
+  /* Evicted entry must not be found */
+  CU_ASSERT(1 < check_deflate_inflate(&deflater, &inflater,
+                                      nv1, ARRLEN(nv1)));
+
+  nghttp2_hd_inflate_free(&inflater);
+  nghttp2_hd_deflate_free(&deflater);
+}
+
+void test_nghttp2_hd_table_wrap_around(void)
+{
+  nghttp2_hd_context inflater, deflater;
+  nghttp2_nv nva[] = { MAKE_NV(":method", "GET"),
+                       MAKE_NV("cookie", "") };
+  char value[32];
+  size_t i;
+
+  nghttp2_hd_deflate_init(&deflater, NGHTTP2_HD_SIDE_CLIENT,
+                          nghttp2_mem_default());
+  nghttp2_hd_inflate_init(&inflater, NGHTTP2_HD_SIDE_SERVER,
+                          nghttp2_mem_default());
+  nghttp2_hd_deflate_set_select_indexing(&deflater,
+                                         select_indexing_incremental, NULL);
+
+  /* Each header block adds unique cookie, and the header table
+     overflows many times. */
+  for(i = 0; i < 1000; ++i) {
+    snprintf(value, sizeof(value), "k=%zu", i);
+    nva[1].value = (uint8_t*)value;
+    nva[1].valuelen = strlen(value);
+    check_deflate_inflate(&deflater, &inflater, nva, ARRLEN(nva));
+
+    CU_ASSERT(deflater.hd_tablelen == inflater.hd_tablelen);
+    CU_ASSERT(nghttp2_nv_equal(&nva[1],
+                               &nghttp2_hd_table_get
+                               (&deflater, deflater.hd_tablelen - 1)->nv));
+    CU_ASSERT(nghttp2_nv_equal(&nva[1],
+                               &nghttp2_hd_table_get
+                               (&inflater, inflater.hd_tablelen - 1)->nv));
+  }
+  CU_ASSERT(deflater.hd_table_bufsize <= NGHTTP2_HD_MAX_BUFFER_SIZE);
+  CU_ASSERT(deflater.hd_table_bufsize == inflater.hd_table_bufsize);
+
+  nghttp2_hd_inflate_free(&inflater);
+  nghttp2_hd_deflate_free(&deflater);
+}
+
+void test_nghttp2_hd_ini_table(void)
+{
+  nghttp2_hd_context deflater, inflater;
+  nghttp2_hd_entry ent;
+  nghttp2_hd_entry *ini;
+  size_t i;
+
+  nghttp2_hd_deflate_init(&deflater, NGHTTP2_HD_SIDE_CLIENT,
+                          nghttp2_mem_default());
+  nghttp2_hd_inflate_init(&inflater, NGHTTP2_HD_SIDE_CLIENT,
+                          nghttp2_mem_default());
+
+  /* The precomputed hashes of the initial entries must match the
+     ones computed at runtime. */
+  for(i = 0; i < deflater.hd_tablelen; ++i) {
+    ini = nghttp2_hd_table_get(&deflater, i);
+    CU_ASSERT(NGHTTP2_HD_FLAG_STATIC == ini->flags);
+    CU_ASSERT(i == ini->slot);
+    nghttp2_hd_entry_init(&ent, 0, NGHTTP2_HD_FLAG_NONE,
+                          ini->nv.name, ini->nv.namelen,
+                          ini->nv.value, ini->nv.valuelen,
+                          nghttp2_mem_default());
+    CU_ASSERT(ent.name_hash == ini->name_hash);
+    CU_ASSERT(ent.nv_hash == ini->nv_hash);
+  }
+  for(i = 0; i < inflater.hd_tablelen; ++i) {
+    ini = nghttp2_hd_table_get(&inflater, i);
+    nghttp2_hd_entry_init(&ent, 0, NGHTTP2_HD_FLAG_NONE,
+                          ini->nv.name, ini->nv.namelen,
+                          ini->nv.value, ini->nv.valuelen,
+                          nghttp2_mem_default());
+    CU_ASSERT(ent.name_hash == ini->name_hash);
+    CU_ASSERT(ent.nv_hash == ini->nv_hash);
+  }
+  /* The initial entries are copied, not shared between contexts */
+  CU_ASSERT(nghttp2_hd_table_get(&deflater, 0) !=
+            nghttp2_hd_table_get(&inflater, 0));
+
+  nghttp2_hd_inflate_free(&inflater);
+  nghttp2_hd_deflate_free(&deflater);
+}
+
+void test_nghttp2_hd_deflate_table_size(void)
+{
+  nghttp2_hd_context inflater, deflater;
+  nghttp2_nv nva[] = { MAKE_NV(":method", "GET"),
+                       MAKE_NV("cookie", "") };
+  char value[32];
+  size_t i, ini_tablelen, limit;
+
+  nghttp2_hd_deflate_init(&deflater, NGHTTP2_HD_SIDE_CLIENT,
+                          nghttp2_mem_default());
+  nghttp2_hd_inflate_init(&inflater, NGHTTP2_HD_SIDE_SERVER,
+                          nghttp2_mem_default());
+  nghttp2_hd_deflate_set_select_indexing(&deflater,
+                                         select_indexing_incremental, NULL);
+  ini_tablelen = deflater.hd_tablelen;
+  limit = deflater.hd_table_bufsize + 100;
+  nghttp2_hd_deflate_set_table_size(&deflater, limit);
+
+  for(i = 0; i < 10; ++i) {
+    snprintf(value, sizeof(value), "k=%zu", i);
+    nva[1].value = (uint8_t*)value;
+    nva[1].valuelen = strlen(value);
+    check_deflate_inflate(&deflater, &inflater, nva, ARRLEN(nva));
+    CU_ASSERT(deflater.hd_table_bufsize <= limit);
+    CU_ASSERT(deflater.hd_table_bufsize == inflater.hd_table_bufsize);
+    CU_ASSERT(deflater.hd_tablelen == inflater.hd_tablelen);
+  }
+  /* Each cookie takes 32 + 6 + 3 bytes, so only 2 of them fit */
+  CU_ASSERT(ini_tablelen + 2 == deflater.hd_tablelen);
+
+  /* Nothing is added with 0 */
+  nghttp2_hd_deflate_set_table_size(&deflater, 0);
+  nva[1].value = (uint8_t*)"k=x";
+  check_deflate_inflate(&deflater, &inflater, nva, ARRLEN(nva));
+  CU_ASSERT(ini_tablelen + 2 == deflater.hd_tablelen);
+  CU_ASSERT(ini_tablelen + 2 == inflater.hd_tablelen);
+
+  nghttp2_hd_inflate_free(&inflater);
+  nghttp2_hd_deflate_free(&deflater);
+}
+
+void test_nghttp2_hd_max_header_fields(void)
+{
+  nghttp2_hd_context inflater, deflater;
+  nghttp2_nv nva[] = { MAKE_NV(":method", "GET"),
+                       MAKE_NV(":path", "/"),
+                       MAKE_NV("x-nghttp2", "") };
+  nghttp2_nv *resnva;
+  uint8_t *buf = NULL;
+  size_t buflen = 0;
+  ssize_t blocklen;
+
+  nghttp2_hd_deflate_init(&deflater, NGHTTP2_HD_SIDE_CLIENT,
+                          nghttp2_mem_default());
+  nghttp2_hd_inflate_init(&inflater, NGHTTP2_HD_SIDE_SERVER,
+                          nghttp2_mem_default());
+
+  CU_ASSERT(NGHTTP2_ERR_INVALID_ARGUMENT ==
+            nghttp2_hd_set_max_header_fields(&inflater, 0));
+  CU_ASSERT(NGHTTP2_ERR_INVALID_ARGUMENT ==
+            nghttp2_hd_set_max_header_fields
+            (&inflater, NGHTTP2_DEFAULT_MAX_HEADER_FIELDS + 1));
+  CU_ASSERT(0 == nghttp2_hd_set_max_header_fields(&inflater, 2));
+  CU_ASSERT(2 == inflater.ws_capacity);
+  CU_ASSERT(2 == inflater.refset_capacity);
+
+  check_deflate_inflate(&deflater, &inflater, nva, 2);
+  CU_ASSERT(2 == inflater.refsetlen);
+  /* The reference set does not fit */
+  CU_ASSERT(NGHTTP2_ERR_INVALID_ARGUMENT ==
+            nghttp2_hd_set_max_header_fields(&inflater, 1));
+
+  /* The capacity is kept across shrink */
+  nghttp2_hd_shrink(&inflater);
+  check_deflate_inflate(&deflater, &inflater, nva, 2);
+  CU_ASSERT(2 == inflater.ws_capacity);
+
+  /* Too many header fields */
+  blocklen = nghttp2_hd_deflate_hd(&deflater, &buf, &buflen, 0, nva,
+                                   ARRLEN(nva));
+  CU_ASSERT(blocklen > 0);
+  nghttp2_hd_end_headers(&deflater);
+  CU_ASSERT(NGHTTP2_ERR_HEADER_COMP ==
+            nghttp2_hd_inflate_hd(&inflater, &resnva, buf, blocklen));
+
+  free(buf);
+  nghttp2_hd_inflate_free(&inflater);
+  nghttp2_hd_deflate_free(&deflater);
+}
+
+void test_nghttp2_hd_huffman(void)
+{
+  uint8_t src[256], enc[512], dec[1024];
+  const uint8_t text[] = "www.example.com";
+  size_t i, enclen;
+  ssize_t declen;
+
+  for(i = 0; i < sizeof(src); ++i) {
+    src[i] = i;
+  }
+  enclen = nghttp2_hd_huff_encode_count(src, sizeof(src));
+  CU_ASSERT(enclen <= sizeof(enc));
+  CU_ASSERT(enclen == nghttp2_hd_huff_encode(enc, src, sizeof(src)));
+  declen = nghttp2_hd_huff_decode(dec, enc, enclen);
+  CU_ASSERT(sizeof(src) == declen);
+  CU_ASSERT(memcmp(src, dec, sizeof(src)) == 0);
+
+  /* Common header characters get shorter */
+  enclen = nghttp2_hd_huff_encode(enc, text, sizeof(text) - 1);
+  CU_ASSERT(enclen < sizeof(text) - 1);
+  CU_ASSERT((ssize_t)sizeof(text) - 1 ==
+            nghttp2_hd_huff_decode(dec, enc, enclen));
+  CU_ASSERT(memcmp(text, dec, sizeof(text) - 1) == 0);
+
+  /* Empty string */
+  CU_ASSERT(0 == nghttp2_hd_huff_encode_count(src, 0));
+  CU_ASSERT(0 == nghttp2_hd_huff_decode(dec, enc, 0));
+
+  /* The padding must be 1 bits */
+  enclen = nghttp2_hd_huff_encode(enc, text, 1);
+  CU_ASSERT(1 == enclen);
+  enc[0] &= 0xf0;
+  CU_ASSERT(NGHTTP2_ERR_HEADER_COMP == nghttp2_hd_huff_decode(dec, enc, 1));
+
+  /* The padding must be less than 8 bits */
+  enc[0] = 0xff;
+  CU_ASSERT(NGHTTP2_ERR_HEADER_COMP == nghttp2_hd_huff_decode(dec, enc, 1));
+
+  /* EOS must not appear */
+  enc[0] = 0xff;
+  enc[1] = 0xff;
+  CU_ASSERT(NGHTTP2_ERR_HEADER_COMP == nghttp2_hd_huff_decode(dec, enc, 2));
+}
+
+void test_nghttp2_hd_deflate_inflate_huffman(void)
+{
+  nghttp2_hd_context inflater, deflater;
+  nghttp2_hd_context plain_inflater, plain_deflater;
+  nghttp2_nv nva[] = {
+    MAKE_NV(":host", "www.example.com"),
+    MAKE_NV(":method", "GET"),
+    MAKE_NV(":path", "/static/js/jquery-1.10.2.min.js"),
+    MAKE_NV(":scheme", "https"),
+    MAKE_NV("accept-encoding", "gzip,deflate,sdch"),
+    MAKE_NV("user-agent", "Mozilla/5.0 (X11; Linux x86_64) Gecko/20100101"),
+    MAKE_NV("x-nghttp2", "\x80\x81\xfe\xff")
+  };
+  ssize_t blocklen, plain_blocklen;
+
+  nghttp2_hd_deflate_init(&deflater, NGHTTP2_HD_SIDE_CLIENT,
+                          nghttp2_mem_default());
+  nghttp2_hd_inflate_init(&inflater, NGHTTP2_HD_SIDE_SERVER,
+                          nghttp2_mem_default());
+  nghttp2_hd_set_huffman(&deflater, 1);
+  nghttp2_hd_set_huffman(&inflater, 1);
+  nghttp2_hd_deflate_init(&plain_deflater, NGHTTP2_HD_SIDE_CLIENT,
+                          nghttp2_mem_default());
+  nghttp2_hd_inflate_init(&plain_inflater, NGHTTP2_HD_SIDE_SERVER,
+                          nghttp2_mem_default());
+
+  blocklen = check_deflate_inflate(&deflater, &inflater, nva, ARRLEN(nva));
+  plain_blocklen = check_deflate_inflate(&plain_deflater, &plain_inflater,
+                                         nva, ARRLEN(nva));
+  CU_ASSERT(blocklen < plain_blocklen);
+  CU_ASSERT(deflater.hd_tablelen == inflater.hd_tablelen);
+
+  /* Indexed name with Huffman encoded value */
+  nva[2].value = (uint8_t*)"/index.html";
+  nva[2].valuelen = strlen("/index.html");
+  check_deflate_inflate(&deflater, &inflater, nva, ARRLEN(nva));
+  CU_ASSERT(deflater.hd_tablelen == inflater.hd_tablelen);
+
+  /* The decoded strings are released by shrink */
+  CU_ASSERT(inflater.strbuflen > 0);
+  nghttp2_hd_shrink(&inflater);
+  CU_ASSERT(NULL == inflater.strbuf);
+  CU_ASSERT(0 == inflater.strbuflen);
+  check_deflate_inflate(&deflater, &inflater, nva, ARRLEN(nva));
+
+  nghttp2_hd_inflate_free(&plain_inflater);
+  nghttp2_hd_deflate_free(&plain_deflater);
+  nghttp2_hd_inflate_free(&inflater);
+  nghttp2_hd_deflate_free(&deflater);
+}
+
+void test_nghttp2_hd_deflate_indexing_policy(void)
+{
+  nghttp2_hd_context inflater, deflater;
+  nghttp2_nv nva[] = { MAKE_NV("x-id", "1"),
+                       MAKE_NV("x-id", "2"),
+                       MAKE_NV("x-id", "3"),
+                       MAKE_NV("x-foo", "bar") };
+  size_t tablelen;
+  int ncalls = 0;
+  nghttp2_hd_entry *ent;
+
+  nghttp2_hd_deflate_init(&deflater, NGHTTP2_HD_SIDE_CLIENT,
+                          nghttp2_mem_default());
+  nghttp2_hd_inflate_init(&inflater, NGHTTP2_HD_SIDE_SERVER,
+                          nghttp2_mem_default());
+  tablelen = deflater.hd_tablelen;
+
+  /* The first value of a name is indexed */
+  check_deflate_inflate(&deflater, &inflater, &nva[0], 1);
+  CU_ASSERT(tablelen + 1 == deflater.hd_tablelen);
+  ent = nghttp2_hd_table_get(&deflater, deflater.hd_tablelen - 1);
+  CU_ASSERT(0 == (ent->flags & NGHTTP2_HD_FLAG_REUSED));
+  /* "x-id: 1" was not reused, so "x-id: 2" is not indexed */
+  check_deflate_inflate(&deflater, &inflater, &nva[1], 1);
+  CU_ASSERT(tablelen + 1 == deflater.hd_tablelen);
+  CU_ASSERT(tablelen + 1 == inflater.hd_tablelen);
+  CU_ASSERT(!hd_table_has(&inflater, &nva[1]));
+  /* Reusing "x-id: 1" makes the name worth indexing again */
+  check_deflate_inflate(&deflater, &inflater, &nva[0], 1);
+  CU_ASSERT(ent->flags & NGHTTP2_HD_FLAG_REUSED);
+  check_deflate_inflate(&deflater, &inflater, &nva[2], 1);
+  CU_ASSERT(tablelen + 2 == deflater.hd_tablelen);
+  CU_ASSERT(hd_table_has(&inflater, &nva[2]));
+
+  /* The callback overrides the default policy */
+  nghttp2_hd_deflate_set_select_indexing(&deflater, select_indexing_none,
+                                         &ncalls);
+  check_deflate_inflate(&deflater, &inflater, &nva[3], 1);
+  CU_ASSERT(1 == ncalls);
+  CU_ASSERT(tablelen + 2 == deflater.hd_tablelen);
+  /* Not called for the header fields in the header table */
+  check_deflate_inflate(&deflater, &inflater, &nva[0], 1);
+  CU_ASSERT(1 == ncalls);
+
+  /* Restores the default policy, which indexes a new name */
+  nghttp2_hd_deflate_set_select_indexing(&deflater, NULL, NULL);
+  check_deflate_inflate(&deflater, &inflater, &nva[3], 1);
+  CU_ASSERT(tablelen + 3 == deflater.hd_tablelen);
+  CU_ASSERT(tablelen + 3 == inflater.hd_tablelen);
+
+  nghttp2_hd_inflate_free(&inflater);
+  nghttp2_hd_deflate_free(&deflater);
+}
+
+void test_nghttp2_hd_deflate_large_refset(void)
+{
+  nghttp2_hd_context inflater, deflater;
+  nghttp2_nv nva[80];
+  uint8_t names[80][16], values[80][16];
+  uint8_t *buf = NULL;
+  size_t buflen = 0;
+  size_t i, k;
+  int rnd;
+
+  nghttp2_hd_deflate_init(&deflater, NGHTTP2_HD_SIDE_CLIENT,
+                          nghttp2_mem_default());
+  nghttp2_hd_inflate_init(&inflater, NGHTTP2_HD_SIDE_SERVER,
+                          nghttp2_mem_default());
+  nghttp2_hd_deflate_set_select_indexing(&deflater,
+                                         select_indexing_incremental, NULL);
+  /* More header fields than the buckets of the working set hash
+     index, so that some of them share the bucket, while all of them
+     fit in the header table. */
+  for(i = 0; i < 80; ++i) {
+    nva[i].name = names[i];
+    nva[i].namelen = snprintf((char*)names[i], sizeof(names[i]),
+                              "x-field-%03zu", i);
+    nva[i].value = values[i];
+    nva[i].valuelen = snprintf((char*)values[i], sizeof(values[i]),
+                               "%zu", i);
+  }
+  check_deflate_inflate(&deflater, &inflater, nva, 80);
+  CU_ASSERT(80 == deflater.refsetlen);
+
+  /* The same header block is entirely in the reference set */
+  CU_ASSERT(0 == nghttp2_hd_deflate_hd(&deflater, &buf, &buflen, 0,
+                                       nva, 80));
+  nghttp2_hd_end_headers(&deflater);
+
+  for(rnd = 0; rnd < 8; ++rnd) {
+    /* Changes some values, which toggles off the old ones */
+    for(k = 0; k < 10; ++k) {
+      i = (rnd * 7 + k * 13) % 80;
+      nva[i].valuelen = snprintf((char*)values[i], sizeof(values[i]),
+                                 "%zu-%d", i, rnd % 3);
+    }
+    check_deflate_inflate(&deflater, &inflater, nva, 80);
+    /* Drops some header fields from the block */
+    check_deflate_inflate(&deflater, &inflater, nva + rnd, 80 - rnd * 2);
+  }
+
+  free(buf);
+  nghttp2_hd_inflate_free(&inflater);
+  nghttp2_hd_deflate_free(&deflater);
+}
+
+void test_nghttp2_hd_inflate_partial(void)
+{
+  nghttp2_hd_context inflater, deflater;
+  nghttp2_nv nva[] = {
+    MAKE_NV(":status", "200 OK"),
+    MAKE_NV("cache-control", "private, max-age=0, must-revalidate"),
+    MAKE_NV("content-type", "text/html"),
+    MAKE_NV("x-cache", "MISS from alphabravo"),
+    MAKE_NV("x-request-id", "f0c3e8a1")
+  };
+  nghttp2_nv upper = MAKE_NV("X-Rel", "nghttp2");
+  nghttp2_nv lower = MAKE_NV("x-rel", "nghttp2");
+  nghttp2_nv *resnva;
+  uint8_t *buf = NULL;
+  size_t buflen = 0;
+  size_t offset = 0;
+  uint8_t piece[64];
+  size_t piecelen, i, n;
+  ssize_t blocklen, rv;
+
+  nghttp2_hd_deflate_init(&deflater, NGHTTP2_HD_SIDE_CLIENT,
+                          nghttp2_mem_default());
+  nghttp2_hd_inflate_init(&inflater, NGHTTP2_HD_SIDE_SERVER,
+                          nghttp2_mem_default());
+
+  blocklen = nghttp2_hd_deflate_hd(&deflater, &buf, &buflen, 0,
+                                   nva, ARRLEN(nva));
+  nghttp2_hd_end_headers(&deflater);
+
+  /* Gives the block in 3 byte pieces. The strings are copied, so the
+     consumed bytes can be overwritten. */
+  CU_ASSERT(0 == nghttp2_hd_inflate_begin(&inflater, blocklen, 1));
+  piecelen = 0;
+  for(i = 0; i < (size_t)blocklen; i += n) {
+    n = blocklen - i < 3 ? blocklen - i : 3;
+    memcpy(piece + piecelen, buf + i, n);
+    piecelen += n;
+    rv = nghttp2_hd_inflate_partial(&inflater, piece, piecelen,
+                                    i + n == (size_t)blocklen);
+    CU_ASSERT(rv >= 0);
+    memmove(piece, piece + rv, piecelen - rv);
+    memset(piece + piecelen - rv, 0xff, rv);
+    piecelen -= rv;
+  }
+  CU_ASSERT(0 == piecelen);
+  CU_ASSERT(ARRLEN(nva) == nghttp2_hd_inflate_finish(&inflater, &resnva));
+  assert_nv_equal(nva, resnva, ARRLEN(nva));
+  nghttp2_hd_end_headers(&inflater);
+
+  /* The upper case name is converted to lower case without modifying
+     the input */
+  nghttp2_hd_inflate_free(&inflater);
+  nghttp2_hd_inflate_init(&inflater, NGHTTP2_HD_SIDE_SERVER,
+                          nghttp2_mem_default());
+  CU_ASSERT(0 == nghttp2_hd_emit_newname_block(&buf, &buflen, &offset,
+                                               &upper, 0,
+                                               nghttp2_mem_default()));
+  CU_ASSERT(1 == nghttp2_hd_inflate_hd(&inflater, &resnva, buf, offset));
+  assert_nv_equal(&lower, resnva, 1);
+  CU_ASSERT(0 == memcmp("X-Rel", buf + 2, 5));
+  nghttp2_hd_end_headers(&inflater);
+
+  /* The truncated block is an error */
+  CU_ASSERT(0 == nghttp2_hd_inflate_begin(&inflater, offset - 1, 0));
+  CU_ASSERT(NGHTTP2_ERR_HEADER_COMP ==
+            nghttp2_hd_inflate_partial(&inflater, buf, offset - 1, 1));
+
+  free(buf);
+  nghttp2_hd_inflate_free(&inflater);
+  nghttp2_hd_deflate_free(&deflater);
+}
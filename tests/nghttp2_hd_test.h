@@ -34,5 +34,15 @@ void test_nghttp2_hd_inflate_indname_subst_eviction(void);
 void test_nghttp2_hd_inflate_indname_subst_eviction_neg(void);
 void test_nghttp2_hd_inflate_newname_subst(void);
 void test_nghttp2_hd_deflate_inflate(void);
+void test_nghttp2_hd_deflate_index_eviction(void);
+void test_nghttp2_hd_table_wrap_around(void);
+void test_nghttp2_hd_ini_table(void);
+void test_nghttp2_hd_deflate_table_size(void);
+void test_nghttp2_hd_max_header_fields(void);
+void test_nghttp2_hd_huffman(void);
+void test_nghttp2_hd_deflate_inflate_huffman(void);
+void test_nghttp2_hd_deflate_indexing_policy(void);
+void test_nghttp2_hd_deflate_large_refset(void);
+void test_nghttp2_hd_inflate_partial(void);
 
 #endif /* NGHTTP2_HD_TEST_H */
@@ -43,7 +43,7 @@ void test_nghttp2_map(void)
 {
   strentry foo, FOO, bar, baz, shrubbery;
   nghttp2_map map;
-  nghttp2_map_init(&map);
+  nghttp2_map_init(&map, nghttp2_mem_default());
 
   strentry_init(&foo, 1, "foo");
   strentry_init(&FOO, 1, "FOO");
@@ -108,6 +108,12 @@ static int eachfun(nghttp2_map_entry *entry, void *ptr)
   return 0;
 }
 
+static int countfun(nghttp2_map_entry *entry, void *ptr)
+{
+  ++*(size_t*)ptr;
+  return 0;
+}
+
 #define NUM_ENT 6000
 strentry arr[NUM_ENT];
 int order[NUM_ENT];
@@ -116,8 +122,9 @@ void test_nghttp2_map_functional(void)
 {
   nghttp2_map map;
   int i;
+  size_t count;
 
-  nghttp2_map_init(&map);
+  nghttp2_map_init(&map, nghttp2_mem_default());
   for(i = 0; i < NUM_ENT; ++i) {
     strentry_init(&arr[i], i + 1, "foo");
     order[i] = i + 1;
@@ -128,17 +135,29 @@ void test_nghttp2_map_functional(void)
     CU_ASSERT(0 == nghttp2_map_insert(&map, &arr[order[i] - 1].map_entry));
   }
   /* traverse */
-  nghttp2_map_each(&map, eachfun, NULL);
+  count = 0;
+  nghttp2_map_each(&map, countfun, &count);
+  CU_ASSERT(NUM_ENT == count);
   /* find */
   shuffle(order, NUM_ENT);
   for(i = 0; i < NUM_ENT; ++i) {
-    nghttp2_map_find(&map, order[i]);
+    CU_ASSERT(&arr[order[i] - 1].map_entry ==
+              nghttp2_map_find(&map, order[i]));
   }
-  /* remove */
+  /* remove half of them; the rest must still be found */
   shuffle(order, NUM_ENT);
+  for(i = 0; i < NUM_ENT / 2; ++i) {
+    CU_ASSERT(0 == nghttp2_map_remove(&map, order[i]));
+  }
   for(i = 0; i < NUM_ENT; ++i) {
+    CU_ASSERT((i < NUM_ENT / 2 ? NULL : &arr[order[i] - 1].map_entry) ==
+              nghttp2_map_find(&map, order[i]));
+  }
+  /* remove */
+  for(i = NUM_ENT / 2; i < NUM_ENT; ++i) {
     CU_ASSERT(0 == nghttp2_map_remove(&map, order[i]));
   }
+  CU_ASSERT(0 == nghttp2_map_size(&map));
 
   /* each_free (but no op function for testing purpose) */
   for(i = 0; i < NUM_ENT; ++i) {
@@ -164,7 +183,7 @@ void test_nghttp2_map_each_free(void)
     *baz = malloc(sizeof(strentry)),
     *shrubbery = malloc(sizeof(strentry));
   nghttp2_map map;
-  nghttp2_map_init(&map);
+  nghttp2_map_init(&map, nghttp2_mem_default());
 
   strentry_init(foo, 1, "foo");
   strentry_init(bar, 2, "bar");
@@ -0,0 +1,101 @@
+/*
+ * nghttp2 - HTTP/2.0 C Library
+ *
+ * Copyright (c) 2014 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "nghttp2_mempool_test.h"
+
+#include <CUnit/CUnit.h>
+
+#include "nghttp2_mempool.h"
+
+typedef struct {
+  int32_t a;
+  uint8_t b;
+} mempool_obj;
+
+void test_nghttp2_mempool(void)
+{
+  nghttp2_mempool pool;
+  mempool_obj *objs[5];
+  mempool_obj *obj;
+  size_t i;
+
+  nghttp2_mempool_init(&pool, sizeof(mempool_obj), 4, nghttp2_mem_default());
+  CU_ASSERT(NULL == pool.blocks);
+  CU_ASSERT(pool.objsize >= sizeof(mempool_obj));
+  CU_ASSERT(0 == pool.objsize % sizeof(void*));
+
+  for(i = 0; i < 4; ++i) {
+    objs[i] = nghttp2_mempool_alloc(&pool);
+    CU_ASSERT(NULL != objs[i]);
+    objs[i]->a = i;
+    objs[i]->b = i;
+  }
+  /* All objects come from the first block */
+  CU_ASSERT(NULL != pool.blocks);
+  CU_ASSERT(NULL == pool.blocks->next);
+  CU_ASSERT(NULL == pool.freelist);
+  for(i = 1; i < 4; ++i) {
+    CU_ASSERT((uint8_t*)objs[i] - (uint8_t*)objs[i-1] ==
+              (ssize_t)pool.objsize);
+  }
+
+  /* Next allocation needs new block */
+  objs[4] = nghttp2_mempool_alloc(&pool);
+  CU_ASSERT(NULL != objs[4]);
+  CU_ASSERT(NULL != pool.blocks->next);
+  CU_ASSERT(NULL == pool.blocks->next->next);
+
+  /* Released object is handed out first */
+  nghttp2_mempool_release(&pool, objs[2]);
+  obj = nghttp2_mempool_alloc(&pool);
+  CU_ASSERT(objs[2] == obj);
+  CU_ASSERT(3 == objs[3]->a);
+
+  nghttp2_mempool_release(&pool, NULL);
+  CU_ASSERT(5 == pool.nalloc);
+  CU_ASSERT(2 == pool.nblocks);
+  CU_ASSERT(nghttp2_mempool_get_mem_usage(&pool) > 8 * pool.objsize);
+
+  /* Nothing is freed while objects are in use */
+  for(i = 0; i < 4; ++i) {
+    nghttp2_mempool_release(&pool, objs[i]);
+  }
+  nghttp2_mempool_shrink(&pool);
+  CU_ASSERT(2 == pool.nblocks);
+
+  nghttp2_mempool_release(&pool, objs[4]);
+  nghttp2_mempool_shrink(&pool);
+  CU_ASSERT(NULL == pool.blocks);
+  CU_ASSERT(NULL == pool.freelist);
+  CU_ASSERT(0 == nghttp2_mempool_get_mem_usage(&pool));
+
+  /* The pool is still usable after shrink */
+  obj = nghttp2_mempool_alloc(&pool);
+  CU_ASSERT(NULL != obj);
+  CU_ASSERT(1 == pool.nblocks);
+  nghttp2_mempool_release(&pool, obj);
+  nghttp2_mempool_free(&pool);
+  CU_ASSERT(NULL == pool.blocks);
+  CU_ASSERT(NULL == pool.freelist);
+}
@@ -0,0 +1,80 @@
+/*
+ * nghttp2 - HTTP/2.0 C Library
+ *
+ * Copyright (c) 2014 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "nghttp2_mpscq_test.h"
+
+#include <CUnit/CUnit.h>
+
+#include "nghttp2_mpscq.h"
+
+void test_nghttp2_mpscq(void)
+{
+  nghttp2_mpscq q;
+  nghttp2_mpscq_entry ents[5];
+  size_t i;
+
+  nghttp2_mpscq_init(&q);
+  CU_ASSERT(nghttp2_mpscq_empty(&q));
+  CU_ASSERT(NULL == nghttp2_mpscq_pop(&q));
+
+  for(i = 0; i < 5; ++i) {
+    nghttp2_mpscq_push(&q, &ents[i]);
+    CU_ASSERT(!nghttp2_mpscq_empty(&q));
+  }
+  for(i = 0; i < 3; ++i) {
+    CU_ASSERT(&ents[i] == nghttp2_mpscq_pop(&q));
+  }
+  /* Push while entries remain */
+  nghttp2_mpscq_push(&q, &ents[0]);
+  CU_ASSERT(&ents[3] == nghttp2_mpscq_pop(&q));
+  CU_ASSERT(&ents[4] == nghttp2_mpscq_pop(&q));
+  CU_ASSERT(&ents[0] == nghttp2_mpscq_pop(&q));
+  CU_ASSERT(nghttp2_mpscq_empty(&q));
+  CU_ASSERT(NULL == nghttp2_mpscq_pop(&q));
+
+  /* The entry whose producer has swapped head but not linked it yet
+     is not visible, and neither is anything behind it. The entry in
+     front of it is held back too, since the queue cannot be left
+     without the stub. */
+  nghttp2_mpscq_push(&q, &ents[0]);
+  ents[1].next = NULL;
+  q.head = &ents[1];
+  nghttp2_mpscq_push(&q, &ents[2]);
+  CU_ASSERT(NULL == nghttp2_mpscq_pop(&q));
+  CU_ASSERT(!nghttp2_mpscq_empty(&q));
+  /* The producer completes the push */
+  ents[0].next = &ents[1];
+  CU_ASSERT(&ents[0] == nghttp2_mpscq_pop(&q));
+  CU_ASSERT(&ents[1] == nghttp2_mpscq_pop(&q));
+  CU_ASSERT(&ents[2] == nghttp2_mpscq_pop(&q));
+  CU_ASSERT(nghttp2_mpscq_empty(&q));
+
+  /* The last entry is not popped yet */
+  nghttp2_mpscq_push(&q, &ents[0]);
+  nghttp2_mpscq_push(&q, &ents[1]);
+  CU_ASSERT(&ents[0] == nghttp2_mpscq_pop(&q));
+  CU_ASSERT(!nghttp2_mpscq_empty(&q));
+  CU_ASSERT(&ents[1] == nghttp2_mpscq_pop(&q));
+  CU_ASSERT(nghttp2_mpscq_empty(&q));
+}
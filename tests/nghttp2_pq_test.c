@@ -24,53 +24,85 @@
  */
 #include "nghttp2_pq_test.h"
 
+#include <stdlib.h>
+#include <string.h>
+
 #include <CUnit/CUnit.h>
 
 #include "nghttp2_pq.h"
 
+typedef struct {
+  nghttp2_pq_entry ent;
+  const char *s;
+} string_entry;
+
+static string_entry* string_entry_new(const char *s)
+{
+  string_entry *ent = malloc(sizeof(string_entry));
+  ent->s = s;
+  return ent;
+}
+
 static int pq_compar(const void *lhs, const void *rhs)
 {
-  return strcmp(lhs, rhs);
+  return strcmp(((string_entry*)lhs)->s, ((string_entry*)rhs)->s);
+}
+
+static const char* pq_top_str(nghttp2_pq *pq)
+{
+  return ((string_entry*)nghttp2_pq_top(pq))->s;
 }
 
 void test_nghttp2_pq(void)
 {
   int i;
   nghttp2_pq pq;
-  nghttp2_pq_init(&pq, pq_compar);
+  string_entry *top;
+  nghttp2_pq_init(&pq, pq_compar, nghttp2_mem_default());
   CU_ASSERT(nghttp2_pq_empty(&pq));
   CU_ASSERT(0 == nghttp2_pq_size(&pq));
-  CU_ASSERT(0 == nghttp2_pq_push(&pq, (void*)"foo"));
+  CU_ASSERT(0 == nghttp2_pq_push(&pq, &string_entry_new("foo")->ent));
   CU_ASSERT(0 == nghttp2_pq_empty(&pq));
   CU_ASSERT(1 == nghttp2_pq_size(&pq));
-  CU_ASSERT(strcmp("foo", nghttp2_pq_top(&pq)) == 0);
-  CU_ASSERT(0 == nghttp2_pq_push(&pq, (void*)"bar"));
-  CU_ASSERT(strcmp("bar", nghttp2_pq_top(&pq)) == 0);
-  CU_ASSERT(0 == nghttp2_pq_push(&pq, (void*)"baz"));
-  CU_ASSERT(strcmp("bar", nghttp2_pq_top(&pq)) == 0);
-  CU_ASSERT(0 == nghttp2_pq_push(&pq, (void*)"C"));
+  CU_ASSERT(strcmp("foo", pq_top_str(&pq)) == 0);
+  CU_ASSERT(0 == nghttp2_pq_push(&pq, &string_entry_new("bar")->ent));
+  CU_ASSERT(strcmp("bar", pq_top_str(&pq)) == 0);
+  CU_ASSERT(0 == nghttp2_pq_push(&pq, &string_entry_new("baz")->ent));
+  CU_ASSERT(strcmp("bar", pq_top_str(&pq)) == 0);
+  CU_ASSERT(0 == nghttp2_pq_push(&pq, &string_entry_new("C")->ent));
   CU_ASSERT(4 == nghttp2_pq_size(&pq));
-  CU_ASSERT(strcmp("C", nghttp2_pq_top(&pq)) == 0);
+  CU_ASSERT(strcmp("C", pq_top_str(&pq)) == 0);
+  CU_ASSERT(0 == nghttp2_pq_top(&pq)->index);
+  top = (string_entry*)nghttp2_pq_top(&pq);
   nghttp2_pq_pop(&pq);
+  free(top);
   CU_ASSERT(3 == nghttp2_pq_size(&pq));
-  CU_ASSERT(strcmp("bar", nghttp2_pq_top(&pq)) == 0);
+  CU_ASSERT(strcmp("bar", pq_top_str(&pq)) == 0);
+  top = (string_entry*)nghttp2_pq_top(&pq);
   nghttp2_pq_pop(&pq);
-  CU_ASSERT(strcmp("baz", nghttp2_pq_top(&pq)) == 0);
+  free(top);
+  CU_ASSERT(strcmp("baz", pq_top_str(&pq)) == 0);
+  top = (string_entry*)nghttp2_pq_top(&pq);
   nghttp2_pq_pop(&pq);
-  CU_ASSERT(strcmp("foo", nghttp2_pq_top(&pq)) == 0);
+  free(top);
+  CU_ASSERT(strcmp("foo", pq_top_str(&pq)) == 0);
+  top = (string_entry*)nghttp2_pq_top(&pq);
   nghttp2_pq_pop(&pq);
+  free(top);
   CU_ASSERT(nghttp2_pq_empty(&pq));
   CU_ASSERT(0 == nghttp2_pq_size(&pq));
   CU_ASSERT(NULL == nghttp2_pq_top(&pq));
 
   /* Add bunch of entry to see realloc works */
   for(i = 0; i < 10000; ++i) {
-    CU_ASSERT(0 == nghttp2_pq_push(&pq, (void*)"foo"));
+    CU_ASSERT(0 == nghttp2_pq_push(&pq, &string_entry_new("foo")->ent));
     CU_ASSERT((size_t)(i+1) == nghttp2_pq_size(&pq));
   }
   for(i = 10000; i > 0; --i) {
-    CU_ASSERT(NULL != nghttp2_pq_top(&pq));
+    top = (string_entry*)nghttp2_pq_top(&pq);
+    CU_ASSERT(NULL != top);
     nghttp2_pq_pop(&pq);
+    free(top);
     CU_ASSERT((size_t)(i-1) == nghttp2_pq_size(&pq));
   }
 
@@ -78,6 +110,7 @@ void test_nghttp2_pq(void)
 }
 
 typedef struct {
+  nghttp2_pq_entry ent;
   int key;
   int val;
 } node;
@@ -89,7 +122,7 @@ static int node_compar(const void *lhs, const void *rhs)
   return ln->key - rn->key;
 }
 
-static int node_update(void *item, void *arg)
+static int node_update(nghttp2_pq_entry *item, void *arg)
 {
   node *nd = (node*)item;
   if((nd->key % 2) == 0) {
@@ -108,22 +141,86 @@ void test_nghttp2_pq_update(void)
   node *nd;
   int ans[] = {-8, -6, -4, -2, 0, 1, 3, 5, 7, 9};
 
-  nghttp2_pq_init(&pq, node_compar);
+  nghttp2_pq_init(&pq, node_compar, nghttp2_mem_default());
 
   for(i = 0; i < sizeof(nodes)/sizeof(nodes[0]); ++i) {
     nodes[i].key = i;
     nodes[i].val = i;
-    nghttp2_pq_push(&pq, &nodes[i]);
+    nghttp2_pq_push(&pq, &nodes[i].ent);
   }
 
   nghttp2_pq_update(&pq, node_update, NULL);
 
   for(i = 0; i < sizeof(nodes)/sizeof(nodes[0]); ++i) {
-    nd = nghttp2_pq_top(&pq);
+    nd = (node*)nghttp2_pq_top(&pq);
+    CU_ASSERT(ans[i] == nd->key);
+    nghttp2_pq_pop(&pq);
+  }
+
+  nghttp2_pq_free(&pq);
+}
+
+void test_nghttp2_pq_update_entry(void)
+{
+  nghttp2_pq pq;
+  node nodes[10];
+  size_t i;
+  node *nd;
+  int ans[] = {-9, 1, 2, 3, 4, 5, 6, 7, 8, 100};
+
+  nghttp2_pq_init(&pq, node_compar, nghttp2_mem_default());
+
+  for(i = 0; i < sizeof(nodes)/sizeof(nodes[0]); ++i) {
+    nodes[i].key = i;
+    nodes[i].val = i;
+    nghttp2_pq_push(&pq, &nodes[i].ent);
+  }
+
+  /* Move the top to the bottom */
+  nodes[0].key = 100;
+  nghttp2_pq_update_entry(&pq, &nodes[0].ent);
+  /* Move the last one to the top */
+  nodes[9].key = -9;
+  nghttp2_pq_update_entry(&pq, &nodes[9].ent);
+
+  for(i = 0; i < sizeof(nodes)/sizeof(nodes[0]); ++i) {
+    nd = (node*)nghttp2_pq_top(&pq);
     CU_ASSERT(ans[i] == nd->key);
+    CU_ASSERT(0 == nd->ent.index);
     nghttp2_pq_pop(&pq);
   }
 
   nghttp2_pq_free(&pq);
 }
 
+void test_nghttp2_pq_remove(void)
+{
+  nghttp2_pq pq;
+  node nodes[10];
+  size_t i;
+  node *nd;
+  int ans[] = {1, 2, 4, 5, 6, 7, 8};
+
+  nghttp2_pq_init(&pq, node_compar, nghttp2_mem_default());
+
+  for(i = 0; i < sizeof(nodes)/sizeof(nodes[0]); ++i) {
+    nodes[i].key = i;
+    nodes[i].val = i;
+    nghttp2_pq_push(&pq, &nodes[i].ent);
+  }
+
+  /* Remove the top, an entry in the middle and the last one */
+  nghttp2_pq_remove(&pq, &nodes[0].ent);
+  nghttp2_pq_remove(&pq, &nodes[3].ent);
+  nghttp2_pq_remove(&pq, &nodes[9].ent);
+  CU_ASSERT(7 == nghttp2_pq_size(&pq));
+
+  for(i = 0; i < sizeof(ans)/sizeof(ans[0]); ++i) {
+    nd = (node*)nghttp2_pq_top(&pq);
+    CU_ASSERT(ans[i] == nd->key);
+    nghttp2_pq_pop(&pq);
+  }
+  CU_ASSERT(nghttp2_pq_empty(&pq));
+
+  nghttp2_pq_free(&pq);
+}
@@ -27,5 +27,7 @@
 
 void test_nghttp2_pq(void);
 void test_nghttp2_pq_update(void);
+void test_nghttp2_pq_update_entry(void);
+void test_nghttp2_pq_remove(void);
 
 #endif /* NGHTTP2_PQ_TEST_H */
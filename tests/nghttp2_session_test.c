@@ -67,8 +67,76 @@ typedef struct {
   size_t block_count;
   int data_chunk_recv_cb_called;
   int data_recv_cb_called;
+  size_t data_send_lens[16];
+  int32_t data_send_stream_ids[16];
+  size_t data_send_lenslen;
+  /* The header fields expected by on_frame_recv_check_nv_callback */
+  nghttp2_nv *nva;
+  size_t nvlen;
 } my_user_data;
 
+typedef struct {
+  size_t nalloc;
+  size_t nfree;
+} counting_mem_stat;
+
+/* Every allocation made through counting_mem is prefixed with a
+   header, so releasing it with plain free() is detected. */
+#define COUNTING_MEM_HDLEN 16
+
+static void* counting_malloc(size_t size, void *mem_user_data)
+{
+  counting_mem_stat *stat = (counting_mem_stat*)mem_user_data;
+  uint8_t *p = malloc(size + COUNTING_MEM_HDLEN);
+  if(p == NULL) {
+    return NULL;
+  }
+  ++stat->nalloc;
+  return p + COUNTING_MEM_HDLEN;
+}
+
+static void counting_free(void *ptr, void *mem_user_data)
+{
+  counting_mem_stat *stat = (counting_mem_stat*)mem_user_data;
+  if(ptr == NULL) {
+    return;
+  }
+  ++stat->nfree;
+  free((uint8_t*)ptr - COUNTING_MEM_HDLEN);
+}
+
+static void* counting_calloc(size_t nmemb, size_t size, void *mem_user_data)
+{
+  void *p = counting_malloc(nmemb * size, mem_user_data);
+  if(p) {
+    memset(p, 0, nmemb * size);
+  }
+  return p;
+}
+
+static void* counting_realloc(void *ptr, size_t size, void *mem_user_data)
+{
+  uint8_t *p;
+  if(ptr == NULL) {
+    return counting_malloc(size, mem_user_data);
+  }
+  p = realloc((uint8_t*)ptr - COUNTING_MEM_HDLEN, size + COUNTING_MEM_HDLEN);
+  if(p == NULL) {
+    return NULL;
+  }
+  return p + COUNTING_MEM_HDLEN;
+}
+
+typedef struct {
+  uint8_t buf[16384];
+  size_t length;
+  /* The maximum number of bytes sent in one callback call. 0 means
+     that the callback returns NGHTTP2_ERR_WOULDBLOCK. */
+  size_t sendmax;
+  size_t sendv_cb_called;
+  size_t data_source_length;
+} sendv_user_data;
+
 static void scripted_data_feed_init(scripted_data_feed *df,
                                     uint8_t *data, size_t data_length)
 {
@@ -135,6 +203,24 @@ static void on_frame_recv_callback(nghttp2_session *session,
   ++ud->frame_recv_cb_called;
 }
 
+static void on_frame_recv_check_nv_callback(nghttp2_session *session,
+                                            nghttp2_frame *frame,
+                                            void *user_data)
+{
+  my_user_data *ud = (my_user_data*)user_data;
+  size_t i;
+  if(frame->hd.type != NGHTTP2_HEADERS ||
+     frame->headers.nvlen != ud->nvlen) {
+    return;
+  }
+  for(i = 0; i < ud->nvlen; ++i) {
+    if(!nghttp2_nv_equal(&frame->headers.nva[i], &ud->nva[i])) {
+      return;
+    }
+  }
+  ++ud->frame_recv_cb_called;
+}
+
 static void on_invalid_frame_recv_callback(nghttp2_session *session,
                                            nghttp2_frame *frame,
                                            nghttp2_error_code error_code,
@@ -271,7 +357,7 @@ static void stream_close_callback(nghttp2_session *session, int32_t stream_id,
 static nghttp2_settings_entry* dup_iv(const nghttp2_settings_entry *iv,
                                       size_t niv)
 {
-  return nghttp2_frame_iv_copy(iv, niv);
+  return nghttp2_frame_iv_copy(iv, niv, nghttp2_mem_default());
 }
 
 static const char *empty_name_nv[] = { "Version", "HTTP/1.1",
@@ -310,7 +396,7 @@ void test_nghttp2_session_recv(void)
   user_data.df = &df;
   nghttp2_session_server_new(&session, &callbacks, &user_data);
 
-  nvlen = nghttp2_nv_array_from_cstr(&nva, nv);
+  nvlen = nghttp2_nv_array_from_cstr(&nva, nv, nghttp2_mem_default());
   nghttp2_frame_headers_init(&frame.headers, NGHTTP2_FLAG_END_HEADERS,
                              1, NGHTTP2_PRI_DEFAULT, nva, nvlen);
   framelen = nghttp2_frame_pack_headers(&framedata, &framedatalen,
@@ -323,7 +409,7 @@ void test_nghttp2_session_recv(void)
   for(i = 0; i < framelen; ++i) {
     df.feedseq[i] = 1;
   }
-  nghttp2_frame_headers_free(&frame.headers);
+  nghttp2_frame_headers_free(&frame.headers, nghttp2_mem_default());
 
   user_data.frame_recv_cb_called = 0;
   while((ssize_t)df.seqidx < framelen) {
@@ -332,7 +418,7 @@ void test_nghttp2_session_recv(void)
   CU_ASSERT(1 == user_data.frame_recv_cb_called);
 
   /* Received HEADERS without header block, which is valid */
-  nvlen = nghttp2_nv_array_from_cstr(&nva, empty_nv);
+  nvlen = nghttp2_nv_array_from_cstr(&nva, empty_nv, nghttp2_mem_default());
   nghttp2_frame_headers_init(&frame.headers, NGHTTP2_FLAG_END_HEADERS,
                              5, NGHTTP2_PRI_DEFAULT, nva, nvlen);
   framelen = nghttp2_frame_pack_headers(&framedata, &framedatalen,
@@ -340,7 +426,7 @@ void test_nghttp2_session_recv(void)
                                         &session->hd_deflater);
   nghttp2_hd_end_headers(&session->hd_deflater);
 
-  nghttp2_frame_headers_free(&frame.headers);
+  nghttp2_frame_headers_free(&frame.headers, nghttp2_mem_default());
 
   scripted_data_feed_init(&df, framedata, framelen);
   user_data.frame_recv_cb_called = 0;
@@ -354,8 +440,9 @@ void test_nghttp2_session_recv(void)
 
   /* Receive PING with too large payload */
   nghttp2_frame_ping_init(&frame.ping, NGHTTP2_FLAG_NONE, NULL);
-  nghttp2_reserve_buffer(&framedata, &framedatalen, 77);
-  framelen = nghttp2_frame_pack_ping(&framedata, &framedatalen, &frame.ping);
+  nghttp2_reserve_buffer(&framedata, &framedatalen, 77, nghttp2_mem_default());
+  framelen = nghttp2_frame_pack_ping(&framedata, &framedatalen, &frame.ping,
+                                     nghttp2_mem_default());
   nghttp2_frame_ping_free(&frame.ping);
 
   nghttp2_put_uint16be(&framedata[0],
@@ -393,7 +480,7 @@ void test_nghttp2_session_recv_invalid_stream_id(void)
   user_data.df = &df;
   user_data.invalid_frame_recv_cb_called = 0;
   nghttp2_session_server_new(&session, &callbacks, &user_data);
-  nvlen = nghttp2_nv_array_from_cstr(&nva, nv);
+  nvlen = nghttp2_nv_array_from_cstr(&nva, nv, nghttp2_mem_default());
   nghttp2_frame_headers_init(&frame.headers, NGHTTP2_FLAG_END_HEADERS, 2,
                              NGHTTP2_PRI_DEFAULT, nva, nvlen);
   framelen = nghttp2_frame_pack_headers(&framedata, &framedatalen,
@@ -402,7 +489,7 @@ void test_nghttp2_session_recv_invalid_stream_id(void)
   nghttp2_hd_end_headers(&session->hd_deflater);
 
   scripted_data_feed_init(&df, framedata, framelen);
-  nghttp2_frame_headers_free(&frame.headers);
+  nghttp2_frame_headers_free(&frame.headers, nghttp2_mem_default());
 
   CU_ASSERT(0 == nghttp2_session_recv(session));
   CU_ASSERT(1 == user_data.invalid_frame_recv_cb_called);
@@ -435,7 +522,7 @@ void test_nghttp2_session_recv_invalid_frame(void)
   user_data.df = &df;
   user_data.frame_send_cb_called = 0;
   nghttp2_session_server_new(&session, &callbacks, &user_data);
-  nvlen = nghttp2_nv_array_from_cstr(&nva, nv);
+  nvlen = nghttp2_nv_array_from_cstr(&nva, nv, nghttp2_mem_default());
   nghttp2_frame_headers_init(&frame.headers, NGHTTP2_FLAG_END_HEADERS, 1,
                              NGHTTP2_PRI_DEFAULT, nva, nvlen);
   framelen = nghttp2_frame_pack_headers(&framedata, &framedatalen,
@@ -458,7 +545,7 @@ void test_nghttp2_session_recv_invalid_frame(void)
   CU_ASSERT(0 == user_data.frame_send_cb_called);
 
   free(framedata);
-  nghttp2_frame_headers_free(&frame.headers);
+  nghttp2_frame_headers_free(&frame.headers, nghttp2_mem_default());
 
   nghttp2_session_del(session);
 }
@@ -595,7 +682,7 @@ void test_nghttp2_session_add_frame(void)
   CU_ASSERT(0 == nghttp2_session_client_new(&session, &callbacks, &user_data));
 
   frame = malloc(sizeof(nghttp2_frame));
-  nvlen = nghttp2_nv_array_from_cstr(&nva, nv);
+  nvlen = nghttp2_nv_array_from_cstr(&nva, nv, nghttp2_mem_default());
   nghttp2_frame_headers_init(&frame->headers,
                              NGHTTP2_FLAG_END_HEADERS | NGHTTP2_FLAG_PRIORITY,
                              -1, NGHTTP2_PRI_DEFAULT, nva, nvlen);
@@ -631,7 +718,7 @@ void test_nghttp2_session_on_request_headers_received(void)
   user_data.invalid_frame_recv_cb_called = 0;
 
   nghttp2_session_server_new(&session, &callbacks, &user_data);
-  nvlen = nghttp2_nv_array_from_cstr(&nva, nv);
+  nvlen = nghttp2_nv_array_from_cstr(&nva, nv, nghttp2_mem_default());
   nghttp2_frame_headers_init(&frame.headers,
                              NGHTTP2_FLAG_END_HEADERS | NGHTTP2_FLAG_PRIORITY,
                              stream_id, 1 << 20, nva, nvlen);
@@ -642,11 +729,11 @@ void test_nghttp2_session_on_request_headers_received(void)
   CU_ASSERT(NGHTTP2_STREAM_OPENING == stream->state);
   CU_ASSERT(1 << 20 == stream->pri);
 
-  nghttp2_frame_headers_free(&frame.headers);
+  nghttp2_frame_headers_free(&frame.headers, nghttp2_mem_default());
 
   /* More than max concurrent streams leads REFUSED_STREAM */
   session->local_settings[NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS] = 1;
-  nvlen = nghttp2_nv_array_from_cstr(&nva, nv);
+  nvlen = nghttp2_nv_array_from_cstr(&nva, nv, nghttp2_mem_default());
   nghttp2_frame_headers_init(&frame.headers, NGHTTP2_FLAG_END_HEADERS,
                              3, NGHTTP2_PRI_DEFAULT, nva, nvlen);
   user_data.invalid_frame_recv_cb_called = 0;
@@ -654,13 +741,13 @@ void test_nghttp2_session_on_request_headers_received(void)
   CU_ASSERT(1 == user_data.invalid_frame_recv_cb_called);
   CU_ASSERT(0 == (session->goaway_flags & NGHTTP2_GOAWAY_FAIL_ON_SEND));
 
-  nghttp2_frame_headers_free(&frame.headers);
+  nghttp2_frame_headers_free(&frame.headers, nghttp2_mem_default());
   session->local_settings[NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS] =
     NGHTTP2_INITIAL_MAX_CONCURRENT_STREAMS;
 
   /* Stream ID less than or equal to the previouly received SYN_STREAM
      leads to connection error */
-  nvlen = nghttp2_nv_array_from_cstr(&nva, nv);
+  nvlen = nghttp2_nv_array_from_cstr(&nva, nv, nghttp2_mem_default());
   nghttp2_frame_headers_init(&frame.headers, NGHTTP2_FLAG_END_HEADERS,
                              3, NGHTTP2_PRI_DEFAULT, nva, nvlen);
   user_data.invalid_frame_recv_cb_called = 0;
@@ -668,7 +755,7 @@ void test_nghttp2_session_on_request_headers_received(void)
   CU_ASSERT(1 == user_data.invalid_frame_recv_cb_called);
   CU_ASSERT(session->goaway_flags & NGHTTP2_GOAWAY_FAIL_ON_SEND);
 
-  nghttp2_frame_headers_free(&frame.headers);
+  nghttp2_frame_headers_free(&frame.headers, nghttp2_mem_default());
 
   nghttp2_session_del(session);
 }
@@ -694,7 +781,7 @@ void test_nghttp2_session_on_response_headers_received(void)
   stream = nghttp2_session_open_stream(session, 1, NGHTTP2_FLAG_NONE,
                                        NGHTTP2_PRI_DEFAULT,
                                        NGHTTP2_STREAM_OPENING, NULL);
-  nvlen = nghttp2_nv_array_from_cstr(&nva, nv);
+  nvlen = nghttp2_nv_array_from_cstr(&nva, nv, nghttp2_mem_default());
   nghttp2_frame_headers_init(&frame.headers, NGHTTP2_FLAG_END_HEADERS, 1,
                              NGHTTP2_PRI_DEFAULT, nva, nvlen);
 
@@ -703,7 +790,7 @@ void test_nghttp2_session_on_response_headers_received(void)
   CU_ASSERT(1 == user_data.frame_recv_cb_called);
   CU_ASSERT(NGHTTP2_STREAM_OPENED == stream->state);
 
-  nghttp2_frame_headers_free(&frame.headers);
+  nghttp2_frame_headers_free(&frame.headers, nghttp2_mem_default());
   nghttp2_session_del(session);
 }
 
@@ -729,7 +816,7 @@ void test_nghttp2_session_on_headers_received(void)
                                        NGHTTP2_PRI_DEFAULT,
                                        NGHTTP2_STREAM_OPENED, NULL);
   nghttp2_stream_shutdown(stream, NGHTTP2_SHUT_WR);
-  nvlen = nghttp2_nv_array_from_cstr(&nva, nv);
+  nvlen = nghttp2_nv_array_from_cstr(&nva, nv, nghttp2_mem_default());
   nghttp2_frame_headers_init(&frame.headers, NGHTTP2_FLAG_END_HEADERS, 1,
                              NGHTTP2_PRI_DEFAULT, nva, nvlen);
 
@@ -773,7 +860,7 @@ void test_nghttp2_session_on_headers_received(void)
   CU_ASSERT(0 == nghttp2_session_on_headers_received(session, &frame, stream));
   CU_ASSERT(1 == user_data.invalid_frame_recv_cb_called);
 
-  nghttp2_frame_headers_free(&frame.headers);
+  nghttp2_frame_headers_free(&frame.headers, nghttp2_mem_default());
 
   nghttp2_session_del(session);
 }
@@ -800,7 +887,7 @@ void test_nghttp2_session_on_push_response_headers_received(void)
   stream = nghttp2_session_open_stream(session, 2, NGHTTP2_FLAG_NONE,
                                        NGHTTP2_PRI_DEFAULT,
                                        NGHTTP2_STREAM_RESERVED, NULL);
-  nvlen = nghttp2_nv_array_from_cstr(&nva, nv);
+  nvlen = nghttp2_nv_array_from_cstr(&nva, nv, nghttp2_mem_default());
   nghttp2_frame_headers_init(&frame.headers, NGHTTP2_FLAG_END_HEADERS, 2,
                              NGHTTP2_PRI_DEFAULT, nva, nvlen);
   /* nghttp2_session_on_push_response_headers_received assumes
@@ -824,7 +911,7 @@ void test_nghttp2_session_on_push_response_headers_received(void)
   CU_ASSERT(NGHTTP2_RST_STREAM == OB_CTRL_TYPE(item));
   CU_ASSERT(NGHTTP2_REFUSED_STREAM == OB_CTRL(item)->rst_stream.error_code);
 
-  nghttp2_frame_headers_free(&frame.headers);
+  nghttp2_frame_headers_free(&frame.headers, nghttp2_mem_default());
   nghttp2_session_del(session);
 }
 
@@ -935,7 +1022,7 @@ void test_nghttp2_session_on_settings_received(void)
   CU_ASSERT(0 == stream2->remote_flow_control);
   CU_ASSERT(0 == session->remote_flow_control);
 
-  nghttp2_frame_settings_free(&frame.settings);
+  nghttp2_frame_settings_free(&frame.settings, nghttp2_mem_default());
 
   nghttp2_session_del(session);
 }
@@ -963,7 +1050,7 @@ void test_nghttp2_session_on_push_promise_received(void)
   stream = nghttp2_session_open_stream(session, 1, NGHTTP2_FLAG_NONE,
                                        NGHTTP2_PRI_DEFAULT,
                                        NGHTTP2_STREAM_OPENING, NULL);
-  nvlen = nghttp2_nv_array_from_cstr(&nva, nv);
+  nvlen = nghttp2_nv_array_from_cstr(&nva, nv, nghttp2_mem_default());
   nghttp2_frame_push_promise_init(&frame.push_promise,
                                   NGHTTP2_FLAG_END_PUSH_PROMISE, 1, 2,
                                   nva, nvlen);
@@ -1051,7 +1138,7 @@ void test_nghttp2_session_on_push_promise_received(void)
   CU_ASSERT(NULL == nghttp2_session_get_stream(session, 10));
   CU_ASSERT(NULL == nghttp2_session_get_next_ob_item(session));
 
-  nghttp2_frame_push_promise_free(&frame.push_promise);
+  nghttp2_frame_push_promise_free(&frame.push_promise, nghttp2_mem_default());
   nghttp2_session_del(session);
 }
 
@@ -1115,7 +1202,7 @@ void test_nghttp2_session_on_goaway_received(void)
   CU_ASSERT(1 == user_data.frame_recv_cb_called);
   CU_ASSERT(session->goaway_flags == NGHTTP2_GOAWAY_RECV);
 
-  nghttp2_frame_goaway_free(&frame.goaway);
+  nghttp2_frame_goaway_free(&frame.goaway, nghttp2_mem_default());
   nghttp2_session_del(session);
 }
 
@@ -1145,7 +1232,7 @@ void test_nghttp2_session_on_window_update_received(void)
   CU_ASSERT(1 == user_data.frame_recv_cb_called);
   CU_ASSERT(NGHTTP2_INITIAL_WINDOW_SIZE+16*1024 == stream->remote_window_size);
 
-  data_item = malloc(sizeof(nghttp2_outbound_item));
+  data_item = nghttp2_mempool_alloc(&session->item_pool);
   memset(data_item, 0, sizeof(nghttp2_outbound_item));
   data_item->frame_cat = NGHTTP2_CAT_DATA;
   nghttp2_stream_defer_data(stream, data_item, NGHTTP2_DEFERRED_FLOW_CONTROL);
@@ -1239,7 +1326,7 @@ void test_nghttp2_session_send_headers_start_stream(void)
   callbacks.send_callback = null_send_callback;
 
   nghttp2_session_client_new(&session, &callbacks, NULL);
-  nvlen = nghttp2_nv_array_from_cstr(&nva, nv);
+  nvlen = nghttp2_nv_array_from_cstr(&nva, nv, nghttp2_mem_default());
   nghttp2_frame_headers_init(&frame->headers, NGHTTP2_FLAG_END_HEADERS, -1,
                              NGHTTP2_PRI_DEFAULT, nva, nvlen);
   nghttp2_session_add_frame(session, NGHTTP2_CAT_CTRL, frame, aux_data);
@@ -1267,7 +1354,7 @@ void test_nghttp2_session_send_headers_reply(void)
   nghttp2_session_open_stream(session, 2, NGHTTP2_FLAG_NONE,
                               NGHTTP2_PRI_DEFAULT,
                               NGHTTP2_STREAM_OPENING, NULL);
-  nvlen = nghttp2_nv_array_from_cstr(&nva, nv);
+  nvlen = nghttp2_nv_array_from_cstr(&nva, nv, nghttp2_mem_default());
   nghttp2_frame_headers_init(&frame->headers, NGHTTP2_FLAG_END_HEADERS, 2,
                              NGHTTP2_PRI_DEFAULT, nva, nvlen);
   nghttp2_session_add_frame(session, NGHTTP2_CAT_CTRL, frame, NULL);
@@ -1303,7 +1390,8 @@ void test_nghttp2_session_send_headers_header_comp_error(void)
   callbacks.send_callback = null_send_callback;
 
   nghttp2_session_client_new(&session, &callbacks, NULL);
-  nvlen = nghttp2_nv_array_from_cstr(&nva, (const char**)nv);
+  nvlen = nghttp2_nv_array_from_cstr(&nva, (const char**)nv,
+                                     nghttp2_mem_default());
 
   nghttp2_frame_headers_init(&frame->headers, NGHTTP2_FLAG_END_HEADERS, -1,
                              NGHTTP2_PRI_DEFAULT, nva, nvlen);
@@ -1337,7 +1425,7 @@ void test_nghttp2_session_send_headers_push_reply(void)
   nghttp2_session_open_stream(session, 2, NGHTTP2_FLAG_NONE,
                               NGHTTP2_PRI_DEFAULT,
                               NGHTTP2_STREAM_RESERVED, NULL);
-  nvlen = nghttp2_nv_array_from_cstr(&nva, nv);
+  nvlen = nghttp2_nv_array_from_cstr(&nva, nv, nghttp2_mem_default());
   nghttp2_frame_headers_init(&frame->headers, NGHTTP2_FLAG_END_HEADERS, 2,
                              NGHTTP2_PRI_DEFAULT, nva, nvlen);
   nghttp2_session_add_frame(session, NGHTTP2_CAT_CTRL, frame, NULL);
@@ -1388,7 +1476,7 @@ void test_nghttp2_session_send_push_promise(void)
   nghttp2_session_open_stream(session, 1, NGHTTP2_FLAG_NONE,
                               NGHTTP2_PRI_DEFAULT, NGHTTP2_STREAM_OPENING,
                               NULL);
-  nvlen = nghttp2_nv_array_from_cstr(&nva, nv);
+  nvlen = nghttp2_nv_array_from_cstr(&nva, nv, nghttp2_mem_default());
   nghttp2_frame_push_promise_init(&frame->push_promise,
                                   NGHTTP2_FLAG_END_PUSH_PROMISE, 1, -1,
                                   nva, nvlen);
@@ -1405,7 +1493,7 @@ void test_nghttp2_session_send_push_promise(void)
   nghttp2_session_open_stream(session, 1, NGHTTP2_FLAG_NONE,
                               NGHTTP2_PRI_DEFAULT, NGHTTP2_STREAM_OPENING,
                               NULL);
-  nvlen = nghttp2_nv_array_from_cstr(&nva, nv);
+  nvlen = nghttp2_nv_array_from_cstr(&nva, nv, nghttp2_mem_default());
   frame = malloc(sizeof(nghttp2_frame));
   nghttp2_frame_push_promise_init(&frame->push_promise,
                                   NGHTTP2_FLAG_END_PUSH_PROMISE, 1, -1,
@@ -1631,7 +1719,6 @@ void test_nghttp2_submit_response_without_data(void)
                                             &session->hd_inflater,
                                             acc.buf, acc.length));
   CU_ASSERT(nvnameeq(":version", &frame.headers.nva[0]));
-  nghttp2_frame_headers_free(&frame.headers);
 
   nghttp2_session_del(session);
 }
@@ -1688,7 +1775,133 @@ void test_nghttp2_submit_request_without_data(void)
                                             &session->hd_inflater,
                                             acc.buf, acc.length));
   CU_ASSERT(nvnameeq(":version", &frame.headers.nva[0]));
-  nghttp2_frame_headers_free(&frame.headers);
+
+  nghttp2_session_del(session);
+}
+
+void test_nghttp2_submit_request2(void)
+{
+  nghttp2_session *session;
+  nghttp2_session_callbacks callbacks;
+  uint8_t path[] = "/alpha";
+  nghttp2_nv nva[] = {
+    { (uint8_t*)":Version", (uint8_t*)"HTTP/1.1", 8, 8,
+      NGHTTP2_NV_FLAG_NONE },
+    { (uint8_t*)":path", path, 5, 6,
+      NGHTTP2_NV_FLAG_NO_COPY | NGHTTP2_NV_FLAG_LOWERCASE }
+  };
+  nghttp2_nv badnva[] = {
+    { (uint8_t*)"", (uint8_t*)"empty", 0, 5, NGHTTP2_NV_FLAG_NONE }
+  };
+  nghttp2_data_provider data_prd;
+  my_user_data ud;
+  nghttp2_outbound_item *item;
+
+  memset(&callbacks, 0, sizeof(nghttp2_session_callbacks));
+  callbacks.send_callback = null_send_callback;
+
+  data_prd.read_callback = fixed_length_data_source_read_callback;
+  ud.data_source_length = 64*1024 - 1;
+  CU_ASSERT(0 == nghttp2_session_client_new(&session, &callbacks, &ud));
+  CU_ASSERT(NGHTTP2_ERR_INVALID_ARGUMENT ==
+            nghttp2_submit_request2(session, NGHTTP2_PRI_DEFAULT, badnva, 1,
+                                    &data_prd, NULL));
+  CU_ASSERT(0 == nghttp2_submit_request2(session, NGHTTP2_PRI_DEFAULT,
+                                         nva, 2, &data_prd, NULL));
+  item = nghttp2_session_get_next_ob_item(session);
+  CU_ASSERT(2 == OB_CTRL(item)->headers.nvlen);
+  CU_ASSERT(nvnameeq(":path", &OB_CTRL(item)->headers.nva[0]));
+  CU_ASSERT(path == OB_CTRL(item)->headers.nva[0].value);
+  CU_ASSERT(nvnameeq(":version", &OB_CTRL(item)->headers.nva[1]));
+  CU_ASSERT(0 == (OB_CTRL(item)->hd.flags & NGHTTP2_FLAG_END_STREAM));
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  CU_ASSERT(0 == ud.data_source_length);
+
+  nghttp2_session_del(session);
+}
+
+void test_nghttp2_submit_request_async(void)
+{
+  nghttp2_session *session;
+  nghttp2_session_callbacks callbacks;
+  nghttp2_nv nva[] = {
+    { (uint8_t*)":path", (uint8_t*)"/", 5, 1, NGHTTP2_NV_FLAG_NONE }
+  };
+  nghttp2_nv badnva[] = {
+    { (uint8_t*)"", (uint8_t*)"empty", 0, 5, NGHTTP2_NV_FLAG_NONE }
+  };
+  nghttp2_data_provider data_prd;
+  my_user_data ud;
+  const uint8_t *data;
+
+  memset(&callbacks, 0, sizeof(nghttp2_session_callbacks));
+  callbacks.send_callback = null_send_callback;
+  callbacks.on_frame_send_callback = on_frame_send_callback;
+
+  data_prd.read_callback = fixed_length_data_source_read_callback;
+  ud.data_source_length = 1024;
+  ud.frame_send_cb_called = 0;
+  CU_ASSERT(0 == nghttp2_session_client_new(&session, &callbacks, &ud));
+  CU_ASSERT(NGHTTP2_ERR_INVALID_ARGUMENT ==
+            nghttp2_submit_request_async(session, -1, nva, 1, NULL, NULL));
+  CU_ASSERT(NGHTTP2_ERR_INVALID_ARGUMENT ==
+            nghttp2_submit_request_async(session, NGHTTP2_PRI_DEFAULT,
+                                         badnva, 1, NULL, NULL));
+  CU_ASSERT(0 == nghttp2_session_want_write(session));
+
+  CU_ASSERT(0 == nghttp2_submit_request_async(session, NGHTTP2_PRI_DEFAULT,
+                                              nva, 1, &data_prd, &ud));
+  CU_ASSERT(0 == nghttp2_submit_request_async(session, NGHTTP2_PRI_DEFAULT,
+                                              nva, 1, NULL, NULL));
+  /* Queued, but not submitted until nghttp2_session_send() */
+  CU_ASSERT(nghttp2_session_want_write(session));
+  CU_ASSERT(0 == nghttp2_session_get_outbound_queue_size(session));
+
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  CU_ASSERT(2 == ud.frame_send_cb_called);
+  CU_ASSERT(0 == ud.data_source_length);
+  CU_ASSERT(&ud == nghttp2_session_get_stream_user_data(session, 1));
+  CU_ASSERT(NULL != nghttp2_session_get_stream(session, 3));
+  CU_ASSERT(0 == nghttp2_session_want_write(session));
+
+  /* nghttp2_session_mem_send() submits them too */
+  CU_ASSERT(0 == nghttp2_submit_request_async(session, NGHTTP2_PRI_DEFAULT,
+                                              nva, 1, NULL, NULL));
+  CU_ASSERT(0 < nghttp2_session_mem_send(session, &data));
+  CU_ASSERT(NGHTTP2_HEADERS == data[2]);
+  CU_ASSERT(0 == nghttp2_session_mem_send(session, &data));
+  CU_ASSERT(NULL != nghttp2_session_get_stream(session, 5));
+  CU_ASSERT(0 == nghttp2_session_want_write(session));
+
+  /* The queued requests are freed with the session */
+  CU_ASSERT(0 == nghttp2_submit_request_async(session, NGHTTP2_PRI_DEFAULT,
+                                              nva, 1, NULL, NULL));
+  nghttp2_session_del(session);
+}
+
+void test_nghttp2_submit_response2(void)
+{
+  nghttp2_session *session;
+  nghttp2_session_callbacks callbacks;
+  nghttp2_nv nva[] = {
+    { (uint8_t*)":status", (uint8_t*)"200", 7, 3,
+      NGHTTP2_NV_FLAG_NO_COPY | NGHTTP2_NV_FLAG_LOWERCASE }
+  };
+  my_user_data ud;
+  nghttp2_outbound_item *item;
+
+  memset(&callbacks, 0, sizeof(nghttp2_session_callbacks));
+  callbacks.send_callback = null_send_callback;
+
+  CU_ASSERT(0 == nghttp2_session_server_new(&session, &callbacks, &ud));
+  nghttp2_session_open_stream(session, 1, NGHTTP2_FLAG_NONE,
+                              NGHTTP2_PRI_DEFAULT,
+                              NGHTTP2_STREAM_OPENING, NULL);
+  CU_ASSERT(0 == nghttp2_submit_response2(session, 1, nva, 1, NULL));
+  item = nghttp2_session_get_next_ob_item(session);
+  CU_ASSERT(nva[0].name == OB_CTRL(item)->headers.nva[0].name);
+  CU_ASSERT(OB_CTRL(item)->hd.flags & NGHTTP2_FLAG_END_STREAM);
+  CU_ASSERT(0 == nghttp2_session_send(session));
 
   nghttp2_session_del(session);
 }
@@ -1865,7 +2078,6 @@ void test_nghttp2_submit_headers(void)
                                             &session->hd_inflater,
                                             acc.buf, acc.length));
   CU_ASSERT(nvnameeq(":version", &frame.headers.nva[0]));
-  nghttp2_frame_headers_free(&frame.headers);
 
   nghttp2_session_del(session);
 }
@@ -2361,13 +2573,11 @@ void test_nghttp2_session_pop_next_ob_item(void)
 
   item = nghttp2_session_pop_next_ob_item(session);
   CU_ASSERT(NGHTTP2_PING == OB_CTRL_TYPE(item));
-  nghttp2_outbound_item_free(item);
-  free(item);
+  nghttp2_session_free_outbound_item(session, item);
 
   item = nghttp2_session_pop_next_ob_item(session);
   CU_ASSERT(NGHTTP2_HEADERS == OB_CTRL_TYPE(item));
-  nghttp2_outbound_item_free(item);
-  free(item);
+  nghttp2_session_free_outbound_item(session, item);
 
   CU_ASSERT(NULL == nghttp2_session_pop_next_ob_item(session));
 
@@ -2385,8 +2595,7 @@ void test_nghttp2_session_pop_next_ob_item(void)
   item = nghttp2_session_pop_next_ob_item(session);
   CU_ASSERT(NGHTTP2_HEADERS == OB_CTRL_TYPE(item));
   CU_ASSERT(1 == OB_CTRL(item)->hd.stream_id);
-  nghttp2_outbound_item_free(item);
-  free(item);
+  nghttp2_session_free_outbound_item(session, item);
 
   CU_ASSERT(NULL == nghttp2_session_pop_next_ob_item(session));
 
@@ -2394,8 +2603,7 @@ void test_nghttp2_session_pop_next_ob_item(void)
 
   item = nghttp2_session_pop_next_ob_item(session);
   CU_ASSERT(NGHTTP2_HEADERS == OB_CTRL_TYPE(item));
-  nghttp2_outbound_item_free(item);
-  free(item);
+  nghttp2_session_free_outbound_item(session, item);
 
   nghttp2_session_del(session);
 
@@ -2449,7 +2657,7 @@ void test_nghttp2_session_max_concurrent_streams(void)
   nghttp2_session_open_stream(session, 1, NGHTTP2_FLAG_NONE,
                               NGHTTP2_PRI_DEFAULT,
                               NGHTTP2_STREAM_OPENED, NULL);
-  nvlen = nghttp2_nv_array_from_cstr(&nva, nv);
+  nvlen = nghttp2_nv_array_from_cstr(&nva, nv, nghttp2_mem_default());
   nghttp2_frame_headers_init(&frame.headers, NGHTTP2_FLAG_NONE, 3,
                              NGHTTP2_PRI_DEFAULT, nva, nvlen);
   session->local_settings[NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS] = 1;
@@ -2460,7 +2668,7 @@ void test_nghttp2_session_max_concurrent_streams(void)
   CU_ASSERT(NGHTTP2_RST_STREAM == OB_CTRL_TYPE(item));
   CU_ASSERT(NGHTTP2_REFUSED_STREAM == OB_CTRL(item)->rst_stream.error_code)
 
-  nghttp2_frame_headers_free(&frame.headers);
+  nghttp2_frame_headers_free(&frame.headers, nghttp2_mem_default());
   nghttp2_session_del(session);
 }
 
@@ -2610,6 +2818,44 @@ void test_nghttp2_session_defer_data(void)
   nghttp2_session_del(session);
 }
 
+void test_nghttp2_session_resume_data_async(void)
+{
+  nghttp2_session *session;
+  nghttp2_session_callbacks callbacks;
+  const char *nv[] = { NULL };
+  my_user_data ud;
+  nghttp2_data_provider data_prd;
+  nghttp2_stream *stream;
+
+  memset(&callbacks, 0, sizeof(nghttp2_session_callbacks));
+  callbacks.send_callback = null_send_callback;
+  data_prd.read_callback = defer_data_source_read_callback;
+
+  ud.data_source_length = 16*1024;
+
+  nghttp2_session_server_new(&session, &callbacks, &ud);
+  stream = nghttp2_session_open_stream(session, 1, NGHTTP2_FLAG_NONE,
+                                       NGHTTP2_PRI_DEFAULT,
+                                       NGHTTP2_STREAM_OPENING, NULL);
+  nghttp2_submit_response(session, 1, nv, &data_prd);
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  CU_ASSERT(NULL != stream->deferred_data);
+
+  CU_ASSERT(0 == nghttp2_session_resume_data_async(session, 1));
+  /* The stream does not exist. This is ignored when it is drained. */
+  CU_ASSERT(0 == nghttp2_session_resume_data_async(session, 3));
+  CU_ASSERT(nghttp2_session_want_write(session));
+  CU_ASSERT(NULL != stream->deferred_data);
+
+  OB_DATA(stream->deferred_data)->data_prd.read_callback =
+    fixed_length_data_source_read_callback;
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  CU_ASSERT(0 == ud.data_source_length);
+  CU_ASSERT(0 == nghttp2_session_want_write(session));
+
+  nghttp2_session_del(session);
+}
+
 void test_nghttp2_session_flow_control(void)
 {
   nghttp2_session *session;
@@ -2701,7 +2947,7 @@ void test_nghttp2_session_flow_control(void)
 
   nghttp2_frame_settings_init(&settings_frame.settings, dup_iv(iv, 1), 1);
   nghttp2_session_on_settings_received(session, &settings_frame);
-  nghttp2_frame_settings_free(&settings_frame.settings);
+  nghttp2_frame_settings_free(&settings_frame.settings, nghttp2_mem_default());
 
   /* Sends another 8KiB data */
   CU_ASSERT(0 == nghttp2_session_send(session));
@@ -2938,7 +3184,7 @@ void test_nghttp2_session_on_request_recv_callback(void)
   user_data.stream_id = 0;
 
   nghttp2_session_server_new(&session, &callbacks, &user_data);
-  nvlen = nghttp2_nv_array_from_cstr(&nva, nv);
+  nvlen = nghttp2_nv_array_from_cstr(&nva, nv, nghttp2_mem_default());
   nghttp2_frame_headers_init(&frame.headers, NGHTTP2_FLAG_END_HEADERS,
                              1, NGHTTP2_PRI_DEFAULT, nva, nvlen);
   CU_ASSERT(0 == nghttp2_session_on_request_headers_received(session, &frame));
@@ -2950,14 +3196,14 @@ void test_nghttp2_session_on_request_recv_callback(void)
   CU_ASSERT(0 == nghttp2_session_on_request_headers_received(session, &frame));
   CU_ASSERT(3 == user_data.stream_id);
 
-  nghttp2_frame_headers_free(&frame.headers);
+  nghttp2_frame_headers_free(&frame.headers, nghttp2_mem_default());
 
   user_data.stream_id = 0;
 
   stream = nghttp2_session_open_stream(session, 5, NGHTTP2_FLAG_NONE,
                               NGHTTP2_PRI_DEFAULT,
                               NGHTTP2_STREAM_OPENING, NULL);
-  nvlen = nghttp2_nv_array_from_cstr(&nva, nv);
+  nvlen = nghttp2_nv_array_from_cstr(&nva, nv, nghttp2_mem_default());
   nghttp2_frame_headers_init(&frame.headers, NGHTTP2_FLAG_END_HEADERS,
                              5, NGHTTP2_PRI_DEFAULT, nva, nvlen);
 
@@ -2969,7 +3215,7 @@ void test_nghttp2_session_on_request_recv_callback(void)
   CU_ASSERT(0 == nghttp2_session_on_headers_received(session, &frame, stream));
   CU_ASSERT(5 == user_data.stream_id);
 
-  nghttp2_frame_headers_free(&frame.headers);
+  nghttp2_frame_headers_free(&frame.headers, nghttp2_mem_default());
   nghttp2_session_del(session);
 }
 
@@ -3118,6 +3364,7 @@ void test_nghttp2_session_set_option(void)
   nghttp2_session_callbacks callbacks;
   int intval;
   char charval;
+  size_t sizeval;
   memset(&callbacks, 0, sizeof(nghttp2_session_callbacks));
   nghttp2_session_client_new(&session, &callbacks, NULL);
 
@@ -3158,6 +3405,66 @@ void test_nghttp2_session_set_option(void)
   CU_ASSERT(session->opt_flags &
             NGHTTP2_OPTMASK_NO_AUTO_CONNECTION_WINDOW_UPDATE);
 
+  sizeval = 16384;
+  CU_ASSERT(0 ==
+            nghttp2_session_set_option
+            (session, NGHTTP2_OPT_MAX_DATA_PAYLOAD_LENGTH,
+             &sizeval, sizeof(sizeval)));
+  CU_ASSERT(16384 == session->max_data_payloadlen);
+
+  sizeval = 0;
+  CU_ASSERT(NGHTTP2_ERR_INVALID_ARGUMENT ==
+            nghttp2_session_set_option
+            (session, NGHTTP2_OPT_MAX_DATA_PAYLOAD_LENGTH,
+             &sizeval, sizeof(sizeval)));
+
+  sizeval = 1024;
+  CU_ASSERT(0 ==
+            nghttp2_session_set_option
+            (session, NGHTTP2_OPT_HD_TABLE_SIZE, &sizeval, sizeof(sizeval)));
+  CU_ASSERT(1024 == session->hd_deflater.deflate_table_size);
+
+  sizeval = NGHTTP2_HD_TABLE_SIZE + 1;
+  CU_ASSERT(NGHTTP2_ERR_INVALID_ARGUMENT ==
+            nghttp2_session_set_option
+            (session, NGHTTP2_OPT_HD_TABLE_SIZE, &sizeval, sizeof(sizeval)));
+
+  sizeval = 16;
+  CU_ASSERT(0 ==
+            nghttp2_session_set_option
+            (session, NGHTTP2_OPT_MAX_HEADER_FIELDS,
+             &sizeval, sizeof(sizeval)));
+  CU_ASSERT(16 == session->hd_deflater.ws_capacity);
+  CU_ASSERT(16 == session->hd_inflater.ws_capacity);
+
+  sizeval = 0;
+  CU_ASSERT(NGHTTP2_ERR_INVALID_ARGUMENT ==
+            nghttp2_session_set_option
+            (session, NGHTTP2_OPT_MAX_HEADER_FIELDS,
+             &sizeval, sizeof(sizeval)));
+
+  sizeval = NGHTTP2_MAX_FRAME_LENGTH + 1;
+  CU_ASSERT(NGHTTP2_ERR_INVALID_ARGUMENT ==
+            nghttp2_session_set_option
+            (session, NGHTTP2_OPT_MAX_DATA_PAYLOAD_LENGTH,
+             &sizeval, sizeof(sizeval)));
+  CU_ASSERT(16384 == session->max_data_payloadlen);
+
+  intval = 1;
+  CU_ASSERT(0 ==
+            nghttp2_session_set_option(session, NGHTTP2_OPT_HD_HUFFMAN,
+                                       &intval, sizeof(intval)));
+  CU_ASSERT(1 == session->hd_deflater.huffman);
+  CU_ASSERT(1 == session->hd_inflater.huffman);
+
+  /* Cannot be changed once a header block is processed */
+  session->hd_deflater.block_bytes = 1;
+  intval = 0;
+  CU_ASSERT(NGHTTP2_ERR_INVALID_ARGUMENT ==
+            nghttp2_session_set_option(session, NGHTTP2_OPT_HD_HUFFMAN,
+                                       &intval, sizeof(intval)));
+  CU_ASSERT(1 == session->hd_deflater.huffman);
+
   nghttp2_session_del(session);
 }
 
@@ -3222,7 +3529,8 @@ void test_nghttp2_pack_settings_payload(void)
   len = nghttp2_pack_settings_payload(buf, iv, 2);
   CU_ASSERT(16 == len);
   CU_ASSERT(0 == nghttp2_frame_unpack_settings_payload(&resiv, &resniv,
-                                                       buf, len));
+                                                       buf, len,
+                                                       nghttp2_mem_default()));
   CU_ASSERT(2 == resniv);
   CU_ASSERT(NGHTTP2_SETTINGS_INITIAL_WINDOW_SIZE == resiv[0].settings_id);
   CU_ASSERT(4095 == resiv[0].value);
@@ -3231,3 +3539,1345 @@ void test_nghttp2_pack_settings_payload(void)
 
   free(resiv);
 }
+
+void test_nghttp2_session_custom_allocator(void)
+{
+  nghttp2_session *session;
+  nghttp2_session_callbacks callbacks;
+  const char *nv[] = { ":path", "/", NULL };
+  my_user_data ud;
+  nghttp2_data_provider data_prd;
+  counting_mem_stat stat = { 0, 0 };
+  nghttp2_mem mem = { &stat, counting_malloc, counting_free, counting_calloc,
+                      counting_realloc };
+  int i;
+
+  memset(&callbacks, 0, sizeof(nghttp2_session_callbacks));
+  callbacks.send_callback = null_send_callback;
+  data_prd.read_callback = fixed_length_data_source_read_callback;
+  ud.data_source_length = 16*1024;
+
+  CU_ASSERT(0 == nghttp2_session_client_new2(&session, &callbacks, &ud,
+                                             &mem));
+  /* The session keeps its own copy of the allocator */
+  memset(&mem, 0, sizeof(mem));
+  CU_ASSERT(stat.nalloc > 0);
+
+  /* Open more streams than one pool block holds */
+  for(i = 0; i < NGHTTP2_SESSION_POOL_BLOCK_NOBJ + 8; ++i) {
+    CU_ASSERT(0 == nghttp2_submit_request(session, NGHTTP2_PRI_DEFAULT, nv,
+                                          i == 0 ? &data_prd : NULL, NULL));
+  }
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  CU_ASSERT(0 == ud.data_source_length);
+  CU_ASSERT(NGHTTP2_SESSION_POOL_BLOCK_NOBJ + 8 ==
+            nghttp2_map_size(&session->streams));
+
+  CU_ASSERT(0 == nghttp2_submit_ping(session, NULL));
+  CU_ASSERT(0 == nghttp2_submit_goaway(session, NGHTTP2_NO_ERROR,
+                                       (uint8_t*)"debug", 5));
+  CU_ASSERT(0 == nghttp2_session_send(session));
+
+  nghttp2_session_del(session);
+
+  CU_ASSERT(stat.nalloc == stat.nfree);
+}
+
+static ssize_t sendv_accumulator_send_callback
+(nghttp2_session *session, const uint8_t *data, size_t len, int flags,
+ void *user_data)
+{
+  sendv_user_data *ud = (sendv_user_data*)user_data;
+  assert(ud->length+len <= sizeof(ud->buf));
+  memcpy(ud->buf+ud->length, data, len);
+  ud->length += len;
+  return len;
+}
+
+static ssize_t sendv_accumulator_sendv_callback
+(nghttp2_session *session, const nghttp2_vec *iov, size_t iovcnt, int flags,
+ void *user_data)
+{
+  sendv_user_data *ud = (sendv_user_data*)user_data;
+  size_t i, len, sentlen = 0;
+  ++ud->sendv_cb_called;
+  if(ud->sendmax == 0) {
+    return NGHTTP2_ERR_WOULDBLOCK;
+  }
+  for(i = 0; i < iovcnt && sentlen < ud->sendmax; ++i) {
+    len = nghttp2_min(iov[i].len, ud->sendmax - sentlen);
+    assert(ud->length+len <= sizeof(ud->buf));
+    memcpy(ud->buf+ud->length, iov[i].base, len);
+    ud->length += len;
+    sentlen += len;
+  }
+  return sentlen;
+}
+
+static ssize_t sendv_data_source_read_callback
+(nghttp2_session *session, int32_t stream_id,
+ uint8_t *buf, size_t len, int *eof,
+ nghttp2_data_source *source, void *user_data)
+{
+  sendv_user_data *ud = (sendv_user_data*)user_data;
+  size_t wlen = nghttp2_min(len, ud->data_source_length);
+  memset(buf, 'a' + ud->data_source_length % 26, wlen);
+  ud->data_source_length -= wlen;
+  if(ud->data_source_length == 0) {
+    *eof = 1;
+  }
+  return wlen;
+}
+
+static void sendv_submit(nghttp2_session *session)
+{
+  const char *nv[] = { ":path", "/", NULL };
+  nghttp2_data_provider data_prd;
+  data_prd.read_callback = sendv_data_source_read_callback;
+  nghttp2_submit_request(session, NGHTTP2_PRI_DEFAULT, nv, &data_prd, NULL);
+  nghttp2_submit_ping(session, NULL);
+}
+
+void test_nghttp2_session_sendv(void)
+{
+  nghttp2_session *session;
+  nghttp2_session_callbacks callbacks;
+  sendv_user_data ref, ud;
+  size_t sendv_max_bytes;
+
+  /* The bytes sent by send_callback are the reference */
+  memset(&callbacks, 0, sizeof(nghttp2_session_callbacks));
+  callbacks.send_callback = sendv_accumulator_send_callback;
+  memset(&ref, 0, sizeof(ref));
+  ref.data_source_length = 10000;
+  nghttp2_session_client_new(&session, &callbacks, &ref);
+  sendv_submit(session);
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  nghttp2_session_del(session);
+
+  /* HEADERS, PING and 3 DATA frames go in one call */
+  callbacks.send_callback = NULL;
+  callbacks.sendv_callback = sendv_accumulator_sendv_callback;
+  memset(&ud, 0, sizeof(ud));
+  ud.sendmax = sizeof(ud.buf);
+  ud.data_source_length = 10000;
+  nghttp2_session_client_new(&session, &callbacks, &ud);
+  sendv_submit(session);
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  CU_ASSERT(1 == ud.sendv_cb_called);
+  CU_ASSERT(ref.length == ud.length);
+  CU_ASSERT(0 == memcmp(ref.buf, ud.buf, ref.length));
+  CU_ASSERT(0 == nghttp2_session_want_write(session));
+  nghttp2_session_del(session);
+
+  /* Partial writes */
+  memset(&ud, 0, sizeof(ud));
+  ud.sendmax = 1000;
+  ud.data_source_length = 10000;
+  nghttp2_session_client_new(&session, &callbacks, &ud);
+  sendv_submit(session);
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  CU_ASSERT((ref.length+999)/1000 == ud.sendv_cb_called);
+  CU_ASSERT(ref.length == ud.length);
+  CU_ASSERT(0 == memcmp(ref.buf, ud.buf, ref.length));
+  nghttp2_session_del(session);
+
+  /* The byte budget limits the number of frames in one call */
+  memset(&ud, 0, sizeof(ud));
+  ud.sendmax = sizeof(ud.buf);
+  ud.data_source_length = 10000;
+  nghttp2_session_client_new(&session, &callbacks, &ud);
+  sendv_max_bytes = 0;
+  CU_ASSERT(NGHTTP2_ERR_INVALID_ARGUMENT ==
+            nghttp2_session_set_option(session, NGHTTP2_OPT_SENDV_MAX_BYTES,
+                                       &sendv_max_bytes,
+                                       sizeof(sendv_max_bytes)));
+  sendv_max_bytes = 1;
+  CU_ASSERT(0 == nghttp2_session_set_option(session,
+                                            NGHTTP2_OPT_SENDV_MAX_BYTES,
+                                            &sendv_max_bytes,
+                                            sizeof(sendv_max_bytes)));
+  sendv_submit(session);
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  CU_ASSERT(5 == ud.sendv_cb_called);
+  CU_ASSERT(ref.length == ud.length);
+  CU_ASSERT(0 == memcmp(ref.buf, ud.buf, ref.length));
+  nghttp2_session_del(session);
+
+  /* Packed frames are kept until the callback accepts them */
+  memset(&ud, 0, sizeof(ud));
+  ud.sendmax = 0;
+  ud.data_source_length = 10000;
+  nghttp2_session_client_new(&session, &callbacks, &ud);
+  sendv_submit(session);
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  CU_ASSERT(0 == ud.length);
+  CU_ASSERT(0 == nghttp2_session_get_outbound_queue_size(session));
+  CU_ASSERT(nghttp2_session_want_write(session));
+  ud.sendmax = sizeof(ud.buf);
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  CU_ASSERT(ref.length == ud.length);
+  CU_ASSERT(0 == memcmp(ref.buf, ud.buf, ref.length));
+  CU_ASSERT(0 == nghttp2_session_want_write(session));
+  nghttp2_session_del(session);
+
+  /* GOAWAY which fails the session is written before the
+     application drops the connection */
+  memset(&ud, 0, sizeof(ud));
+  ud.sendmax = 0;
+  nghttp2_session_client_new(&session, &callbacks, &ud);
+  CU_ASSERT(0 == nghttp2_session_fail_session(session,
+                                              NGHTTP2_PROTOCOL_ERROR));
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  CU_ASSERT(0 == ud.length);
+  CU_ASSERT(nghttp2_session_want_write(session));
+  CU_ASSERT(0 == nghttp2_session_want_read(session));
+  ud.sendmax = sizeof(ud.buf);
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  CU_ASSERT(NGHTTP2_FRAME_HEAD_LENGTH + 8 == ud.length);
+  CU_ASSERT(NGHTTP2_GOAWAY == ud.buf[2]);
+  CU_ASSERT(0 == nghttp2_session_want_write(session));
+  nghttp2_session_del(session);
+}
+
+static ssize_t copy_data_source_read_callback
+(nghttp2_session *session, int32_t stream_id,
+ uint8_t *buf, size_t len, int *data_flags,
+ nghttp2_data_source *source, void *user_data)
+{
+  sendv_user_data *ud = (sendv_user_data*)user_data;
+  size_t wlen = nghttp2_min(len, ud->data_source_length);
+  memset(buf, 'a', wlen);
+  ud->data_source_length -= wlen;
+  if(ud->data_source_length == 0) {
+    *data_flags |= NGHTTP2_DATA_FLAG_EOF;
+  }
+  return wlen;
+}
+
+static ssize_t no_copy_data_source_read_callback
+(nghttp2_session *session, int32_t stream_id,
+ uint8_t *buf, size_t len, int *data_flags,
+ nghttp2_data_source *source, void *user_data)
+{
+  sendv_user_data *ud = (sendv_user_data*)user_data;
+  size_t wlen = nghttp2_min(len, ud->data_source_length);
+  ud->data_source_length -= wlen;
+  *data_flags |= NGHTTP2_DATA_FLAG_NO_COPY;
+  if(ud->data_source_length == 0) {
+    *data_flags |= NGHTTP2_DATA_FLAG_EOF;
+  }
+  return wlen;
+}
+
+static int accumulator_send_data_callback
+(nghttp2_session *session, int32_t stream_id,
+ const uint8_t *framehd, size_t length,
+ nghttp2_data_source *source, void *user_data)
+{
+  sendv_user_data *ud = (sendv_user_data*)user_data;
+  if(ud->sendmax == 0) {
+    return NGHTTP2_ERR_WOULDBLOCK;
+  }
+  assert(ud->length+8+length <= sizeof(ud->buf));
+  memcpy(ud->buf+ud->length, framehd, 8);
+  memset(ud->buf+ud->length+8, 'a', length);
+  ud->length += 8+length;
+  return 0;
+}
+
+static void no_copy_submit(nghttp2_session *session,
+                           nghttp2_data_source_read_callback read_callback)
+{
+  const char *nv[] = { ":path", "/", NULL };
+  nghttp2_data_provider data_prd;
+  data_prd.read_callback = read_callback;
+  nghttp2_submit_request(session, NGHTTP2_PRI_DEFAULT, nv, &data_prd, NULL);
+  nghttp2_submit_ping(session, NULL);
+}
+
+void test_nghttp2_session_send_data_no_copy(void)
+{
+  nghttp2_session *session;
+  nghttp2_session_callbacks callbacks;
+  sendv_user_data ref, ud;
+
+  /* The bytes sent with copied payload are the reference */
+  memset(&callbacks, 0, sizeof(nghttp2_session_callbacks));
+  callbacks.send_callback = sendv_accumulator_send_callback;
+  memset(&ref, 0, sizeof(ref));
+  ref.data_source_length = 10000;
+  nghttp2_session_client_new(&session, &callbacks, &ref);
+  no_copy_submit(session, copy_data_source_read_callback);
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  nghttp2_session_del(session);
+
+  /* send_data_callback is required */
+  memset(&ud, 0, sizeof(ud));
+  ud.data_source_length = 10000;
+  nghttp2_session_client_new(&session, &callbacks, &ud);
+  no_copy_submit(session, no_copy_data_source_read_callback);
+  CU_ASSERT(NGHTTP2_ERR_CALLBACK_FAILURE == nghttp2_session_send(session));
+  nghttp2_session_del(session);
+
+  callbacks.send_data_callback = accumulator_send_data_callback;
+  memset(&ud, 0, sizeof(ud));
+  ud.data_source_length = 10000;
+  nghttp2_session_client_new(&session, &callbacks, &ud);
+  no_copy_submit(session, no_copy_data_source_read_callback);
+  /* The first DATA frame cannot be sent */
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  CU_ASSERT(ud.length > 0 && ud.length < ref.length);
+  CU_ASSERT(nghttp2_session_want_write(session));
+  ud.sendmax = sizeof(ud.buf);
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  CU_ASSERT(ref.length == ud.length);
+  CU_ASSERT(0 == memcmp(ref.buf, ud.buf, ref.length));
+  CU_ASSERT(NGHTTP2_INITIAL_CONNECTION_WINDOW_SIZE - 10000 ==
+            session->remote_window_size);
+  nghttp2_session_del(session);
+
+  /* With sendv_callback, DATA frames are sent between batches */
+  callbacks.send_callback = NULL;
+  callbacks.sendv_callback = sendv_accumulator_sendv_callback;
+  memset(&ud, 0, sizeof(ud));
+  ud.sendmax = sizeof(ud.buf);
+  ud.data_source_length = 10000;
+  nghttp2_session_client_new(&session, &callbacks, &ud);
+  no_copy_submit(session, no_copy_data_source_read_callback);
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  CU_ASSERT(1 == ud.sendv_cb_called);
+  CU_ASSERT(ref.length == ud.length);
+  CU_ASSERT(0 == memcmp(ref.buf, ud.buf, ref.length));
+  CU_ASSERT(0 == nghttp2_session_want_write(session));
+  nghttp2_session_del(session);
+}
+
+typedef struct {
+  /* This must be the first member */
+  sendv_user_data sent;
+  uint8_t buf[16384];
+  size_t length;
+  size_t recvlen;
+} capture_user_data;
+
+static void capture_callback(nghttp2_session *session, uint8_t flags,
+                             const uint8_t *data, size_t length,
+                             void *user_data)
+{
+  capture_user_data *ud = (capture_user_data*)user_data;
+  if(flags & NGHTTP2_CAPTURE_RECV) {
+    ud->recvlen += length;
+    return;
+  }
+  assert(ud->length+length <= sizeof(ud->buf));
+  if(data) {
+    memcpy(ud->buf+ud->length, data, length);
+  } else {
+    /* The payload of DATA frame sent by send_data_callback */
+    memset(ud->buf+ud->length, 'a', length);
+  }
+  ud->length += length;
+}
+
+void test_nghttp2_session_capture(void)
+{
+  nghttp2_session *session;
+  nghttp2_session_callbacks callbacks;
+  capture_user_data ud;
+  uint8_t *framedata = NULL;
+  size_t framedatalen = 0;
+  ssize_t framelen;
+  nghttp2_frame frame;
+  const uint8_t *data;
+  ssize_t datalen;
+
+  memset(&callbacks, 0, sizeof(nghttp2_session_callbacks));
+  callbacks.send_callback = sendv_accumulator_send_callback;
+  callbacks.capture_callback = capture_callback;
+
+  /* send_callback */
+  memset(&ud, 0, sizeof(ud));
+  ud.sent.data_source_length = 10000;
+  nghttp2_session_client_new(&session, &callbacks, &ud);
+  no_copy_submit(session, copy_data_source_read_callback);
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  CU_ASSERT(ud.sent.length > 10000);
+  CU_ASSERT(ud.sent.length == ud.length);
+  CU_ASSERT(0 == memcmp(ud.sent.buf, ud.buf, ud.length));
+
+  /* Received bytes are captured as they are passed */
+  nghttp2_frame_ping_init(&frame.ping, NGHTTP2_FLAG_NONE, NULL);
+  framelen = nghttp2_frame_pack_ping(&framedata, &framedatalen, &frame.ping,
+                                     nghttp2_mem_default());
+  CU_ASSERT(framelen == nghttp2_session_mem_recv(session, framedata,
+                                                 framelen));
+  CU_ASSERT((size_t)framelen == ud.recvlen);
+  nghttp2_frame_ping_free(&frame.ping);
+  free(framedata);
+  nghttp2_session_del(session);
+
+  /* send_data_callback */
+  callbacks.send_data_callback = accumulator_send_data_callback;
+  memset(&ud, 0, sizeof(ud));
+  ud.sent.sendmax = sizeof(ud.sent.buf);
+  ud.sent.data_source_length = 10000;
+  nghttp2_session_client_new(&session, &callbacks, &ud);
+  no_copy_submit(session, no_copy_data_source_read_callback);
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  CU_ASSERT(ud.sent.length == ud.length);
+  CU_ASSERT(0 == memcmp(ud.sent.buf, ud.buf, ud.length));
+  nghttp2_session_del(session);
+
+  /* sendv_callback, which sends partially */
+  callbacks.send_callback = NULL;
+  callbacks.sendv_callback = sendv_accumulator_sendv_callback;
+  memset(&ud, 0, sizeof(ud));
+  ud.sent.sendmax = 1000;
+  ud.sent.data_source_length = 10000;
+  nghttp2_session_client_new(&session, &callbacks, &ud);
+  no_copy_submit(session, copy_data_source_read_callback);
+  while(nghttp2_session_want_write(session)) {
+    CU_ASSERT(0 == nghttp2_session_send(session));
+  }
+  CU_ASSERT(ud.sent.length > 10000);
+  CU_ASSERT(ud.sent.length == ud.length);
+  CU_ASSERT(0 == memcmp(ud.sent.buf, ud.buf, ud.length));
+  nghttp2_session_del(session);
+
+  /* nghttp2_session_mem_send() with no-copy DATA frames */
+  callbacks.sendv_callback = NULL;
+  memset(&ud, 0, sizeof(ud));
+  ud.sent.sendmax = sizeof(ud.sent.buf);
+  ud.sent.data_source_length = 10000;
+  nghttp2_session_client_new(&session, &callbacks, &ud);
+  no_copy_submit(session, no_copy_data_source_read_callback);
+  while((datalen = nghttp2_session_mem_send(session, &data)) > 0) {
+    memcpy(ud.sent.buf+ud.sent.length, data, datalen);
+    ud.sent.length += datalen;
+  }
+  CU_ASSERT(0 == datalen);
+  CU_ASSERT(ud.sent.length > 10000);
+  CU_ASSERT(ud.sent.length == ud.length);
+  CU_ASSERT(0 == memcmp(ud.sent.buf, ud.buf, ud.length));
+  nghttp2_session_del(session);
+}
+
+#ifndef NGHTTP2_TESTS_DIR
+#  define NGHTTP2_TESTS_DIR "."
+#endif /* NGHTTP2_TESTS_DIR */
+
+typedef struct {
+  nghttp2_session *server;
+  nghttp2_session *client;
+  size_t request_recv_cb_called;
+  size_t response_recv_cb_called;
+  size_t data_chunk_recvlen;
+} replay_user_data;
+
+static void replay_on_frame_recv_callback(nghttp2_session *session,
+                                          nghttp2_frame *frame,
+                                          void *user_data)
+{
+  replay_user_data *ud = (replay_user_data*)user_data;
+  if(session == ud->client) {
+    if(frame->hd.type == NGHTTP2_HEADERS &&
+       frame->headers.cat == NGHTTP2_HCAT_RESPONSE) {
+      ++ud->response_recv_cb_called;
+    }
+    return;
+  }
+  /* Tell the client what the captured client did, so that it accepts
+     the frames from the server. */
+  switch(frame->hd.type) {
+  case NGHTTP2_HEADERS:
+    if(frame->headers.cat == NGHTTP2_HCAT_REQUEST) {
+      ++ud->request_recv_cb_called;
+      nghttp2_submit_request2(ud->client, frame->headers.pri,
+                              frame->headers.nva, frame->headers.nvlen,
+                              NULL, NULL);
+      nghttp2_session_send(ud->client);
+    }
+    break;
+  case NGHTTP2_SETTINGS:
+    nghttp2_submit_settings(ud->client, frame->settings.iv,
+                            frame->settings.niv);
+    break;
+  case NGHTTP2_WINDOW_UPDATE:
+    nghttp2_submit_window_update(ud->client, frame->hd.flags,
+                                 frame->hd.stream_id,
+                                 frame->window_update.window_size_increment);
+    break;
+  default:
+    break;
+  }
+}
+
+static void replay_on_data_chunk_recv_callback(nghttp2_session *session,
+                                               uint8_t flags,
+                                               int32_t stream_id,
+                                               const uint8_t *data,
+                                               size_t len, void *user_data)
+{
+  ((replay_user_data*)user_data)->data_chunk_recvlen += len;
+}
+
+/*
+ * Replays the capture file |name| in testdata directory through new
+ * server and client sessions. Returns the number of the records, or
+ * -1 if the file cannot be read or a record is rejected.
+ */
+static int replay_capture(replay_user_data *ud, const char *name)
+{
+  nghttp2_session_callbacks callbacks;
+  char path[1024];
+  FILE *fp;
+  uint8_t hd[12];
+  uint8_t *buf;
+  uint32_t length;
+  int client_side, from_client;
+  nghttp2_session *session;
+  int nrec = 0;
+
+  snprintf(path, sizeof(path), "%s/testdata/%s", NGHTTP2_TESTS_DIR, name);
+  fp = fopen(path, "rb");
+  if(fp == NULL) {
+    return -1;
+  }
+  if(fread(hd, 12, 1, fp) != 1 || memcmp(hd, "NGH2CAP\x01", 8) != 0) {
+    fclose(fp);
+    return -1;
+  }
+  client_side = hd[8] == 0;
+
+  memset(&callbacks, 0, sizeof(nghttp2_session_callbacks));
+  callbacks.send_callback = null_send_callback;
+  callbacks.on_frame_recv_callback = replay_on_frame_recv_callback;
+  callbacks.on_data_chunk_recv_callback = replay_on_data_chunk_recv_callback;
+  memset(ud, 0, sizeof(*ud));
+  nghttp2_session_server_new(&ud->server, &callbacks, ud);
+  nghttp2_session_client_new(&ud->client, &callbacks, ud);
+
+  /* flags(1), delta(4), length(4) */
+  while(fread(hd, 9, 1, fp) == 1) {
+    length = nghttp2_get_uint32(&hd[5]);
+    buf = malloc(length);
+    if(length > 0 && fread(buf, length, 1, fp) != 1) {
+      free(buf);
+      nrec = -1;
+      break;
+    }
+    from_client = client_side == ((hd[0] & NGHTTP2_CAPTURE_SEND) != 0);
+    session = from_client ? ud->server : ud->client;
+    if(nghttp2_session_mem_recv(session, buf, length) != (ssize_t)length ||
+       nghttp2_session_send(session) != 0) {
+      free(buf);
+      nrec = -1;
+      break;
+    }
+    free(buf);
+    ++nrec;
+  }
+  fclose(fp);
+  nghttp2_session_del(ud->server);
+  nghttp2_session_del(ud->client);
+  return nrec;
+}
+
+void test_nghttp2_session_replay_captures(void)
+{
+  replay_user_data ud;
+  /* The client and server sides of the same connection: the client
+     got index.html (32 bytes) and lorem.txt (12000 bytes) from
+     nghttpd. */
+  static const char *names[] = { "client.h2cap", "server.h2cap" };
+  size_t i;
+
+  for(i = 0; i < sizeof(names)/sizeof(names[0]); ++i) {
+    CU_ASSERT(0 < replay_capture(&ud, names[i]));
+    CU_ASSERT(2 == ud.request_recv_cb_called);
+    CU_ASSERT(2 == ud.response_recv_cb_called);
+    CU_ASSERT(32 + 12000 == ud.data_chunk_recvlen);
+  }
+}
+
+void test_nghttp2_session_mem_send(void)
+{
+  nghttp2_session *session;
+  nghttp2_session_callbacks callbacks;
+  sendv_user_data ref, ud;
+  my_user_data mud;
+  const uint8_t *data;
+  ssize_t datalen;
+  size_t ncalls;
+
+  /* The bytes sent by send_callback are the reference */
+  memset(&callbacks, 0, sizeof(nghttp2_session_callbacks));
+  callbacks.send_callback = sendv_accumulator_send_callback;
+  memset(&ref, 0, sizeof(ref));
+  ref.data_source_length = 10000;
+  nghttp2_session_client_new(&session, &callbacks, &ref);
+  no_copy_submit(session, copy_data_source_read_callback);
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  nghttp2_session_del(session);
+
+  /* HEADERS, PING and 3 DATA frames */
+  memset(&callbacks, 0, sizeof(nghttp2_session_callbacks));
+  memset(&ud, 0, sizeof(ud));
+  ud.data_source_length = 10000;
+  nghttp2_session_client_new(&session, &callbacks, &ud);
+  no_copy_submit(session, copy_data_source_read_callback);
+  for(ncalls = 0;
+      (datalen = nghttp2_session_mem_send(session, &data)) > 0; ++ncalls) {
+    CU_ASSERT(ud.length+datalen <= sizeof(ud.buf));
+    memcpy(ud.buf+ud.length, data, datalen);
+    ud.length += datalen;
+  }
+  CU_ASSERT(0 == datalen);
+  CU_ASSERT(NULL == data);
+  CU_ASSERT(5 == ncalls);
+  CU_ASSERT(ref.length == ud.length);
+  CU_ASSERT(0 == memcmp(ref.buf, ud.buf, ref.length));
+  CU_ASSERT(NGHTTP2_INITIAL_CONNECTION_WINDOW_SIZE - 10000 ==
+            session->remote_window_size);
+  CU_ASSERT(0 == nghttp2_session_want_write(session));
+  nghttp2_session_del(session);
+
+  /* The frame is finished in the next call */
+  callbacks.on_frame_send_callback = on_frame_send_callback;
+  memset(&mud, 0, sizeof(mud));
+  nghttp2_session_client_new(&session, &callbacks, &mud);
+  nghttp2_submit_ping(session, NULL);
+  CU_ASSERT(16 == nghttp2_session_mem_send(session, &data));
+  CU_ASSERT(NGHTTP2_PING == data[2]);
+  CU_ASSERT(0 == mud.frame_send_cb_called);
+  CU_ASSERT(0 == nghttp2_session_mem_send(session, &data));
+  CU_ASSERT(1 == mud.frame_send_cb_called);
+  CU_ASSERT(NGHTTP2_PING == mud.sent_frame_type);
+  CU_ASSERT(0 == nghttp2_session_want_write(session));
+  nghttp2_session_del(session);
+}
+
+void test_nghttp2_session_fc_blocked_streams(void)
+{
+  nghttp2_session *session;
+  nghttp2_session_callbacks callbacks;
+  const char *nv[] = { NULL };
+  my_user_data ud;
+  nghttp2_data_provider data_prd;
+  nghttp2_frame frame;
+  nghttp2_stream *stream1, *stream3;
+  int i;
+
+  memset(&callbacks, 0, sizeof(nghttp2_session_callbacks));
+  callbacks.send_callback = null_send_callback;
+  data_prd.read_callback = fixed_length_data_source_read_callback;
+  ud.data_source_length = 128*1024;
+
+  nghttp2_session_client_new(&session, &callbacks, &ud);
+  session->remote_window_size = 0;
+  for(i = 0; i < 3; ++i) {
+    nghttp2_submit_request(session, NGHTTP2_PRI_DEFAULT, nv, &data_prd, NULL);
+  }
+  /* HEADERS are sent, but all DATA are blocked by connection window */
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  CU_ASSERT(0 == nghttp2_session_get_outbound_queue_size(session));
+  CU_ASSERT(NULL != session->fc_blocked_streams);
+  CU_ASSERT(NULL != session->fc_blocked_streams->fc_next);
+  CU_ASSERT(NULL != session->fc_blocked_streams->fc_next->fc_next);
+  CU_ASSERT(NULL == session->fc_blocked_streams->fc_next->fc_next->fc_next);
+
+  /* Closed stream leaves the list */
+  nghttp2_session_close_stream(session, 5, NGHTTP2_CANCEL);
+  CU_ASSERT(NULL == session->fc_blocked_streams->fc_next->fc_next);
+
+  /* Stream 1 is also blocked by its own window */
+  stream1 = nghttp2_session_get_stream(session, 1);
+  stream3 = nghttp2_session_get_stream(session, 3);
+  stream1->remote_window_size = 0;
+
+  nghttp2_frame_window_update_init(&frame.window_update, NGHTTP2_FLAG_NONE,
+                                   0, 4096);
+  CU_ASSERT(0 == nghttp2_session_on_window_update_received(session, &frame));
+  CU_ASSERT(1 == nghttp2_session_get_outbound_queue_size(session));
+  CU_ASSERT(NULL == stream3->deferred_data);
+  CU_ASSERT(stream1 == session->fc_blocked_streams);
+  CU_ASSERT(NULL == stream1->fc_prev);
+  CU_ASSERT(NULL == stream1->fc_next);
+
+  /* Stream-level WINDOW_UPDATE takes it off the list */
+  frame.hd.stream_id = 1;
+  CU_ASSERT(0 == nghttp2_session_on_window_update_received(session, &frame));
+  CU_ASSERT(2 == nghttp2_session_get_outbound_queue_size(session));
+  CU_ASSERT(NULL == session->fc_blocked_streams);
+
+  nghttp2_frame_window_update_free(&frame.window_update);
+  nghttp2_session_del(session);
+}
+
+void test_nghttp2_session_cancel_queued_data(void)
+{
+  nghttp2_session *session;
+  nghttp2_session_callbacks callbacks;
+  my_user_data ud;
+  nghttp2_data_provider data_prd;
+  nghttp2_stream *stream1, *stream7;
+  nghttp2_outbound_item *item;
+  int32_t i;
+
+  memset(&callbacks, 0, sizeof(nghttp2_session_callbacks));
+  callbacks.send_callback = null_send_callback;
+  data_prd.read_callback = fixed_length_data_source_read_callback;
+  ud.data_source_length = 64*1024;
+
+  nghttp2_session_client_new(&session, &callbacks, &ud);
+  for(i = 1; i <= 7; i += 2) {
+    nghttp2_session_open_stream(session, i, NGHTTP2_FLAG_NONE,
+                                NGHTTP2_PRI_DEFAULT,
+                                NGHTTP2_STREAM_OPENED, NULL);
+    CU_ASSERT(0 == nghttp2_submit_data(session, NGHTTP2_FLAG_END_STREAM, i,
+                                       &data_prd));
+  }
+  stream1 = nghttp2_session_get_stream(session, 1);
+  stream7 = nghttp2_session_get_stream(session, 7);
+  CU_ASSERT(4 == nghttp2_session_get_outbound_queue_size(session));
+  CU_ASSERT(NULL != stream1->queued_items);
+
+  /* Queuing RST_STREAM drops the queued DATA right away */
+  CU_ASSERT(0 == nghttp2_submit_rst_stream(session, 1, NGHTTP2_CANCEL));
+  CU_ASSERT(4 == nghttp2_session_get_outbound_queue_size(session));
+  CU_ASSERT(NULL == stream1->queued_items);
+  item = nghttp2_session_get_next_ob_item(session);
+  CU_ASSERT(NGHTTP2_RST_STREAM == OB_CTRL_TYPE(item));
+
+  /* So does closing the stream */
+  nghttp2_session_close_stream(session, 3, NGHTTP2_NO_ERROR);
+  CU_ASSERT(3 == nghttp2_session_get_outbound_queue_size(session));
+
+  /* Reprioritized DATA moves ahead of the other DATA, but control
+     frames are always sent first */
+  nghttp2_session_reprioritize_stream(session, stream7, 0);
+  item = nghttp2_session_pop_next_ob_item(session);
+  CU_ASSERT(NGHTTP2_RST_STREAM == OB_CTRL_TYPE(item));
+  nghttp2_session_free_outbound_item(session, item);
+  item = nghttp2_session_get_next_ob_item(session);
+  CU_ASSERT(NGHTTP2_CAT_DATA == item->frame_cat);
+  CU_ASSERT(7 == OB_DATA(item)->hd.stream_id);
+  CU_ASSERT(0 == item->pri);
+
+  nghttp2_session_del(session);
+}
+
+static void log_data_send_callback(nghttp2_session *session,
+                                   uint16_t length, uint8_t flags,
+                                   int32_t stream_id, void *user_data)
+{
+  my_user_data *ud = (my_user_data*)user_data;
+  if(ud->data_send_lenslen <
+     sizeof(ud->data_send_lens)/sizeof(ud->data_send_lens[0])) {
+    ud->data_send_stream_ids[ud->data_send_lenslen] = stream_id;
+    ud->data_send_lens[ud->data_send_lenslen++] = length;
+  }
+}
+
+void test_nghttp2_session_data_payload_length(void)
+{
+  nghttp2_session *session;
+  nghttp2_session_callbacks callbacks;
+  my_user_data ud;
+  nghttp2_data_provider data_prd;
+  nghttp2_stream *stream;
+  size_t maxlen = 16384;
+
+  memset(&callbacks, 0, sizeof(nghttp2_session_callbacks));
+  callbacks.send_callback = null_send_callback;
+  callbacks.on_data_send_callback = log_data_send_callback;
+  data_prd.read_callback = fixed_length_data_source_read_callback;
+
+  /* Default is NGHTTP2_DATA_PAYLOAD_LENGTH */
+  ud.data_send_lenslen = 0;
+  ud.data_source_length = 10000;
+  nghttp2_session_client_new(&session, &callbacks, &ud);
+  nghttp2_session_open_stream(session, 1, NGHTTP2_FLAG_NONE,
+                              NGHTTP2_PRI_DEFAULT,
+                              NGHTTP2_STREAM_OPENED, NULL);
+  CU_ASSERT(0 == nghttp2_submit_data(session, NGHTTP2_FLAG_END_STREAM, 1,
+                                     &data_prd));
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  CU_ASSERT(3 == ud.data_send_lenslen);
+  CU_ASSERT(4096 == ud.data_send_lens[0]);
+  CU_ASSERT(4096 == ud.data_send_lens[1]);
+  CU_ASSERT(1808 == ud.data_send_lens[2]);
+  nghttp2_session_del(session);
+
+  /* Bulk transfer ramps up to the configured maximum */
+  ud.data_send_lenslen = 0;
+  ud.data_source_length = 48*1024;
+  nghttp2_session_client_new(&session, &callbacks, &ud);
+  CU_ASSERT(0 == nghttp2_session_set_option
+            (session, NGHTTP2_OPT_MAX_DATA_PAYLOAD_LENGTH,
+             &maxlen, sizeof(maxlen)));
+  stream = nghttp2_session_open_stream(session, 1, NGHTTP2_FLAG_NONE,
+                                       NGHTTP2_PRI_DEFAULT,
+                                       NGHTTP2_STREAM_OPENED, NULL);
+  CU_ASSERT(0 == nghttp2_submit_data(session, NGHTTP2_FLAG_END_STREAM, 1,
+                                     &data_prd));
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  CU_ASSERT(5 == ud.data_send_lenslen);
+  CU_ASSERT(4096 == ud.data_send_lens[0]);
+  CU_ASSERT(8192 == ud.data_send_lens[1]);
+  CU_ASSERT(16384 == ud.data_send_lens[2]);
+  CU_ASSERT(16384 == ud.data_send_lens[3]);
+  CU_ASSERT(4096 == ud.data_send_lens[4]);
+  CU_ASSERT(16384 == stream->data_payloadlen);
+
+  /* Small window limits the payload */
+  ud.data_send_lenslen = 0;
+  ud.data_source_length = 8192;
+  stream = nghttp2_session_open_stream(session, 3, NGHTTP2_FLAG_NONE,
+                                       NGHTTP2_PRI_DEFAULT,
+                                       NGHTTP2_STREAM_OPENED, NULL);
+  stream->data_payloadlen = 16384;
+  stream->remote_window_size = 1000;
+  CU_ASSERT(0 == nghttp2_submit_data(session, NGHTTP2_FLAG_END_STREAM, 3,
+                                     &data_prd));
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  CU_ASSERT(1 == ud.data_send_lenslen);
+  CU_ASSERT(1000 == ud.data_send_lens[0]);
+  nghttp2_session_del(session);
+}
+
+static ssize_t stream_length_data_source_read_callback
+(nghttp2_session *session, int32_t stream_id,
+ uint8_t *buf, size_t len, int *eof,
+ nghttp2_data_source *source, void *user_data)
+{
+  size_t *remaining = (size_t*)source->ptr;
+  size_t wlen = len < *remaining ? len : *remaining;
+  *remaining -= wlen;
+  if(*remaining == 0) {
+    *eof = 1;
+  }
+  return wlen;
+}
+
+static void ping_data_send_callback(nghttp2_session *session,
+                                    uint16_t length, uint8_t flags,
+                                    int32_t stream_id, void *user_data)
+{
+  log_data_send_callback(session, length, flags, stream_id, user_data);
+  nghttp2_submit_ping(session, NULL);
+}
+
+void test_nghttp2_session_data_round_robin(void)
+{
+  nghttp2_session *session;
+  nghttp2_session_callbacks callbacks;
+  my_user_data ud;
+  nghttp2_data_provider data_prd[3];
+  size_t remaining[3] = { 24*1024, 24*1024, 16*1024 };
+  size_t maxlen = 4096;
+  int32_t expected[] = { 1, 1, 1, 1, 3, 3, 3, 3, 5, 5, 1, 1, 3, 3, 5, 5 };
+  int32_t expected_ping[] = { 1, 1, 1, 1, 3, 3, 1, 1, 3, 3, 3, 3 };
+  size_t i;
+
+  memset(&callbacks, 0, sizeof(nghttp2_session_callbacks));
+  callbacks.send_callback = null_send_callback;
+  callbacks.on_data_send_callback = log_data_send_callback;
+
+  ud.data_send_lenslen = 0;
+  nghttp2_session_client_new(&session, &callbacks, &ud);
+  /* Keep frames at 4KiB so that the turns are easy to count */
+  CU_ASSERT(0 == nghttp2_session_set_option
+            (session, NGHTTP2_OPT_MAX_DATA_PAYLOAD_LENGTH,
+             &maxlen, sizeof(maxlen)));
+  session->remote_window_size = 1 << 20;
+  for(i = 0; i < 3; ++i) {
+    int32_t stream_id = (int32_t)(i*2+1);
+    nghttp2_session_open_stream(session, stream_id, NGHTTP2_FLAG_NONE,
+                                NGHTTP2_PRI_DEFAULT,
+                                NGHTTP2_STREAM_OPENED, NULL);
+    data_prd[i].source.ptr = &remaining[i];
+    data_prd[i].read_callback = stream_length_data_source_read_callback;
+    CU_ASSERT(0 == nghttp2_submit_data(session, NGHTTP2_FLAG_END_STREAM,
+                                       stream_id, &data_prd[i]));
+  }
+  CU_ASSERT(NGHTTP2_ERR_INVALID_ARGUMENT ==
+            nghttp2_session_set_stream_weight(session, 5,
+                                              NGHTTP2_MIN_WEIGHT-1));
+  CU_ASSERT(NGHTTP2_ERR_INVALID_ARGUMENT ==
+            nghttp2_session_set_stream_weight(session, 5,
+                                              NGHTTP2_MAX_WEIGHT+1));
+  CU_ASSERT(NGHTTP2_ERR_STREAM_CLOSED ==
+            nghttp2_session_set_stream_weight(session, 7,
+                                              NGHTTP2_DEFAULT_WEIGHT));
+  /* Stream 5 gets half the share of the others */
+  CU_ASSERT(0 == nghttp2_session_set_stream_weight(session, 5, 8));
+
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  CU_ASSERT(16 == ud.data_send_lenslen);
+  for(i = 0; i < 16; ++i) {
+    CU_ASSERT(expected[i] == ud.data_send_stream_ids[i]);
+    CU_ASSERT(4096 == ud.data_send_lens[i]);
+  }
+  nghttp2_session_del(session);
+
+  /* A PING sent between DATA frames does not end the turn */
+  callbacks.on_data_send_callback = ping_data_send_callback;
+  ud.data_send_lenslen = 0;
+  nghttp2_session_client_new(&session, &callbacks, &ud);
+  CU_ASSERT(0 == nghttp2_session_set_option
+            (session, NGHTTP2_OPT_MAX_DATA_PAYLOAD_LENGTH,
+             &maxlen, sizeof(maxlen)));
+  session->remote_window_size = 1 << 20;
+  for(i = 0; i < 2; ++i) {
+    int32_t stream_id = (int32_t)(i*2+1);
+    nghttp2_session_open_stream(session, stream_id, NGHTTP2_FLAG_NONE,
+                                NGHTTP2_PRI_DEFAULT,
+                                NGHTTP2_STREAM_OPENED, NULL);
+    remaining[i] = 24*1024;
+    data_prd[i].source.ptr = &remaining[i];
+    data_prd[i].read_callback = stream_length_data_source_read_callback;
+    CU_ASSERT(0 == nghttp2_submit_data(session, NGHTTP2_FLAG_END_STREAM,
+                                       stream_id, &data_prd[i]));
+  }
+  CU_ASSERT(0 == nghttp2_session_set_stream_weight(session, 3, 8));
+
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  CU_ASSERT(12 == ud.data_send_lenslen);
+  for(i = 0; i < 12; ++i) {
+    CU_ASSERT(expected_ping[i] == ud.data_send_stream_ids[i]);
+  }
+  nghttp2_session_del(session);
+}
+
+static void recv_data_frame(nghttp2_session *session, int32_t stream_id,
+                            size_t length)
+{
+  uint8_t data[NGHTTP2_FRAME_HEAD_LENGTH+16384];
+  nghttp2_frame_hd hd;
+  assert(length <= 16384);
+  memset(data, 0, sizeof(data));
+  hd.length = length;
+  hd.type = NGHTTP2_DATA;
+  hd.flags = NGHTTP2_FLAG_NONE;
+  hd.stream_id = stream_id;
+  nghttp2_frame_pack_frame_hd(data, &hd);
+  CU_ASSERT((ssize_t)(NGHTTP2_FRAME_HEAD_LENGTH+length) ==
+            nghttp2_session_mem_recv(session, data,
+                                     NGHTTP2_FRAME_HEAD_LENGTH+length));
+}
+
+void test_nghttp2_session_window_auto_tuning(void)
+{
+  nghttp2_session *session;
+  nghttp2_session_callbacks callbacks;
+  nghttp2_stream *stream;
+  nghttp2_outbound_item *item;
+  nghttp2_frame frame;
+  int32_t maxval = 1 << 20;
+  int32_t peer_window_size;
+  int i;
+
+  memset(&callbacks, 0, sizeof(nghttp2_session_callbacks));
+  callbacks.send_callback = null_send_callback;
+
+  nghttp2_session_client_new(&session, &callbacks, NULL);
+  CU_ASSERT(0 == nghttp2_session_set_option
+            (session, NGHTTP2_OPT_WINDOW_AUTO_TUNING_MAX,
+             &maxval, sizeof(maxval)));
+  stream = nghttp2_session_open_stream(session, 1, NGHTTP2_FLAG_NONE,
+                                       NGHTTP2_PRI_DEFAULT,
+                                       NGHTTP2_STREAM_OPENED, NULL);
+
+  /* The first DATA starts the measurement */
+  recv_data_frame(session, 1, 16384);
+  item = nghttp2_session_get_next_ob_item(session);
+  CU_ASSERT(NGHTTP2_PING == OB_CTRL_TYPE(item));
+  CU_ASSERT(0 == memcmp(NGHTTP2_WINDOW_AUTO_TUNING_PING_DATA,
+                        OB_CTRL(item)->ping.opaque_data, 8));
+  CU_ASSERT(0 == nghttp2_session_send(session));
+
+  /* 48KiB arrives in one round trip, which fills most of the
+     window */
+  for(i = 0; i < 3; ++i) {
+    recv_data_frame(session, 1, 16384);
+  }
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  nghttp2_frame_ping_init(&frame.ping, NGHTTP2_FLAG_PONG,
+                          (uint8_t*)NGHTTP2_WINDOW_AUTO_TUNING_PING_DATA);
+  CU_ASSERT(0 == nghttp2_session_on_ping_received(session, &frame));
+  CU_ASSERT(0 == session->auto_window_ping_inflight);
+  CU_ASSERT(2*49152 == session->auto_window_size);
+
+  /* The windows grow when DATA is received next time */
+  recv_data_frame(session, 1, 16384);
+  CU_ASSERT(2*49152 == session->local_window_size);
+  CU_ASSERT(2*49152 == stream->local_window_size);
+  /* WINDOW_UPDATE is queued to advertise them */
+  CU_ASSERT(0 == session->recv_window_size);
+  CU_ASSERT(0 == stream->recv_window_size);
+  /* The next measurement has started */
+  CU_ASSERT(1 == session->auto_window_ping_inflight);
+  CU_ASSERT(0 == nghttp2_session_send(session));
+
+  /* Nothing arrives in the next round trip. The windows shrink, but
+     not below the initial size. */
+  CU_ASSERT(0 == nghttp2_session_on_ping_received(session, &frame));
+  CU_ASSERT(NGHTTP2_INITIAL_WINDOW_SIZE == session->auto_window_size);
+  peer_window_size = stream->local_window_size - stream->recv_window_size;
+  recv_data_frame(session, 1, 1);
+  CU_ASSERT(NGHTTP2_INITIAL_WINDOW_SIZE == session->local_window_size);
+  CU_ASSERT(NGHTTP2_INITIAL_WINDOW_SIZE == stream->local_window_size);
+  /* The remote endpoint keeps the window it had, and the shrunk part
+     is withheld from the subsequent WINDOW_UPDATE */
+  CU_ASSERT(peer_window_size - 1 ==
+            stream->local_window_size - stream->recv_window_size);
+  CU_ASSERT(stream->recv_window_size < 0);
+
+  nghttp2_frame_ping_free(&frame.ping);
+  nghttp2_session_del(session);
+}
+
+void test_nghttp2_session_get_stats(void)
+{
+  nghttp2_session *client, *server;
+  nghttp2_session_callbacks callbacks;
+  const char *nv[] = { ":path", "/", ":method", "GET", NULL };
+  nghttp2_data_provider data_prd;
+  my_user_data ud;
+  nghttp2_stream *stream;
+  nghttp2_session_stats cstats, sstats;
+  const uint8_t *data;
+  uint8_t buf[4096];
+  ssize_t buflen;
+
+  memset(&callbacks, 0, sizeof(nghttp2_session_callbacks));
+  callbacks.send_callback = null_send_callback;
+  data_prd.read_callback = fixed_length_data_source_read_callback;
+
+  nghttp2_session_client_new(&client, &callbacks, &ud);
+  nghttp2_session_server_new(&server, &callbacks, &ud);
+
+  CU_ASSERT(0 == nghttp2_submit_request(client, NGHTTP2_PRI_DEFAULT, nv,
+                                        NULL, NULL));
+  nghttp2_session_get_stats(client, &cstats);
+  CU_ASSERT(0 == cstats.ob_pq_len);
+  CU_ASSERT(1 == cstats.ob_ss_pq_len);
+
+  buflen = nghttp2_session_mem_send(client, &data);
+  CU_ASSERT(buflen > 0 && buflen <= (ssize_t)sizeof(buf));
+  memcpy(buf, data, buflen);
+  CU_ASSERT(0 == nghttp2_session_mem_send(client, &data));
+
+  nghttp2_session_get_stats(client, &cstats);
+  CU_ASSERT(1 == cstats.frames_sent[NGHTTP2_HEADERS]);
+  CU_ASSERT((uint64_t)buflen == cstats.bytes_sent[NGHTTP2_HEADERS]);
+  CU_ASSERT(0 == cstats.frames_recv[NGHTTP2_HEADERS]);
+  CU_ASSERT(0 == cstats.ob_ss_pq_len);
+  CU_ASSERT(strlen(":path/:methodGET") == cstats.deflate_in_bytes);
+  CU_ASSERT(buflen - NGHTTP2_FRAME_HEAD_LENGTH == cstats.deflate_out_bytes);
+  CU_ASSERT(NGHTTP2_INITIAL_OUTBOUND_FRAMEBUF_LENGTH <=
+            cstats.framebuf_bytes);
+  CU_ASSERT(cstats.deflater_bytes > 0);
+  CU_ASSERT(cstats.inflater_bytes > 0);
+
+  CU_ASSERT(buflen == nghttp2_session_mem_recv(server, buf, buflen));
+  nghttp2_session_get_stats(server, &sstats);
+  CU_ASSERT(1 == sstats.frames_recv[NGHTTP2_HEADERS]);
+  CU_ASSERT((uint64_t)buflen == sstats.bytes_recv[NGHTTP2_HEADERS]);
+  CU_ASSERT(cstats.deflate_in_bytes == sstats.inflate_out_bytes);
+  CU_ASSERT(cstats.deflate_out_bytes == sstats.inflate_in_bytes);
+  /* The frame was processed in place */
+  CU_ASSERT(0 == sstats.iframe_buf_bytes);
+
+  nghttp2_session_del(server);
+
+  /* DATA blocked by flow control */
+  stream = nghttp2_session_open_stream(client, 3, NGHTTP2_FLAG_NONE,
+                                       NGHTTP2_PRI_DEFAULT,
+                                       NGHTTP2_STREAM_OPENED, NULL);
+  stream->remote_window_size = 100;
+  ud.data_source_length = 1000;
+  CU_ASSERT(0 == nghttp2_submit_data(client, NGHTTP2_FLAG_END_STREAM, 3,
+                                     &data_prd));
+  CU_ASSERT(0 == nghttp2_session_send(client));
+
+  nghttp2_session_get_stats(client, &cstats);
+  CU_ASSERT(1 == cstats.frames_sent[NGHTTP2_DATA]);
+  CU_ASSERT(NGHTTP2_FRAME_HEAD_LENGTH + 100 ==
+            cstats.bytes_sent[NGHTTP2_DATA]);
+  CU_ASSERT(1 == cstats.data_fc_blocked);
+  CU_ASSERT(0 == cstats.data_deferred);
+  CU_ASSERT(1 == cstats.num_deferred_data);
+  CU_ASSERT(1 == cstats.num_fc_blocked);
+
+  nghttp2_session_del(client);
+}
+
+/*
+ * Sends all pending frames of |src| and feeds them to |dst|.
+ */
+static void mem_send_recv(nghttp2_session *src, nghttp2_session *dst)
+{
+  const uint8_t *data;
+  ssize_t datalen;
+  while((datalen = nghttp2_session_mem_send(src, &data)) > 0) {
+    CU_ASSERT(datalen == nghttp2_session_mem_recv(dst, data, datalen));
+  }
+  CU_ASSERT(0 == datalen);
+}
+
+void test_nghttp2_session_shrink(void)
+{
+  nghttp2_session *client, *server;
+  nghttp2_session_callbacks callbacks;
+  const char *reqnv[] = { ":path", "/", ":method", "GET", NULL };
+  const char *resnv[] = { ":status", "200", NULL };
+  nghttp2_session_stats before, after;
+  int i;
+
+  memset(&callbacks, 0, sizeof(nghttp2_session_callbacks));
+  callbacks.send_callback = null_send_callback;
+
+  nghttp2_session_client_new(&client, &callbacks, NULL);
+  nghttp2_session_server_new(&server, &callbacks, NULL);
+
+  /* The second round checks that the released buffers are
+     reallocated and the header compression state is kept */
+  for(i = 0; i < 2; ++i) {
+    int32_t stream_id = i * 2 + 1;
+    CU_ASSERT(0 == nghttp2_submit_request(client, NGHTTP2_PRI_DEFAULT,
+                                          reqnv, NULL, NULL));
+    mem_send_recv(client, server);
+    CU_ASSERT(NULL != nghttp2_session_get_stream(server, stream_id));
+    CU_ASSERT(0 == nghttp2_submit_response(server, stream_id, resnv, NULL));
+    mem_send_recv(server, client);
+    CU_ASSERT(NULL == nghttp2_session_get_stream(server, stream_id));
+    CU_ASSERT(NULL == nghttp2_session_get_stream(client, stream_id));
+
+    nghttp2_session_get_stats(client, &before);
+    nghttp2_session_shrink(client);
+    nghttp2_session_shrink(server);
+    nghttp2_session_get_stats(client, &after);
+
+    CU_ASSERT(before.framebuf_bytes > 0);
+    CU_ASSERT(0 == after.framebuf_bytes);
+    /* The frames are processed in place, so iframe.buf is not used */
+    CU_ASSERT(0 == before.iframe_buf_bytes);
+    CU_ASSERT(0 == after.iframe_buf_bytes);
+    CU_ASSERT(before.deflater_bytes > after.deflater_bytes);
+    CU_ASSERT(before.inflater_bytes > after.inflater_bytes);
+    CU_ASSERT(before.pool_bytes > 0);
+    CU_ASSERT(0 == after.pool_bytes);
+  }
+  nghttp2_session_del(client);
+  nghttp2_session_del(server);
+}
+
+static int select_header_indexing_none_callback(nghttp2_session *session,
+                                                const nghttp2_nv *nv,
+                                                void *user_data)
+{
+  ++*(int*)user_data;
+  return NGHTTP2_HD_INDEXING_NONE;
+}
+
+void test_nghttp2_session_select_header_indexing(void)
+{
+  nghttp2_session *session;
+  nghttp2_session_callbacks callbacks;
+  const char *nv[] = { "x-request-id", "8f4e4a2c", NULL };
+  size_t tablelen;
+  int ncalls = 0;
+
+  memset(&callbacks, 0, sizeof(nghttp2_session_callbacks));
+  callbacks.send_callback = null_send_callback;
+  callbacks.select_header_indexing_callback =
+    select_header_indexing_none_callback;
+
+  CU_ASSERT(0 == nghttp2_session_client_new(&session, &callbacks, &ncalls));
+  tablelen = session->hd_deflater.hd_tablelen;
+  CU_ASSERT(0 == nghttp2_submit_request(session, NGHTTP2_PRI_DEFAULT, nv,
+                                        NULL, NULL));
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  CU_ASSERT(1 == ncalls);
+  CU_ASSERT(tablelen == session->hd_deflater.hd_tablelen);
+
+  nghttp2_session_del(session);
+}
+
+void test_nghttp2_session_recv_header_block(void)
+{
+  nghttp2_session *session;
+  nghttp2_session_callbacks callbacks;
+  my_user_data user_data;
+  nghttp2_hd_context deflater;
+  char names[16][16], values[16][512];
+  const char *nv[33];
+  nghttp2_frame frame;
+  uint8_t *framedata = NULL;
+  size_t framedatalen = 0;
+  ssize_t framelen;
+  size_t i, j, n;
+  int k;
+
+  for(i = 0; i < 16; ++i) {
+    snprintf(names[i], sizeof(names[i]), "x-field-%02zu", i);
+    memset(values[i], 'a' + i, sizeof(values[i]) - 1);
+    values[i][sizeof(values[i]) - 1] = '\0';
+    nv[i * 2] = names[i];
+    nv[i * 2 + 1] = values[i];
+  }
+  nv[32] = NULL;
+
+  memset(&callbacks, 0, sizeof(nghttp2_session_callbacks));
+  callbacks.send_callback = null_send_callback;
+  callbacks.on_frame_recv_callback = on_frame_recv_check_nv_callback;
+  nghttp2_session_server_new(&session, &callbacks, &user_data);
+  nghttp2_hd_deflate_init(&deflater, NGHTTP2_HD_SIDE_CLIENT,
+                          nghttp2_mem_default());
+
+  user_data.nvlen = nghttp2_nv_array_from_cstr(&user_data.nva, nv,
+                                               nghttp2_mem_default());
+  for(k = 0; k < 3; ++k) {
+    /* Each frame adds new header fields to the header table, and the
+       header fields are also toggled off and on in the reference
+       set. */
+    values[k][0] = 'A' + k;
+    nghttp2_frame_headers_init(&frame.headers,
+                               NGHTTP2_FLAG_END_HEADERS |
+                               NGHTTP2_FLAG_PRIORITY,
+                               k * 2 + 1, k, user_data.nva, user_data.nvlen);
+    framelen = nghttp2_frame_pack_headers(&framedata, &framedatalen,
+                                          &frame.headers,
+                                          &deflater);
+    CU_ASSERT(framelen > 0);
+    nghttp2_hd_end_headers(&deflater);
+
+    user_data.frame_recv_cb_called = 0;
+    if(k == 0) {
+      /* The frame contained in one input is processed in place */
+      CU_ASSERT(framelen ==
+                nghttp2_session_mem_recv(session, framedata, framelen));
+      CU_ASSERT(0 == session->iframe.bufmax);
+    } else {
+      /* The header block split across inputs is inflated as it
+         arrives. Only the priority and the incomplete header
+         representation are buffered. */
+      n = k == 1 ? 1 : 7;
+      for(j = 0; j < (size_t)framelen; j += n) {
+        size_t len = nghttp2_min(n, framelen - j);
+        CU_ASSERT((ssize_t)len ==
+                  nghttp2_session_mem_recv(session, framedata + j, len));
+      }
+      CU_ASSERT(session->iframe.bufmax < (size_t)framelen);
+    }
+    CU_ASSERT(1 == user_data.frame_recv_cb_called);
+    CU_ASSERT(NULL != nghttp2_session_get_stream(session, k * 2 + 1));
+    frame.headers.nva = NULL;
+    frame.headers.nvlen = 0;
+    nghttp2_frame_headers_free(&frame.headers, nghttp2_mem_default());
+    /* Reflects the next value in the expected header fields */
+    nghttp2_nv_array_del(user_data.nva, nghttp2_mem_default());
+    values[k][0] = 'a' + k;
+    values[k + 1][0] = 'A' + k + 1;
+    user_data.nvlen = nghttp2_nv_array_from_cstr(&user_data.nva, nv,
+                                                 nghttp2_mem_default());
+    values[k + 1][0] = 'a' + k + 1;
+  }
+
+  nghttp2_nv_array_del(user_data.nva, nghttp2_mem_default());
+  free(framedata);
+  nghttp2_hd_deflate_free(&deflater);
+  nghttp2_session_del(session);
+}
+
+void test_nghttp2_session_flooding(void)
+{
+  nghttp2_session *session;
+  nghttp2_session_callbacks callbacks;
+  my_user_data ud;
+  nghttp2_frame frame;
+  nghttp2_session_stats stats;
+  nghttp2_outbound_item *item;
+  uint8_t *framedata = NULL;
+  size_t framedatalen = 0;
+  ssize_t framelen;
+  uint8_t in[5 * 16];
+  size_t i, max_ob_ctrl = 3;
+
+  memset(&callbacks, 0, sizeof(nghttp2_session_callbacks));
+  callbacks.send_callback = null_send_callback;
+
+  nghttp2_frame_ping_init(&frame.ping, NGHTTP2_FLAG_NONE, NULL);
+  framelen = nghttp2_frame_pack_ping(&framedata, &framedatalen, &frame.ping,
+                                     nghttp2_mem_default());
+  nghttp2_frame_ping_free(&frame.ping);
+  CU_ASSERT(16 == framelen);
+  for(i = 0; i < 5; ++i) {
+    memcpy(in + i * framelen, framedata, framelen);
+  }
+
+  nghttp2_session_server_new(&session, &callbacks, &ud);
+  CU_ASSERT(NGHTTP2_ERR_INVALID_ARGUMENT ==
+            nghttp2_session_set_option(session,
+                                       NGHTTP2_OPT_MAX_OUTBOUND_CTRL,
+                                       &i, 0));
+  CU_ASSERT(0 == nghttp2_session_set_option(session,
+                                            NGHTTP2_OPT_MAX_OUTBOUND_CTRL,
+                                            &max_ob_ctrl, sizeof(size_t)));
+
+  /* Control frames are sent before the others, PING first */
+  CU_ASSERT(0 == nghttp2_submit_goaway(session, NGHTTP2_NO_ERROR, NULL, 0));
+  CU_ASSERT(0 == nghttp2_submit_window_update(session, NGHTTP2_FLAG_NONE, 0,
+                                              1));
+  CU_ASSERT(0 == nghttp2_submit_ping(session, NULL));
+  nghttp2_session_get_stats(session, &stats);
+  CU_ASSERT(2 == stats.ob_ctrl_len);
+  CU_ASSERT(1 == stats.ob_pq_len);
+  CU_ASSERT(3 == nghttp2_session_get_outbound_queue_size(session));
+  item = nghttp2_session_pop_next_ob_item(session);
+  CU_ASSERT(NGHTTP2_PING == OB_CTRL_TYPE(item));
+  nghttp2_session_free_outbound_item(session, item);
+  item = nghttp2_session_pop_next_ob_item(session);
+  CU_ASSERT(NGHTTP2_WINDOW_UPDATE == OB_CTRL_TYPE(item));
+  nghttp2_session_free_outbound_item(session, item);
+  item = nghttp2_session_pop_next_ob_item(session);
+  CU_ASSERT(NGHTTP2_GOAWAY == OB_CTRL_TYPE(item));
+  nghttp2_session_free_outbound_item(session, item);
+  CU_ASSERT(NULL == nghttp2_session_pop_next_ob_item(session));
+
+  /* The peer sends 5 PINGs without reading the replies. Input is
+     refused once 3 replies are queued. */
+  CU_ASSERT(NGHTTP2_ERR_FLOODED ==
+            nghttp2_session_mem_recv(session, in, sizeof(in)));
+  nghttp2_session_get_stats(session, &stats);
+  CU_ASSERT(3 == stats.ob_ctrl_len);
+  CU_ASSERT(3 == stats.frames_recv[NGHTTP2_PING]);
+
+  /* Sending the replies makes room again */
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  CU_ASSERT(framelen * 2 ==
+            nghttp2_session_mem_recv(session, in, framelen * 2));
+  nghttp2_session_get_stats(session, &stats);
+  CU_ASSERT(2 == stats.ob_ctrl_len);
+  CU_ASSERT(3 == stats.frames_sent[NGHTTP2_PING]);
+
+  /* The frames the application submits do not count */
+  CU_ASSERT(0 == nghttp2_session_send(session));
+  for(i = 0; i < 5; ++i) {
+    CU_ASSERT(0 == nghttp2_submit_ping(session, NULL));
+  }
+  CU_ASSERT(framelen * 2 ==
+            nghttp2_session_mem_recv(session, in, framelen * 2));
+  nghttp2_session_get_stats(session, &stats);
+  CU_ASSERT(7 == stats.ob_ctrl_len);
+  CU_ASSERT(NGHTTP2_ERR_FLOODED ==
+            nghttp2_session_mem_recv(session, in, framelen * 2));
+  nghttp2_session_get_stats(session, &stats);
+  CU_ASSERT(8 == stats.ob_ctrl_len);
+
+  free(framedata);
+  nghttp2_session_del(session);
+}
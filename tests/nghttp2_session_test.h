@@ -56,6 +56,9 @@ void test_nghttp2_submit_response(void);
 void test_nghttp2_submit_response_without_data(void);
 void test_nghttp2_submit_request_with_data(void);
 void test_nghttp2_submit_request_without_data(void);
+void test_nghttp2_submit_request2(void);
+void test_nghttp2_submit_response2(void);
+void test_nghttp2_submit_request_async(void);
 void test_nghttp2_submit_headers_start_stream(void);
 void test_nghttp2_submit_headers_reply(void);
 void test_nghttp2_submit_headers_push_reply(void);
@@ -75,6 +78,7 @@ void test_nghttp2_session_max_concurrent_streams(void);
 void test_nghttp2_session_stream_close_on_headers_push(void);
 void test_nghttp2_session_stop_data_with_rst_stream(void);
 void test_nghttp2_session_defer_data(void);
+void test_nghttp2_session_resume_data_async(void);
 void test_nghttp2_session_flow_control(void);
 void test_nghttp2_session_flow_control_disable_remote(void);
 void test_nghttp2_session_flow_control_disable_local(void);
@@ -86,6 +90,22 @@ void test_nghttp2_session_on_ctrl_not_send(void);
 void test_nghttp2_session_get_outbound_queue_size(void);
 void test_nghttp2_session_set_option(void);
 void test_nghttp2_session_data_backoff_by_high_pri_frame(void);
+void test_nghttp2_session_custom_allocator(void);
+void test_nghttp2_session_sendv(void);
+void test_nghttp2_session_send_data_no_copy(void);
+void test_nghttp2_session_capture(void);
+void test_nghttp2_session_replay_captures(void);
+void test_nghttp2_session_mem_send(void);
+void test_nghttp2_session_fc_blocked_streams(void);
+void test_nghttp2_session_cancel_queued_data(void);
+void test_nghttp2_session_data_payload_length(void);
+void test_nghttp2_session_data_round_robin(void);
+void test_nghttp2_session_window_auto_tuning(void);
+void test_nghttp2_session_get_stats(void);
+void test_nghttp2_session_shrink(void);
+void test_nghttp2_session_select_header_indexing(void);
+void test_nghttp2_session_recv_header_block(void);
+void test_nghttp2_session_flooding(void);
 void test_nghttp2_pack_settings_payload(void);
 
 #endif /* NGHTTP2_SESSION_TEST_H */